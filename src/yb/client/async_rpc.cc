@@ -578,6 +578,14 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
   req_.set_proxy_uuid(data->batcher->proxy_uuid());
 
   int ctr = 0;
+  // The strictest staleness bound of ops batched in this RPC.
+  MonoDelta max_staleness;
+  auto update_max_staleness = [&max_staleness](const MonoDelta& op_max_staleness) {
+    if (op_max_staleness.Initialized() &&
+        (!max_staleness.Initialized() || op_max_staleness < max_staleness)) {
+      max_staleness = op_max_staleness;
+    }
+  };
   for (auto& op : ops_) {
     switch (op->yb_op->type()) {
       case YBOperation::Type::REDIS_READ: {
@@ -597,6 +605,7 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
         if (ql_op->read_time()) {
           ql_op->read_time().AddToPB(&req_);
         }
+        update_max_staleness(ql_op->max_staleness());
         break;
       }
       case YBOperation::Type::PGSQL_READ: {
@@ -606,6 +615,7 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
         if (pgsql_op->read_time()) {
           pgsql_op->read_time().AddToPB(&req_);
         }
+        update_max_staleness(pgsql_op->max_staleness());
         break;
       }
       case YBOperation::Type::PGSQL_WRITE: FALLTHROUGH_INTENDED;
@@ -621,6 +631,12 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
     VLOG(4) << ++ctr << ". Encoded row " << op->yb_op->ToString();
   }
 
+  if (max_staleness.Initialized() &&
+      yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX) {
+    req_.set_max_staleness_ms(std::max<int64_t>(max_staleness.ToMilliseconds(), 0));
+    tablet_invoker_.set_max_staleness(max_staleness);
+  }
+
   if (VLOG_IS_ON(3)) {
     VLOG(3) << "Created batch for " << data->tablet->tablet_id() << ":\n"
             << req_.ShortDebugString();
@@ -782,6 +798,13 @@ void ReadRpc::ProcessResponseFromTserver(const Status& status) {
   if (resp_.has_trace_buffer()) {
     TRACE_TO(trace_, "Received from server: $0", resp_.trace_buffer());
   }
+  if (status.ok() && resp_.has_safe_time() && resp_.has_propagated_hybrid_time()) {
+    // Remember how far behind the replica is, to route further bounded staleness reads.
+    auto staleness_us = HybridTime(resp_.propagated_hybrid_time()).PhysicalDiff(
+        HybridTime(resp_.safe_time()));
+    tablet_invoker_.tablet()->UpdateReplicaStaleness(
+        &tablet_invoker_.current_ts(), MonoDelta::FromMicroseconds(staleness_us));
+  }
   batcher_->ProcessReadResponse(*this, status);
   if (!CommonResponseCheck(status)) {
     SwapRequestsAndResponses(true);
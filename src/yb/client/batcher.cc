@@ -41,6 +41,8 @@
 #include <utility>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include <glog/logging.h>
 
 #include "yb/client/async_rpc.h"
@@ -405,8 +407,6 @@ void Batcher::TransactionReady(const Status& status, const BatcherPtr& self) {
   }
 }
 
-YB_DEFINE_ENUM(OpGroup, (kWrite)(kLeaderRead)(kConsistentPrefixRead));
-
 namespace {
 inline bool IsOkToReadFromFollower(const InFlightOpPtr& op) {
   return op->yb_op->type() == YBOperation::Type::REDIS_READ &&
@@ -431,6 +431,20 @@ OpGroup GetOpGroup(const InFlightOpPtr& op) {
   return OpGroup::kLeaderRead;
 }
 
+size_t CurrentThreadBufferIndex(const OpsBuffers& buffers) {
+  for (size_t i = 0; i != buffers.size(); ++i) {
+    const auto& buffer = buffers[i];
+    if (buffer.group == OpGroup::kConsistentPrefixRead) {
+      continue;
+    }
+    auto* leader = buffer.tablet->LeaderTServer();
+    if (leader != nullptr && leader->IsLocal()) {
+      return i;
+    }
+  }
+  return buffers.size() - 1;
+}
+
 void Batcher::FlushBuffersIfReady() {
   InFlightOps ops;
 
@@ -489,23 +503,20 @@ void Batcher::FlushBuffersIfReady() {
     return lhs->tablet.get() < rhs->tablet.get();
   });
 
-  // Now flush the ops for each tablet.
+  // Now split the ops into buffers, one per tablet and group.
+  OpsBuffers buffers;
   auto start = ops.begin();
   auto start_group = GetOpGroup(*start);
   int num_sidecars = 0; // QL read ops and some QL write ops return rows in a sidecar.
   for (auto it = start; it != ops.end(); ++it) {
     auto it_group = GetOpGroup(*it);
-    // Aggregate and flush the ops so far if either:
+    // Aggregate the ops so far into a buffer if either:
     //   - we reached the next tablet or group
     //   - we gathered more ops with rows result than we can handle in one call (kMaxSidecarSlices).
     if ((**it).tablet.get() != (**start).tablet.get() ||
         start_group != it_group ||
         num_sidecars >= rpc::CallResponse::kMaxSidecarSlices) {
-      // Consistent read is not required when whole batch fits into one command.
-      bool need_consistent_read = force_consistent_read || start != ops.begin() || it != ops.end();
-      FlushBuffer(
-          start->get()->tablet.get(), start, it, /* allow_local_calls_in_curr_thread */ false,
-          need_consistent_read);
+      buffers.push_back(OpsBuffer{start->get()->tablet.get(), start, it, start_group});
       start = it;
       start_group = it_group;
       num_sidecars = 0;
@@ -514,10 +525,25 @@ void Batcher::FlushBuffersIfReady() {
       num_sidecars++;
     }
   }
+  buffers.push_back(OpsBuffer{start->get()->tablet.get(), start, ops.end(), start_group});
+
+  // Only one buffer could be executed in the current thread, since executing it blocks sending the
+  // rest. Prefer the buffer whose tablet leader is in this process, so that it is handed directly
+  // to the local tablet service instead of being queued to its service pool, and send it last so
+  // that the remote calls are already in flight while it is executed.
+  const size_t curr_thread_buffer = CurrentThreadBufferIndex(buffers);
 
   // Consistent read is not required when whole batch fits into one command.
-  bool need_consistent_read = force_consistent_read || start != ops.begin();
-  FlushBuffer(start->get()->tablet.get(), start, ops.end(), allow_local_calls_in_curr_thread_,
+  const bool need_consistent_read = force_consistent_read || buffers.size() > 1;
+  for (size_t i = 0; i != buffers.size(); ++i) {
+    if (i != curr_thread_buffer) {
+      const auto& buffer = buffers[i];
+      FlushBuffer(buffer.tablet, buffer.begin, buffer.end,
+                  /* allow_local_calls_in_curr_thread */ false, need_consistent_read);
+    }
+  }
+  const auto& buffer = buffers[curr_thread_buffer];
+  FlushBuffer(buffer.tablet, buffer.begin, buffer.end, allow_local_calls_in_curr_thread_,
               need_consistent_read);
 }
 
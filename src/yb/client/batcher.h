@@ -36,6 +36,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "yb/client/async_rpc.h"
 #include "yb/client/transaction.h"
 
@@ -49,6 +51,7 @@
 #include "yb/util/async_util.h"
 #include "yb/util/atomic.h"
 #include "yb/util/debug-util.h"
+#include "yb/util/enums.h"
 #include "yb/util/locks.h"
 #include "yb/util/status.h"
 
@@ -70,6 +73,23 @@ class ErrorCollector;
 class RemoteTablet;
 class AsyncRpc;
 
+YB_DEFINE_ENUM(OpGroup, (kWrite)(kLeaderRead)(kConsistentPrefixRead));
+
+// Ops of the same tablet and group, that are sent to the tablet in a single RPC.
+struct OpsBuffer {
+  RemoteTablet* tablet;
+  InFlightOps::const_iterator begin;
+  InFlightOps::const_iterator end;
+  OpGroup group;
+};
+
+typedef boost::container::small_vector<OpsBuffer, 8> OpsBuffers;
+
+// Returns index of the buffer that should be executed in the current thread, i.e. the first
+// buffer whose tablet leader is local, or the last buffer when there is no such buffer.
+// Consistent prefix reads are not sent to the leader, so their buffers are never preferred.
+size_t CurrentThreadBufferIndex(const OpsBuffers& buffers);
+
 // A Batcher is the class responsible for collecting row operations, routing them to the
 // correct tablet server, and possibly batching them together for better efficiency.
 //
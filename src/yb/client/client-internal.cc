@@ -71,6 +71,7 @@
 #include "yb/util/flags.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/random_util.h"
 #include "yb/util/thread_restrictions.h"
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -1342,6 +1343,24 @@ shared_ptr<master::MasterServiceProxy> YBClient::Data::master_proxy() const {
   return master_proxy_;
 }
 
+shared_ptr<master::MasterServiceProxy> YBClient::Data::random_master_proxy() const {
+  std::vector<HostPort> addrs;
+  {
+    std::lock_guard<simple_spinlock> l(master_server_addrs_lock_);
+    for (const string& master_server_addr : master_server_addrs_) {
+      auto parsed = HostPort::ParseStrings(master_server_addr, master::kMasterDefaultPort);
+      if (!parsed.ok()) {
+        return nullptr;
+      }
+      addrs.insert(addrs.end(), parsed->begin(), parsed->end());
+    }
+  }
+  if (addrs.empty()) {
+    return nullptr;
+  }
+  return std::make_shared<master::MasterServiceProxy>(proxy_cache_.get(), RandomElement(addrs));
+}
+
 uint64_t YBClient::Data::GetLatestObservedHybridTime() const {
   return latest_observed_hybrid_time_.Load();
 }
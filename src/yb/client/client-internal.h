@@ -212,6 +212,10 @@ class YBClient::Data {
 
   std::shared_ptr<master::MasterServiceProxy> master_proxy() const;
 
+  // Returns proxy to a random master from 'master_server_addrs_', that could be a follower.
+  // Returns nullptr if master addresses could not be parsed.
+  std::shared_ptr<master::MasterServiceProxy> random_master_proxy() const;
+
   HostPort leader_master_hostport() const;
 
   uint64_t GetLatestObservedHybridTime() const;
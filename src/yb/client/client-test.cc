@@ -90,6 +90,7 @@
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
 #include "yb/util/tostring.h"
+#include "yb/util/tsan_util.h"
 
 DECLARE_bool(enable_data_block_fsync);
 DECLARE_bool(log_inject_latency);
@@ -1664,6 +1665,61 @@ TEST_F(ClientTest, TestMasterLookupPermits) {
             client_->data_->meta_cache_->master_lookup_sem_.GetValue());
 }
 
+// Only the partition group of the looked up key is fetched from the master, so lookups of keys in
+// the other groups must not be resolved to a cached tablet of an earlier group.
+TEST_F(ClientTest, LookupTabletByKeyInUncachedPartitionGroup) {
+  // Partition groups contain 4 tablets in debug builds, so this table spans several groups.
+  constexpr int kManyTablets = 12;
+  TableHandle table;
+  ASSERT_NO_FATALS(CreateTable(YBTableName("many_groups"), kManyTablets, &table));
+
+  auto* meta_cache = client_->data_->meta_cache_.get();
+  const auto& partitions = table->GetPartitions();
+  ASSERT_EQ(kManyTablets, partitions.size());
+  const auto deadline = MonoTime::Now() + 10s * kTimeMultiplier;
+  auto first_tablet = ASSERT_RESULT(meta_cache->LookupTabletByKeyFuture(
+      table.get(), partitions.front(), deadline).get());
+  ASSERT_EQ(partitions.front(), first_tablet->partition().partition_key_start());
+
+  std::set<TabletId> tablet_ids;
+  for (auto it = partitions.rbegin(); it != partitions.rend(); ++it) {
+    auto tablet = ASSERT_RESULT(meta_cache->LookupTabletByKeyFuture(
+        table.get(), *it, deadline).get());
+    ASSERT_EQ(*it, tablet->partition().partition_key_start());
+    tablet_ids.insert(tablet->tablet_id());
+  }
+  ASSERT_EQ(kManyTablets, tablet_ids.size());
+}
+
+TEST_F(ClientTest, RefreshTabletLocationsInBackground) {
+  auto tablet = ASSERT_RESULT(LookupFirstTabletFuture(client_table_.get()).get());
+  ASSERT_OK(WaitFor([&tablet] {
+    if (tablet->HasLeader()) {
+      return true;
+    }
+    tablet->MarkStale();
+    return false;
+  }, 10s * kTimeMultiplier, "Tablet leader known"));
+
+  ASSERT_TRUE(tablet->MarkReplicaFailed(
+      tablet->LeaderTServer(), STATUS(NetworkError, "Test failure")));
+  ASSERT_FALSE(tablet->HasLeader());
+
+  // The refresh should bring back the leader from the master, without any lookup by the caller.
+  client_->data_->meta_cache_->RefreshTabletLocations(tablet);
+  ASSERT_OK(WaitFor([&tablet] { return tablet->HasLeader(); },
+                    10s * kTimeMultiplier, "Tablet leader refreshed"));
+
+  // The refresh is finished, so the next one could be started.
+  ASSERT_OK(WaitFor([&tablet] {
+    if (!tablet->StartRefresh()) {
+      return false;
+    }
+    tablet->RefreshDone();
+    return true;
+  }, 10s * kTimeMultiplier, "Background refresh finished"));
+}
+
 // Define callback for deadlock simulation, as well as various helper methods.
 namespace {
 
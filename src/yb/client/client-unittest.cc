@@ -31,14 +31,26 @@
 //
 // Tests for the client which are true unit tests and don't require a cluster, etc.
 
+#include <algorithm>
 #include <functional>
+#include <set>
 #include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "yb/client/batcher.h"
 #include "yb/client/client.h"
 #include "yb/client/client-internal.h"
+#include "yb/client/meta_cache.h"
+#include "yb/client/transaction_manager.h"
+
+#include "yb/master/master.pb.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/proxy.h"
+
+#include "yb/tserver/tserver_service.proxy.h"
 
 namespace yb {
 namespace client {
@@ -171,6 +183,184 @@ TEST(ClientUnitTest, TestRetryFunc) {
   ASSERT_LT(counter, 20);
 }
 
+namespace {
+
+class OpsBuffersBuilder {
+ public:
+  OpsBuffersBuilder() {
+    messenger_ = CHECK_RESULT(rpc::MessengerBuilder("client-unittest").Build());
+    proxy_cache_ = std::make_unique<rpc::ProxyCache>(messenger_.get());
+    // Empty host port makes the proxy call the service of this process.
+    tservers_.emplace(kLocalTServer, std::make_unique<internal::RemoteTabletServer>(
+        kLocalTServer,
+        std::make_shared<tserver::TabletServerServiceProxy>(proxy_cache_.get(), HostPort())));
+    tservers_.emplace(kRemoteTServer, std::make_unique<internal::RemoteTabletServer>(
+        kRemoteTServer, nullptr /* proxy */));
+  }
+
+  ~OpsBuffersBuilder() {
+    buffers_.clear();
+    tablets_.clear();
+    tservers_.clear();
+    proxy_cache_.reset();
+    messenger_->Shutdown();
+  }
+
+  // Adds buffer of ops to a new tablet, led by the specified tablet server.
+  void Add(const std::string& leader_uuid, internal::OpGroup group) {
+    internal::RemoteTabletPtr tablet(new internal::RemoteTablet(
+        Format("tablet-$0", tablets_.size()), Partition()));
+    google::protobuf::RepeatedPtrField<master::TabletLocationsPB_ReplicaPB> replicas;
+    for (const auto& uuid : {kLocalTServer, kRemoteTServer}) {
+      auto* replica = replicas.Add();
+      replica->mutable_ts_info()->set_permanent_uuid(uuid);
+      replica->set_role(uuid == leader_uuid ? consensus::RaftPeerPB::LEADER
+                                            : consensus::RaftPeerPB::FOLLOWER);
+    }
+    tablet->Refresh(tservers_, replicas);
+    buffers_.push_back(internal::OpsBuffer{tablet.get(), ops_.end(), ops_.end(), group});
+    tablets_.push_back(std::move(tablet));
+  }
+
+  const internal::OpsBuffers& buffers() const {
+    return buffers_;
+  }
+
+  static const std::string kLocalTServer;
+  static const std::string kRemoteTServer;
+
+ private:
+  std::unique_ptr<rpc::Messenger> messenger_;
+  std::unique_ptr<rpc::ProxyCache> proxy_cache_;
+  internal::TabletServerMap tservers_;
+  std::vector<internal::RemoteTabletPtr> tablets_;
+  internal::InFlightOps ops_;
+  internal::OpsBuffers buffers_;
+};
+
+const std::string OpsBuffersBuilder::kLocalTServer = "local";
+const std::string OpsBuffersBuilder::kRemoteTServer = "remote";
+
+} // namespace
+
+TEST(ClientUnitTest, CurrentThreadBufferIndex) {
+  const auto& kLocal = OpsBuffersBuilder::kLocalTServer;
+  const auto& kRemote = OpsBuffersBuilder::kRemoteTServer;
+  using internal::OpGroup;
+
+  {
+    // Without local leader the last buffer is executed in the current thread.
+    OpsBuffersBuilder builder;
+    builder.Add(kRemote, OpGroup::kWrite);
+    builder.Add(kRemote, OpGroup::kLeaderRead);
+    ASSERT_EQ(1U, internal::CurrentThreadBufferIndex(builder.buffers()));
+  }
+
+  {
+    // Buffer of the local leader is preferred, even when it is not the last one.
+    OpsBuffersBuilder builder;
+    builder.Add(kRemote, OpGroup::kWrite);
+    builder.Add(kLocal, OpGroup::kWrite);
+    builder.Add(kRemote, OpGroup::kWrite);
+    ASSERT_EQ(1U, internal::CurrentThreadBufferIndex(builder.buffers()));
+  }
+
+  {
+    OpsBuffersBuilder builder;
+    builder.Add(kLocal, OpGroup::kLeaderRead);
+    builder.Add(kRemote, OpGroup::kWrite);
+    builder.Add(kLocal, OpGroup::kWrite);
+    ASSERT_EQ(0U, internal::CurrentThreadBufferIndex(builder.buffers()));
+  }
+
+  {
+    // Consistent prefix reads are not sent to the leader, so they are skipped.
+    OpsBuffersBuilder builder;
+    builder.Add(kLocal, OpGroup::kConsistentPrefixRead);
+    builder.Add(kLocal, OpGroup::kWrite);
+    builder.Add(kRemote, OpGroup::kWrite);
+    ASSERT_EQ(1U, internal::CurrentThreadBufferIndex(builder.buffers()));
+  }
+
+  {
+    OpsBuffersBuilder builder;
+    builder.Add(kLocal, OpGroup::kConsistentPrefixRead);
+    builder.Add(kRemote, OpGroup::kWrite);
+    builder.Add(kRemote, OpGroup::kLeaderRead);
+    ASSERT_EQ(2U, internal::CurrentThreadBufferIndex(builder.buffers()));
+  }
+}
+
+namespace {
+
+CloudInfoPB MakeCloudInfo(const std::string& region) {
+  CloudInfoPB result;
+  result.set_placement_cloud("cloud");
+  result.set_placement_region(region);
+  result.set_placement_zone(region + "_zone");
+  return result;
+}
+
+void AddTabletLocations(
+    const TabletId& tablet_id, const std::string& leader_region,
+    const std::string& follower_region,
+    google::protobuf::RepeatedPtrField<master::TabletLocationsPB>* locations) {
+  auto* tablet = locations->Add();
+  tablet->set_tablet_id(tablet_id);
+  auto* follower = tablet->add_replicas();
+  follower->set_role(consensus::RaftPeerPB::FOLLOWER);
+  *follower->mutable_ts_info()->mutable_cloud_info() = MakeCloudInfo(follower_region);
+  auto* leader = tablet->add_replicas();
+  leader->set_role(consensus::RaftPeerPB::LEADER);
+  *leader->mutable_ts_info()->mutable_cloud_info() = MakeCloudInfo(leader_region);
+}
+
+} // namespace
+
+TEST(ClientUnitTest, SelectStatusTablet) {
+  constexpr int kNumIterations = 20;
+  const std::string kLocalRegion = "local";
+  const std::string kRemoteRegion = "remote";
+
+  google::protobuf::RepeatedPtrField<master::TabletLocationsPB> locations;
+  // Follower in the local region does not make tablet preferred.
+  AddTabletLocations("remote_leader_1", kRemoteRegion, kLocalRegion, &locations);
+  AddTabletLocations("local_leader", kLocalRegion, kRemoteRegion, &locations);
+  AddTabletLocations("remote_leader_2", kRemoteRegion, kRemoteRegion, &locations);
+
+  auto tablets = internal::MakeTransactionTablets(MakeCloudInfo(kLocalRegion), locations);
+  ASSERT_EQ(3U, tablets->tablets.size());
+  ASSERT_EQ(std::vector<TabletId>{"local_leader"}, tablets->region_local_tablets);
+  for (int i = 0; i != kNumIterations; ++i) {
+    ASSERT_EQ("local_leader", internal::SelectStatusTablet(LocalTabletFilter(), *tablets));
+  }
+
+  // Tablet with leader on the local tablet server is preferred to the local region.
+  LocalTabletFilter filter = [](std::vector<const TabletId*>* ids) {
+    ids->erase(std::remove_if(ids->begin(), ids->end(), [](const TabletId* id) {
+      return *id != "remote_leader_2";
+    }), ids->end());
+  };
+  for (int i = 0; i != kNumIterations; ++i) {
+    ASSERT_EQ("remote_leader_2", internal::SelectStatusTablet(filter, *tablets));
+  }
+
+  // Client without placement does not prefer any region.
+  ASSERT_TRUE(internal::MakeTransactionTablets(CloudInfoPB(), locations)
+                  ->region_local_tablets.empty());
+
+  // Leader moved out of the local region, so any tablet could be picked.
+  locations.Mutable(1)->mutable_replicas(1)->mutable_ts_info()->mutable_cloud_info()->CopyFrom(
+      MakeCloudInfo(kRemoteRegion));
+  tablets = internal::MakeTransactionTablets(MakeCloudInfo(kLocalRegion), locations);
+  ASSERT_TRUE(tablets->region_local_tablets.empty());
+  std::set<TabletId> picked;
+  for (int i = 0; i != kNumIterations * 10; ++i) {
+    picked.insert(internal::SelectStatusTablet(LocalTabletFilter(), *tablets));
+  }
+  ASSERT_EQ(3U, picked.size());
+}
+
 } // namespace client
 } // namespace yb
 
@@ -508,7 +508,8 @@ Status YBClient::CreateNamespace(const std::string& namespace_name,
                                  const std::string& creator_role_name,
                                  const std::string& namespace_id,
                                  const std::string& source_namespace_id,
-                                 const boost::optional<uint32_t>& next_pg_oid) {
+                                 const boost::optional<uint32_t>& next_pg_oid,
+                                 bool colocated) {
   CreateNamespaceRequestPB req;
   CreateNamespaceResponsePB resp;
   req.set_name(namespace_name);
@@ -527,6 +528,7 @@ Status YBClient::CreateNamespace(const std::string& namespace_name,
   if (next_pg_oid) {
     req.set_next_pg_oid(*next_pg_oid);
   }
+  req.set_colocated(colocated);
   CALL_SYNC_LEADER_MASTER_RPC(req, resp, CreateNamespace);
   return Status::OK();
 }
@@ -536,7 +538,8 @@ Status YBClient::CreateNamespaceIfNotExists(const std::string& namespace_name,
                                             const std::string& creator_role_name,
                                             const std::string& namespace_id,
                                             const std::string& source_namespace_id,
-                                            const boost::optional<uint32_t>& next_pg_oid) {
+                                            const boost::optional<uint32_t>& next_pg_oid,
+                                            bool colocated) {
   Result<bool> namespace_exists = (!namespace_id.empty() ? NamespaceIdExists(namespace_id)
                                                          : NamespaceExists(namespace_name));
   if (VERIFY_RESULT(namespace_exists)) {
@@ -544,7 +547,7 @@ Status YBClient::CreateNamespaceIfNotExists(const std::string& namespace_name,
   }
 
   return CreateNamespace(namespace_name, database_type, creator_role_name, namespace_id,
-                         source_namespace_id, next_pg_oid);
+                         source_namespace_id, next_pg_oid, colocated);
 }
 
 Status YBClient::DeleteNamespace(const std::string& namespace_name,
@@ -988,6 +991,10 @@ const std::string& YBClient::proxy_uuid() const {
   return data_->uuid_;
 }
 
+const CloudInfoPB& YBClient::cloud_info() const {
+  return data_->cloud_info_pb_;
+}
+
 const ClientId& YBClient::id() const {
   return data_->id_;
 }
@@ -298,7 +298,8 @@ class YBClient {
                                  const std::string& creator_role_name = "",
                                  const std::string& namespace_id = "",
                                  const std::string& source_namespace_id = "",
-                                 const boost::optional<uint32_t>& next_pg_oid = boost::none);
+                                 const boost::optional<uint32_t>& next_pg_oid = boost::none,
+                                 bool colocated = false);
 
   // It calls CreateNamespace(), but before it checks that the namespace has NOT been yet
   // created. So, it prevents error 'namespace already exists'.
@@ -311,7 +312,8 @@ class YBClient {
                                             const std::string& namespace_id = "",
                                             const std::string& source_namespace_id = "",
                                             const boost::optional<uint32_t>& next_pg_oid =
-                                            boost::none);
+                                            boost::none,
+                                            bool colocated = false);
 
   // Delete namespace with the given name.
   CHECKED_STATUS DeleteNamespace(const std::string& namespace_name,
@@ -531,6 +533,9 @@ class YBClient {
 
   const std::string& proxy_uuid() const;
 
+  // Placement of this client, as specified by YBClientBuilder::set_cloud_info_pb.
+  const CloudInfoPB& cloud_info() const;
+
   // Id of this client instance.
   const ClientId& id() const;
 
@@ -556,6 +561,8 @@ class YBClient {
   friend class internal::TabletInvoker;
   friend class PlacementInfoTest;
 
+  FRIEND_TEST(ClientTest, LookupTabletByKeyInUncachedPartitionGroup);
+  FRIEND_TEST(ClientTest, RefreshTabletLocationsInBackground);
   FRIEND_TEST(ClientTest, TestGetTabletServerBlacklist);
   FRIEND_TEST(ClientTest, TestMasterDown);
   FRIEND_TEST(ClientTest, TestMasterLookupPermits);
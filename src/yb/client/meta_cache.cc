@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include <algorithm>
 #include <mutex>
 
 #include <glog/logging.h>
@@ -69,6 +70,23 @@ DEFINE_test_flag(bool, verify_all_replicas_alive, false,
 DEFINE_int32(retry_failed_replica_ms, 60 * 1000,
              "Time in milliseconds to wait for before retrying a failed replica");
 
+DEFINE_bool(refresh_tablet_locations_on_leader_failure, true,
+            "Whether the client should refresh the locations of a tablet from the master in "
+            "background as soon as its leader fails, instead of waiting for a retry to find that "
+            "there is no known leader");
+TAG_FLAG(refresh_tablet_locations_on_leader_failure, advanced);
+
+DEFINE_bool(lookup_tablet_locations_from_master_followers, false,
+            "Whether lookups of tables and tablets, that are absent from the client cache, could "
+            "be sent to a random master instead of the leader, so that clients warming up their "
+            "cache spread load across all masters. Requires masters to serve tablet locations on "
+            "followers, see master_follower_tablet_locations_refresh_interval_ms.");
+TAG_FLAG(lookup_tablet_locations_from_master_followers, advanced);
+
+DEFINE_int32(replica_staleness_expiration_ms, 5000,
+             "Time in milliseconds during which staleness reported by a replica is used to route "
+             "bounded staleness reads to other replicas");
+
 METRIC_DEFINE_histogram(
   server, dns_resolve_latency_during_init_proxy,
   "yb.client.MetaCache.InitProxy DNS Resolve",
@@ -270,6 +288,31 @@ bool RemoteTablet::MarkReplicaFailed(RemoteTabletServer *ts, const Status& statu
   return false;
 }
 
+void RemoteTablet::UpdateReplicaStaleness(const RemoteTabletServer* ts, MonoDelta staleness) {
+  std::lock_guard<simple_spinlock> l(lock_);
+  for (RemoteReplica& rep : replicas_) {
+    if (rep.ts == ts) {
+      rep.staleness = staleness;
+      rep.staleness_update_time = MonoTime::Now();
+      return;
+    }
+  }
+}
+
+void RemoteTablet::GetStaleReplicas(
+    MonoDelta max_staleness, std::set<std::string>* uuids) const {
+  auto expiration_time = MonoTime::Now() - FLAGS_replica_staleness_expiration_ms * 1ms;
+  std::lock_guard<simple_spinlock> l(lock_);
+  for (const RemoteReplica& rep : replicas_) {
+    // Staleness is reported only by replicas that served reads, so replica that was considered
+    // stale is tried again after some time.
+    if (rep.staleness_update_time.Initialized() && rep.staleness_update_time > expiration_time &&
+        rep.staleness > max_staleness) {
+      uuids->insert(rep.ts->permanent_uuid());
+    }
+  }
+}
+
 int RemoteTablet::GetNumFailedReplicas() const {
   int failed = 0;
   std::lock_guard<simple_spinlock> l(lock_);
@@ -295,10 +338,14 @@ bool RemoteTablet::HasLeader() const {
   return LeaderTServer() != nullptr;
 }
 
-void RemoteTablet::GetRemoteTabletServers(vector<RemoteTabletServer*>* servers) {
+void RemoteTablet::GetRemoteTabletServers(
+    vector<RemoteTabletServer*>* servers, IncludeReadReplicas include_read_replicas) {
   DCHECK(servers->empty());
   std::lock_guard<simple_spinlock> l(lock_);
   for (RemoteReplica& replica : replicas_) {
+    if (!include_read_replicas && replica.role == RaftPeerPB::READ_REPLICA) {
+      continue;
+    }
     if (replica.Failed()) {
       switch (replica.state) {
         case RaftGroupStatePB::UNKNOWN: FALLTHROUGH_INTENDED;
@@ -438,6 +485,8 @@ void MetaCache::UpdateTabletServerUnlocked(const master::TSInfoPB& pb) {
   CHECK(ts_cache_.emplace(permanent_uuid, std::make_unique<RemoteTabletServer>(pb)).second);
 }
 
+YB_STRONGLY_TYPED_BOOL(AllowFollowerMaster);
+
 // A (table, partition_key) --> tablet lookup. May be in-flight to a master, or
 // may be handled locally.
 //
@@ -447,7 +496,8 @@ class LookupRpc : public Rpc {
   LookupRpc(const scoped_refptr<MetaCache>& meta_cache,
             const MonoTime& deadline,
             Messenger* messenger,
-            rpc::ProxyCache* proxy_cache);
+            rpc::ProxyCache* proxy_cache,
+            AllowFollowerMaster allow_follower_master);
 
   virtual ~LookupRpc();
 
@@ -461,7 +511,7 @@ class LookupRpc : public Rpc {
   virtual void Notify(const Status& status, const RemoteTabletPtr& result = nullptr) = 0;
 
   std::shared_ptr<MasterServiceProxy> master_proxy() const {
-    return client()->data_->master_proxy();
+    return follower_master_proxy_ ? follower_master_proxy_ : client()->data_->master_proxy();
   }
 
   template <class Response>
@@ -483,17 +533,26 @@ class LookupRpc : public Rpc {
   // Whether this lookup has acquired a master lookup permit.
   bool has_permit_ = false;
 
+  // Proxy to a random master, that could be a follower serving tablet locations from its copy of
+  // the sys catalog. Used until the first failure, then the lookup is sent to the leader.
+  std::shared_ptr<MasterServiceProxy> follower_master_proxy_;
+
   rpc::Rpcs::Handle retained_self_;
 };
 
 LookupRpc::LookupRpc(const scoped_refptr<MetaCache>& meta_cache,
                      const MonoTime& deadline,
                      Messenger* messenger,
-                     rpc::ProxyCache* proxy_cache)
+                     rpc::ProxyCache* proxy_cache,
+                     AllowFollowerMaster allow_follower_master)
     : Rpc(deadline, messenger, proxy_cache),
       meta_cache_(meta_cache),
       retained_self_(meta_cache_->rpcs_.InvalidHandle()) {
   DCHECK(deadline.Initialized());
+  if (allow_follower_master && FLAGS_lookup_tablet_locations_from_master_followers &&
+      client()->IsMultiMaster()) {
+    follower_master_proxy_ = client()->data_->random_master_proxy();
+  }
 }
 
 LookupRpc::~LookupRpc() {
@@ -550,6 +609,18 @@ void LookupRpc::NewLeaderMasterDeterminedCb(const Status& status) {
 template <class Response>
 void LookupRpc::DoFinished(
     const Status& status, const Response& resp, const std::string* partition_group_start) {
+  if (follower_master_proxy_ &&
+      (!status.ok() || !retrier().controller().status().ok() || resp.has_error() ||
+       resp.tablet_locations_size() == 0)) {
+    // The master could be a follower without fresh tablet locations, so the lookup is retried on
+    // the leader. There is no reason to determine the leader again, it did not fail.
+    VLOG(1) << ToString() << " was not served by a random master, retrying on the leader";
+    follower_master_proxy_ = nullptr;
+    mutable_retrier()->mutable_controller()->Reset();
+    SendRpc();
+    return;
+  }
+
   if (resp.has_error()) {
     LOG(INFO) << "Got resp error " << resp.error().code() << ", code=" << status.CodeAsString();
   }
@@ -623,6 +694,7 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
 
   {
     std::lock_guard<decltype(mutex_)> l(mutex_);
+    std::unordered_set<TableId> updated_tables;
     for (const TabletLocationsPB& loc : locations) {
       for (const std::string& table_id : loc.table_ids()) {
         auto& table_data = tables_[table_id];
@@ -652,6 +724,7 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
 
           CHECK(tablets_by_id_.emplace(tablet_id, remote).second);
           CHECK(tablets_by_key.emplace(partition.partition_key_start(), remote).second);
+          updated_tables.insert(table_id);
         }
         remote->Refresh(ts_cache_, loc.replicas());
 
@@ -680,6 +753,9 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
         }
       }
     }
+    if (!updated_tables.empty()) {
+      UpdateTablesSnapshotUnlocked(updated_tables);
+    }
   }
 
   for (const auto& callback_and_remote_tablet : to_notify) {
@@ -752,7 +828,7 @@ void MetaCache::LookupFailed(
   if (max_deadline) {
     rpc::StartRpc<LookupByKeyRpc>(
         this, table, partition_group_start, max_deadline, client_->data_->messenger_,
-        client_->data_->proxy_cache_.get());
+        client_->data_->proxy_cache_.get(), AllowFollowerMaster::kFalse);
   }
 }
 
@@ -763,8 +839,9 @@ class LookupByIdRpc : public LookupRpc {
                 TabletId tablet_id,
                 const MonoTime& deadline,
                 Messenger* messenger,
-                rpc::ProxyCache* proxy_cache)
-      : LookupRpc(meta_cache, deadline, messenger, proxy_cache),
+                rpc::ProxyCache* proxy_cache,
+                AllowFollowerMaster allow_follower_master)
+      : LookupRpc(meta_cache, deadline, messenger, proxy_cache, allow_follower_master),
         user_cb_(std::move(user_cb)),
         tablet_id_(std::move(tablet_id)) {}
 
@@ -817,8 +894,9 @@ class LookupByKeyRpc : public LookupRpc {
                  MetaCache::PartitionGroupKey partition_group_start,
                  const MonoTime& deadline,
                  Messenger* messenger,
-                 rpc::ProxyCache* proxy_cache)
-      : LookupRpc(meta_cache, deadline, messenger, proxy_cache),
+                 rpc::ProxyCache* proxy_cache,
+                 AllowFollowerMaster allow_follower_master)
+      : LookupRpc(meta_cache, deadline, messenger, proxy_cache, allow_follower_master),
         table_(table->shared_from_this()),
         partition_group_start_(std::move(partition_group_start)) {
   }
@@ -855,7 +933,7 @@ class LookupByKeyRpc : public LookupRpc {
 
   void Notify(const Status& status, const RemoteTabletPtr& result) override {
     if (status.ok()) {
-      return; // This case is handled by LookupTabletByKeyFastPathUnlocked.
+      return; // This case is handled by ProcessTabletLocations.
     }
     meta_cache()->LookupFailed(table_.get(), partition_group_start_, status);
   }
@@ -873,22 +951,31 @@ class LookupByKeyRpc : public LookupRpc {
   GetTableLocationsResponsePB resp_;
 };
 
-RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* table,
-                                                             const std::string& partition_key) {
-  auto it = tables_.find(table->id());
-  if (PREDICT_FALSE(it == tables_.end())) {
+RemoteTabletPtr MetaCache::LookupTabletByKeyFastPath(const YBTable* table,
+                                                     const std::string& partition_key) {
+  const auto snapshot = std::atomic_load_explicit(&tables_snapshot_, std::memory_order_acquire);
+  auto it = snapshot->find(table->id());
+  if (PREDICT_FALSE(it == snapshot->end())) {
     // No cache available for this table.
     return nullptr;
   }
 
   DCHECK_EQ(partition_key, table->FindPartitionStart(partition_key));
-  auto tablet_it = it->second.tablets_by_partition.find(partition_key);
-  if (PREDICT_FALSE(tablet_it == it->second.tablets_by_partition.end())) {
-    // No tablets with a start partition key lower than 'partition_key'.
+  const auto& tablets = *it->second;
+  auto tablet_it = std::lower_bound(
+      tablets.begin(), tablets.end(), partition_key,
+      [](const RemoteTabletPtr& tablet, const std::string& key) {
+        return tablet->partition().partition_key_start() < key;
+      });
+  // The cache is filled lazily, one partition group at a time, so the closest cached tablet
+  // below the key could belong to another group. Only the tablet starting exactly at
+  // 'partition_key' owns it.
+  if (PREDICT_FALSE(tablet_it == tablets.end() ||
+                    (*tablet_it)->partition().partition_key_start() != partition_key)) {
     return nullptr;
   }
 
-  const auto& result = tablet_it->second;
+  const auto& result = *tablet_it;
 
   // Stale entries must be re-fetched.
   if (result->stale()) {
@@ -904,6 +991,27 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* tabl
   return nullptr;
 }
 
+void MetaCache::UpdateTablesSnapshotUnlocked(const std::unordered_set<TableId>& table_ids) {
+  // Only the arrays of updated tables are rebuilt, the rest are shared with the current snapshot.
+  auto snapshot = std::make_shared<TablesSnapshot>(*tables_snapshot_);
+  for (const auto& table_id : table_ids) {
+    const auto& tablets_by_partition = tables_[table_id].tablets_by_partition;
+    auto tablets = std::make_shared<TabletsByPartitionStart>();
+    tablets->reserve(tablets_by_partition.size());
+    for (const auto& partition_and_tablet : tablets_by_partition) {
+      tablets->push_back(partition_and_tablet.second);
+    }
+    std::sort(tablets->begin(), tablets->end(),
+              [](const RemoteTabletPtr& lhs, const RemoteTabletPtr& rhs) {
+      return lhs->partition().partition_key_start() < rhs->partition().partition_key_start();
+    });
+    (*snapshot)[table_id] = std::move(tablets);
+  }
+  std::atomic_store_explicit(
+      &tables_snapshot_, std::shared_ptr<const TablesSnapshot>(std::move(snapshot)),
+      std::memory_order_release);
+}
+
 template <class Lock>
 bool MetaCache::FastLookupTabletByKeyUnlocked(
     const YBTable* table,
@@ -911,7 +1019,7 @@ bool MetaCache::FastLookupTabletByKeyUnlocked(
     const LookupTabletCallback& callback,
     Lock* lock) {
   // Fast path: lookup in the cache.
-  auto result = LookupTabletByKeyFastPathUnlocked(table, partition_start);
+  auto result = LookupTabletByKeyFastPath(table, partition_start);
   if (result && result->HasLeader()) {
     lock->unlock();
     VLOG(3) << "Fast lookup: found tablet " << result->tablet_id();
@@ -928,16 +1036,19 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
                                   LookupTabletCallback callback) {
   const auto& partition_start = table->FindPartitionStart(partition_key);
 
-  rpc::Rpcs::Handle rpc;
+  // Fast path: lookup in the published snapshot, without taking mutex_.
   {
-    boost::shared_lock<boost::shared_mutex> lock(mutex_);
-    if (FastLookupTabletByKeyUnlocked(table, partition_start, callback, &lock)) {
+    auto result = LookupTabletByKeyFastPath(table, partition_start);
+    if (result && result->HasLeader()) {
+      VLOG(3) << "Fast lookup: found tablet " << result->tablet_id();
+      callback(result);
       return;
     }
   }
 
   const std::string& partition_group_start =
       table->FindPartitionStart(partition_start, kPartitionGroupSize);
+  AllowFollowerMaster allow_follower_master = AllowFollowerMaster::kFalse;
   {
     std::unique_lock<boost::shared_mutex> lock(mutex_);
     if (FastLookupTabletByKeyUnlocked(table, partition_start, callback, &lock)) {
@@ -951,11 +1062,13 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
     if (!was_empty) {
       return;
     }
+    // Only the initial lookups of a table could be served by a master follower.
+    allow_follower_master = AllowFollowerMaster(table_data.tablets_by_partition.empty());
   }
 
   rpc::StartRpc<LookupByKeyRpc>(
       this, table, partition_group_start, deadline, client_->data_->messenger_,
-      client_->data_->proxy_cache_.get());
+      client_->data_->proxy_cache_.get(), allow_follower_master);
 }
 
 RemoteTabletPtr MetaCache::LookupTabletByIdFastPath(const TabletId& tablet_id) {
@@ -971,6 +1084,7 @@ void MetaCache::LookupTabletById(const TabletId& tablet_id,
                                  const MonoTime& deadline,
                                  LookupTabletCallback callback,
                                  UseCache use_cache) {
+  AllowFollowerMaster allow_follower_master = AllowFollowerMaster::kFalse;
   if (use_cache) {
     // Fast path: lookup in the cache.
     scoped_refptr<RemoteTablet> result = LookupTabletByIdFastPath(tablet_id);
@@ -979,11 +1093,13 @@ void MetaCache::LookupTabletById(const TabletId& tablet_id,
       callback(result);
       return;
     }
+    // Only the initial lookup of a tablet could be served by a master follower.
+    allow_follower_master = AllowFollowerMaster(result == nullptr);
   }
 
   rpc::StartRpc<LookupByIdRpc>(
       this, std::move(callback), tablet_id, deadline, client_->data_->messenger_,
-      client_->data_->proxy_cache_.get());
+      client_->data_->proxy_cache_.get(), allow_follower_master);
 }
 
 void MetaCache::MarkTSFailed(RemoteTabletServer* ts,
@@ -1001,6 +1117,24 @@ void MetaCache::MarkTSFailed(RemoteTabletServer* ts,
   }
 }
 
+void MetaCache::RefreshTabletLocations(const RemoteTabletPtr& tablet) {
+  if (!FLAGS_refresh_tablet_locations_on_leader_failure || !tablet->StartRefresh()) {
+    return;
+  }
+
+  VLOG(1) << "Refreshing locations of tablet " << tablet->tablet_id() << " in background";
+  rpc::StartRpc<LookupByIdRpc>(
+      this,
+      [tablet](const Result<RemoteTabletPtr>& result) {
+        VLOG_IF(1, !result.ok()) << "Background refresh of tablet " << tablet->tablet_id()
+                                 << " failed: " << result.status();
+        tablet->RefreshDone();
+      },
+      tablet->tablet_id(), MonoTime::Now() + client_->default_rpc_timeout(),
+      client_->data_->messenger_, client_->data_->proxy_cache_.get(),
+      AllowFollowerMaster::kFalse);
+}
+
 bool MetaCache::AcquireMasterLookupPermit() {
   return master_lookup_sem_.TryAcquire();
 }
@@ -33,10 +33,13 @@
 #ifndef YB_CLIENT_META_CACHE_H
 #define YB_CLIENT_META_CACHE_H
 
+#include <atomic>
 #include <map>
+#include <set>
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/thread/shared_mutex.hpp>
@@ -170,6 +173,10 @@ struct RemoteReplica {
   MonoTime last_failed_time = MonoTime::kUninitialized;
   // The state of this replica. Only updated after calling GetTabletStatus.
   tablet::RaftGroupStatePB state = tablet::RaftGroupStatePB::UNKNOWN;
+  // How far behind the leader this replica was, i.e. difference between its clock and safe time,
+  // as reported with the last read response. Used to route bounded staleness reads.
+  MonoDelta staleness;
+  MonoTime staleness_update_time = MonoTime::kUninitialized;
 
   RemoteReplica(RemoteTabletServer* ts_, consensus::RaftPeerPB::Role role_)
       : ts(ts_), role(role_) {}
@@ -197,6 +204,7 @@ struct RemoteReplica {
 typedef std::unordered_map<std::string, std::unique_ptr<RemoteTabletServer>> TabletServerMap;
 
 YB_STRONGLY_TYPED_BOOL(UpdateLocalTsState);
+YB_STRONGLY_TYPED_BOOL(IncludeReadReplicas);
 
 // The client's view of a given tablet. This object manages lookups of
 // the tablet's locations, status, etc.
@@ -238,6 +246,12 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   // Return the number of failed replicas for this tablet.
   int GetNumFailedReplicas() const;
 
+  // Remembers staleness of replica hosted by 'ts', reported with read response.
+  void UpdateReplicaStaleness(const RemoteTabletServer* ts, MonoDelta staleness);
+
+  // Adds uuids of tablet servers whose replicas recently reported staleness above max_staleness.
+  void GetStaleReplicas(MonoDelta max_staleness, std::set<std::string>* uuids) const;
+
   // Return the tablet server which is acting as the current LEADER for
   // this tablet, provided it hasn't failed.
   //
@@ -249,11 +263,16 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   // Writes this tablet's TSes (across all replicas) to 'servers' for all available replicas. If a
   // replica has failed recently, check if it is available now if it is local. For remote replica,
   // wait for some time (configurable) before retrying.
-  void GetRemoteTabletServers(std::vector<RemoteTabletServer*>* servers);
-
-  std::vector<RemoteTabletServer*> GetRemoteTabletServers() {
+  // Observers of read replica clusters are skipped unless include_read_replicas is set, since they
+  // could serve only consistent prefix reads.
+  void GetRemoteTabletServers(
+      std::vector<RemoteTabletServer*>* servers,
+      IncludeReadReplicas include_read_replicas = IncludeReadReplicas::kTrue);
+
+  std::vector<RemoteTabletServer*> GetRemoteTabletServers(
+      IncludeReadReplicas include_read_replicas = IncludeReadReplicas::kTrue) {
     std::vector<RemoteTabletServer*> result;
-    GetRemoteTabletServers(&result);
+    GetRemoteTabletServers(&result, include_read_replicas);
     return result;
   }
 
@@ -283,6 +302,16 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
 
   MonoTime refresh_time() { return refresh_time_.load(std::memory_order_acquire); }
 
+  // Returns true if the caller should refresh the locations of this tablet in background, i.e. no
+  // other background refresh is in progress. RefreshDone should be called when it is finished.
+  bool StartRefresh() {
+    return !refresh_in_progress_.exchange(true, std::memory_order_acq_rel);
+  }
+
+  void RefreshDone() {
+    refresh_in_progress_.store(false, std::memory_order_release);
+  }
+
  private:
   // Same as ReplicasAsString(), except that the caller must hold lock_.
   std::string ReplicasAsStringUnlocked() const;
@@ -300,6 +329,9 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   // checking whether it has been initialized everytime we use this value.
   std::atomic<MonoTime> refresh_time_{MonoTime::Min()};
 
+  // Whether a background refresh of the tablet locations is in progress.
+  std::atomic<bool> refresh_in_progress_{false};
+
   DISALLOW_COPY_AND_ASSIGN(RemoteTablet);
 };
 
@@ -358,6 +390,11 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   // not be returned in future cache lookups.
   void MarkTSFailed(RemoteTabletServer* ts, const Status& status);
 
+  // Refresh the locations of the tablet from the master in background, so the new leader is
+  // usually known by the time the failed operations are retried. Does nothing if a refresh of
+  // this tablet is already in progress.
+  void RefreshTabletLocations(const RemoteTabletPtr& tablet);
+
   // Acquire or release a permit to perform a (slow) master lookup.
   //
   // If acquisition fails, caller may still do the lookup, but is first
@@ -378,10 +415,15 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   FRIEND_TEST(client::ClientTest, TestMasterLookupPermits);
 
-  // Lookup the given tablet by key, only consulting local information.
-  // Returns true and sets *remote_tablet if successful.
-  RemoteTabletPtr LookupTabletByKeyFastPathUnlocked(const YBTable* table,
-                                                    const std::string& partition_key);
+  // Lookup the given tablet by key, only consulting the published tables snapshot, so no lock is
+  // required. Returns the tablet if successful.
+  RemoteTabletPtr LookupTabletByKeyFastPath(const YBTable* table,
+                                            const std::string& partition_key);
+
+  // Publish a new snapshot of tables with rebuilt tablet arrays of the specified tables.
+  //
+  // NOTE: Must be called with mutex_ exclusively held.
+  void UpdateTablesSnapshotUnlocked(const std::unordered_set<TableId>& table_ids);
 
   RemoteTabletPtr LookupTabletByIdFastPath(const TabletId& tablet_id);
 
@@ -444,6 +486,16 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   std::unordered_map<TableId, TableData> tables_;
 
+  // Immutable snapshot of the cached tablets of each table sorted by partition start. Readers load
+  // it without taking mutex_ and use binary search to find the tablet of a partition key, writers
+  // publish a new snapshot while holding mutex_ exclusively.
+  typedef std::vector<RemoteTabletPtr> TabletsByPartitionStart;
+  typedef std::unordered_map<TableId, std::shared_ptr<const TabletsByPartitionStart>>
+      TablesSnapshot;
+
+  // Accessed with std::atomic_load/std::atomic_store.
+  std::shared_ptr<const TablesSnapshot> tables_snapshot_ = std::make_shared<TablesSnapshot>();
+
   // Cache of tablets, keyed by tablet ID.
   //
   // Protected by lock_
@@ -18,7 +18,10 @@
 #include "yb/client/table_alterer.h"
 #include "yb/client/table_handle.h"
 
+#include "yb/consensus/consensus.h"
+
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/mini_tablet_server.h"
@@ -1253,6 +1256,53 @@ TEST_F(QLDmlTest, ReadFollower) {
   ASSERT_TRUE(missing_rows.empty()) << "Missing rows: " << yb::ToString(missing_rows);
 }
 
+TEST_F(QLDmlTest, BoundedStalenessRead) {
+  constexpr int kNumRows = 100;
+
+  ASSERT_NO_FATALS(InsertRows(kNumRows));
+
+  auto follower_peers = ListTabletPeers(
+      cluster_.get(), [this](const std::shared_ptr<tablet::TabletPeer>& peer) {
+    return peer->tablet_metadata()->table_id() == table_->id() &&
+           peer->consensus()->GetLeaderStatus() == consensus::LeaderStatus::NOT_LEADER;
+  });
+  ASSERT_FALSE(follower_peers.empty());
+  auto follower_reads = [&follower_peers] {
+    uint64_t result = 0;
+    for (const auto& peer : follower_peers) {
+      result += peer->tablet()->metrics()->ql_read_latency->TotalCount();
+    }
+    return result;
+  };
+  const auto follower_reads_before = follower_reads();
+
+  // Staleness bound is large enough for followers to qualify, so they should serve some reads.
+  // Rows could be not yet replicated to the follower, so retry until they are visible.
+  auto must_see_all_rows_after_this_deadline = MonoTime::Now() + 5s * kTimeMultiplier;
+  auto session = NewSession();
+  for (int i = 0; i != kNumRows; ++i) {
+    for (;;) {
+      auto op = SelectRow(session, kValueColumns, KeyForIndex(i));
+      op->set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+      op->set_max_staleness(MonoDelta::FromSeconds(3600));
+      ASSERT_OK(session->Flush());
+      ASSERT_EQ(op->response().status(), QLResponsePB::YQL_STATUS_OK);
+      auto rowblock = RowsResult(op.get()).GetRowBlock();
+      if (rowblock->row_count() == 0) {
+        ASSERT_LE(MonoTime::Now(), must_see_all_rows_after_this_deadline);
+        continue;
+      }
+      ASSERT_EQ(1, rowblock->row_count());
+      const auto& row = rowblock->row(0);
+      ASSERT_EQ((RowValue{row.column(0).int32_value(), row.column(1).string_value()}),
+                ValueForIndex(i));
+      break;
+    }
+  }
+
+  ASSERT_GT(follower_reads(), follower_reads_before);
+}
+
 TEST_F(QLDmlTest, DeletePartialRangeKey) {
   auto session = NewSession();
   RowKey row_key{1, "a", 2, "b"};
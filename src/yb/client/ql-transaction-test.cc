@@ -34,6 +34,7 @@
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver_service.pb.h"
 
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 
 #include "yb/yql/cql/ql/util/errcodes.h"
@@ -58,6 +59,13 @@ DECLARE_int32(master_inject_latency_on_transactional_tablet_lookups_ms);
 DECLARE_int64(transaction_rpc_timeout_ms);
 DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(delay_init_tablet_peer_ms);
+DECLARE_uint64(txn_max_apply_batch_records);
+DECLARE_uint64(transaction_resend_applying_interval_usec);
+DECLARE_double(txn_continue_apply_failure_probability);
+DECLARE_int32(transaction_apply_retry_initial_delay_ms);
+DECLARE_uint64(transaction_table_num_tablets);
+
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_GetTransactionStatus);
 
 namespace yb {
 namespace client {
@@ -88,6 +96,43 @@ TEST_F(QLTransactionTest, Simple) {
   CheckNoRunningTransactions();
 }
 
+// Apply intents of transaction in several batches, so most of them are applied in background.
+TEST_F(QLTransactionTest, ApplyInBatches) {
+  FLAGS_txn_max_apply_batch_records = 3;
+
+  ASSERT_NO_FATALS(WriteData());
+  ASSERT_NO_FATALS(VerifyData());
+  ASSERT_OK(cluster_->RestartSync());
+  ASSERT_NO_FATALS(VerifyData());
+  CheckNoRunningTransactions();
+}
+
+// Coordinator resends APPLYING while the previous apply is still in progress in background.
+TEST_F(QLTransactionTest, ApplyInBatchesWithResend) {
+  FLAGS_txn_max_apply_batch_records = 1;
+  FLAGS_transaction_resend_applying_interval_usec = 1000;
+
+  ASSERT_NO_FATALS(WriteData());
+  ASSERT_NO_FATALS(VerifyData());
+  CheckNoRunningTransactions();
+}
+
+// Batches applied in background fail, so they are retried until transaction is applied.
+TEST_F(QLTransactionTest, ApplyInBatchesWithFailures) {
+  FLAGS_txn_max_apply_batch_records = 1;
+  FLAGS_txn_continue_apply_failure_probability = 0.5;
+  FLAGS_transaction_apply_retry_initial_delay_ms = 10;
+
+  ASSERT_NO_FATALS(WriteData());
+  ASSERT_NO_FATALS(VerifyData());
+  CheckNoRunningTransactions();
+
+  FLAGS_txn_continue_apply_failure_probability = 0;
+  ASSERT_OK(cluster_->RestartSync());
+  ASSERT_NO_FATALS(VerifyData());
+  CheckNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, LookupTabletFailure) {
   FLAGS_master_inject_latency_on_transactional_tablet_lookups_ms =
       TransactionRpcTimeout().ToMilliseconds() + 500;
@@ -540,6 +585,66 @@ TEST_F(QLTransactionTest, SimpleWriteConflict) {
   ASSERT_NOK(transaction->CommitFuture().get());
 }
 
+class BatchedConflictResolutionTest : public QLTransactionTest {
+ protected:
+  void SetUp() override {
+    // Status requests to the same status tablet are batched, so use single status tablet.
+    FLAGS_transaction_table_num_tablets = 1;
+    QLTransactionTest::SetUp();
+  }
+
+  int NumTablets() override {
+    return 1;
+  }
+
+  int64_t NumGetTransactionStatusRequests() {
+    int64_t result = 0;
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      auto metrics = cluster_->mini_tablet_server(i)->server()->metric_entity()
+          ->UnsafeMetricsMapForTests();
+      auto it = metrics.find(
+          &METRIC_handler_latency_yb_tserver_TabletServerService_GetTransactionStatus);
+      if (it != metrics.end()) {
+        result += down_cast<Histogram*>(it->second.get())->TotalCount();
+      }
+    }
+    return result;
+  }
+};
+
+// Write that conflicts with several pending transactions should request their statuses using
+// a single RPC, since they have the same status tablet.
+TEST_F_EX(QLTransactionTest, BatchedConflictResolution, BatchedConflictResolutionTest) {
+  constexpr int32_t kNumTransactions = 10;
+
+  std::vector<YBTransactionPtr> transactions;
+  for (int32_t key = 0; key != kNumTransactions; ++key) {
+    transactions.push_back(CreateTransaction());
+    ASSERT_OK(WriteRow(CreateSession(transactions.back()), key, key));
+  }
+
+  const auto num_requests_before = NumGetTransactionStatusRequests();
+
+  // Non transactional write aborts all conflicting pending transactions.
+  auto session = CreateSession();
+  for (int32_t key = 0; key != kNumTransactions; ++key) {
+    ASSERT_OK(WriteRow(session, key, -key, WriteOpType::INSERT, Flush::kFalse));
+  }
+  ASSERT_OK(session->Flush());
+
+  const auto num_requests = NumGetTransactionStatusRequests() - num_requests_before;
+  LOG(INFO) << "Status requests: " << num_requests;
+  ASSERT_GT(num_requests, 0);
+  ASSERT_LT(num_requests, kNumTransactions);
+
+  for (const auto& transaction : transactions) {
+    ASSERT_NOK(transaction->CommitFuture().get());
+  }
+  for (int32_t key = 0; key != kNumTransactions; ++key) {
+    ASSERT_EQ(-key, ASSERT_RESULT(SelectRow(session, key)));
+  }
+}
+
 void QLTransactionTest::TestWriteConflicts(bool do_restarts) {
   struct ActiveTransaction {
     YBTransactionPtr transaction;
@@ -1027,28 +1132,28 @@ struct TransactionState {
     auto resp = status_future.get();
     ASSERT_OK(resp);
 
-    if (resp->status() == TransactionStatus::ABORTED) {
+    if (resp->status(0) == TransactionStatus::ABORTED) {
       ASSERT_TRUE(commit_future.valid());
       transaction = nullptr;
       return;
     }
 
-    auto new_time = HybridTime(resp->status_hybrid_time());
+    auto new_time = HybridTime(resp->status_hybrid_time(0));
     if (last_status == TransactionStatus::PENDING) {
-      if (resp->status() == TransactionStatus::PENDING) {
+      if (resp->status(0) == TransactionStatus::PENDING) {
         ASSERT_GE(new_time, status_time);
       } else {
-        ASSERT_EQ(TransactionStatus::COMMITTED, resp->status());
+        ASSERT_EQ(TransactionStatus::COMMITTED, resp->status(0));
         ASSERT_GT(new_time, status_time);
       }
     } else {
       ASSERT_EQ(last_status, TransactionStatus::COMMITTED);
-      ASSERT_EQ(resp->status(), TransactionStatus::COMMITTED)
-          << "Bad transaction status: " << TransactionStatus_Name(resp->status());
+      ASSERT_EQ(resp->status(0), TransactionStatus::COMMITTED)
+          << "Bad transaction status: " << TransactionStatus_Name(resp->status(0));
       ASSERT_EQ(status_time, new_time);
     }
     status_time = new_time;
-    last_status = resp->status();
+    last_status = resp->status(0);
   }
 };
 
@@ -1110,7 +1215,7 @@ TEST_F(QLTransactionTest, StatusEvolution) {
       }
       tserver::GetTransactionStatusRequestPB req;
       req.set_tablet_id(state.metadata.status_tablet);
-      req.set_transaction_id(state.metadata.transaction_id.data,
+      req.add_transaction_id(state.metadata.transaction_id.data,
                              state.metadata.transaction_id.size());
       state.status_future = rpc::WrapRpcFuture<tserver::GetTransactionStatusResponsePB>(
           GetTransactionStatus, &rpcs)(
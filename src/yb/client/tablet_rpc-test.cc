@@ -108,6 +108,52 @@ TEST_F(TabletRpcTest, TabletInvokerSelectTabletServerRace) {
   replicas_refresher.join();
 }
 
+TEST_F(TabletRpcTest, TabletInvokerDoesNotSelectReadReplicaAsLeader) {
+  master::TabletLocationsPB tablet_locations;
+  tablet_locations.set_tablet_id(kTestTablet);
+  tablet_locations.set_stale(false);
+
+  auto* observer = tablet_locations.add_replicas();
+  FillTsInfo("n1-uuid", "n1", "127.0.0.1", observer->mutable_ts_info());
+  observer->set_role(consensus::RaftPeerPB_Role::RaftPeerPB_Role_READ_REPLICA);
+  observer->set_member_type(consensus::RaftPeerPB_MemberType::RaftPeerPB_MemberType_OBSERVER);
+
+  auto* voter = tablet_locations.add_replicas();
+  FillTsInfo("n2-uuid", "n2", "127.0.0.2", voter->mutable_ts_info());
+  voter->set_role(consensus::RaftPeerPB_Role::RaftPeerPB_Role_FOLLOWER);
+  voter->set_member_type(consensus::RaftPeerPB_MemberType::RaftPeerPB_MemberType_VOTER);
+
+  TabletServerMap ts_map;
+  for (const auto& replica : tablet_locations.replicas()) {
+    const auto& uuid = replica.ts_info().permanent_uuid();
+    ts_map.emplace(uuid, std::make_unique<RemoteTabletServer>(uuid, nullptr, nullptr));
+  }
+
+  Partition partition;
+  Partition::FromPB(tablet_locations.partition(), &partition);
+  internal::RemoteTabletPtr remote_tablet = new internal::RemoteTablet(
+      tablet_locations.tablet_id(), partition);
+  remote_tablet->Refresh(ts_map, tablet_locations.replicas());
+
+  ASSERT_EQ(2, remote_tablet->GetRemoteTabletServers().size());
+  ASSERT_EQ(1, remote_tablet->GetRemoteTabletServers(IncludeReadReplicas::kFalse).size());
+
+  scoped_refptr<Trace> trace(new Trace());
+  internal::TabletInvoker invoker(false /* local_tserver_only */,
+                                  false /* consistent_prefix */,
+                                  nullptr /* client */,
+                                  nullptr /* command */,
+                                  nullptr /* rpc */,
+                                  remote_tablet.get(),
+                                  nullptr /* retrier */,
+                                  trace.get());
+  invoker.SelectTabletServer();
+
+  auto* leader = remote_tablet->LeaderTServer();
+  ASSERT_NE(nullptr, leader);
+  ASSERT_EQ("n2-uuid", leader->permanent_uuid());
+}
+
 } // namespace internal
 } // namespace client
 } // namespace yb
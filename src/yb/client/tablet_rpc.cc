@@ -57,9 +57,21 @@ TabletInvoker::~TabletInvoker() {}
 
 void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
   std::vector<RemoteTabletServer*> candidates;
+  std::set<std::string> blacklist;
+  if (max_staleness_.Initialized()) {
+    // Bounded staleness read, skip replicas that rejected it or are known to be too far behind.
+    for (const auto* ts : followers_) {
+      blacklist.insert(ts->permanent_uuid());
+    }
+    tablet_->GetStaleReplicas(max_staleness_, &blacklist);
+  }
   current_ts_ = client_->data_->SelectTServer(tablet_.get(),
-                                              YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
-                                              &candidates);
+                                              YBClient::ReplicaSelection::CLOSEST_REPLICA,
+                                              blacklist, &candidates);
+  if (!current_ts_ && !blacklist.empty()) {
+    // All replicas are too stale, so redirect read to the leader.
+    SelectTabletServer();
+  }
   VLOG(1) << "Using tserver: " << yb::ToString(current_ts_);
 }
 
@@ -105,7 +117,8 @@ void TabletInvoker::SelectTabletServer()  {
     // Try to "guess" the next leader.
     for (;;) {
       vector<RemoteTabletServer*> replicas;
-      tablet_->GetRemoteTabletServers(&replicas);
+      // Observers never become leaders, so there is no point to try them.
+      tablet_->GetRemoteTabletServers(&replicas, IncludeReadReplicas::kFalse);
       for (RemoteTabletServer* ts : replicas) {
         if (!ContainsKey(followers_, ts)) {
           current_ts_ = ts;
@@ -209,14 +222,25 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
                                        const tserver::TabletServerErrorPB* error_code) {
   VLOG(1) << "Failing " << command_->ToString() << " to a new replica: " << reason.ToString();
 
-  bool found = ErrorCode(error_code) != tserver::TabletServerErrorPB::STALE_FOLLOWER &&
-               (!tablet_ || tablet_->MarkReplicaFailed(current_ts_, reason));
-  if (!found) {
-    // Its possible that current_ts_ is not part of replicas if RemoteTablet.Refresh() is invoked
-    // which updates the set of replicas.
-    LOG(WARNING) << "Tablet " << tablet_id_ << ": Unable to mark replica "
-                 << current_ts_->ToString()
-                 << " as failed. Replicas: " << tablet_->ReplicasAsString();
+  if (ErrorCode(error_code) == tserver::TabletServerErrorPB::STALE_FOLLOWER) {
+    // Stale follower is healthy, so it is not marked as failed, just another replica is tried.
+    VLOG(2) << "Tablet " << tablet_id_ << ": Replica " << current_ts_->ToString()
+            << " is too stale, trying another one";
+  } else {
+    bool found = !tablet_ || tablet_->MarkReplicaFailed(current_ts_, reason);
+    if (!found) {
+      // Its possible that current_ts_ is not part of replicas if RemoteTablet.Refresh() is invoked
+      // which updates the set of replicas.
+      LOG(WARNING) << "Tablet " << tablet_id_ << ": Unable to mark replica "
+                   << current_ts_->ToString()
+                   << " as failed. Replicas: " << tablet_->ReplicasAsString();
+    }
+  }
+
+  // The leader is gone, start looking up the new one right away, so it is likely to be known by the
+  // time of the retry.
+  if (tablet_ && !tablet_->HasLeader()) {
+    client_->data_->meta_cache_->RefreshTabletLocations(tablet_);
   }
 
   auto status = retrier_->DelayedRetry(command_, reason);
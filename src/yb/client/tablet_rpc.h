@@ -75,6 +75,10 @@ class TabletInvoker {
   const RemoteTabletServer& current_ts() { return *current_ts_; }
   bool local_tserver_only() const { return local_tserver_only_; }
 
+  // Max staleness of consistent prefix read, replicas that are known to lag behind more are not
+  // selected.
+  void set_max_staleness(MonoDelta max_staleness) { max_staleness_ = max_staleness; }
+
  private:
   friend class TabletRpcTest;
   FRIEND_TEST(TabletRpcTest, TabletInvokerSelectTabletServerRace);
@@ -135,6 +139,8 @@ class TabletInvoker {
 
   const bool consistent_prefix_;
 
+  MonoDelta max_staleness_;
+
   // The TS receiving the write. May change if the write is retried.
   // RemoteTabletServer is taken from YBClient cache, so it is guaranteed that those objects are
   // alive while YBClient is alive. Because we don't delete them, but only add and update.
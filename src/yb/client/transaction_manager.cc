@@ -26,42 +26,112 @@
 
 #include "yb/common/transaction.h"
 
+#include "yb/master/master.pb.h"
 #include "yb/master/master_defaults.h"
 
+DEFINE_uint64(transaction_table_locations_refresh_interval_ms, 60000,
+              "Interval at which transaction manager refreshes locations of transaction status "
+              "tablets, used to prefer status tablets with leader in the local region.");
+
 namespace yb {
 namespace client {
 
+namespace internal {
+
 namespace {
 
-const YBTableName kTransactionTableName(master::kSystemNamespaceName, kTransactionsTableName);
+bool SameRegion(const CloudInfoPB& lhs, const CloudInfoPB& rhs) {
+  return lhs.has_placement_region() && rhs.has_placement_region() &&
+         lhs.placement_cloud() == rhs.placement_cloud() &&
+         lhs.placement_region() == rhs.placement_region();
+}
 
-// Exists - table exists.
-// Updating - intermediate state, we are currently updating local cache of tablets.
-// Resolved - final state, when all tablets are resolved and written to cache.
-YB_DEFINE_ENUM(TransactionTableStatus, (kExists)(kUpdating)(kResolved));
+} // namespace
 
-void InvokeCallback(const LocalTabletFilter& filter, const std::vector<TabletId>& tablets,
-                    const PickStatusTabletCallback& callback) {
+TransactionTabletsPtr MakeTransactionTablets(
+    const CloudInfoPB& client_cloud_info,
+    const google::protobuf::RepeatedPtrField<master::TabletLocationsPB>& locations) {
+  auto result = std::make_shared<TransactionTablets>();
+  result->tablets.reserve(locations.size());
+  for (const auto& tablet : locations) {
+    result->tablets.push_back(tablet.tablet_id());
+    for (const auto& replica : tablet.replicas()) {
+      if (replica.role() == consensus::RaftPeerPB::LEADER &&
+          SameRegion(client_cloud_info, replica.ts_info().cloud_info())) {
+        result->region_local_tablets.push_back(tablet.tablet_id());
+        break;
+      }
+    }
+  }
+  result->resolve_time = CoarseMonoClock::now();
+  return result;
+}
+
+const TabletId& SelectStatusTablet(
+    const LocalTabletFilter& filter, const TransactionTablets& tablets) {
   if (filter) {
     std::vector<const TabletId*> ids;
-    ids.reserve(tablets.size());
-    for (const auto& id : tablets) {
+    ids.reserve(tablets.tablets.size());
+    for (const auto& id : tablets.tablets) {
       ids.push_back(&id);
     }
     filter(&ids);
     if (!ids.empty()) {
-      callback(*RandomElement(ids));
-      return;
+      return *RandomElement(ids);
     }
-    LOG(WARNING) << "No local transaction status tablet";
+    VLOG(1) << "No local transaction status tablet";
+  }
+  if (!tablets.region_local_tablets.empty()) {
+    return RandomElement(tablets.region_local_tablets);
   }
-  callback(RandomElement(tablets));
+  return RandomElement(tablets.tablets);
+}
+
+} // namespace internal
+
+namespace {
+
+const YBTableName kTransactionTableName(master::kSystemNamespaceName, kTransactionsTableName);
+
+// Exists - table exists.
+// Updating - intermediate state, we are currently updating local cache of tablets.
+// Resolved - final state, when all tablets are resolved and written to cache.
+YB_DEFINE_ENUM(TransactionTableStatus, (kExists)(kUpdating)(kResolved));
+
+void InvokeCallback(const LocalTabletFilter& filter, const internal::TransactionTablets& tablets,
+                    const PickStatusTabletCallback& callback) {
+  callback(internal::SelectStatusTablet(filter, tablets));
 }
 
 struct TransactionTableState {
   LocalTabletFilter local_tablet_filter;
   std::atomic<TransactionTableStatus> status{TransactionTableStatus::kExists};
-  std::vector<TabletId> tablets;
+
+  internal::TransactionTabletsPtr tablets() const {
+    return std::atomic_load_explicit(&tablets_, std::memory_order_acquire);
+  }
+
+  void SetTablets(internal::TransactionTabletsPtr tablets) {
+    std::atomic_store_explicit(&tablets_, std::move(tablets), std::memory_order_release);
+  }
+
+  // Returns true when caller should refresh locations of status tablets. Only one caller
+  // gets true until refresh is finished.
+  bool StartRefreshIfStale() {
+    auto current = tablets();
+    if (CoarseMonoClock::now() <
+            current->resolve_time +
+            std::chrono::milliseconds(FLAGS_transaction_table_locations_refresh_interval_ms)) {
+      return false;
+    }
+    bool expected = false;
+    return refreshing.compare_exchange_strong(expected, true, std::memory_order_acq_rel);
+  }
+
+  std::atomic<bool> refreshing{false};
+
+ private:
+  internal::TransactionTabletsPtr tablets_;
 };
 
 // Picks status tablet for transaction.
@@ -76,24 +146,25 @@ class PickStatusTabletTask {
 
   void Run() {
     // TODO(dtxn) async
-    std::vector<TabletId> tablets;
-    auto status = client_->GetTablets(kTransactionTableName, 0, &tablets, /* ranges */ nullptr);
+    google::protobuf::RepeatedPtrField<master::TabletLocationsPB> locations;
+    auto status = client_->GetTablets(kTransactionTableName, 0, &locations);
     if (!status.ok()) {
       callback_(status);
       return;
     }
-    if (tablets.empty()) {
+    if (locations.empty()) {
       callback_(STATUS_FORMAT(IllegalState, "No tablets in table $0", kTransactionTableName));
       return;
     }
+    auto tablets = internal::MakeTransactionTablets(client_->cloud_info(), locations);
     auto expected = TransactionTableStatus::kExists;
     if (table_state_->status.compare_exchange_strong(
         expected, TransactionTableStatus::kUpdating, std::memory_order_acq_rel)) {
-      table_state_->tablets = tablets;
+      table_state_->SetTablets(tablets);
       table_state_->status.store(TransactionTableStatus::kResolved, std::memory_order_release);
     }
 
-    InvokeCallback(table_state_->local_tablet_filter, tablets, callback_);
+    InvokeCallback(table_state_->local_tablet_filter, *tablets, callback_);
   }
 
   void Done(const Status& status) {
@@ -119,7 +190,7 @@ class InvokeCallbackTask {
   }
 
   void Run() {
-    InvokeCallback(table_state_->local_tablet_filter, table_state_->tablets, callback_);
+    InvokeCallback(table_state_->local_tablet_filter, *table_state_->tablets(), callback_);
   }
 
   void Done(const Status& status) {
@@ -134,6 +205,33 @@ class InvokeCallbackTask {
   PickStatusTabletCallback callback_;
 };
 
+// Refreshes locations of status tablets, since their leaders could move to other regions.
+class RefreshTabletsTask {
+ public:
+  RefreshTabletsTask(YBClient* client, TransactionTableState* table_state)
+      : client_(client), table_state_(table_state) {
+  }
+
+  void Run() {
+    google::protobuf::RepeatedPtrField<master::TabletLocationsPB> locations;
+    auto status = client_->GetTablets(kTransactionTableName, 0, &locations);
+    if (!status.ok() || locations.empty()) {
+      LOG(WARNING) << "Failed to refresh transaction status tablets: " << status;
+      return;
+    }
+    table_state_->SetTablets(internal::MakeTransactionTablets(client_->cloud_info(), locations));
+  }
+
+  void Done(const Status& status) {
+    table_state_->refreshing.store(false, std::memory_order_release);
+    client_ = nullptr;
+  }
+
+ private:
+  YBClient* client_;
+  TransactionTableState* table_state_;
+};
+
 constexpr size_t kQueueLimit = 150;
 constexpr size_t kMaxWorkers = 50;
 
@@ -148,14 +246,19 @@ class TransactionManager::Impl {
         table_state_{std::move(local_tablet_filter)},
         thread_pool_("TransactionManager", kQueueLimit, kMaxWorkers),
         tasks_pool_(kQueueLimit),
-        invoke_callback_tasks_(kQueueLimit) {
+        invoke_callback_tasks_(kQueueLimit),
+        refresh_tasks_(1) {
     CHECK(clock);
   }
 
   void PickStatusTablet(PickStatusTabletCallback callback) {
     if (table_state_.status.load(std::memory_order_acquire) == TransactionTableStatus::kResolved) {
+      if (table_state_.StartRefreshIfStale() &&
+          !refresh_tasks_.Enqueue(&thread_pool_, client_, &table_state_)) {
+        table_state_.refreshing.store(false, std::memory_order_release);
+      }
       if (ThreadRestrictions::IsWaitAllowed()) {
-        InvokeCallback(table_state_.local_tablet_filter, table_state_.tablets, callback);
+        InvokeCallback(table_state_.local_tablet_filter, *table_state_.tablets(), callback);
       } else if (!invoke_callback_tasks_.Enqueue(&thread_pool_, &table_state_, callback)) {
         callback(STATUS_FORMAT(ServiceUnavailable,
                               "Invoke callback queue overflow, number of tasks: $0",
@@ -205,6 +308,7 @@ class TransactionManager::Impl {
   yb::rpc::ThreadPool thread_pool_; // TODO async operations instead of pool
   yb::rpc::TasksPool<PickStatusTabletTask> tasks_pool_;
   yb::rpc::TasksPool<InvokeCallbackTask> invoke_callback_tasks_;
+  yb::rpc::TasksPool<RefreshTabletsTask> refresh_tasks_;
   yb::rpc::Rpcs rpcs_;
 };
 
@@ -18,6 +18,9 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
+
+#include <google/protobuf/repeated_field.h>
 
 #include "yb/client/client_fwd.h"
 
@@ -26,13 +29,48 @@
 
 #include "yb/rpc/rpc_fwd.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/result.h"
 
 namespace yb {
+
+class CloudInfoPB;
+
+namespace master {
+
+class TabletLocationsPB;
+
+} // namespace master
+
 namespace client {
 
 typedef std::function<void(const Result<std::string>&)> PickStatusTabletCallback;
 
+namespace internal {
+
+// Status tablets of transaction table.
+struct TransactionTablets {
+  std::vector<TabletId> tablets;
+  // Tablets whose leader is placed in the same region as client.
+  std::vector<TabletId> region_local_tablets;
+  CoarseTimePoint resolve_time;
+};
+
+typedef std::shared_ptr<const TransactionTablets> TransactionTabletsPtr;
+
+TransactionTabletsPtr MakeTransactionTablets(
+    const CloudInfoPB& client_cloud_info,
+    const google::protobuf::RepeatedPtrField<master::TabletLocationsPB>& locations);
+
+// Picks status tablet in the following order of preference:
+// 1) Tablet with leader on the local tablet server, when filter is specified.
+// 2) Tablet with leader in the same region as client.
+// 3) Any tablet.
+const TabletId& SelectStatusTablet(
+    const LocalTabletFilter& filter, const TransactionTablets& tablets);
+
+} // namespace internal
+
 // TransactionManager manages multiple transactions. It lives at the YQL engine layer.
 class TransactionManager {
  public:
@@ -41,6 +41,8 @@
 #include "yb/common/partition.h"
 #include "yb/common/read_hybrid_time.h"
 
+#include "yb/util/monotime.h"
+
 namespace yb {
 
 class RedisWriteRequestPB;
@@ -353,6 +355,12 @@ class YBqlReadOp : public YBqlOp {
     yb_consistency_level_ = yb_consistency_level;
   }
 
+  // Bounded staleness of CONSISTENT_PREFIX read. If set, read is served only by replicas that
+  // lag behind the leader by no more than the specified time, otherwise it is redirected.
+  const MonoDelta& max_staleness() const { return max_staleness_; }
+
+  void set_max_staleness(MonoDelta max_staleness) { max_staleness_ = max_staleness; }
+
   std::vector<ColumnSchema> MakeColumnSchemasFromRequest() const;
   Result<QLRowBlock> MakeRowBlock() const;
 
@@ -367,6 +375,7 @@ class YBqlReadOp : public YBqlOp {
   explicit YBqlReadOp(const std::shared_ptr<YBTable>& table);
   std::unique_ptr<QLReadRequestPB> ql_read_request_;
   YBConsistencyLevel yb_consistency_level_;
+  MonoDelta max_staleness_;
   ReadHybridTime read_time_;
 };
 
@@ -480,6 +489,12 @@ class YBPgsqlReadOp : public YBPgsqlOp {
     yb_consistency_level_ = yb_consistency_level;
   }
 
+  // Bounded staleness of CONSISTENT_PREFIX read. If set, read is served only by replicas that
+  // lag behind the leader by no more than the specified time, otherwise it is redirected.
+  const MonoDelta& max_staleness() const { return max_staleness_; }
+
+  void set_max_staleness(MonoDelta max_staleness) { max_staleness_ = max_staleness; }
+
   std::vector<ColumnSchema> MakeColumnSchemasFromRequest() const;
   Result<QLRowBlock> MakeRowBlock() const;
 
@@ -0,0 +1,61 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/common/ql_expr.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+
+class QLTableRowTest : public YBTest {
+};
+
+TEST_F(QLTableRowTest, Columns) {
+  const ColumnId kColumn(kFirstColumnId + 1);
+  // Virtual columns have negative ids.
+  const auto kVirtualColumn = static_cast<ColumnIdRep>(PgSystemAttrNum::kYBTupleId);
+
+  QLTableRow row;
+  ASSERT_TRUE(row.IsEmpty());
+  ASSERT_FALSE(row.GetValue(kColumn));
+
+  QLValue value;
+  value.set_string_value("value");
+  row.AllocColumn(kColumn, value);
+  value.set_binary_value("ybctid");
+  row.AllocColumn(kVirtualColumn, value).ttl_seconds = 10;
+  ASSERT_EQ(2U, row.ColumnCount());
+  ASSERT_EQ("value", row.GetValue(kColumn)->string_value());
+  ASSERT_EQ("ybctid", row.GetValue(kVirtualColumn)->binary_value());
+  int64_t ttl_seconds = 0;
+  ASSERT_OK(row.GetTTL(kVirtualColumn, &ttl_seconds));
+  ASSERT_EQ(10, ttl_seconds);
+
+  QLTableRow copy;
+  ASSERT_FALSE(copy.MatchColumn(kColumn, row));
+  ASSERT_OK(copy.CopyColumn(kColumn, row));
+  ASSERT_TRUE(copy.MatchColumn(kColumn, row));
+
+  // Reused row does not expose columns of the previous row.
+  row.Clear();
+  ASSERT_TRUE(row.IsEmpty());
+  ASSERT_FALSE(row.GetValue(kColumn));
+  ASSERT_FALSE(row.GetValue(kVirtualColumn));
+  auto& column = row.AllocColumn(kVirtualColumn);
+  ASSERT_EQ(QLValuePB::VALUE_NOT_SET, column.value.value_case());
+  ASSERT_TRUE(column.write_time == QLTableColumn::kUninitializedWriteTime);
+  ASSERT_EQ(1U, row.ColumnCount());
+}
+
+} // namespace yb
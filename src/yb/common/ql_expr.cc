@@ -2,8 +2,11 @@
 // Copyright (c) YugaByte, Inc.
 //--------------------------------------------------------------------------------------------------
 
-#include "yb/common/jsonb.h"
 #include "yb/common/ql_expr.h"
+
+#include <algorithm>
+
+#include "yb/common/jsonb.h"
 #include "yb/common/ql_bfunc.h"
 
 namespace yb {
@@ -626,14 +629,39 @@ CHECKED_STATUS QLExprExecutor::EvalCondition(const PgsqlConditionPB& condition,
 
 //--------------------------------------------------------------------------------------------------
 
+const QLTableColumn* QLTableRow::FindColumn(ColumnIdRep col_id) const {
+  if (col_id >= kFirstColumnId.rep() && col_id - kFirstColumnId.rep() < kMaxDenseColumns) {
+    const size_t index = static_cast<size_t>(col_id - kFirstColumnId.rep());
+    return index < dense_assigned_.size() && dense_assigned_[index] ? &dense_columns_[index]
+                                                                     : nullptr;
+  }
+  for (const auto& sparse : sparse_columns_) {
+    if (sparse.id == col_id) {
+      return sparse.assigned ? &sparse.column : nullptr;
+    }
+  }
+  return nullptr;
+}
+
+void QLTableRow::Clear() {
+  if (num_assigned_ == 0) {
+    return;
+  }
+  std::fill(dense_assigned_.begin(), dense_assigned_.end(), false);
+  for (auto& sparse : sparse_columns_) {
+    sparse.assigned = false;
+  }
+  num_assigned_ = 0;
+}
+
 CHECKED_STATUS QLTableRow::ReadColumn(ColumnIdRep col_id, QLValue *col_value) const {
-  const auto& col_iter = col_map_.find(col_id);
-  if (col_iter == col_map_.end()) {
+  const auto* column = FindColumn(col_id);
+  if (column == nullptr) {
     col_value->SetNull();
     return Status::OK();
   }
 
-  *col_value = col_iter->second.value;
+  *col_value = column->value;
   return Status::OK();
 }
 
@@ -642,21 +670,21 @@ CHECKED_STATUS QLTableRow::ReadSubscriptedColumn(const QLSubscriptedColPB& subco
                                                  QLValue *col_value) const {
   col_value->SetNull();
 
-  const auto& col_iter = col_map_.find(subcol.column_id());
-  if (col_iter == col_map_.end()) {
+  const auto* column = FindColumn(subcol.column_id());
+  if (column == nullptr) {
     // Not exists.
     return Status::OK();
-  } else if (col_iter->second.value.has_map_value()) {
+  } else if (column->value.has_map_value()) {
     // map['key']
-    auto& map = col_iter->second.value.map_value();
+    auto& map = column->value.map_value();
     for (int i = 0; i < map.keys_size(); i++) {
       if (map.keys(i) == index_arg.value()) {
           *col_value = map.values(i);
       }
     }
-  } else if (col_iter->second.value.has_list_value()) {
+  } else if (column->value.has_list_value()) {
     // list[index]
-    auto& list = col_iter->second.value.list_value();
+    auto& list = column->value.list_value();
     if (index_arg.value().has_int32_value()) {
       int list_index = index_arg.int32_value();
       if (list_index >= 0 && list_index < list.elems_size()) {
@@ -668,91 +696,144 @@ CHECKED_STATUS QLTableRow::ReadSubscriptedColumn(const QLSubscriptedColPB& subco
 }
 
 CHECKED_STATUS QLTableRow::GetTTL(ColumnIdRep col_id, int64_t *ttl_seconds) const {
-  const auto& col_iter = col_map_.find(col_id);
-  if (col_iter == col_map_.end()) {
+  const auto* column = FindColumn(col_id);
+  if (column == nullptr) {
     // Not exists.
     return STATUS(InternalError, "Column unexpectedly not found in cache");
   }
-  *ttl_seconds = col_iter->second.ttl_seconds;
+  *ttl_seconds = column->ttl_seconds;
   return Status::OK();
 }
 
 CHECKED_STATUS QLTableRow::GetWriteTime(ColumnIdRep col_id, int64_t *write_time) const {
-  const auto& col_iter = col_map_.find(col_id);
-  if (col_iter == col_map_.end()) {
+  const auto* column = FindColumn(col_id);
+  if (column == nullptr) {
     // Not exists.
     return STATUS(InternalError, "Column unexpectedly not found in cache");
   }
-  DCHECK_NE(QLTableColumn::kUninitializedWriteTime, col_iter->second.write_time);
-  *write_time = col_iter->second.write_time;
+  DCHECK_NE(QLTableColumn::kUninitializedWriteTime, column->write_time);
+  *write_time = column->write_time;
   return Status::OK();
 }
 
 CHECKED_STATUS QLTableRow::GetValue(ColumnIdRep col_id, QLValue *column) const {
-  const auto& col_iter = col_map_.find(col_id);
-  if (col_iter == col_map_.end()) {
+  const auto* table_column = FindColumn(col_id);
+  if (table_column == nullptr) {
     // Not exists.
     return STATUS(InternalError, "Column unexpectedly not found in cache");
   }
-  *column = std::move(col_iter->second.value);
+  *column = table_column->value;
   return Status::OK();
 }
 
 boost::optional<const QLValuePB&> QLTableRow::GetValue(ColumnIdRep col_id) const {
-  const auto& col_iter = col_map_.find(col_id);
-  if (col_iter == col_map_.end()) {
+  const auto* column = FindColumn(col_id);
+  if (column == nullptr) {
     return boost::none;
   }
-  return col_iter->second.value;
+  return column->value;
 }
 
 void QLTableRow::ClearValue(ColumnIdRep col_id) {
-  col_map_[col_id].value.Clear();
+  AllocColumn(col_id).value.Clear();
 }
 
 bool QLTableRow::MatchColumn(ColumnIdRep col_id, const QLTableRow& source) const {
-  auto this_iter = col_map_.find(col_id);
-  auto source_iter = source.col_map_.find(col_id);
-  if (this_iter != col_map_.end() && source_iter != source.col_map_.end()) {
-    return this_iter->second.value == source_iter->second.value;
+  const auto* this_column = FindColumn(col_id);
+  const auto* source_column = source.FindColumn(col_id);
+  if (this_column != nullptr && source_column != nullptr) {
+    return this_column->value == source_column->value;
   }
-  if (this_iter != col_map_.end() || source_iter != source.col_map_.end()) {
+  if (this_column != nullptr || source_column != nullptr) {
     return false;
   }
   return true;
 }
 
 QLTableColumn& QLTableRow::AllocColumn(ColumnIdRep col_id) {
-  return col_map_[col_id];
+  QLTableColumn* column;
+  if (col_id >= kFirstColumnId.rep() && col_id - kFirstColumnId.rep() < kMaxDenseColumns) {
+    const size_t index = static_cast<size_t>(col_id - kFirstColumnId.rep());
+    if (index >= dense_columns_.size()) {
+      dense_columns_.resize(index + 1);
+      dense_assigned_.resize(index + 1, false);
+    }
+    column = &dense_columns_[index];
+    if (dense_assigned_[index]) {
+      return *column;
+    }
+    dense_assigned_[index] = true;
+  } else {
+    auto it = std::find_if(
+        sparse_columns_.begin(), sparse_columns_.end(),
+        [col_id](const SparseColumn& sparse) { return sparse.id == col_id; });
+    if (it == sparse_columns_.end()) {
+      sparse_columns_.push_back(SparseColumn{col_id, false, QLTableColumn()});
+      it = sparse_columns_.end() - 1;
+    }
+    column = &it->column;
+    if (it->assigned) {
+      return *column;
+    }
+    it->assigned = true;
+  }
+  ++num_assigned_;
+  // Storage could be left from the previous use of this row, so column is reset to the state of
+  // a newly allocated one.
+  column->value.Clear();
+  column->ttl_seconds = 0;
+  column->write_time = QLTableColumn::kUninitializedWriteTime;
+  return *column;
 }
 
 QLTableColumn& QLTableRow::AllocColumn(ColumnIdRep col_id, const QLValue& ql_value) {
-  col_map_[col_id].value = ql_value.value();
-  return col_map_[col_id];
+  QLTableColumn& column = AllocColumn(col_id);
+  column.value = ql_value.value();
+  return column;
 }
 
 QLTableColumn& QLTableRow::AllocColumn(ColumnIdRep col_id, const QLValuePB& ql_value) {
-  col_map_[col_id].value = ql_value;
-  return col_map_[col_id];
+  QLTableColumn& column = AllocColumn(col_id);
+  column.value = ql_value;
+  return column;
 }
 
 CHECKED_STATUS QLTableRow::CopyColumn(ColumnIdRep col_id,
                                       const QLTableRow& source) {
-  auto col_iter = source.col_map_.find(col_id);
-  if (col_iter != source.col_map_.end()) {
-    col_map_[col_id] = col_iter->second;
+  const auto* source_column = source.FindColumn(col_id);
+  if (source_column != nullptr) {
+    AllocColumn(col_id) = *source_column;
   }
   return Status::OK();
 }
 
+std::string QLTableRow::ToString() const {
+  std::string ret("{ ");
+  auto append = [&ret](ColumnIdRep col_id, const QLTableColumn& column) {
+    ret += Format("$0 -> $1 ", col_id, column);
+  };
+  for (size_t index = 0; index != dense_columns_.size(); ++index) {
+    if (dense_assigned_[index]) {
+      append(static_cast<ColumnIdRep>(index) + kFirstColumnId.rep(), dense_columns_[index]);
+    }
+  }
+  for (const auto& sparse : sparse_columns_) {
+    if (sparse.assigned) {
+      append(sparse.id, sparse.column);
+    }
+  }
+  ret.append("}");
+  return ret;
+}
+
 std::string QLTableRow::ToString(const Schema& schema) const {
   std::string ret;
   ret.append("{ ");
 
   for (size_t col_idx = 0; col_idx < schema.num_columns(); col_idx++) {
-    auto it = col_map_.find(schema.column_id(col_idx));
-    if (it != col_map_.end() && it->second.value.value_case() != QLValuePB::VALUE_NOT_SET) {
-      ret += it->second.value.ShortDebugString();
+    const auto* column = FindColumn(schema.column_id(col_idx));
+    if (column != nullptr && column->value.value_case() != QLValuePB::VALUE_NOT_SET) {
+      ret += column->value.ShortDebugString();
     } else {
       ret += "null";
     }
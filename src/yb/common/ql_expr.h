@@ -73,16 +73,16 @@ class QLTableRow {
 
   // Check if row is empty (no column).
   bool IsEmpty() const {
-    return col_map_.empty();
+    return num_assigned_ == 0;
   }
 
   // Get column count.
   size_t ColumnCount() const {
-    return col_map_.size();
+    return num_assigned_;
   }
 
-  // Clear the row.
-  void Clear() { col_map_.clear(); }
+  // Clear the row. Storage of columns is kept, so the row could be reused without allocations.
+  void Clear();
 
   // Compare column value between two rows.
   bool MatchColumn(ColumnIdRep col_id, const QLTableRow& source) const;
@@ -139,20 +139,34 @@ class QLTableRow {
 
   // For testing only (no status check).
   const QLTableColumn& TestValue(ColumnIdRep col_id) const {
-    return col_map_.at(col_id);
+    return *CHECK_NOTNULL(FindColumn(col_id));
   }
   const QLTableColumn& TestValue(const ColumnId& col) const {
-    return col_map_.at(col.rep());
+    return TestValue(col.rep());
   }
 
-  std::string ToString() const {
-    return yb::ToString(col_map_);
-  }
+  std::string ToString() const;
 
   std::string ToString(const Schema& schema) const;
 
  private:
-  std::unordered_map<ColumnIdRep, QLTableColumn> col_map_;
+  // Columns with ids in [kFirstColumnId, kFirstColumnId + kMaxDenseColumns) are stored in a vector
+  // indexed by column id. Other columns, for instance virtual ones, are stored in a short list.
+  static constexpr ColumnIdRep kMaxDenseColumns = 128;
+
+  struct SparseColumn {
+    ColumnIdRep id;
+    bool assigned;
+    QLTableColumn column;
+  };
+
+  // Returns nullptr if column is not assigned.
+  const QLTableColumn* FindColumn(ColumnIdRep col_id) const;
+
+  std::vector<QLTableColumn> dense_columns_;
+  std::vector<bool> dense_assigned_;
+  std::vector<SparseColumn> sparse_columns_;
+  size_t num_assigned_ = 0;
 };
 
 class QLExprExecutor {
@@ -80,6 +80,7 @@ typedef std::function<void(Result<TransactionStatusResult>)> TransactionStatusCa
 struct TransactionMetadata;
 
 YB_STRONGLY_TYPED_BOOL(MustExist);
+YB_STRONGLY_TYPED_BOOL(AllowRecentPending);
 
 // Used by RequestStatusAt.
 struct StatusRequest {
@@ -90,6 +91,11 @@ struct StatusRequest {
   const std::string* reason;
   MustExist must_exist;
   TransactionStatusCallback callback;
+  // Whether PENDING status received from coordinator recently (see
+  // transaction_status_cache_ttl_ms) could be used as response, even when it does not cover
+  // global_limit_ht. It is acceptable only for callers that would double check the status
+  // later, for instance conflict resolution that aborts pending transactions.
+  AllowRecentPending allow_recent_pending;
 };
 
 class RequestScope;
@@ -114,6 +120,15 @@ class TransactionStatusManager {
   // 4. Any kind of network/timeout errors would be reflected in error passed to callback.
   virtual void RequestStatusAt(const StatusRequest& request) = 0;
 
+  // Fetches statuses of several transactions at once, semantics for each request is the same as
+  // in RequestStatusAt. Implementation could combine requests for transactions that have
+  // the same status tablet into a single RPC.
+  virtual void RequestStatusesAt(const std::vector<StatusRequest>& requests) {
+    for (const auto& request : requests) {
+      RequestStatusAt(request);
+    }
+  }
+
   virtual boost::optional<TransactionMetadata> Metadata(const TransactionId& id) = 0;
 
   virtual void Abort(const TransactionId& id, TransactionStatusCallback callback) = 0;
@@ -221,7 +221,7 @@ class DelayablePeerProxy : public TestPeerProxy {
     return TestPeerProxy::Respond(method);
   }
 
-  virtual void UpdateAsync(const ConsensusRequestPB* request,
+  virtual void UpdateAsync(ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
                            ConsensusResponsePB* response,
                            rpc::RpcController* controller,
@@ -275,7 +275,7 @@ class MockedPeerProxy : public TestPeerProxy {
     }
   }
 
-  virtual void UpdateAsync(const ConsensusRequestPB* request,
+  virtual void UpdateAsync(ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
                            ConsensusResponsePB* response,
                            rpc::RpcController* controller,
@@ -339,7 +339,7 @@ class NoOpTestPeerProxy : public TestPeerProxy {
     last_received_.CopyFrom(MinimumOpId());
   }
 
-  virtual void UpdateAsync(const ConsensusRequestPB* request,
+  virtual void UpdateAsync(ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
                            ConsensusResponsePB* response,
                            rpc::RpcController* controller,
@@ -479,7 +479,7 @@ class LocalTestPeerProxy : public TestPeerProxy {
         peers_(peers),
         miss_comm_(false) {}
 
-  void UpdateAsync(const ConsensusRequestPB* request,
+  void UpdateAsync(ConsensusRequestPB* request,
                    RequestTriggerMode trigger_mode,
                    ConsensusResponsePB* response,
                    rpc::RpcController* controller,
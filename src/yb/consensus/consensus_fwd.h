@@ -44,6 +44,9 @@ typedef std::vector<ConsensusRoundPtr> ConsensusRounds;
 class ConsensusServiceProxy;
 typedef std::unique_ptr<ConsensusServiceProxy> ConsensusServiceProxyPtr;
 
+class MultiRaftHeartbeatBatcher;
+class MultiRaftManager;
+
 class LeaderElection;
 typedef scoped_refptr<LeaderElection> LeaderElectionPtr;
 
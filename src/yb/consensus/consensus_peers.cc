@@ -48,6 +48,7 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus_queue.h"
 #include "yb/consensus/log.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/replicate_msgs_holder.h"
 
 #include "yb/gutil/map-util.h"
@@ -93,6 +94,7 @@ DEFINE_test_flag(bool, enable_remote_bootstrap, true,
                  "replica.");
 
 DECLARE_int32(log_change_config_every_n);
+DECLARE_bool(enable_multi_raft_heartbeat_batcher);
 
 namespace yb {
 namespace consensus {
@@ -313,6 +315,10 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   // condition. When rest of this function is running in parallel to ProcessResponse.
   msgs_holder.ReleaseOps();
 
+  // Ops are already encoded by the log cache, so the proxy could send them without serializing
+  // them again for every peer.
+  controller_.set_encoded_request_fields(msgs_holder.encoded_messages());
+
   proxy_->UpdateAsync(&request_, trigger_mode, &response_, &controller_,
                       std::bind(&Peer::ProcessResponse, retain_self));
 }
@@ -479,16 +485,33 @@ Peer::~Peer() {
   CHECK_EQ(state_, kPeerClosed) << "Peer cannot be implicitly closed";
 }
 
-RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy)
-    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)) {
+RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+                           std::shared_ptr<MultiRaftHeartbeatBatcher> multi_raft_batcher)
+    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)),
+      multi_raft_batcher_(std::move(multi_raft_batcher)) {
 }
 
-void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
+void RpcPeerProxy::UpdateAsync(ConsensusRequestPB* request,
                                RequestTriggerMode trigger_mode,
                                ConsensusResponsePB* response,
                                rpc::RpcController* controller,
                                const rpc::ResponseCallback& callback) {
   controller->set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  if (multi_raft_batcher_ && FLAGS_enable_multi_raft_heartbeat_batcher &&
+      request->ops_size() == 0 && !consensus_proxy_->IsServiceLocal()) {
+    multi_raft_batcher_->AddRequestToBatch(request, response, controller, callback);
+    return;
+  }
+  if (controller->has_encoded_request_fields()) {
+    if (consensus_proxy_->IsServiceLocal()) {
+      // Local calls pass the request object as is, so ops should stay in it.
+      controller->set_encoded_request_fields(std::vector<RefCntBuffer>());
+    } else {
+      // Ops are appended to the serialized request as encoded fields. They are still owned by
+      // the log cache, so just release them.
+      request->mutable_ops()->ExtractSubrange(0, request->ops_size(), nullptr /* elements */);
+    }
+  }
   consensus_proxy_->UpdateConsensusAsync(*request, response, controller, callback);
 }
 
@@ -524,13 +547,20 @@ void RpcPeerProxy::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req
 RpcPeerProxy::~RpcPeerProxy() {}
 
 RpcPeerProxyFactory::RpcPeerProxyFactory(
-    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from)
-    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)) {}
+    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+    MultiRaftManager* multi_raft_manager)
+    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)),
+      multi_raft_manager_(multi_raft_manager) {}
 
 PeerProxyPtr RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb) {
   auto hostport = HostPortFromPB(DesiredHostPort(peer_pb, from_));
   auto proxy = std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport);
-  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy));
+  MultiRaftHeartbeatBatcherPtr multi_raft_batcher;
+  if (multi_raft_manager_) {
+    multi_raft_batcher = multi_raft_manager_->AddOrGetBatcher(hostport);
+  }
+  return std::make_unique<RpcPeerProxy>(
+      std::move(hostport), std::move(proxy), std::move(multi_raft_batcher));
 }
 
 RpcPeerProxyFactory::~RpcPeerProxyFactory() {}
@@ -260,7 +260,7 @@ class PeerProxy {
  public:
 
   // Sends a request, asynchronously, to a remote peer.
-  virtual void UpdateAsync(const ConsensusRequestPB* request,
+  virtual void UpdateAsync(ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
                            ConsensusResponsePB* response,
                            rpc::RpcController* controller,
@@ -316,9 +316,10 @@ class PeerProxyFactory {
 // PeerProxy implementation that does RPC calls
 class RpcPeerProxy : public PeerProxy {
  public:
-  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy);
+  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+               std::shared_ptr<MultiRaftHeartbeatBatcher> multi_raft_batcher = nullptr);
 
-  virtual void UpdateAsync(const ConsensusRequestPB* request,
+  virtual void UpdateAsync(ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
                            ConsensusResponsePB* response,
                            rpc::RpcController* controller,
@@ -349,12 +350,15 @@ class RpcPeerProxy : public PeerProxy {
  private:
   HostPort hostport_;
   ConsensusServiceProxyPtr consensus_proxy_;
+  // Used to batch heartbeats with other tablets, that have peers on the same server.
+  std::shared_ptr<MultiRaftHeartbeatBatcher> multi_raft_batcher_;
 };
 
 // PeerProxyFactory implementation that generates RPCPeerProxies
 class RpcPeerProxyFactory : public PeerProxyFactory {
  public:
-  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from);
+  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+                      MultiRaftManager* multi_raft_manager = nullptr);
 
   PeerProxyPtr NewProxy(const RaftPeerPB& peer_pb) override;
 
@@ -366,6 +370,7 @@ class RpcPeerProxyFactory : public PeerProxyFactory {
   rpc::Messenger* messenger_ = nullptr;
   rpc::ProxyCache* const proxy_cache_;
   const CloudInfoPB from_;
+  MultiRaftManager* const multi_raft_manager_;
 };
 
 // Query the consensus service at last known host/port that is specified in 'remote_peer' and set
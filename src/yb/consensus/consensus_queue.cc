@@ -431,6 +431,7 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     DCHECK_LT(FLAGS_consensus_max_batch_size_bytes + 1_KB, FLAGS_rpc_max_message_size);
     // The batch of messages to send to the peer.
     ReplicateMsgs messages;
+    std::vector<RefCntBuffer> encoded_messages;
     int max_batch_size = FLAGS_consensus_max_batch_size_bytes - request->ByteSize();
     bool have_more_messages = false;
 
@@ -439,7 +440,8 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
                                   max_batch_size,
                                   &messages,
                                   &preceding_id,
-                                  &have_more_messages);
+                                  &have_more_messages,
+                                  &encoded_messages);
     if (PREDICT_FALSE(!s.ok())) {
       if (PREDICT_TRUE(s.IsNotFound())) {
         // It's normal to have a NotFound() here if a follower falls behind where the leader has
@@ -471,7 +473,8 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     for (const auto& msg : messages) {
       request->mutable_ops()->AddAllocated(msg.get());
     }
-    *msgs_holder = ReplicateMsgsHolder(request->mutable_ops(), std::move(messages));
+    *msgs_holder = ReplicateMsgsHolder(
+        request->mutable_ops(), std::move(messages), std::move(encoded_messages));
 
     if (propagated_safe_time && !have_more_messages) {
       // Get the current local safe time on the leader and propagate it to the follower.
@@ -187,6 +187,38 @@ TEST_F(LogCacheTest, TestAppendAndGetMessages) {
 }
 
 
+TEST_F(LogCacheTest, TestEncodedMessages) {
+  ASSERT_OK(AppendReplicateMessagesToCache(1, 10));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  auto size_before_read = cache_->metrics_.log_cache_size->value();
+
+  for (int i = 0; i != 2; ++i) {
+    ReplicateMsgs messages;
+    std::vector<RefCntBuffer> encoded_messages;
+    OpId preceding;
+    ASSERT_OK(cache_->ReadOps(
+        0, 8 * 1024 * 1024, &messages, &preceding, nullptr /* have_more_messages */,
+        &encoded_messages));
+    ASSERT_EQ(10, messages.size());
+    ASSERT_EQ(messages.size(), encoded_messages.size());
+
+    // Encoded messages should form a valid ConsensusRequestPB containing the same ops.
+    std::string encoded;
+    for (const auto& buffer : encoded_messages) {
+      encoded.append(buffer.data(), buffer.size());
+    }
+    ConsensusRequestPB request;
+    ASSERT_TRUE(request.ParseFromString(encoded));
+    ASSERT_EQ(messages.size(), static_cast<size_t>(request.ops_size()));
+    for (size_t j = 0; j != messages.size(); ++j) {
+      ASSERT_EQ(messages[j]->SerializeAsString(), request.ops(j).SerializeAsString());
+    }
+  }
+
+  // Encoded messages are kept in the cache.
+  ASSERT_GT(cache_->metrics_.log_cache_size->value(), size_before_read);
+}
+
 // Ensure that the cache always yields at least one message,
 // even if that message is larger than the batch size. This ensures
 // that we don't get "stuck" in the case that a large message enters
@@ -33,7 +33,6 @@
 #include "yb/consensus/log_cache.h"
 
 #include <algorithm>
-#include <map>
 #include <mutex>
 #include <vector>
 
@@ -116,11 +115,6 @@ LogCache::LogCache(const scoped_refptr<MetricEntity>& metric_entity,
       max_ops_size_bytes, Format("$0-$1", kParentMemTrackerId, tablet_id), parent_tracker_,
       AddToParent::kTrue, CreateMetrics::kFalse);
   tracker_->SetMetricEntity(metric_entity, kParentMemTrackerId);
-
-  // Put a fake message at index 0, since this simplifies a lot of our code paths elsewhere.
-  auto zero_op = std::make_shared<ReplicateMsg>();
-  *zero_op->mutable_id() = MinimumOpId();
-  InsertOrDie(&cache_, 0, { zero_op, zero_op->SpaceUsed() });
 }
 
 LogCache::~LogCache() {
@@ -132,7 +126,7 @@ LogCache::~LogCache() {
 
 void LogCache::Init(const OpId& preceding_op) {
   std::lock_guard<simple_spinlock> l(lock_);
-  CHECK_EQ(cache_.size(), 1) << "Cache should have only our special '0' op";
+  CHECK(cache_.empty()) << "Cache should be empty";
   next_sequential_op_index_ = preceding_op.index() + 1;
   min_pinned_op_index_ = next_sequential_op_index_;
 }
@@ -143,7 +137,7 @@ Result<LogCache::PrepareAppendResult> LogCache::PrepareAppendOperations(const Re
   std::vector<CacheEntry> entries_to_insert;
   entries_to_insert.reserve(msgs.size());
   for (const auto& msg : msgs) {
-    CacheEntry e = { msg, static_cast<int64_t>(msg->SpaceUsedLong()) };
+    CacheEntry e = { msg, static_cast<int64_t>(msg->SpaceUsedLong()), RefCntBuffer() };
     result.mem_required += e.mem_usage;
     entries_to_insert.emplace_back(std::move(e));
   }
@@ -160,12 +154,12 @@ Result<LogCache::PrepareAppendResult> LogCache::PrepareAppendOperations(const Re
     CHECK_LE(first_idx_in_batch, next_sequential_op_index_);
 
     // Now remove the overwritten operations.
-    for (int64_t i = first_idx_in_batch; i < next_sequential_op_index_; ++i) {
-      auto it = cache_.find(i);
-      if (it != cache_.end()) {
-        AccountForMessageRemovalUnlocked(it->second);
-        cache_.erase(it);
+    while (!cache_.empty() &&
+           cache_start_index_ + static_cast<int64_t>(cache_.size()) > first_idx_in_batch) {
+      if (cache_.back().msg) {
+        AccountForMessageRemovalUnlocked(cache_.back());
       }
+      cache_.pop_back();
     }
   }
 
@@ -193,7 +187,11 @@ Result<LogCache::PrepareAppendResult> LogCache::PrepareAppendOperations(const Re
 
   for (auto& e : entries_to_insert) {
     auto index = e.msg->id().index();
-    EmplaceOrDie(&cache_, index, std::move(e));
+    if (cache_.empty()) {
+      cache_start_index_ = index;
+    }
+    CHECK_EQ(cache_start_index_ + static_cast<int64_t>(cache_.size()), index);
+    cache_.push_back(std::move(e));
     next_sequential_op_index_ = index + 1;
   }
 
@@ -265,9 +263,16 @@ Status LogCache::LookupOpId(int64_t op_index, OpId* op_id) const {
                                            "(next sequential op: $1)",
                                            op_index, next_sequential_op_index_));
     }
-    auto iter = cache_.find(op_index);
-    if (iter != cache_.end()) {
-      *op_id = iter->second.msg->id();
+    const CacheEntry* entry = FindEntryUnlocked(op_index);
+    if (entry != nullptr) {
+      *op_id = entry->msg->id();
+      return Status::OK();
+    }
+
+    // There is no real op at index 0, but treating it as the minimum op simplifies a lot of our
+    // code paths elsewhere.
+    if (op_index == 0) {
+      *op_id = MinimumOpId();
       return Status::OK();
     }
   }
@@ -287,13 +292,41 @@ int64_t TotalByteSizeForMessage(const ReplicateMsg& msg) {
   return msg_size;
 }
 
+// Encodes the message as an element of ConsensusRequestPB::ops, i.e. with the field tag and
+// length, so it could be appended to a serialized request.
+RefCntBuffer EncodeMessage(const ReplicateMsg& msg) {
+  using google::protobuf::internal::WireFormatLite;
+  RefCntBuffer result(TotalByteSizeForMessage(msg));
+  uint8_t* out = WireFormatLite::WriteTagToArray(
+      ConsensusRequestPB::kOpsFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED,
+      result.udata());
+  out = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(msg.GetCachedSize(), out);
+  out = msg.SerializeWithCachedSizesToArray(out);
+  CHECK_EQ(out, result.udata() + result.size());
+  return result;
+}
+
 } // anonymous namespace
 
+LogCache::CacheEntry* LogCache::FindEntryUnlocked(int64_t index) {
+  if (index < cache_start_index_ ||
+      index >= cache_start_index_ + static_cast<int64_t>(cache_.size())) {
+    return nullptr;
+  }
+  auto& entry = cache_[index - cache_start_index_];
+  return entry.msg ? &entry : nullptr;
+}
+
+const LogCache::CacheEntry* LogCache::FindEntryUnlocked(int64_t index) const {
+  return const_cast<LogCache*>(this)->FindEntryUnlocked(index);
+}
+
 Status LogCache::ReadOps(int64_t after_op_index,
                          int max_size_bytes,
                          ReplicateMsgs* messages,
                          OpId* preceding_op,
-                         bool* have_more_messages) {
+                         bool* have_more_messages,
+                         std::vector<RefCntBuffer>* encoded_messages) {
   DCHECK_ONLY_NOTNULL(messages);
   DCHECK_ONLY_NOTNULL(preceding_op);
   DCHECK_GE(after_op_index, 0);
@@ -310,16 +343,16 @@ Status LogCache::ReadOps(int64_t after_op_index,
   while (remaining_space > 0 && next_index < next_sequential_op_index_) {
 
     // If the messages the peer needs haven't been loaded into the queue yet, load them.
-    MessageCache::const_iterator iter = cache_.lower_bound(next_index);
-    if (iter == cache_.end() || iter->first != next_index) {
-      int64_t up_to;
-      if (iter == cache_.end()) {
-        // Read all the way to the current op.
-        up_to = next_sequential_op_index_ - 1;
-      } else {
-        // Read up to the next entry that's in the cache.
-        up_to = iter->first - 1;
+    if (FindEntryUnlocked(next_index) == nullptr) {
+      // Read up to the next entry that's in the cache, or all the way to the current op.
+      int64_t up_to = next_sequential_op_index_;
+      if (!cache_.empty()) {
+        up_to = std::max(next_index, cache_start_index_);
+        while (up_to < next_sequential_op_index_ && FindEntryUnlocked(up_to) == nullptr) {
+          ++up_to;
+        }
       }
+      --up_to;
 
       l.unlock();
 
@@ -338,6 +371,9 @@ Status LogCache::ReadOps(int64_t after_op_index,
         remaining_space -= TotalByteSizeForMessage(*msg);
         if (remaining_space > 0 || messages->empty()) {
           messages->push_back(msg);
+          if (encoded_messages) {
+            encoded_messages->emplace_back();
+          }
           next_index++;
         } else if (have_more_messages) {
           *have_more_messages = true;
@@ -346,14 +382,9 @@ Status LogCache::ReadOps(int64_t after_op_index,
 
     } else {
       // Pull contiguous messages from the cache until the size limit is achieved.
-      for (; iter != cache_.end(); ++iter) {
-        const ReplicateMsgPtr& msg = iter->second.msg;
-        int64_t index = msg->id().index();
-        if (index != next_index) {
-          continue;
-        }
-
-        remaining_space -= TotalByteSizeForMessage(*msg);
+      for (const CacheEntry* entry; (entry = FindEntryUnlocked(next_index)) != nullptr;) {
+        remaining_space -= entry->encoded_msg ? static_cast<int64_t>(entry->encoded_msg.size())
+                                              : TotalByteSizeForMessage(*entry->msg);
         if (remaining_space < 0 && !messages->empty()) {
           if (have_more_messages) {
             *have_more_messages = true;
@@ -361,14 +392,55 @@ Status LogCache::ReadOps(int64_t after_op_index,
           break;
         }
 
-        messages->push_back(msg);
+        messages->push_back(entry->msg);
+        if (encoded_messages) {
+          encoded_messages->push_back(entry->encoded_msg);
+        }
         next_index++;
       }
     }
   }
+
+  if (encoded_messages) {
+    EncodeMessages(*messages, encoded_messages, &l);
+  }
   return Status::OK();
 }
 
+void LogCache::EncodeMessages(const ReplicateMsgs& messages,
+                              std::vector<RefCntBuffer>* encoded_messages,
+                              std::unique_lock<simple_spinlock>* lock) {
+  DCHECK_EQ(messages.size(), encoded_messages->size());
+  std::vector<size_t> encoded_indexes;
+  for (size_t i = 0; i != messages.size(); ++i) {
+    if (!(*encoded_messages)[i]) {
+      encoded_indexes.push_back(i);
+    }
+  }
+  if (encoded_indexes.empty()) {
+    return;
+  }
+
+  // Encoding is relatively expensive, so do it outside the lock.
+  lock->unlock();
+  for (auto i : encoded_indexes) {
+    (*encoded_messages)[i] = EncodeMessage(*messages[i]);
+  }
+  lock->lock();
+
+  // Keep the encoded messages for other peers, unless the ops were evicted or replaced meanwhile.
+  for (auto i : encoded_indexes) {
+    CacheEntry* entry = FindEntryUnlocked(messages[i]->id().index());
+    if (entry == nullptr || entry->msg != messages[i] || entry->encoded_msg) {
+      continue;
+    }
+    const auto& encoded_msg = (*encoded_messages)[i];
+    entry->encoded_msg = encoded_msg;
+    entry->mem_usage += encoded_msg.size();
+    tracker_->Consume(encoded_msg.size());
+    metrics_.log_cache_size->IncrementBy(encoded_msg.size());
+  }
+}
 
 void LogCache::EvictThroughOp(int64_t index) {
   std::lock_guard<simple_spinlock> lock(lock_);
@@ -384,17 +456,14 @@ void LogCache::EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_evic
                       << ": before state: " << ToStringUnlocked();
 
   int64_t bytes_evicted = 0;
-  for (auto iter = cache_.begin(); iter != cache_.end();) {
-    const CacheEntry& entry = iter->second;
+  for (auto& entry : cache_) {
     const ReplicateMsgPtr& msg = entry.msg;
-    VLOG_WITH_PREFIX_UNLOCKED(2) << "considering for eviction: " << msg->id();
-    int64_t msg_index = msg->id().index();
-    if (msg_index == 0) {
-      // Always keep our special '0' op.
-      ++iter;
+    if (!msg) {
+      // Already evicted.
       continue;
     }
-
+    VLOG_WITH_PREFIX_UNLOCKED(2) << "considering for eviction: " << msg->id();
+    int64_t msg_index = msg->id().index();
     if (msg_index > stop_after_index || msg_index >= min_pinned_op_index_) {
       break;
     }
@@ -402,19 +471,24 @@ void LogCache::EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_evic
     if (!msg.unique()) {
       VLOG_WITH_PREFIX_UNLOCKED(2) << "Evicting cache: cannot remove " << msg->id()
                                    << " because it is in-use by a peer.";
-      ++iter;
       continue;
     }
 
     VLOG_WITH_PREFIX_UNLOCKED(2) << "Evicting cache. Removing: " << msg->id();
     AccountForMessageRemovalUnlocked(entry);
     bytes_evicted += entry.mem_usage;
-    cache_.erase(iter++);
+    entry = CacheEntry();
 
     if (bytes_evicted >= bytes_to_evict) {
       break;
     }
   }
+
+  // Drop the evicted entries from the front of the cache.
+  while (!cache_.empty() && !cache_.front().msg) {
+    cache_.pop_front();
+    ++cache_start_index_;
+  }
   VLOG_WITH_PREFIX_UNLOCKED(1) << "Evicting log cache: after state: " << ToStringUnlocked();
 }
 
@@ -470,7 +544,10 @@ void LogCache::DumpToStrings(vector<string>* lines) const {
   lines->push_back(ToStringUnlocked());
   lines->push_back("Messages:");
   for (const auto& entry : cache_) {
-    const ReplicateMsgPtr msg = entry.second.msg;
+    const ReplicateMsgPtr msg = entry.msg;
+    if (!msg) {
+      continue;
+    }
     lines->push_back(
       Substitute("Message[$0] $1.$2 : REPLICATE. Type: $3, Size: $4",
                  counter++, msg->id().term(), msg->id().index(),
@@ -489,7 +566,10 @@ void LogCache::DumpToHtml(std::ostream& out) const {
 
   int counter = 0;
   for (const auto& entry : cache_) {
-    const ReplicateMsgPtr msg = entry.second.msg;
+    const ReplicateMsgPtr msg = entry.msg;
+    if (!msg) {
+      continue;
+    }
     out << Substitute("<tr><th>$0</th><th>$1.$2</th><td>REPLICATE $3</td>"
                       "<td>$4</td><td>$5</td></tr>",
                       counter++, msg->id().term(), msg->id().index(),
@@ -32,7 +32,7 @@
 #ifndef YB_CONSENSUS_LOG_CACHE_H
 #define YB_CONSENSUS_LOG_CACHE_H
 
-#include <map>
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -47,6 +47,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/metrics.h"
 #include "yb/util/opid.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/restart_safe_clock.h"
 #include "yb/util/result.h"
 
@@ -98,11 +99,16 @@ class LogCache {
   // If the ops being requested are not available in the log, this will synchronously read these ops
   // from disk. Therefore, this function may take a substantial amount of time and should not be
   // called with important locks held, etc.
+  //
+  // If 'encoded_messages' is specified, it is filled with the returned ops encoded as elements of
+  // ConsensusRequestPB::ops. Encoded ops are kept in the cache, so an op replicated to several
+  // peers is encoded only once.
   CHECKED_STATUS ReadOps(int64_t after_op_index,
                  int max_size_bytes,
                  ReplicateMsgs* messages,
                  OpId* preceding_op,
-                 bool* have_more_messages = nullptr);
+                 bool* have_more_messages = nullptr,
+                 std::vector<RefCntBuffer>* encoded_messages = nullptr);
 
   // Append the operations into the log and the cache.  When the messages have completed writing
   // into the on-disk log, fires 'callback'.
@@ -157,12 +163,25 @@ class LogCache {
 
   // An entry in the cache.
   struct CacheEntry {
+    // nullptr if the entry was evicted.
     ReplicateMsgPtr msg;
-    // The cached value of msg->SpaceUsedLong(). This method is expensive
-    // to compute, so we compute it only once upon insertion.
+    // The cached value of msg->SpaceUsedLong() plus the size of encoded_msg. SpaceUsedLong is
+    // expensive to compute, so we compute it only once upon insertion.
     int64_t mem_usage;
+    // msg encoded as an element of ConsensusRequestPB::ops, set when msg is read for a peer for
+    // the first time.
+    RefCntBuffer encoded_msg;
   };
 
+  // Returns the cached entry for the op with the specified index, nullptr if it is not cached.
+  CacheEntry* FindEntryUnlocked(int64_t index);
+  const CacheEntry* FindEntryUnlocked(int64_t index) const;
+
+  // Encodes messages that are not encoded yet and stores the encoded messages in the cache.
+  void EncodeMessages(const ReplicateMsgs& messages,
+                      std::vector<RefCntBuffer>* encoded_messages,
+                      std::unique_lock<simple_spinlock>* lock);
+
   // Try to evict the oldest operations from the queue, stopping either when
   // 'bytes_to_evict' bytes have been evicted, or the op with index
   // 'stop_after_index' has been evicted, whichever comes first.
@@ -205,12 +224,13 @@ class LogCache {
 
   mutable simple_spinlock lock_;
 
-  // An ordered map that serves as the buffer for the cached messages.
-  // Maps from log index -> ReplicateMsg
-  // An ordered map that serves as the buffer for the cached messages.  Maps from log index ->
-  // CacheEntry
-  typedef std::map<uint64_t, CacheEntry> MessageCache;
-  MessageCache cache_;
+  // The buffer for the cached messages, addressed by log index. Entries are appended to the back
+  // and evicted from the front. Entries evicted from the middle are kept with null msg until all
+  // entries before them are evicted.
+  std::deque<CacheEntry> cache_;
+
+  // Log index of the front entry of cache_.
+  int64_t cache_start_index_ = 0;
 
   // The next log index to append. Each append operation must either start with this log index, or
   // go backward (but never skip forward).
@@ -0,0 +1,202 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/consensus.proxy.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/rpc_controller.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+
+using namespace std::literals;
+
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, false,
+            "Send heartbeats of tablets, that have peers on the same server, in a single RPC.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, advanced);
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, runtime);
+
+DEFINE_int32(multi_raft_batch_delay_us, 1000,
+             "How long heartbeats are accumulated before the batch is sent to the server.");
+TAG_FLAG(multi_raft_batch_delay_us, advanced);
+TAG_FLAG(multi_raft_batch_delay_us, runtime);
+
+DEFINE_int32(multi_raft_batch_size, 256,
+             "Max number of heartbeats sent in a single batch, 0 means unlimited.");
+TAG_FLAG(multi_raft_batch_size, advanced);
+TAG_FLAG(multi_raft_batch_size, runtime);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+
+namespace yb {
+namespace consensus {
+
+struct MultiRaftHeartbeatBatcher::Batch {
+  MultiRaftConsensusRequestPB request;
+  MultiRaftConsensusResponsePB response;
+  rpc::RpcController controller;
+  std::vector<BatchEntry> entries;
+
+  // Requests are owned by peers, so they should be released before sending individually or
+  // invoking callbacks.
+  void ReleaseRequests() {
+    auto* requests = request.mutable_consensus_request();
+    requests->ExtractSubrange(0, requests->size(), nullptr /* elements */);
+  }
+
+  ~Batch() {
+    ReleaseRequests();
+  }
+};
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
+    rpc::Messenger* messenger, HostPort hostport, ConsensusServiceProxyPtr proxy)
+    : messenger_(messenger), hostport_(std::move(hostport)), proxy_(std::move(proxy)) {
+}
+
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
+  // Scheduled flush retains this object, so there could be no pending entries here.
+  DCHECK(entries_.empty());
+}
+
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(
+    ConsensusRequestPB* request, ConsensusResponsePB* response, rpc::RpcController* controller,
+    rpc::ResponseCallback callback) {
+  std::vector<BatchEntry> entries_to_send;
+  bool schedule_flush = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.push_back(BatchEntry{request, response, controller, std::move(callback)});
+    auto max_batch_size = FLAGS_multi_raft_batch_size;
+    if (max_batch_size > 0 && entries_.size() >= static_cast<size_t>(max_batch_size)) {
+      entries_to_send.swap(entries_);
+    } else if (!flush_scheduled_) {
+      flush_scheduled_ = true;
+      schedule_flush = true;
+    }
+  }
+
+  if (schedule_flush) {
+    // The flush is executed even when the scheduler is shut down, in this case the batch just
+    // fails and requests are completed with an error.
+    messenger_->scheduler().Schedule(
+        [self = shared_from_this()](const Status& status) {
+          self->FlushScheduled();
+        },
+        FLAGS_multi_raft_batch_delay_us * 1us);
+  }
+
+  if (!entries_to_send.empty()) {
+    SendBatch(std::move(entries_to_send));
+  }
+}
+
+void MultiRaftHeartbeatBatcher::FlushScheduled() {
+  std::vector<BatchEntry> entries_to_send;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flush_scheduled_ = false;
+    entries_to_send.swap(entries_);
+  }
+
+  if (!entries_to_send.empty()) {
+    SendBatch(std::move(entries_to_send));
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SendBatch(std::vector<BatchEntry> entries) {
+  auto batch = std::make_shared<Batch>();
+  batch->entries = std::move(entries);
+  auto* requests = batch->request.mutable_consensus_request();
+  requests->Reserve(batch->entries.size());
+  // Requests are not copied, since peers do not touch them until the response is received.
+  for (const auto& entry : batch->entries) {
+    requests->AddAllocated(entry.request);
+  }
+
+  batch->controller.set_timeout(FLAGS_consensus_rpc_timeout_ms * 1ms);
+  proxy_->MultiRaftUpdateConsensusAsync(
+      batch->request, &batch->response, &batch->controller,
+      [self = shared_from_this(), batch] {
+        self->ProcessResponse(batch);
+      });
+}
+
+void MultiRaftHeartbeatBatcher::ProcessResponse(const std::shared_ptr<Batch>& batch) {
+  batch->ReleaseRequests();
+
+  auto status = batch->controller.status();
+  if (status.ok() &&
+      static_cast<size_t>(batch->response.consensus_response_size()) != batch->entries.size()) {
+    status = STATUS_FORMAT(
+        IllegalState, "Wrong number of responses: $0, while $1 expected",
+        batch->response.consensus_response_size(), batch->entries.size());
+  }
+  if (!status.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 10)
+        << "Multi Raft update to " << hostport_ << " failed, sending "
+        << batch->entries.size() << " requests individually: " << status;
+    SendIndividually(batch.get());
+    return;
+  }
+
+  auto* responses = batch->response.mutable_consensus_response();
+  for (size_t i = 0; i != batch->entries.size(); ++i) {
+    auto& entry = batch->entries[i];
+    entry.response->Swap(responses->Mutable(i));
+    entry.callback();
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SendIndividually(Batch* batch) {
+  for (auto& entry : batch->entries) {
+    proxy_->UpdateConsensusAsync(
+        *entry.request, entry.response, entry.controller, std::move(entry.callback));
+  }
+}
+
+MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache)
+    : messenger_(messenger), proxy_cache_(proxy_cache) {
+}
+
+MultiRaftManager::~MultiRaftManager() {
+}
+
+MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const HostPort& hostport) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& weak_batcher = batchers_[hostport];
+  auto result = weak_batcher.lock();
+  if (result) {
+    return result;
+  }
+
+  // Cleanup batchers of servers that are not used anymore.
+  for (auto it = batchers_.begin(); it != batchers_.end();) {
+    if (it->second.expired() && it->first != hostport) {
+      it = batchers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  result = std::make_shared<MultiRaftHeartbeatBatcher>(
+      messenger_, hostport, std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport));
+  weak_batcher = result;
+  return result;
+}
+
+} // namespace consensus
+} // namespace yb
@@ -0,0 +1,100 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/consensus/consensus_fwd.h"
+
+#include "yb/rpc/response_callback.h"
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/net/net_util.h"
+
+namespace yb {
+namespace consensus {
+
+// Coalesces consensus requests without ops, i.e. heartbeats and commit index updates, that
+// peers of different tablets send to the same server, into a single MultiRaftUpdateConsensus RPC.
+// Responses are fanned back out to the callbacks of the original requests.
+//
+// Requests are accumulated for multi_raft_batch_delay_us, or until multi_raft_batch_size requests
+// are collected. If the batch RPC fails, for instance because the remote server does not support
+// it, requests are resent one by one, so peers observe the same errors as without batching.
+class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
+ public:
+  MultiRaftHeartbeatBatcher(
+      rpc::Messenger* messenger, HostPort hostport, ConsensusServiceProxyPtr proxy);
+  ~MultiRaftHeartbeatBatcher();
+
+  // Adds request to the current batch. request, response and controller should stay alive
+  // until the callback is invoked.
+  void AddRequestToBatch(ConsensusRequestPB* request,
+                         ConsensusResponsePB* response,
+                         rpc::RpcController* controller,
+                         rpc::ResponseCallback callback);
+
+ private:
+  struct BatchEntry {
+    ConsensusRequestPB* request;
+    ConsensusResponsePB* response;
+    rpc::RpcController* controller;
+    rpc::ResponseCallback callback;
+  };
+
+  struct Batch;
+
+  void FlushScheduled();
+  void SendBatch(std::vector<BatchEntry> entries);
+  void ProcessResponse(const std::shared_ptr<Batch>& batch);
+  void SendIndividually(Batch* batch);
+
+  rpc::Messenger* const messenger_;
+  const HostPort hostport_;
+  ConsensusServiceProxyPtr proxy_;
+
+  std::mutex mutex_;
+  std::vector<BatchEntry> entries_;
+  bool flush_scheduled_ = false;
+};
+
+typedef std::shared_ptr<MultiRaftHeartbeatBatcher> MultiRaftHeartbeatBatcherPtr;
+
+// Server wide registry of heartbeat batchers, one per destination server.
+class MultiRaftManager {
+ public:
+  MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache);
+  ~MultiRaftManager();
+
+  // Returns batcher for requests sent to the specified host, creating it if necessary.
+  MultiRaftHeartbeatBatcherPtr AddOrGetBatcher(const HostPort& hostport);
+
+ private:
+  rpc::Messenger* const messenger_;
+  rpc::ProxyCache* const proxy_cache_;
+
+  std::mutex mutex_;
+  // Batchers are owned by peer proxies, so they are destroyed when the last tablet peer on the
+  // destination server goes away.
+  std::unordered_map<HostPort, std::weak_ptr<MultiRaftHeartbeatBatcher>, HostPortHash> batchers_;
+};
+
+} // namespace consensus
+} // namespace yb
+
+#endif // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
@@ -14,10 +14,14 @@
 #ifndef YB_CONSENSUS_REPLICATE_MSGS_HOLDER_H
 #define YB_CONSENSUS_REPLICATE_MSGS_HOLDER_H
 
+#include <vector>
+
 #include <google/protobuf/repeated_field.h>
 
 #include "yb/consensus/consensus_fwd.h"
 
+#include "yb/util/ref_cnt_buffer.h"
+
 namespace yb {
 namespace consensus {
 
@@ -26,7 +30,8 @@ class ReplicateMsgsHolder {
   ReplicateMsgsHolder() : ops_(nullptr) {}
 
   explicit ReplicateMsgsHolder(
-      google::protobuf::RepeatedPtrField<ReplicateMsg>* ops, ReplicateMsgs messages);
+      google::protobuf::RepeatedPtrField<ReplicateMsg>* ops, ReplicateMsgs messages,
+      std::vector<RefCntBuffer> encoded_messages = std::vector<RefCntBuffer>());
 
   ReplicateMsgsHolder(ReplicateMsgsHolder&& rhs);
   void operator=(ReplicateMsgsHolder&& rhs);
@@ -43,6 +48,11 @@ class ReplicateMsgsHolder {
     ops_ = nullptr;
   }
 
+  // Ops encoded as ConsensusRequestPB::ops fields, one per op, or empty if ops were not encoded.
+  const std::vector<RefCntBuffer>& encoded_messages() const {
+    return encoded_messages_;
+  }
+
  private:
   google::protobuf::RepeatedPtrField<ReplicateMsg>* ops_;
 
@@ -51,6 +61,9 @@ class ReplicateMsgsHolder {
   // object as other peers. Since the PB request_ itself can't hold reference counts, this holds
   // them.
   ReplicateMsgs messages_;
+
+  // Shared with the LogCache, so ops are serialized once for all peers.
+  std::vector<RefCntBuffer> encoded_messages_;
 };
 
 }  // namespace consensus
@@ -276,12 +276,16 @@ class ConflictResolver {
     return Status::OK();
   }
 
+  // Requests statuses of all conflicting transactions at once, so status manager could combine
+  // requests to the same status tablet.
   void FetchTransactionStatuses() {
     static const std::string kRequestReason = "conflict resolution"s;
     CountDownLatch latch(transactions_.size());
+    std::vector<StatusRequest> requests;
+    requests.reserve(transactions_.size());
     for (auto& i : transactions_) {
       auto& transaction = i;
-      StatusRequest request = {
+      requests.push_back(StatusRequest {
         &transaction.id,
         context_.GetResolutionHt(),
         context_.GetResolutionHt(),
@@ -301,10 +305,13 @@ class ConflictResolver {
             transaction.failure = result.status();
           }
           latch.CountDown();
-        }
-      };
-      status_manager().RequestStatusAt(request);
+        },
+        // Pending transaction is either aborted by us, which reports its actual status, or
+        // causes conflict that is retried, so recently fetched status is good enough.
+        AllowRecentPending::kTrue
+      });
     }
+    status_manager().RequestStatusesAt(requests);
     latch.Wait();
   }
 
@@ -1065,6 +1065,11 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
                                 const Schema& projection,
                                 QLResultSet* resultset,
                                 HybridTime* restart_read_ht) {
+  if (!request_.primary_keys().empty()) {
+    return ExecuteByPrimaryKeys(
+        ql_storage, deadline, read_time, schema, projection, resultset, restart_read_ht);
+  }
+
   SimulateTimeoutIfTesting(&deadline);
   size_t row_count_limit = std::numeric_limits<std::size_t>::max();
   size_t num_rows_skipped = 0;
@@ -1079,6 +1084,17 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
     row_count_limit = request_.limit();
   }
 
+  if (request_.group_by_column_count() > 0) {
+    if (!request_.is_aggregate() || request_.group_by_column_count() > schema.num_key_columns()) {
+      return STATUS_FORMAT(InvalidArgument, "Invalid GROUP BY column count: $0",
+                           request_.group_by_column_count());
+    }
+    group_by_column_ids_.reserve(request_.group_by_column_count());
+    for (size_t idx = 0; idx < request_.group_by_column_count(); idx++) {
+      group_by_column_ids_.push_back(schema.column_id(idx));
+    }
+  }
+
   // Create the projections of the non-key columns selected by the row block plus any referenced in
   // the WHERE condition. When DocRowwiseIterator::NextRow() populates the value map, it uses this
   // projection only to scan sub-documents. The query schema is used to select only referenced
@@ -1140,6 +1156,11 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
       RETURN_NOT_OK(iter->NextRow(non_static_projection, &non_static_row));
     }
 
+    if (!group_by_column_ids_.empty()) {
+      // Remembered in case this row starts a group that does not fit in the result.
+      current_row_key_ = VERIFY_RESULT(iter->GetTupleId());
+    }
+
     // We have two possible cases: whether we use distinct or not
     // If we use distinct, then in general we only need to add the static rows
     // However, we might have to add non-static rows, if there is no static row corresponding to
@@ -1198,7 +1219,8 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
     }
   }
 
-  if (request_.is_aggregate() && match_count > 0) {
+  if (request_.is_aggregate() && match_count > 0 &&
+      (group_by_column_ids_.empty() || !group_by_values_.empty())) {
     RETURN_NOT_OK(PopulateAggregate(selected_row, resultset));
   }
 
@@ -1215,15 +1237,73 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
   return Status::OK();
 }
 
+Status QLReadOperation::ExecuteByPrimaryKeys(const common::YQLStorageIf& ql_storage,
+                                             CoarseTimePoint deadline,
+                                             const ReadHybridTime& read_time,
+                                             const Schema& schema,
+                                             const Schema& projection,
+                                             QLResultSet* resultset,
+                                             HybridTime* restart_read_ht) {
+  // Each row is read by a point read request, that differs from this request by the key only.
+  // The range columns of the key are appended to the where condition as equality conditions.
+  QLReadRequestPB key_request(request_);
+  key_request.clear_primary_keys();
+  QLConditionPB* where_pb = key_request.mutable_where_expr()->mutable_condition();
+  if (!where_pb->has_op()) {
+    where_pb->set_op(QL_OP_AND);
+  } else if (where_pb->op() != QL_OP_AND) {
+    return STATUS_FORMAT(InvalidArgument, "Unexpected where condition of read by primary keys: $0",
+                         where_pb->ShortDebugString());
+  }
+  const int num_operands = where_pb->operands_size();
+  const size_t num_hash_key_columns = schema.num_hash_key_columns();
+
+  for (const QLPrimaryKeyPB& key : request_.primary_keys()) {
+    if (static_cast<size_t>(key.hashed_column_values().size()) != num_hash_key_columns ||
+        static_cast<size_t>(key.range_column_values().size()) != schema.num_range_key_columns()) {
+      return STATUS_FORMAT(InvalidArgument, "Invalid primary key: $0", key.ShortDebugString());
+    }
+    key_request.set_hash_code(key.hash_code());
+    key_request.set_max_hash_code(key.hash_code());
+    *key_request.mutable_hashed_column_values() = key.hashed_column_values();
+    where_pb->mutable_operands()->DeleteSubrange(
+        num_operands, where_pb->operands_size() - num_operands);
+    size_t column_idx = num_hash_key_columns;
+    for (const QLExpressionPB& column_value : key.range_column_values()) {
+      QLConditionPB* column_cond = where_pb->add_operands()->mutable_condition();
+      column_cond->set_op(QL_OP_EQUAL);
+      column_cond->add_operands()->set_column_id(schema.column_id(column_idx));
+      *column_cond->add_operands() = column_value;
+      column_idx++;
+    }
+
+    QLReadOperation key_op(key_request, txn_op_context_);
+    HybridTime key_restart_read_ht;
+    RETURN_NOT_OK(key_op.Execute(
+        ql_storage, deadline, read_time, schema, projection, resultset, &key_restart_read_ht));
+    restart_read_ht->MakeAtLeast(key_restart_read_ht);
+  }
+  return Status::OK();
+}
+
 Status QLReadOperation::SetPagingStateIfNecessary(const common::YQLRowwiseIteratorIf* iter,
                                                   const QLResultSet* resultset,
                                                   const size_t row_count_limit,
                                                   const size_t num_rows_skipped,
                                                   const ReadHybridTime& read_time) {
+  // Aggregate read is only paged when it is grouped, at the row that starts the next group.
+  const bool stopped_at_group = !next_group_row_key_.empty();
   if ((resultset->rsrow_count() >= row_count_limit || request_.has_offset()) &&
-      !request_.is_aggregate()) {
+      (!request_.is_aggregate() || stopped_at_group)) {
     SubDocKey next_row_key;
-    RETURN_NOT_OK(iter->GetNextReadSubDocKey(&next_row_key));
+    if (stopped_at_group) {
+      // The first row of the next group was already read by the iterator.
+      DocKey doc_key;
+      RETURN_NOT_OK(doc_key.FullyDecodeFrom(next_group_row_key_));
+      next_row_key = SubDocKey(doc_key, read_time.read);
+    } else {
+      RETURN_NOT_OK(iter->GetNextReadSubDocKey(&next_row_key));
+    }
     // When the "limit" number of rows are returned and we are asked to return the paging state,
     // return the partition key and row key of the next row to read in the paging state if there are
     // still more rows to read. Otherwise, leave the paging state empty which means we are done
@@ -1258,6 +1338,19 @@ Status QLReadOperation::SetPagingStateIfNecessary(const common::YQLRowwiseIterat
 }
 
 Status QLReadOperation::GetIntents(const Schema& schema, KeyValueWriteBatchPB* out) {
+  for (const QLPrimaryKeyPB& key : request_.primary_keys()) {
+    std::vector<PrimitiveValue> hashed_components;
+    RETURN_NOT_OK(QLKeyColumnValuesToPrimitiveValues(
+        key.hashed_column_values(), schema, 0, schema.num_hash_key_columns(),
+        &hashed_components));
+    auto pair = out->mutable_read_pairs()->Add();
+    pair->set_key(DocKey(key.hash_code(), hashed_components).Encode().data());
+    pair->set_value(std::string(1, ValueTypeAsChar::kNull));
+  }
+  if (!request_.primary_keys().empty()) {
+    return Status::OK();
+  }
+
   std::vector<PrimitiveValue> hashed_components;
   RETURN_NOT_OK(QLKeyColumnValuesToPrimitiveValues(
       request_.hashed_column_values(), schema, 0, schema.num_hash_key_columns(),
@@ -1312,6 +1405,42 @@ Status QLReadOperation::PopulateAggregate(const QLTableRow& table_row, QLResultS
   return Status::OK();
 }
 
+Status QLReadOperation::EvalGroupedAggregate(const QLTableRow& table_row,
+                                             const size_t row_count_limit,
+                                             QLResultSet* resultset) {
+  // Rows are grouped by a prefix of primary key columns, so rows of the same group are adjacent
+  // and the current group is complete once a row of another group is met.
+  bool new_group = group_by_values_.empty();
+  if (!new_group) {
+    for (size_t idx = 0; idx < group_by_column_ids_.size(); idx++) {
+      const auto value = table_row.GetValue(group_by_column_ids_[idx]);
+      if (!value || !(*value == group_by_values_[idx])) {
+        new_group = true;
+        break;
+      }
+    }
+    if (new_group) {
+      RETURN_NOT_OK(PopulateAggregate(table_row, resultset));
+      aggr_result_.clear();
+      group_by_values_.clear();
+      if (resultset->rsrow_count() >= row_count_limit) {
+        // The next page starts from this row, so each group is aggregated within a single page.
+        next_group_row_key_ = current_row_key_.ToBuffer();
+        return Status::OK();
+      }
+    }
+  }
+
+  if (new_group) {
+    group_by_values_.reserve(group_by_column_ids_.size());
+    for (const auto& column_id : group_by_column_ids_) {
+      const auto value = table_row.GetValue(column_id);
+      group_by_values_.push_back(value ? *value : QLValuePB());
+    }
+  }
+  return EvalAggregate(table_row);
+}
+
 Status QLReadOperation::AddRowToResult(const std::unique_ptr<common::QLScanSpec>& spec,
                                        const QLTableRow& row,
                                        const size_t row_count_limit,
@@ -1325,7 +1454,9 @@ Status QLReadOperation::AddRowToResult(const std::unique_ptr<common::QLScanSpec>
     if (match) {
       if (*num_rows_skipped >= offset) {
         (*match_count)++;
-        if (request_.is_aggregate()) {
+        if (!group_by_column_ids_.empty()) {
+          RETURN_NOT_OK(EvalGroupedAggregate(row, row_count_limit, resultset));
+        } else if (request_.is_aggregate()) {
           RETURN_NOT_OK(EvalAggregate(row));
         } else {
           RETURN_NOT_OK(PopulateResultSet(row, resultset));
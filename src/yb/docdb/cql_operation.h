@@ -191,11 +191,26 @@ class QLReadOperation : public DocExprExecutor {
                          QLResultSet* result_set,
                          HybridTime* restart_read_ht);
 
+  // Reads rows by the primary keys specified in the request, in the order of the keys.
+  CHECKED_STATUS ExecuteByPrimaryKeys(const common::YQLStorageIf& ql_storage,
+                                      CoarseTimePoint deadline,
+                                      const ReadHybridTime& read_time,
+                                      const Schema& schema,
+                                      const Schema& projection,
+                                      QLResultSet* result_set,
+                                      HybridTime* restart_read_ht);
+
   CHECKED_STATUS PopulateResultSet(const QLTableRow& table_row, QLResultSet *result_set);
 
   CHECKED_STATUS EvalAggregate(const QLTableRow& table_row);
   CHECKED_STATUS PopulateAggregate(const QLTableRow& table_row, QLResultSet *resultset);
 
+  // Evaluates aggregates of the group table_row belongs to, for aggregate read with GROUP BY.
+  // Populates aggregates of the previous group when table_row starts a new one.
+  CHECKED_STATUS EvalGroupedAggregate(const QLTableRow& table_row,
+                                      const size_t row_count_limit,
+                                      QLResultSet* resultset);
+
   CHECKED_STATUS AddRowToResult(const std::unique_ptr<common::QLScanSpec>& spec,
                                 const QLTableRow& row,
                                 const size_t row_count_limit,
@@ -221,6 +236,15 @@ class QLReadOperation : public DocExprExecutor {
   const QLReadRequestPB& request_;
   const TransactionOperationContextOpt txn_op_context_;
   QLResponsePB response_;
+
+  // For aggregate read with GROUP BY, ids of the columns rows are grouped by and their values in
+  // the current group.
+  std::vector<ColumnId> group_by_column_ids_;
+  std::vector<QLValuePB> group_by_values_;
+  // Key of the row being aggregated, and of the row the next page should start from when the
+  // read stopped at a group boundary.
+  Slice current_row_key_;
+  std::string next_group_row_key_;
 };
 
 }  // namespace docdb
@@ -17,12 +17,19 @@
 
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/value.h"
+
+#include "yb/gutil/endian.h"
+
+#include "yb/server/hybrid_clock.h"
 
 namespace yb {
 namespace docdb {
 
 Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime* out);
 
+Status GetTtlExpiration(const rocksdb::UserBoundaryValues& values, HybridTime* out);
+
 Status GetPrimitiveValue(const rocksdb::UserBoundaryValues& values,
                          size_t index,
                          PrimitiveValue* out);
@@ -30,6 +37,7 @@ Status GetPrimitiveValue(const rocksdb::UserBoundaryValues& values,
 namespace {
 
 constexpr rocksdb::UserBoundaryTag kDocHybridTimeTag = 1;
+constexpr rocksdb::UserBoundaryTag kTtlExpirationTag = 2;
 // Here we reserve some tags for future use.
 // Because Tag is persistent.
 constexpr rocksdb::UserBoundaryTag kRangeComponentsStart = 10;
@@ -80,6 +88,77 @@ class DocHybridTimeValue : public rocksdb::UserBoundaryValue {
   Slice encoded_;
 };
 
+// Wrapper for UserBoundaryValue that stores hybrid time when record expires because of its own
+// TTL.
+class TtlExpirationValue : public rocksdb::UserBoundaryValue {
+ public:
+  explicit TtlExpirationValue(HybridTime value) : value_(value) {
+    BigEndian::Store64(buffer_, value.ToUint64());
+  }
+
+  static CHECKED_STATUS Create(HybridTime data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+    *value = std::make_shared<TtlExpirationValue>(data);
+    return Status::OK();
+  }
+
+  static CHECKED_STATUS Create(Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    if (data.size() != sizeof(uint64_t)) {
+      return STATUS_SUBSTITUTE(Corruption, "Wrong size of encoded TTL expiration: $0", data.size());
+    }
+    return Create(HybridTime(BigEndian::Load64(data.data())), value);
+  }
+
+  virtual ~TtlExpirationValue() {}
+
+  rocksdb::UserBoundaryTag Tag() override {
+    return kTtlExpirationTag;
+  }
+
+  Slice Encode() override {
+    return Slice(buffer_, sizeof(buffer_));
+  }
+
+  int CompareTo(const UserBoundaryValue& pre_rhs) override {
+    const auto* rhs = down_cast<const TtlExpirationValue*>(&pre_rhs);
+    return value_.CompareTo(rhs->value_);
+  }
+
+  HybridTime value() const {
+    return value_;
+  }
+
+ private:
+  HybridTime value_;
+  char buffer_[sizeof(uint64_t)];
+};
+
+// Returns hybrid time when the record expires because of TTL stored in its value.
+// Records without such TTL expire according to the table TTL, that could be altered later. So
+// HybridTime::kMin is returned for them, and their expiration is derived from the max hybrid time
+// of the file when table TTL is known.
+Result<HybridTime> ValueTtlExpiration(Slice encoded_doc_ht, Slice value) {
+  if (value.empty()) {
+    return HybridTime::kMin;
+  }
+  Value decoded_value;
+  RETURN_NOT_OK(decoded_value.DecodeControlFields(&value));
+  if (decoded_value.merge_flags() & Value::kTtlFlag) {
+    // TTL merge record updates TTL of a record that could reside in an older file.
+    return HybridTime::kMax;
+  }
+  const auto ttl = decoded_value.ttl();
+  if (ttl.Equals(Value::kMaxTtl)) {
+    return HybridTime::kMin;
+  }
+  if (ttl.Equals(Value::kResetTtl)) {
+    return HybridTime::kMax;
+  }
+  DocHybridTime doc_ht;
+  RETURN_NOT_OK(doc_ht.FullyDecodeFrom(encoded_doc_ht));
+  return server::HybridClock::AddPhysicalTimeToHybridTime(doc_ht.hybrid_time(), ttl);
+}
+
 // Wrapper for UserBoundaryValue that stores PrimitiveValue with index.
 class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
  public:
@@ -147,6 +226,9 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     if (tag == kDocHybridTimeTag) {
       return DocHybridTimeValue::Create(data, value);
     }
+    if (tag == kTtlExpirationTag) {
+      return TtlExpirationValue::Create(data, value);
+    }
     if (tag >= kRangeComponentsStart) {
       return PrimitiveBoundaryValue::Create(tag - kRangeComponentsStart, data, value);
     }
@@ -156,9 +238,10 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
 
   Status Extract(Slice user_key, Slice value, rocksdb::UserBoundaryValues* values) override {
     if (user_key.size() >= 1 &&
-        static_cast<ValueType>(user_key[0]) == ValueType::kTransactionId) {
+        (static_cast<ValueType>(user_key[0]) == ValueType::kTransactionId ||
+         static_cast<ValueType>(user_key[0]) == ValueType::kTransactionApplyState)) {
       // Skipping reverse index from transaction id to keys of write intents belonging to that
-      // transaction.
+      // transaction, and transaction apply state records.
       return Status::OK();
     }
 
@@ -177,6 +260,12 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     RETURN_NOT_OK(DocHybridTimeValue::Create(slices.back(), &temp));
     values->push_back(std::move(temp));
 
+    // Expiration is stored even for records without TTL, so files written before it was tracked
+    // could be distinguished.
+    RETURN_NOT_OK(TtlExpirationValue::Create(
+        VERIFY_RESULT(ValueTtlExpiration(slices.back(), value)), &temp));
+    values->push_back(std::move(temp));
+
     for (size_t i = 0; i != size; ++i) {
       RETURN_NOT_OK(PrimitiveBoundaryValue::Create(i, slices[i], &temp));
       values->push_back(std::move(temp));
@@ -252,6 +341,15 @@ Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime
   return time_value->value(out);
 }
 
+Status GetTtlExpiration(const rocksdb::UserBoundaryValues& values, HybridTime* out) {
+  auto value = rocksdb::UserValueWithTag(values, kTtlExpirationTag);
+  if (!value) {
+    return STATUS(NotFound, "Not found value for TTL expiration");
+  }
+  *out = down_cast<TtlExpirationValue*>(value.get())->value();
+  return Status::OK();
+}
+
 rocksdb::UserBoundaryTag TagForRangeComponent(size_t index) {
   return PrimitiveBoundaryValue::TagForIndex(index);
 }
@@ -718,6 +718,8 @@ class DocDbAwareFilterPolicy : public rocksdb::FilterPolicy {
 struct DocDB {
   rocksdb::DB* regular;
   rocksdb::DB* intents;
+  // Range tombstones that apply to regular DB, nullptr when they are not used.
+  const RangeTombstones* range_tombstones = nullptr;
 
   static DocDB FromRegular(rocksdb::DB* regular) {
     return {regular, nullptr /* intents */};
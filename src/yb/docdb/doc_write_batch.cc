@@ -578,8 +578,15 @@ Status DocWriteBatch::ReplaceInList(
   }
 }
 
+void DocWriteBatch::DeleteRange(const Slice& start_key, const Slice& end_key) {
+  range_tombstones_.emplace_back(start_key.ToBuffer(), end_key.ToBuffer());
+  // Cached entries could be covered by the new tombstone.
+  cache_.Clear();
+}
+
 void DocWriteBatch::Clear() {
   put_batch_.clear();
+  range_tombstones_.clear();
   cache_.Clear();
 }
 
@@ -590,6 +597,12 @@ void DocWriteBatch::MoveToWriteBatchPB(KeyValueWriteBatchPB *kv_pb) {
     kv_pair->mutable_key()->swap(entry.first);
     kv_pair->mutable_value()->swap(entry.second);
   }
+  // Hybrid time of range tombstones is assigned when the operation is applied.
+  for (auto& entry : range_tombstones_) {
+    RangeTombstonePB* tombstone = kv_pb->add_range_tombstones();
+    tombstone->mutable_start_key()->swap(entry.first);
+    tombstone->mutable_end_key()->swap(entry.second);
+  }
 }
 
 void DocWriteBatch::TEST_CopyToWriteBatchPB(KeyValueWriteBatchPB *kv_pb) const {
@@ -599,6 +612,11 @@ void DocWriteBatch::TEST_CopyToWriteBatchPB(KeyValueWriteBatchPB *kv_pb) const {
     kv_pair->mutable_key()->assign(entry.first);
     kv_pair->mutable_value()->assign(entry.second);
   }
+  for (auto& entry : range_tombstones_) {
+    RangeTombstonePB* tombstone = kv_pb->add_range_tombstones();
+    tombstone->mutable_start_key()->assign(entry.first);
+    tombstone->mutable_end_key()->assign(entry.second);
+  }
 }
 
 }  // namespace docdb
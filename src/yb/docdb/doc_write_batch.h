@@ -184,8 +184,15 @@ class DocWriteBatch {
                         read_ht, deadline, query_id, user_timestamp);
   }
 
+  // Deletes all records with key in [start_key, end_key) using a single range tombstone, instead
+  // of writing tombstone for each of them. Keys are encoded SubDocKeys without hybrid time, empty
+  // end_key means the end of the key space.
+  // Range deletions are applied at the hybrid time of the write operation and are not supported
+  // in transactions.
+  void DeleteRange(const Slice& start_key, const Slice& end_key);
+
   void Clear();
-  bool IsEmpty() const { return put_batch_.empty(); }
+  bool IsEmpty() const { return put_batch_.empty() && range_tombstones_.empty(); }
 
   size_t size() const { return put_batch_.size(); }
 
@@ -193,6 +200,10 @@ class DocWriteBatch {
     return put_batch_;
   }
 
+  const std::vector<std::pair<std::string, std::string>>& range_tombstones() const {
+    return range_tombstones_;
+  }
+
   void MoveToWriteBatchPB(KeyValueWriteBatchPB *kv_pb);
 
   // This method has worse performance comparing to MoveToWriteBatchPB and intented to be used in
@@ -240,6 +251,8 @@ class DocWriteBatch {
   const InitMarkerBehavior init_marker_behavior_;
   std::atomic<int64_t>* monotonic_counter_;
   std::vector<std::pair<std::string, std::string>> put_batch_;
+  // Start and end keys of range deletions.
+  std::vector<std::pair<std::string, std::string>> range_tombstones_;
 
   // Taken from internal_doc_iterator
   KeyBytes key_prefix_;
@@ -26,6 +26,10 @@ KeyType GetKeyType(const Slice& slice, StorageDbType db_type) {
     return KeyType::kValueKey;
   }
 
+  if (slice[0] == ValueTypeAsChar::kTransactionApplyState) {
+    return KeyType::kTransactionApplyState;
+  }
+
   if (slice.size() > 0 && slice[0] == ValueTypeAsChar::kTransactionId) {
     if (slice.size() == TransactionId::static_size() + 1) {
       return KeyType::kTransactionMetadata;
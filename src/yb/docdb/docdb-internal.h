@@ -56,7 +56,8 @@ namespace yb {
 namespace docdb {
 
 // Type of keys written by DocDB into RocksDB.
-YB_DEFINE_ENUM(KeyType, (kEmpty)(kIntentKey)(kReverseTxnKey)(kValueKey)(kTransactionMetadata));
+YB_DEFINE_ENUM(KeyType, (kEmpty)(kIntentKey)(kReverseTxnKey)(kValueKey)(kTransactionMetadata)
+                        (kTransactionApplyState));
 
 KeyType GetKeyType(const Slice& slice, StorageDbType db_type);
 
@@ -13,11 +13,13 @@
 
 #include "yb/docdb/docdb.h"
 
+#include <map>
 #include <memory>
 #include <string>
 
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/status.h"
+#include "yb/rocksdb/table_properties.h"
 #include "yb/rocksdb/util/statistics.h"
 
 #include "yb/common/hybrid_time.h"
@@ -58,6 +60,7 @@ using namespace std::chrono_literals;
 
 DECLARE_bool(use_docdb_aware_bloom_filter);
 DECLARE_int32(max_nexts_to_avoid_seek);
+DECLARE_int32(max_range_tombstones_per_tablet);
 
 #define ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(str) ASSERT_NO_FATALS(AssertDocDbDebugDumpStrEq(str))
 
@@ -3232,5 +3235,309 @@ TEST_F(DocDBTest, ForceFlushedFrontier) {
   ASSERT_EQ(*new_user_frontier_ptr, *rocksdb_->GetFlushedFrontier());
 }
 
+namespace {
+
+class WriteBatchRecordsCollector : public rocksdb::WriteBatch::Handler {
+ public:
+  void Put(const Slice& key, const Slice& value) override {
+    records_.emplace(key.ToBuffer(), value.ToBuffer());
+  }
+
+  const std::map<std::string, std::string>& records() const {
+    return records_;
+  }
+
+ private:
+  std::map<std::string, std::string> records_;
+};
+
+} // namespace
+
+TEST_F(DocDBTest, ApplyIntentsInBatches) {
+  const auto txn_id = ASSERT_RESULT(FullyDecodeTransactionId("0000000000000001"));
+  SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+  SetCurrentTransactionId(txn_id);
+  for (int i = 0; i != 10; ++i) {
+    const KeyBytes encoded_doc_key(DocKey(PrimitiveValues("mydockey", i)).Encode());
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key, "subkey"), PrimitiveValue(Format("value$0", i)),
+        HybridTime::FromMicros(1000 + i)));
+  }
+  ResetCurrentTransactionId();
+
+  KeyBytes metadata_key;
+  AppendTransactionKeyPrefix(txn_id, &metadata_key);
+  ASSERT_OK(intents_db()->Put(write_options(), metadata_key.AsSlice(), "metadata"));
+
+  const HybridTime commit_ht = 2000_usec_ht;
+  WriteBatchRecordsCollector expected;
+  {
+    rocksdb::WriteBatch regular_batch;
+    rocksdb::WriteBatch intents_batch;
+    ASSERT_OK(PrepareApplyIntentsBatch(
+        txn_id, commit_ht, nullptr /* apply_state */, 0 /* max_records */, &regular_batch,
+        intents_db(), &intents_batch));
+    ASSERT_OK(regular_batch.Iterate(&expected));
+  }
+  ASSERT_EQ(10, expected.records().size());
+
+  WriteBatchRecordsCollector actual;
+  ApplyTransactionState apply_state;
+  int num_batches = 0;
+  do {
+    rocksdb::WriteBatch regular_batch;
+    rocksdb::WriteBatch intents_batch;
+    apply_state = ASSERT_RESULT(PrepareApplyIntentsBatch(
+        txn_id, commit_ht, num_batches ? &apply_state : nullptr, 3 /* max_records */,
+        &regular_batch, intents_db(), &intents_batch));
+    ASSERT_OK(regular_batch.Iterate(&actual));
+    ASSERT_OK(intents_db()->Write(write_options(), &intents_batch));
+    ++num_batches;
+
+    // Transaction metadata should be removed only with the last batch.
+    std::string metadata;
+    auto status = intents_db()->Get(rocksdb::ReadOptions(), metadata_key.AsSlice(), &metadata);
+    if (apply_state.active()) {
+      ASSERT_OK(status);
+    } else {
+      ASSERT_TRUE(status.IsNotFound()) << status;
+    }
+  } while (apply_state.active());
+
+  ASSERT_GT(num_batches, 1);
+  ASSERT_EQ(expected.records(), actual.records());
+  ASSERT_EQ("", DocDBDebugDumpToStr(intents_db(), StorageDbType::kIntents));
+}
+
+TEST_F(DocDBTest, AppliedIntentsAreNotFlushed) {
+  const auto txn_id = ASSERT_RESULT(FullyDecodeTransactionId("0000000000000001"));
+  SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+  SetCurrentTransactionId(txn_id);
+  for (int i = 0; i != 10; ++i) {
+    const KeyBytes encoded_doc_key(DocKey(PrimitiveValues("mydockey", i)).Encode());
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key, "subkey"), PrimitiveValue(Format("value$0", i)),
+        HybridTime::FromMicros(1000 + i)));
+  }
+  ResetCurrentTransactionId();
+
+  rocksdb::WriteBatch regular_batch;
+  rocksdb::WriteBatch intents_batch;
+  ASSERT_OK(PrepareApplyIntentsBatch(
+      txn_id, 2000_usec_ht, nullptr /* apply_state */, 0 /* max_records */, &regular_batch,
+      intents_db(), &intents_batch));
+  ASSERT_OK(intents_db()->Write(write_options(), &intents_batch));
+
+  rocksdb::FlushOptions flush_options;
+  flush_options.wait = true;
+  ASSERT_OK(intents_db()->Flush(flush_options));
+
+  // Intents and their reverse index records are cancelled out by their SingleDeletes during
+  // flush, only the removal of transaction metadata could reach the SST file.
+  rocksdb::TablePropertiesCollection props;
+  ASSERT_OK(intents_db()->GetPropertiesOfAllTables(&props));
+  uint64_t num_entries = 0;
+  for (const auto& p : props) {
+    num_entries += p.second->num_entries;
+  }
+  ASSERT_LE(num_entries, 1U);
+  ASSERT_EQ("", DocDBDebugDumpToStr(intents_db(), StorageDbType::kIntents));
+}
+
+TEST_F(DocDBTest, RangeTombstone) {
+  const DocKey doc_key(PrimitiveValues("mydockey", 123456));
+  const KeyBytes encoded_doc_key(doc_key.Encode());
+
+  for (const auto* column : {"c1", "c2", "c3", "c4"}) {
+    ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue(column)),
+                           Value(PrimitiveValue(std::string("v") + (column + 1))), 1000_usec_ht));
+  }
+
+  // Delete c2 and c3, the end of range is exclusive.
+  auto dwb = MakeDocWriteBatch();
+  dwb.DeleteRange(SubDocKey(doc_key, PrimitiveValue("c2")).EncodeWithoutHt().AsSlice(),
+                  SubDocKey(doc_key, PrimitiveValue("c4")).EncodeWithoutHt().AsSlice());
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, 2000_usec_ht));
+
+  // Records written after the tombstone are not affected by it.
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("c3")),
+                         Value(PrimitiveValue("v3new")), 3000_usec_ht));
+
+  VerifySubDocument(SubDocKey(doc_key), 1500_usec_ht, R"#(
+{
+  "c1": "v1",
+  "c2": "v2",
+  "c3": "v3",
+  "c4": "v4"
+}
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 2500_usec_ht, R"#(
+{
+  "c1": "v1",
+  "c4": "v4"
+}
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 3500_usec_ht, R"#(
+{
+  "c1": "v1",
+  "c3": "v3new",
+  "c4": "v4"
+}
+      )#");
+
+  // Tombstone is above history cutoff, so deleted records are kept.
+  FullyCompactHistoryBefore(1500_usec_ht);
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+SubDocKey(DocKey([], ["mydockey", 123456]), ["c1"; HT{ physical: 1000 }]) -> "v1"
+SubDocKey(DocKey([], ["mydockey", 123456]), ["c2"; HT{ physical: 1000 }]) -> "v2"
+SubDocKey(DocKey([], ["mydockey", 123456]), ["c3"; HT{ physical: 3000 }]) -> "v3new"
+SubDocKey(DocKey([], ["mydockey", 123456]), ["c3"; HT{ physical: 1000 }]) -> "v3"
+SubDocKey(DocKey([], ["mydockey", 123456]), ["c4"; HT{ physical: 1000 }]) -> "v4"
+      )#");
+
+  FullyCompactHistoryBefore(2500_usec_ht);
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+SubDocKey(DocKey([], ["mydockey", 123456]), ["c1"; HT{ physical: 1000 }]) -> "v1"
+SubDocKey(DocKey([], ["mydockey", 123456]), ["c3"; HT{ physical: 3000 }]) -> "v3new"
+SubDocKey(DocKey([], ["mydockey", 123456]), ["c4"; HT{ physical: 1000 }]) -> "v4"
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 3500_usec_ht, R"#(
+{
+  "c1": "v1",
+  "c3": "v3new",
+  "c4": "v4"
+}
+      )#");
+}
+
+TEST_F(DocDBTest, SeekPastRangeTombstone) {
+  constexpr size_t kNumDeletedColumns = 1000;
+  const DocKey doc_key(PrimitiveValues("mydockey", 123456));
+  const KeyBytes encoded_doc_key(doc_key.Encode());
+  auto deleted_column = [](size_t i) { return PrimitiveValue(Format("c$0", 10000 + i)); };
+
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("a")),
+                         Value(PrimitiveValue("va")), 1000_usec_ht));
+  for (size_t i = 0; i != kNumDeletedColumns; ++i) {
+    ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, deleted_column(i)),
+                           Value(PrimitiveValue("v")), 1000_usec_ht));
+  }
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("d")),
+                         Value(PrimitiveValue("vd")), 1000_usec_ht));
+
+  auto dwb = MakeDocWriteBatch();
+  dwb.DeleteRange(SubDocKey(doc_key, PrimitiveValue("c")).EncodeWithoutHt().AsSlice(),
+                  SubDocKey(doc_key, PrimitiveValue("d")).EncodeWithoutHt().AsSlice());
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, 2000_usec_ht));
+
+  auto num_steps = [this] {
+    return options().statistics->getTickerCount(rocksdb::NUMBER_DB_NEXT);
+  };
+
+  // Deleted range is skipped by a single seek.
+  auto steps_before = num_steps();
+  VerifySubDocument(SubDocKey(doc_key), 2500_usec_ht, R"#(
+{
+  "a": "va",
+  "d": "vd"
+}
+      )#");
+  ASSERT_LT(num_steps() - steps_before, 10U);
+
+  // Range could contain records written after the tombstone, so it is not skipped anymore.
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, deleted_column(kNumDeletedColumns / 2)),
+                         Value(PrimitiveValue("vnew")), 3000_usec_ht));
+  steps_before = num_steps();
+  VerifySubDocument(SubDocKey(doc_key), 3500_usec_ht, Format(R"#(
+{
+  "a": "va",
+  "$0": "vnew",
+  "d": "vd"
+}
+      )#", deleted_column(kNumDeletedColumns / 2).GetString()));
+  ASSERT_GE(num_steps() - steps_before, kNumDeletedColumns / 2);
+}
+
+TEST_F(DocDBTest, RangeTombstonesLimit) {
+  FLAGS_max_range_tombstones_per_tablet = 2;
+  const DocKey doc_key(PrimitiveValues("mydockey", 123456));
+  auto delete_range = [this, &doc_key](const char* start, const char* end, HybridTime ht) {
+    auto dwb = MakeDocWriteBatch();
+    dwb.DeleteRange(SubDocKey(doc_key, PrimitiveValue(start)).EncodeWithoutHt().AsSlice(),
+                    SubDocKey(doc_key, PrimitiveValue(end)).EncodeWithoutHt().AsSlice());
+    return WriteToRocksDBAndClear(&dwb, ht);
+  };
+
+  ASSERT_OK(delete_range("c1", "c2", 1000_usec_ht));
+  ASSERT_OK(delete_range("c3", "c4", 2000_usec_ht));
+  auto status = delete_range("c5", "c6", 3000_usec_ht);
+  ASSERT_TRUE(status.IsBusy()) << status;
+
+  // Replayed tombstones are not added twice.
+  RangeTombstones tombstones;
+  RangeTombstone tombstone{"a", "b", 1000_usec_ht};
+  ASSERT_EQ(1U, tombstones.Add({tombstone}));
+  ASSERT_EQ(1U, tombstones.Add({tombstone, RangeTombstone{"c", "d", 2000_usec_ht}}));
+  ASSERT_EQ(2U, tombstones.Get()->size());
+}
+
+TEST_F(DocDBTest, TtlFileExpiration) {
+  const DocKey doc_key(PrimitiveValues("mydockey", 123456));
+  const KeyBytes encoded_doc_key(doc_key.Encode());
+  const auto kTableTtl = MonoDelta::FromMilliseconds(1);
+
+  // Record without own TTL expires by table TTL.
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("c1")),
+                         Value(PrimitiveValue("v1")), 1000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  // Record with own TTL, that is longer than table TTL.
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("c2")),
+                         Value(PrimitiveValue("v2"), MonoDelta::FromMilliseconds(10)),
+                         2000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  // Record with reset TTL never expires.
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("c3")),
+                         Value(PrimitiveValue("v3"), Value::kResetTtl), 3000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  std::vector<rocksdb::LiveFileMetaData> files;
+  rocksdb()->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(3U, files.size());
+  sort(files.begin(), files.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.name < rhs.name;
+  });
+
+  auto expired_files = [&files, kTableTtl](HybridTime history_cutoff) {
+    DocDBCompactionFileFilter filter(history_cutoff, kTableTtl);
+    std::vector<bool> result;
+    for (const auto& file : files) {
+      result.push_back(filter.Expired(file.smallest, file.largest));
+    }
+    return result;
+  };
+
+  ASSERT_EQ(std::vector<bool>({false, false, false}), expired_files(1500_usec_ht));
+  ASSERT_EQ(std::vector<bool>({true, false, false}), expired_files(2500_usec_ht));
+  ASSERT_EQ(std::vector<bool>({true, false, false}), expired_files(5000_usec_ht));
+  ASSERT_EQ(std::vector<bool>({true, true, false}), expired_files(13000_usec_ht));
+}
+
+TEST_F(DocDBTest, SubcompactionBoundaryPrefix) {
+  DocDBCompactionFilterFactory factory(std::make_shared<ManualHistoryRetentionPolicy>());
+  const DocKey doc_key(PrimitiveValues("mydockey", 123456));
+  const KeyBytes encoded_doc_key(doc_key.Encode());
+
+  // Subcompaction boundary inside of a document is moved to the start of the document.
+  KeyBytes subdoc_key = SubDocKey(doc_key, PrimitiveValue("subkey_a")).EncodeWithoutHt();
+  ASSERT_EQ(encoded_doc_key.size(), factory.SubcompactionBoundaryPrefixSize(subdoc_key.AsSlice()));
+  ASSERT_EQ(encoded_doc_key.size(),
+            factory.SubcompactionBoundaryPrefixSize(encoded_doc_key.AsSlice()));
+
+  // Boundary that does not start with a complete DocKey, like shortened separator from data index,
+  // is kept as is.
+  Slice truncated(encoded_doc_key.data().data(), encoded_doc_key.size() - 1);
+  ASSERT_EQ(truncated.size(), factory.SubcompactionBoundaryPrefixSize(truncated));
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -34,6 +34,7 @@
 #include "yb/docdb/intent.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/pgsql_operation.h"
+#include "yb/docdb/range_tombstones.h"
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
@@ -318,6 +319,14 @@ Status ExecuteDocWriteOperation(const vector<unique_ptr<DocOperation>>& doc_writ
     RETURN_NOT_OK(s);
   }
   doc_write_batch.MoveToWriteBatchPB(write_batch);
+  if (write_batch->range_tombstones_size() != 0) {
+    if (write_batch->has_transaction()) {
+      return STATUS(NotSupported, "Range deletion is not supported in transactions");
+    }
+    if (doc_db.range_tombstones) {
+      RETURN_NOT_OK(doc_db.range_tombstones->CheckCanAdd(write_batch->range_tombstones_size()));
+    }
+  }
   return Status::OK();
 }
 
@@ -1069,6 +1078,12 @@ Result<std::string> DocDBKeyToDebugStr(Slice key_slice, StorageDbType db_type, K
       RETURN_NOT_OK(transaction_id);
       return Format("TXN META $0", *transaction_id);
     }
+    case KeyType::kTransactionApplyState:
+    {
+      RETURN_NOT_OK(key_slice.consume_byte(ValueTypeAsChar::kTransactionApplyState));
+      auto transaction_id = VERIFY_RESULT(DecodeTransactionId(&key_slice));
+      return Format("TXN APPLY STATE $0", transaction_id);
+    }
     case KeyType::kEmpty: FALLTHROUGH_INTENDED;
     case KeyType::kValueKey:
       RETURN_NOT_OK_PREPEND(
@@ -1123,6 +1138,13 @@ Result<std::string> DocDBValueToDebugStr(
       KeyType ignore_key_type;
       return DocDBKeyToDebugStr(value, StorageDbType::kIntents, &ignore_key_type);
     }
+    case KeyType::kTransactionApplyState: {
+      ApplyTransactionStatePB state_pb;
+      if (!state_pb.ParseFromArray(value.cdata(), value.size())) {
+        return STATUS_FORMAT(Corruption, "Bad apply state: $0", value.ToDebugHexString());
+      }
+      return state_pb.ShortDebugString();
+    }
     case KeyType::kEmpty: FALLTHROUGH_INTENDED;
     case KeyType::kIntentKey: FALLTHROUGH_INTENDED;
     case KeyType::kValueKey:
@@ -1193,6 +1215,15 @@ void AppendTransactionKeyPrefix(const TransactionId& transaction_id, KeyBytes* o
   out->AppendRawBytes(Slice(transaction_id.data, transaction_id.size()));
 }
 
+void AppendApplyTransactionStateKey(const TransactionId& transaction_id, KeyBytes* out) {
+  out->AppendValueType(ValueType::kTransactionApplyState);
+  out->AppendRawBytes(Slice(transaction_id.data, transaction_id.size()));
+}
+
+std::string ApplyTransactionState::ToString() const {
+  return Format("{ key: $0 write_id: $1 }", Slice(key).ToDebugString(), write_id);
+}
+
 DocHybridTimeBuffer::DocHybridTimeBuffer() {
   buffer_[0] = ValueTypeAsChar::kHybridTime;
 }
@@ -1247,8 +1278,9 @@ CHECKED_STATUS IntentToWriteRequest(
   return Status::OK();
 }
 
-Status PrepareApplyIntentsBatch(
+Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     const TransactionId &transaction_id, HybridTime commit_ht,
+    const ApplyTransactionState* apply_state, size_t max_records,
     rocksdb::WriteBatch *regular_batch,
     rocksdb::DB *intents_db, rocksdb::WriteBatch *intents_batch) {
   Slice reverse_index_upperbound;
@@ -1272,11 +1304,22 @@ Status PrepareApplyIntentsBatch(
   txn_reverse_index_upperbound.AppendValueType(ValueType::kMaxByte);
   reverse_index_upperbound = txn_reverse_index_upperbound.AsSlice();
 
-  reverse_index_iter->Seek(txn_reverse_index_prefix.data());
+  // Processed records are deleted, so we could always start from the beginning of transaction
+  // reverse index. But when previous batch deleted a lot of records, seek to the first record
+  // after them is much cheaper than iterating over their tombstones.
+  IntraTxnWriteId write_id = 0;
+  if (apply_state) {
+    reverse_index_iter->Seek(apply_state->key);
+    write_id = apply_state->write_id;
+  } else {
+    reverse_index_iter->Seek(txn_reverse_index_prefix.AsSlice());
+  }
 
   DocHybridTimeBuffer doc_ht_buffer;
 
-  IntraTxnWriteId write_id = 0;
+  size_t num_records = 0;
+  // When processing is continued from previous state, metadata record is before the start key.
+  bool has_metadata = apply_state != nullptr;
   while (reverse_index_iter->Valid()) {
     rocksdb::Slice key_slice(reverse_index_iter->key());
 
@@ -1288,8 +1331,12 @@ Status PrepareApplyIntentsBatch(
             << EntryToString(*reverse_index_iter, StorageDbType::kIntents);
 
     // If the key ends at the transaction id then it is transaction metadata (status tablet,
-    // isolation level etc.).
+    // isolation level etc.). It is deleted after all other records of transaction.
     if (key_slice.size() > txn_reverse_index_prefix.size()) {
+      if (max_records && num_records >= max_records) {
+        return ApplyTransactionState{key_slice.ToBuffer(), write_id};
+      }
+
       // Value of reverse index is a key of original intent record, so seek it and check match.
       if (regular_batch) {
         RETURN_NOT_OK(IntentToWriteRequest(
@@ -1297,15 +1344,27 @@ Status PrepareApplyIntentsBatch(
             regular_batch, &write_id));
       }
 
-      intents_batch->Delete(reverse_index_iter->value());
+      if (intents_batch) {
+        // Intent and reverse index keys contain unique doc hybrid time, so they are written once
+        // and could be removed with SingleDelete. When a short transaction is removed before
+        // the intents memtable is flushed, the flush drops both its records and their removals,
+        // so they are never written to intents SST files.
+        intents_batch->SingleDelete(reverse_index_iter->value());
+        intents_batch->SingleDelete(reverse_index_iter->key());
+      }
+      ++num_records;
+    } else {
+      has_metadata = true;
     }
 
-    intents_batch->Delete(reverse_index_iter->key());
-
     reverse_index_iter->Next();
   }
 
-  return Status::OK();
+  if (has_metadata && intents_batch) {
+    intents_batch->Delete(txn_reverse_index_prefix.AsSlice());
+  }
+
+  return ApplyTransactionState();
 }
 
 }  // namespace docdb
@@ -174,8 +174,29 @@ void PrepareTransactionWriteBatch(
     IsolationLevel isolation_level,
     IntraTxnWriteId* write_id);
 
-CHECKED_STATUS PrepareApplyIntentsBatch(
+// State of transaction, whose intents are applied or removed in several batches.
+struct ApplyTransactionState {
+  // Reverse index key of the next intent to process, empty if all intents were processed.
+  std::string key;
+  // Write id of the next strong intent to apply.
+  IntraTxnWriteId write_id = 0;
+
+  bool active() const {
+    return !key.empty();
+  }
+
+  std::string ToString() const;
+};
+
+// Prepares batches to apply intents of transaction to regular DB and remove them from intents DB.
+// When regular_batch is null, intents are just removed. When intents_batch is null, intents are
+// just applied.
+// Processing starts from apply_state, when it is not null, and stops after max_records intents,
+// when it is not zero. Transaction metadata is removed with the last batch.
+// Returns state to continue processing, it is not active when all intents were processed.
+Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     const TransactionId& transaction_id, HybridTime commit_ht,
+    const ApplyTransactionState* apply_state, size_t max_records,
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch);
 
@@ -482,6 +503,9 @@ void ConfigureDocDBRocksDBOptions(rocksdb::Options* options);
 
 void AppendTransactionKeyPrefix(const TransactionId& transaction_id, docdb::KeyBytes* out);
 
+// Key of intents DB record, that stores ApplyTransactionStatePB of transaction.
+void AppendApplyTransactionStateKey(const TransactionId& transaction_id, docdb::KeyBytes* out);
+
 // Buffer for encoding DocHybridTime
 class DocHybridTimeBuffer {
  public:
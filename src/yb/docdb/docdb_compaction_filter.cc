@@ -18,6 +18,7 @@
 #include <glog/logging.h>
 
 #include "yb/rocksdb/compaction_filter.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/string_util.h"
 
 #include "yb/docdb/doc_key.h"
@@ -34,9 +35,19 @@ using rocksdb::CompactionFilter;
 using rocksdb::VectorToString;
 using rocksdb::FilterDecision;
 
+DEFINE_bool(enable_ttl_file_expiration, true,
+            "Delete SST files of tables with default TTL without compaction, when all their "
+            "records have expired.");
+TAG_FLAG(enable_ttl_file_expiration, advanced);
+TAG_FLAG(enable_ttl_file_expiration, runtime);
+
 namespace yb {
 namespace docdb {
 
+Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime* out);
+
+Status GetTtlExpiration(const rocksdb::UserBoundaryValues& values, HybridTime* out);
+
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilter::DocDBCompactionFilter(
@@ -44,6 +55,9 @@ DocDBCompactionFilter::DocDBCompactionFilter(
     IsMajorCompaction is_major_compaction)
     : retention_(std::move(retention)),
       is_major_compaction_(is_major_compaction) {
+  if (retention_.range_tombstones) {
+    range_tombstone_checker_.emplace(retention_.range_tombstones, retention_.history_cutoff);
+  }
 }
 
 DocDBCompactionFilter::~DocDBCompactionFilter() {
@@ -177,6 +191,17 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
     return FilterDecision::kKeep;
   }
 
+  // Records deleted by a range tombstone at or below the history cutoff are invisible to readers,
+  // so they could be removed by any compaction. They are not treated as overwrites of the records
+  // that follow, the same way as readers ignore them.
+  if (range_tombstone_checker_ &&
+      ht.hybrid_time() < range_tombstone_checker_->DeleteTime(
+          Slice(key.data(), sub_key_ends_.back()))) {
+    AssignPrevSubDocKey(key.cdata(), same_bytes);
+    overwrite_.push_back({prev_overwrite_ht, prev_exp});
+    return FilterDecision::kDiscard;
+  }
+
   // Check for CQL columns deleted from the schema. This is done regardless of whether this is a
   // major or minor compaction.
   //
@@ -305,6 +330,26 @@ const char* DocDBCompactionFilter::Name() const {
 
 // ------------------------------------------------------------------------------------------------
 
+bool DocDBCompactionFileFilter::Expired(
+    const rocksdb::FileBoundaryValuesBase& smallest,
+    const rocksdb::FileBoundaryValuesBase& largest) {
+  DocHybridTime max_ht;
+  HybridTime max_ttl_expiration;
+  // Files written before TTL expiration was collected don't have it, and are never dropped.
+  if (!GetDocHybridTime(largest.user_values, &max_ht).ok() ||
+      !GetTtlExpiration(largest.user_values, &max_ttl_expiration).ok()) {
+    return false;
+  }
+  if (max_ttl_expiration >= history_cutoff_) {
+    return false;
+  }
+  bool has_expired = false;
+  auto status = HasExpiredTTL(max_ht.hybrid_time(), table_ttl_, history_cutoff_, &has_expired);
+  return status.ok() && has_expired;
+}
+
+// ------------------------------------------------------------------------------------------------
+
 DocDBCompactionFilterFactory::DocDBCompactionFilterFactory(
     std::shared_ptr<HistoryRetentionPolicy> retention_policy)
     : retention_policy_(std::move(retention_policy)) {
@@ -320,6 +365,29 @@ unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilte
       IsMajorCompaction(context.is_full_compaction));
 }
 
+unique_ptr<rocksdb::CompactionFileFilter>
+    DocDBCompactionFilterFactory::CreateCompactionFileFilter() {
+  // Without table TTL records written without own TTL never expire, so files are not checked.
+  if (!FLAGS_enable_ttl_file_expiration ||
+      retention_policy_->GetTableTTL().Equals(Value::kMaxTtl)) {
+    return nullptr;
+  }
+  auto retention = retention_policy_->GetRetentionDirective();
+  if (!retention.history_cutoff.is_valid() || retention.table_ttl.Equals(Value::kMaxTtl)) {
+    return nullptr;
+  }
+  return std::make_unique<DocDBCompactionFileFilter>(
+      retention.history_cutoff, retention.table_ttl);
+}
+
+size_t DocDBCompactionFilterFactory::SubcompactionBoundaryPrefixSize(const Slice& user_key) {
+  // Boundary could be a shortened separator key from data index, that is not a valid key. But
+  // only keys starting with a complete DocKey could split a document, so it is safe to keep such
+  // boundary as is.
+  auto doc_key_size = DocKey::EncodedSize(user_key, DocKeyPart::WHOLE_DOC_KEY);
+  return doc_key_size.ok() ? *doc_key_size : user_key.size();
+}
+
 const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
@@ -327,20 +395,25 @@ const char* DocDBCompactionFilterFactory::Name() const {
 // ------------------------------------------------------------------------------------------------
 
 HistoryRetentionDirective ManualHistoryRetentionPolicy::GetRetentionDirective() {
-  std::lock_guard<std::mutex> lock(deleted_cols_mtx_);
+  std::lock_guard<std::mutex> lock(mutex_);
   return {
     history_cutoff_.load(std::memory_order_acquire),
     std::make_shared<ColumnIds>(deleted_cols_),
-    table_ttl_.load(std::memory_order_acquire)
+    table_ttl_.load(std::memory_order_acquire),
+    range_tombstones_
   };
 }
 
+MonoDelta ManualHistoryRetentionPolicy::GetTableTTL() {
+  return table_ttl_.load(std::memory_order_acquire);
+}
+
 void ManualHistoryRetentionPolicy::SetHistoryCutoff(HybridTime history_cutoff) {
   history_cutoff_.store(history_cutoff, std::memory_order_release);
 }
 
 void ManualHistoryRetentionPolicy::AddDeletedColumn(ColumnId col) {
-  std::lock_guard<std::mutex> lock(deleted_cols_mtx_);
+  std::lock_guard<std::mutex> lock(mutex_);
   deleted_cols_.insert(col);
 }
 
@@ -348,5 +421,10 @@ void ManualHistoryRetentionPolicy::SetTableTTLForTests(MonoDelta ttl) {
   table_ttl_.store(ttl, std::memory_order_release);
 }
 
+void ManualHistoryRetentionPolicy::SetRangeTombstones(RangeTombstoneVectorPtr range_tombstones) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  range_tombstones_ = std::move(range_tombstones);
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -31,6 +31,7 @@
 
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/expiration.h"
+#include "yb/docdb/range_tombstones.h"
 
 namespace yb {
 namespace docdb {
@@ -52,6 +53,9 @@ struct HistoryRetentionDirective {
   ColumnIdsPtr deleted_cols;
 
   MonoDelta table_ttl;
+
+  // Range tombstones of the tablet, only ones written at or below history cutoff are applied.
+  RangeTombstoneVectorPtr range_tombstones;
 };
 
 // DocDB compaction filter. A new instance of this class is created for every compaction.
@@ -89,6 +93,9 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   const HistoryRetentionDirective retention_;
   const IsMajorCompaction is_major_compaction_;
 
+  // Range tombstones written at or below history cutoff, not set when there are no tombstones.
+  boost::optional<RangeTombstoneChecker> range_tombstone_checker_;
+
   std::vector<char> prev_subdoc_key_;
 
   // Result of DecodeDocKeyAndSubKeyEnds for prev_subdoc_key_.
@@ -143,12 +150,31 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   bool within_merge_block_ = false;
 };
 
+// Drops whole files of a table with default TTL, when all their records expired by history
+// cutoff. Records without own TTL expire at most table TTL after the max hybrid time of the file,
+// and records with own TTL expire at the max TTL expiration collected for the file.
+class DocDBCompactionFileFilter : public rocksdb::CompactionFileFilter {
+ public:
+  DocDBCompactionFileFilter(HybridTime history_cutoff, MonoDelta table_ttl)
+      : history_cutoff_(history_cutoff), table_ttl_(table_ttl) {}
+
+  bool Expired(const rocksdb::FileBoundaryValuesBase& smallest,
+               const rocksdb::FileBoundaryValuesBase& largest) override;
+
+ private:
+  const HybridTime history_cutoff_;
+  const MonoDelta table_ttl_;
+};
+
 // A strategy for deciding how the history of old database operations should be retained during
 // compactions. We may implement this differently in production and in tests.
 class HistoryRetentionPolicy {
  public:
   virtual ~HistoryRetentionPolicy() = default;
   virtual HistoryRetentionDirective GetRetentionDirective() = 0;
+
+  // Returns the default TTL of the table, without computing the whole directive.
+  virtual MonoDelta GetTableTTL() = 0;
 };
 
 class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
@@ -157,6 +183,10 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
+  std::unique_ptr<rocksdb::CompactionFileFilter> CreateCompactionFileFilter() override;
+  // DocDBCompactionFilter keeps state across subkeys of a document, so subcompaction boundaries
+  // are aligned to DocKey.
+  size_t SubcompactionBoundaryPrefixSize(const Slice& user_key) override;
   const char* Name() const override;
 
  private:
@@ -169,19 +199,25 @@ class ManualHistoryRetentionPolicy : public HistoryRetentionPolicy {
  public:
   HistoryRetentionDirective GetRetentionDirective() override;
 
+  MonoDelta GetTableTTL() override;
+
   void SetHistoryCutoff(HybridTime history_cutoff);
 
   void AddDeletedColumn(ColumnId col);
 
   void SetTableTTLForTests(MonoDelta ttl);
 
+  void SetRangeTombstones(RangeTombstoneVectorPtr range_tombstones);
+
  private:
   std::atomic<HybridTime> history_cutoff_{HybridTime::kMin};
 
-  std::mutex deleted_cols_mtx_;
-  ColumnIds deleted_cols_ GUARDED_BY(deleted_cols_mtx_);
+  std::mutex mutex_;
+  ColumnIds deleted_cols_ GUARDED_BY(mutex_);
 
   std::atomic<MonoDelta> table_ttl_{MonoDelta::kMax};
+
+  RangeTombstoneVectorPtr range_tombstones_ GUARDED_BY(mutex_);
 };
 
 }  // namespace docdb
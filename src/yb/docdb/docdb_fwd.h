@@ -23,7 +23,9 @@ class IntentAwareIterator;
 class KeyValueWriteBatchPB;
 class QLWriteOperation;
 class PgsqlWriteOperation;
+class RangeTombstones;
 
+struct ApplyTransactionState;
 struct DocDB;
 
 }  // namespace docdb
@@ -79,6 +79,8 @@ Status DocDBRocksDBUtil::DestroyRocksDB() {
   LOG(INFO) << "Destroying RocksDB database at " << rocksdb_dir_;
   RETURN_NOT_OK(rocksdb::DestroyDB(rocksdb_dir_, rocksdb_options_));
   RETURN_NOT_OK(rocksdb::DestroyDB(IntentsDBDir(), rocksdb_options_));
+  range_tombstones_.Reset(RangeTombstoneVector());
+  retention_policy_->SetRangeTombstones(nullptr);
   return Status::OK();
 }
 
@@ -159,6 +161,31 @@ Status DocDBRocksDBUtil::WriteToRocksDB(
     rocksdb_write_batch.SetFrontiers(&frontiers);
   }
 
+  if (!doc_write_batch.range_tombstones().empty()) {
+    if (current_txn_id_) {
+      return STATUS(NotSupported, "Range deletion is not supported in transactions");
+    }
+    RETURN_NOT_OK(range_tombstones_.CheckCanAdd(doc_write_batch.range_tombstones().size()));
+    RangeTombstoneVector tombstones;
+    for (const auto& entry : doc_write_batch.range_tombstones()) {
+      tombstones.push_back(RangeTombstone { entry.first, entry.second, hybrid_time });
+    }
+    range_tombstones_.Add(std::move(tombstones));
+    retention_policy_->SetRangeTombstones(range_tombstones_.Get());
+  }
+  if (!current_txn_id_) {
+    const auto& pairs = doc_write_batch.key_value_pairs();
+    range_tombstones_.MarkOverwritten(
+        hybrid_time, [&pairs](const RangeTombstone& tombstone) {
+      for (const auto& pair : pairs) {
+        if (tombstone.Covers(pair.first)) {
+          return true;
+        }
+      }
+      return false;
+    });
+  }
+
   RETURN_NOT_OK(PopulateRocksDBWriteBatch(
       doc_write_batch, &rocksdb_write_batch, hybrid_time, decode_dockey, increment_write_id));
 
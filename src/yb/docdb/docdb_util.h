@@ -50,7 +50,7 @@ class DocDBRocksDBUtil {
 
   rocksdb::DB* rocksdb();
   rocksdb::DB* intents_db();
-  DocDB doc_db() { return {rocksdb(), intents_db()}; }
+  DocDB doc_db() { return {rocksdb(), intents_db(), &range_tombstones_}; }
 
   CHECKED_STATUS InitCommonRocksDBOptions();
 
@@ -188,6 +188,9 @@ class DocDBRocksDBUtil {
   std::shared_ptr<ManualHistoryRetentionPolicy> retention_policy_ {
       std::make_shared<ManualHistoryRetentionPolicy>() };
 
+  // Range tombstones written by WriteToRocksDB, also passed to retention_policy_.
+  RangeTombstones range_tombstones_;
+
   rocksdb::WriteOptions write_options_;
   Schema schema_;
   boost::optional<TransactionId> current_txn_id_;
@@ -100,7 +100,7 @@ Result<HybridTime> TransactionStatusCache::DoGetCommitTime(const TransactionId&
     };
     txn_status_manager_->RequestStatusAt(
         {&transaction_id, read_time_.read, read_time_.global_limit, read_time_.serial_no,
-              &kRequestReason, MustExist::kTrue, callback});
+              &kRequestReason, MustExist::kTrue, callback, AllowRecentPending::kFalse});
     future.wait();
     auto txn_status_result = future.get();
     if (txn_status_result.ok()) {
@@ -251,6 +251,14 @@ IntentAwareIterator::IntentAwareIterator(
                                                 &intent_upperbound_);
   }
   iter_.reset(doc_db.regular->NewIterator(read_opts));
+  // Tombstones are taken after the iterator, so they are marked as overwritten by all records
+  // visible to the iterator.
+  if (doc_db.range_tombstones) {
+    auto range_tombstones = doc_db.range_tombstones->Get();
+    if (range_tombstones) {
+      range_tombstone_checker_.emplace(std::move(range_tombstones), read_time_.local_limit);
+    }
+  }
 }
 
 void IntentAwareIterator::Seek(const DocKey &doc_key) {
@@ -647,6 +655,13 @@ void IntentAwareIterator::ProcessIntent() {
     return;
   }
 
+  // Committed records of other transactions could be deleted by range tombstone, range deletions
+  // are not allowed inside transactions, so records of the same transaction are always visible.
+  if (!decode_result->same_transaction && range_tombstone_checker_ &&
+      decode_result->value_time.hybrid_time() < RangeDeleteTime(decode_result->intent_prefix)) {
+    return;
+  }
+
   if (resolved_intent_state_ == ResolvedIntentState::kNoIntent) {
     resolved_intent_key_prefix_.Reset(decode_result->intent_prefix);
     auto prefix = prefix_stack_.empty() ? Slice() : prefix_stack_.back();
@@ -900,16 +915,42 @@ void IntentAwareIterator::SkipFutureRecords(const Direction direction) {
     encoded_doc_ht.remove_prefix(encoded_doc_ht.size() - doc_ht_size);
     auto value = iter_->value();
     auto value_type = DecodeValueType(value);
+    bool visible;
     if (value_type == ValueType::kHybridTime) {
       // Value came from a transaction, we could try to filter it by original intent time.
       Slice encoded_intent_doc_ht = value;
       encoded_intent_doc_ht.consume_byte();
-      if (encoded_intent_doc_ht.compare(Slice(encoded_read_time_local_limit_)) > 0 &&
-          encoded_doc_ht.compare(Slice(encoded_read_time_global_limit_)) > 0) {
-        iter_valid_ = true;
-        return;
+      visible = encoded_intent_doc_ht.compare(Slice(encoded_read_time_local_limit_)) > 0 &&
+                encoded_doc_ht.compare(Slice(encoded_read_time_global_limit_)) > 0;
+    } else {
+      visible = encoded_doc_ht.compare(Slice(encoded_read_time_local_limit_)) > 0;
+    }
+    if (visible && range_tombstone_checker_) {
+      // Skip kHybridTime value type preceding doc hybrid time.
+      auto delete_time = RangeDeleteTime(
+          Slice(iter_->key().data(), encoded_doc_ht.data() - 1));
+      if (delete_time != HybridTime::kMin) {
+        DocHybridTime doc_ht;
+        auto status = doc_ht.FullyDecodeFrom(encoded_doc_ht);
+        if (!status.ok()) {
+          status_ = std::move(status);
+          iter_valid_ = false;
+          return;
+        }
+        if (doc_ht.hybrid_time() < delete_time) {
+          VLOG(4) << "Skipping because of range tombstone: "
+                  << SubDocKey::DebugSliceToString(iter_->key()) << ", delete time: "
+                  << delete_time;
+          const auto* deleted_end = range_tombstone_checker_->DeletedIntervalEnd();
+          if (deleted_end && direction == Direction::kForward) {
+            SeekPastDeletedInterval(*deleted_end);
+            continue;
+          }
+          visible = false;
+        }
       }
-    } else if (encoded_doc_ht.compare(Slice(encoded_read_time_local_limit_)) > 0) {
+    }
+    if (visible) {
       iter_valid_ = true;
       return;
     }
@@ -932,6 +973,31 @@ void IntentAwareIterator::SkipFutureRecords(const Direction direction) {
   iter_valid_ = false;
 }
 
+void IntentAwareIterator::SeekPastDeletedInterval(const std::string& end) {
+  VLOG(4) << "Seeking past range deleted up to: "
+          << (end.empty() ? "<end>" : SubDocKey::DebugSliceToString(end));
+  if (end.empty()) {
+    // All remaining records are deleted.
+    iter_->SeekToLast();
+    if (iter_->Valid()) {
+      iter_->Next();
+    }
+    return;
+  }
+  ROCKSDB_SEEK(iter_.get(), end);
+}
+
+HybridTime IntentAwareIterator::RangeDeleteTime(const Slice& key_without_ht) {
+  auto result = range_tombstone_checker_->DeleteTime(key_without_ht);
+  if (result > read_time_.read) {
+    // It is unknown whether tombstone was written before or after read, so read should be
+    // restarted.
+    max_seen_ht_.MakeAtLeast(result);
+    return HybridTime::kMin;
+  }
+  return result;
+}
+
 void IntentAwareIterator::SkipFutureIntents() {
   skip_future_intents_needed_ = false;
   if (!intent_iter_ || !status_.ok()) {
@@ -21,6 +21,7 @@
 
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/key_bytes.h"
+#include "yb/docdb/range_tombstones.h"
 
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/options.h"
@@ -251,6 +252,15 @@ class IntentAwareIterator {
 
   bool SatisfyBounds(const Slice& slice);
 
+  // Returns hybrid time of range tombstones covering key_without_ht, that are visible at read
+  // time, or HybridTime::kMin if there are no such tombstones.
+  // Tombstones written after read time, but within uncertainty window, cause read restart.
+  HybridTime RangeDeleteTime(const Slice& key_without_ht);
+
+  // Positions iter_ at the first record after the interval, where all records are deleted by
+  // range tombstones. Empty end means the end of the key space.
+  void SeekPastDeletedInterval(const std::string& end);
+
   const ReadHybridTime read_time_;
   const string encoded_read_time_local_limit_;
   const string encoded_read_time_global_limit_;
@@ -263,6 +273,9 @@ class IntentAwareIterator {
   Status status_;
   HybridTime max_seen_ht_ = HybridTime::kMin;
 
+  // Range tombstones of regular DB, not set when there are no tombstones.
+  boost::optional<RangeTombstoneChecker> range_tombstone_checker_;
+
   // Upperbound for seek. If we see regular or intent record past this bound, it will be ignored.
   Slice upperbound_;
 
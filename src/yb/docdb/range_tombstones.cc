@@ -0,0 +1,218 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/range_tombstones.h"
+
+#include <algorithm>
+
+#include "yb/docdb/docdb.pb.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+
+DEFINE_int32(max_range_tombstones_per_tablet, 1000,
+             "Maximal number of range tombstones, that were not yet purged by full compaction, "
+             "in a tablet. Range deletions that exceed this limit are rejected.");
+TAG_FLAG(max_range_tombstones_per_tablet, advanced);
+
+namespace yb {
+namespace docdb {
+
+void RangeTombstone::ToPB(RangeTombstonePB* pb) const {
+  pb->set_start_key(start_key);
+  pb->set_end_key(end_key);
+  pb->set_hybrid_time(ht.ToUint64());
+  pb->set_overwritten(overwritten);
+}
+
+RangeTombstone RangeTombstone::FromPB(const RangeTombstonePB& pb) {
+  return RangeTombstone {
+      pb.start_key(), pb.end_key(), HybridTime(pb.hybrid_time()), pb.overwritten() };
+}
+
+std::string RangeTombstone::ToString() const {
+  return Format("{ start_key: $0 end_key: $1 ht: $2 overwritten: $3 }",
+                Slice(start_key).ToDebugHexString(),
+                end_key.empty() ? "<end>" : Slice(end_key).ToDebugHexString(),
+                ht, overwritten);
+}
+
+bool operator==(const RangeTombstone& lhs, const RangeTombstone& rhs) {
+  return lhs.start_key == rhs.start_key && lhs.end_key == rhs.end_key && lhs.ht == rhs.ht;
+}
+
+RangeTombstoneChecker::RangeTombstoneChecker(RangeTombstoneVectorPtr tombstones, HybridTime max_ht)
+    : tombstones_(std::move(tombstones)) {
+  // Tombstones that are not visible at max_ht are dropped once, instead of filtering them on
+  // every lookup.
+  if (tombstones_ && max_ht.is_valid()) {
+    bool all_visible = std::all_of(
+        tombstones_->begin(), tombstones_->end(),
+        [max_ht](const RangeTombstone& tombstone) { return tombstone.ht <= max_ht; });
+    if (!all_visible) {
+      auto visible = std::make_shared<RangeTombstoneVector>();
+      for (const auto& tombstone : *tombstones_) {
+        if (tombstone.ht <= max_ht) {
+          visible->push_back(tombstone);
+        }
+      }
+      tombstones_ = std::move(visible);
+    }
+  }
+}
+
+HybridTime RangeTombstoneChecker::DeleteTime(const Slice& key) {
+  if (!tombstones_ || tombstones_->empty()) {
+    return HybridTime::kMin;
+  }
+
+  if (cache_valid_ && Slice(cache_start_).compare(key) <= 0 &&
+      (cache_end_.empty() || key.compare(cache_end_) < 0)) {
+    return cached_delete_time_;
+  }
+
+  // Find covering tombstones and the nearest key, where the set of covering tombstones changes.
+  HybridTime result = HybridTime::kMin;
+  bool overwritten = false;
+  const std::string* end = nullptr;
+  auto update_end = [&end](const std::string& candidate) {
+    if (!end || candidate < *end) {
+      end = &candidate;
+    }
+  };
+  for (const auto& tombstone : *tombstones_) {
+    if (tombstone.Covers(key)) {
+      // Only the latest tombstones matter, records written after earlier ones are deleted by it.
+      if (tombstone.ht > result) {
+        result = tombstone.ht;
+        overwritten = tombstone.overwritten;
+      } else if (tombstone.ht == result) {
+        overwritten = overwritten || tombstone.overwritten;
+      }
+      if (!tombstone.end_key.empty()) {
+        update_end(tombstone.end_key);
+      }
+    } else if (key.compare(tombstone.start_key) < 0) {
+      update_end(tombstone.start_key);
+    }
+  }
+
+  cache_valid_ = true;
+  cache_start_.assign(key.cdata(), key.size());
+  if (end) {
+    cache_end_ = *end;
+  } else {
+    cache_end_.clear();
+  }
+  cached_delete_time_ = result;
+  cached_overwritten_ = overwritten;
+  return result;
+}
+
+RangeTombstoneVectorPtr RangeTombstones::Get() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tombstones_;
+}
+
+Status RangeTombstones::CheckCanAdd(size_t num_tombstones) const {
+  size_t current_size;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_size = tombstones_ ? tombstones_->size() : 0;
+  }
+  if (current_size + num_tombstones > FLAGS_max_range_tombstones_per_tablet) {
+    return STATUS_FORMAT(
+        Busy, "Too many range tombstones: $0 registered, $1 added, limit is $2. "
+              "Range tombstones are removed by full compaction.",
+        current_size, num_tombstones, FLAGS_max_range_tombstones_per_tablet);
+  }
+  return Status::OK();
+}
+
+size_t RangeTombstones::Add(RangeTombstoneVector tombstones) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto new_tombstones = std::make_shared<RangeTombstoneVector>();
+  size_t old_size = tombstones_ ? tombstones_->size() : 0;
+  new_tombstones->reserve(old_size + tombstones.size());
+  if (tombstones_) {
+    // Readers could still use the current vector, so it is copied instead of modified in place.
+    *new_tombstones = *tombstones_;
+  }
+  for (auto& tombstone : tombstones) {
+    if (std::find(new_tombstones->begin(), new_tombstones->end(), tombstone) ==
+            new_tombstones->end()) {
+      new_tombstones->push_back(std::move(tombstone));
+    }
+  }
+  size_t result = new_tombstones->size() - old_size;
+  if (result != 0) {
+    tombstones_ = std::move(new_tombstones);
+  }
+  return result;
+}
+
+size_t RangeTombstones::RemoveUpTo(HybridTime ht) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!tombstones_) {
+    return 0;
+  }
+  auto new_tombstones = std::make_shared<RangeTombstoneVector>();
+  for (const auto& tombstone : *tombstones_) {
+    if (tombstone.ht > ht) {
+      new_tombstones->push_back(tombstone);
+    }
+  }
+  size_t result = tombstones_->size() - new_tombstones->size();
+  if (new_tombstones->empty()) {
+    tombstones_ = nullptr;
+  } else if (result != 0) {
+    tombstones_ = std::move(new_tombstones);
+  }
+  return result;
+}
+
+size_t RangeTombstones::MarkOverwritten(
+    HybridTime ht, const std::function<bool(const RangeTombstone&)>& covers_written_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!tombstones_) {
+    return 0;
+  }
+  std::vector<size_t> marked;
+  for (size_t i = 0; i != tombstones_->size(); ++i) {
+    const auto& tombstone = (*tombstones_)[i];
+    if (!tombstone.overwritten && tombstone.ht <= ht && covers_written_key(tombstone)) {
+      marked.push_back(i);
+    }
+  }
+  if (marked.empty()) {
+    return 0;
+  }
+  auto new_tombstones = std::make_shared<RangeTombstoneVector>(*tombstones_);
+  for (auto i : marked) {
+    (*new_tombstones)[i].overwritten = true;
+  }
+  tombstones_ = std::move(new_tombstones);
+  return marked.size();
+}
+
+void RangeTombstones::Reset(RangeTombstoneVector tombstones) {
+  RangeTombstoneVectorPtr new_tombstones;
+  if (!tombstones.empty()) {
+    new_tombstones = std::make_shared<RangeTombstoneVector>(std::move(tombstones));
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  tombstones_ = std::move(new_tombstones);
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,134 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_RANGE_TOMBSTONES_H
+#define YB_DOCDB_RANGE_TOMBSTONES_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/common/hybrid_time.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+class RangeTombstonePB;
+
+// Deletion of all regular records whose key (without hybrid time) is in [start_key, end_key)
+// and whose hybrid time is less than ht. Empty end_key means the end of the key space.
+struct RangeTombstone {
+  std::string start_key;
+  std::string end_key;
+  HybridTime ht;
+  // Whether a record was written to [start_key, end_key) at or after ht, i.e. whether the range
+  // could contain records that are not deleted by this tombstone.
+  bool overwritten = false;
+
+  bool Covers(const Slice& key) const {
+    return Slice(start_key).compare(key) <= 0 && (end_key.empty() || key.compare(end_key) < 0);
+  }
+
+  void ToPB(RangeTombstonePB* pb) const;
+  static RangeTombstone FromPB(const RangeTombstonePB& pb);
+
+  std::string ToString() const;
+};
+
+// Compares range and hybrid time only, so tombstone replayed during bootstrap is equal to the
+// registered one, that could already be overwritten.
+bool operator==(const RangeTombstone& lhs, const RangeTombstone& rhs);
+
+typedef std::vector<RangeTombstone> RangeTombstoneVector;
+typedef std::shared_ptr<const RangeTombstoneVector> RangeTombstoneVectorPtr;
+
+// Answers whether keys are deleted by range tombstones, ignoring tombstones written after max_ht.
+// Optimized for keys passed in increasing order, as during iteration or compaction: the answer is
+// cached for the key interval where the set of covering tombstones does not change.
+//
+// This class is not thread-safe.
+class RangeTombstoneChecker {
+ public:
+  RangeTombstoneChecker(RangeTombstoneVectorPtr tombstones, HybridTime max_ht);
+
+  // Returns max hybrid time of tombstones covering key, or HybridTime::kMin if there are none.
+  // key - SubDocKey without hybrid time.
+  HybridTime DeleteTime(const Slice& key);
+
+  // Returns the end of the key interval containing the key passed to the last DeleteTime call,
+  // where all records are deleted, so iteration could seek to it instead of stepping over deleted
+  // records. Empty string means the end of the key space.
+  // Returns nullptr when the interval is not deleted or could contain records written after
+  // the tombstones.
+  const std::string* DeletedIntervalEnd() const {
+    return cache_valid_ && cached_delete_time_ != HybridTime::kMin && !cached_overwritten_
+        ? &cache_end_ : nullptr;
+  }
+
+ private:
+  RangeTombstoneVectorPtr tombstones_;
+
+  // [cache_start_, cache_end_) is the interval of keys, that have cached_delete_time_.
+  // Empty cache_end_ with cache_valid_ means the end of the key space.
+  bool cache_valid_ = false;
+  std::string cache_start_;
+  std::string cache_end_;
+  HybridTime cached_delete_time_;
+  // Whether one of the latest tombstones covering the cached interval was overwritten.
+  bool cached_overwritten_ = false;
+};
+
+// Tablet wide registry of range tombstones, that were not yet purged by full compaction.
+// Readers take a snapshot of the tombstones via Get, the snapshot is immutable.
+// Lookups scan all tombstones, so their number is limited by
+// FLAGS_max_range_tombstones_per_tablet.
+class RangeTombstones {
+ public:
+  // Returns nullptr when there are no tombstones, so readers could avoid any overhead.
+  RangeTombstoneVectorPtr Get() const;
+
+  // Checks whether num_tombstones new tombstones could be added without exceeding the limit.
+  // Should be checked before the tombstones are replicated, since replicated ones are always added.
+  CHECKED_STATUS CheckCanAdd(size_t num_tombstones) const;
+
+  // Adds all tombstones at once, so the snapshot is copied once per write batch.
+  // Tombstones that are already registered, for instance during bootstrap, are skipped.
+  // Returns number of added tombstones.
+  size_t Add(RangeTombstoneVector tombstones);
+
+  // Removes tombstones written at or before ht, i.e. ones whose deleted records were already
+  // purged. Returns number of removed tombstones.
+  size_t RemoveUpTo(HybridTime ht);
+
+  // Marks tombstones written at or before ht, for which covers_written_key returns true, as
+  // overwritten. Should be called before records written at ht are visible to readers.
+  // Returns number of marked tombstones.
+  size_t MarkOverwritten(
+      HybridTime ht, const std::function<bool(const RangeTombstone&)>& covers_written_key);
+
+  void Reset(RangeTombstoneVector tombstones);
+
+ private:
+  mutable std::mutex mutex_;
+  RangeTombstoneVectorPtr tombstones_;
+};
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_RANGE_TOMBSTONES_H
@@ -929,6 +929,9 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
       if (data_type == REDIS_TYPE_NONE) {
         return Status::OK();
       }
+      if (request_.has_subkey_range()) {
+        return ApplyDelRange(data);
+      }
       for (int i = 0; i < kv.subkey_size(); i++) {
         PrimitiveValue primitive_value;
         RETURN_NOT_OK(PrimitiveValueFromSubKeyStrict(kv.subkey(i), data_type, &primitive_value));
@@ -1018,6 +1021,47 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
   return Status::OK();
 }
 
+// Deletes timeseries entries with timestamps in subkey range using single range tombstone, so
+// cost of the deletion does not depend on the number of deleted entries.
+Status RedisWriteOperation::ApplyDelRange(const DocOperationApplyData& data) {
+  const RedisKeyValuePB& kv = request_.key_value();
+  const auto& lower_bound = request_.subkey_range().lower_bound();
+  const auto& upper_bound = request_.subkey_range().upper_bound();
+  response_.set_code(RedisResponsePB::OK);
+  if ((lower_bound.has_infinity_type() &&
+       lower_bound.infinity_type() == RedisSubKeyBoundPB::POSITIVE) ||
+      (upper_bound.has_infinity_type() &&
+       upper_bound.infinity_type() == RedisSubKeyBoundPB::NEGATIVE)) {
+    return Status::OK();
+  }
+
+  auto encoded_doc_key = DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key());
+  // Timestamps are stored in descending order, so the upper bound of the time range defines the
+  // start key of the deleted range.
+  KeyBytes start_key = encoded_doc_key;
+  PrimitiveValue(upper_bound.has_infinity_type()
+                     ? std::numeric_limits<int64_t>::max()
+                     : upper_bound.subkey_bound().timestamp_subkey(),
+                 SortOrder::kDescending).AppendToKey(&start_key);
+  if (!upper_bound.has_infinity_type() && upper_bound.is_exclusive()) {
+    // Smallest key after the bound itself.
+    start_key.AppendValueType(ValueType::kLowest);
+  }
+  KeyBytes end_key = encoded_doc_key;
+  PrimitiveValue(lower_bound.has_infinity_type()
+                     ? std::numeric_limits<int64_t>::min()
+                     : lower_bound.subkey_bound().timestamp_subkey(),
+                 SortOrder::kDescending).AppendToKey(&end_key);
+  if (lower_bound.has_infinity_type() || !lower_bound.is_exclusive()) {
+    end_key.AppendValueType(ValueType::kLowest);
+  }
+
+  if (start_key.CompareTo(end_key) < 0) {
+    data.doc_write_batch->DeleteRange(start_key.AsSlice(), end_key.AsSlice());
+  }
+  return Status::OK();
+}
+
 Status RedisWriteOperation::ApplySetRange(const DocOperationApplyData& data) {
   const RedisKeyValuePB& kv = request_.key_value();
   if (kv.value_size() != 1) {
@@ -68,6 +68,7 @@ class RedisWriteOperation :
   CHECKED_STATUS ApplyGetSet(const DocOperationApplyData& data);
   CHECKED_STATUS ApplyAppend(const DocOperationApplyData& data);
   CHECKED_STATUS ApplyDel(const DocOperationApplyData& data);
+  CHECKED_STATUS ApplyDelRange(const DocOperationApplyData& data);
   CHECKED_STATUS ApplySetRange(const DocOperationApplyData& data);
   CHECKED_STATUS ApplyIncr(const DocOperationApplyData& data);
   CHECKED_STATUS ApplyPush(const DocOperationApplyData& data);
@@ -122,6 +122,9 @@ namespace docdb {
     ((kWriteId, 'w')) /* ASCII code 119 */ \
     ((kTransactionId, 'x')) /* ASCII code 120 */ \
     ((kTableId, 'y')) /* ASCII code 121 */ \
+    /* Prefix of intents DB records, that store progress of applying large transactions. */ \
+    /* It is greater than kTransactionId, so such records are never visited by intents scan. */ \
+    ((kTransactionApplyState, 'z')) /* ASCII code 122 */ \
     \
     ((kObject, '{'))  /* ASCII code 123 */ \
     \
@@ -0,0 +1,241 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/client/client.h"
+#include "yb/client/schema.h"
+#include "yb/client/table_creator.h"
+
+#include "yb/integration-tests/mini_cluster.h"
+#include "yb/integration-tests/yb_mini_cluster_test_base.h"
+
+#include "yb/master/catalog_manager.h"
+#include "yb/master/master.h"
+#include "yb/master/master_defaults.h"
+#include "yb/master/mini_master.h"
+
+#include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_peer.h"
+
+#include "yb/tserver/mini_tablet_server.h"
+
+#include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+
+using client::YBTableName;
+using master::SysTablesEntryPB;
+
+namespace {
+
+const std::string kNamespaceName = "colocated_db";
+const std::string kNamespaceId = "colocated_db_id";
+const auto kTimeout = 30s * kTimeMultiplier;
+
+} // namespace
+
+class ColocatedTablesTest : public YBMiniClusterTestBase<MiniCluster> {
+ protected:
+  void SetUp() override {
+    YBMiniClusterTestBase::SetUp();
+
+    MiniClusterOptions opts;
+    opts.num_tablet_servers = 3;
+    cluster_.reset(new MiniCluster(env_.get(), opts));
+    ASSERT_OK(cluster_->Start());
+
+    client_ = ASSERT_RESULT(cluster_->CreateClient());
+    ASSERT_OK(client_->CreateNamespace(
+        kNamespaceName, YQL_DATABASE_PGSQL, "" /* creator_role_name */, kNamespaceId,
+        "" /* source_namespace_id */, boost::none /* next_pg_oid */, true /* colocated */));
+  }
+
+  void DoTearDown() override {
+    client_.reset();
+    if (cluster_) {
+      cluster_->Shutdown();
+      cluster_.reset();
+    }
+    YBMiniClusterTestBase::DoTearDown();
+  }
+
+  master::CatalogManager& catalog_manager() {
+    return *cluster_->mini_master()->master()->catalog_manager();
+  }
+
+  CHECKED_STATUS CreateTable(const TableId& table_id, bool wait = true) {
+    client::YBSchemaBuilder builder;
+    builder.AddColumn("key")->PrimaryKey()->Type(INT64)->NotNull();
+    builder.AddColumn("value")->Type(STRING);
+    client::YBSchema schema;
+    RETURN_NOT_OK(builder.Build(&schema));
+
+    std::unique_ptr<client::YBTableCreator> table_creator(client_->NewTableCreator());
+    return table_creator->table_name(YBTableName(kNamespaceId, kNamespaceName, table_id + "_name"))
+        .table_id(table_id)
+        .schema(&schema)
+        .set_range_partition_columns({"key"})
+        .table_type(client::YBTableType::PGSQL_TABLE_TYPE)
+        .num_tablets(1)
+        .wait(wait)
+        .Create();
+  }
+
+  // Returns the tablet of colocated database, that is owned by its parent table.
+  Result<master::TabletInfoPtr> GetColocatedTablet() {
+    auto parent_table = catalog_manager().GetTableInfo(
+        kNamespaceId + master::kColocatedParentTableIdSuffix);
+    if (!parent_table) {
+      return STATUS(NotFound, "Parent table of colocated database not found");
+    }
+    master::TabletInfos tablets;
+    parent_table->GetAllTablets(&tablets);
+    if (tablets.size() != 1) {
+      return STATUS_FORMAT(IllegalState, "Wrong number of colocated tablets: $0", tablets.size());
+    }
+    return tablets.front();
+  }
+
+  Result<SysTablesEntryPB::State> GetTableState(const TableId& table_id) {
+    auto table = catalog_manager().GetTableInfo(table_id);
+    if (!table) {
+      return STATUS_FORMAT(NotFound, "Table $0 not found", table_id);
+    }
+    return table->LockForRead()->data().pb.state();
+  }
+
+  // Checks whether table is present in metadata of all replicas of the tablet.
+  bool IsTableOnAllReplicas(const TabletId& tablet_id, const TableId& table_id) {
+    auto peers = ListTabletPeers(cluster_.get(), [&tablet_id](const auto& peer) {
+      return peer->tablet_id() == tablet_id;
+    });
+    if (peers.size() != static_cast<size_t>(cluster_->num_tablet_servers())) {
+      return false;
+    }
+    for (const auto& peer : peers) {
+      if (!peer->tablet_metadata()->GetTableInfo(table_id).ok()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Checks whether table is absent in metadata of all replicas of the tablet.
+  bool IsTableRemovedFromAllReplicas(const TabletId& tablet_id, const TableId& table_id) {
+    auto peers = ListTabletPeers(cluster_.get(), [&tablet_id](const auto& peer) {
+      return peer->tablet_id() == tablet_id;
+    });
+    for (const auto& peer : peers) {
+      if (peer->tablet_metadata()->GetTableInfo(table_id).ok()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void CheckTableAdded(const master::TabletInfoPtr& tablet, const TableId& table_id) {
+    ASSERT_EQ(SysTablesEntryPB::RUNNING, ASSERT_RESULT(GetTableState(table_id)));
+
+    // Colocated table uses the tablet of the database instead of having its own.
+    master::TabletInfos tablets;
+    catalog_manager().GetTableInfo(table_id)->GetAllTablets(&tablets);
+    ASSERT_EQ(1U, tablets.size());
+    ASSERT_EQ(tablet->tablet_id(), tablets.front()->tablet_id());
+    {
+      auto tablet_lock = tablet->LockForRead();
+      const auto& table_ids = tablet_lock->data().pb.table_ids();
+      ASSERT_NE(std::find(table_ids.begin(), table_ids.end(), table_id), table_ids.end());
+    }
+
+    ASSERT_OK(WaitFor([this, &tablet, &table_id] {
+      return IsTableOnAllReplicas(tablet->tablet_id(), table_id);
+    }, kTimeout, "Table added to all replicas"));
+  }
+
+  std::unique_ptr<client::YBClient> client_;
+};
+
+TEST_F(ColocatedTablesTest, CreateTables) {
+  const std::vector<TableId> kTableIds = {"table_1", "table_2", "table_3"};
+  for (const auto& table_id : kTableIds) {
+    ASSERT_OK(CreateTable(table_id));
+  }
+
+  auto tablet = ASSERT_RESULT(GetColocatedTablet());
+  for (const auto& table_id : kTableIds) {
+    ASSERT_NO_FATALS(CheckTableAdded(tablet, table_id));
+  }
+
+  // Creating a table again is rejected and does not affect the existing one.
+  ASSERT_NOK(CreateTable(kTableIds.front()));
+  ASSERT_NO_FATALS(CheckTableAdded(tablet, kTableIds.front()));
+}
+
+// Table creation is not finished when master restarts, so table is added to the tablet by the
+// background task of the new master.
+TEST_F(ColocatedTablesTest, MasterRestartWithPendingTable) {
+  const TableId kTableId = "pending_table";
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    cluster_->mini_tablet_server(i)->Shutdown();
+  }
+
+  ASSERT_OK(CreateTable(kTableId, false /* wait */));
+  ASSERT_EQ(SysTablesEntryPB::PREPARING, ASSERT_RESULT(GetTableState(kTableId)));
+
+  ASSERT_OK(cluster_->mini_master()->Restart());
+  ASSERT_OK(cluster_->mini_master()->master()->WaitUntilCatalogManagerIsLeaderAndReadyForTests());
+  ASSERT_EQ(SysTablesEntryPB::PREPARING, ASSERT_RESULT(GetTableState(kTableId)));
+
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    ASSERT_OK(cluster_->mini_tablet_server(i)->Start());
+  }
+  ASSERT_OK(cluster_->WaitForTabletServerCount(cluster_->num_tablet_servers()));
+
+  ASSERT_OK(WaitFor([this, &kTableId]() -> Result<bool> {
+    return VERIFY_RESULT(GetTableState(kTableId)) == SysTablesEntryPB::RUNNING;
+  }, kTimeout, "Pending table is running"));
+  auto tablet = ASSERT_RESULT(GetColocatedTablet());
+  ASSERT_NO_FATALS(CheckTableAdded(tablet, kTableId));
+}
+
+TEST_F(ColocatedTablesTest, DropTable) {
+  const TableId kDroppedTableId = "dropped_table";
+  const TableId kKeptTableId = "kept_table";
+  ASSERT_OK(CreateTable(kDroppedTableId));
+  ASSERT_OK(CreateTable(kKeptTableId));
+  auto tablet = ASSERT_RESULT(GetColocatedTablet());
+  ASSERT_NO_FATALS(CheckTableAdded(tablet, kDroppedTableId));
+
+  ASSERT_OK(client_->DeleteTable(kDroppedTableId));
+
+  ASSERT_EQ(SysTablesEntryPB::DELETED, ASSERT_RESULT(GetTableState(kDroppedTableId)));
+  {
+    auto tablet_lock = tablet->LockForRead();
+    const auto& table_ids = tablet_lock->data().pb.table_ids();
+    ASSERT_EQ(std::find(table_ids.begin(), table_ids.end(), kDroppedTableId), table_ids.end());
+  }
+  ASSERT_OK(WaitFor([this, &tablet, &kDroppedTableId] {
+    return IsTableRemovedFromAllReplicas(tablet->tablet_id(), kDroppedTableId);
+  }, kTimeout, "Table removed from all replicas"));
+
+  // The shared tablet and other tables of the database are not affected.
+  ASSERT_TRUE(tablet->LockForRead()->data().is_running());
+  ASSERT_EQ(tablet->tablet_id(), ASSERT_RESULT(GetColocatedTablet())->tablet_id());
+  ASSERT_NO_FATALS(CheckTableAdded(tablet, kKeptTableId));
+}
+
+} // namespace yb
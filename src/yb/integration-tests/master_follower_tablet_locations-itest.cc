@@ -0,0 +1,221 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "yb/client/client.h"
+#include "yb/client/meta_cache.h"
+#include "yb/client/table_handle.h"
+
+#include "yb/integration-tests/mini_cluster.h"
+#include "yb/integration-tests/yb_mini_cluster_test_base.h"
+
+#include "yb/master/master.h"
+#include "yb/master/master.proxy.h"
+#include "yb/master/mini_master.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/proxy.h"
+
+#include "yb/util/async_util.h"
+#include "yb/util/metrics.h"
+#include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
+
+using namespace std::literals;
+
+DECLARE_int32(master_follower_tablet_locations_refresh_interval_ms);
+DECLARE_int32(master_follower_tablet_locations_max_staleness_ms);
+DECLARE_bool(lookup_tablet_locations_from_master_followers);
+
+METRIC_DECLARE_histogram(handler_latency_yb_master_MasterService_GetTableLocations);
+
+namespace yb {
+namespace master {
+
+using client::YBTableName;
+
+namespace {
+
+const YBTableName kTableName("my_keyspace", "follower_locations_table");
+constexpr int kNumMasters = 3;
+constexpr int kNumTabletServers = 3;
+constexpr int kNumTablets = 4;
+const auto kTimeout = 30s * kTimeMultiplier;
+
+} // namespace
+
+class MasterFollowerTabletLocationsTest : public YBMiniClusterTestBase<MiniCluster> {
+ protected:
+  void SetUp() override {
+    FLAGS_master_follower_tablet_locations_refresh_interval_ms = 100;
+    YBMiniClusterTestBase::SetUp();
+
+    MiniClusterOptions opts;
+    opts.num_masters = kNumMasters;
+    opts.num_tablet_servers = kNumTabletServers;
+    cluster_.reset(new MiniCluster(env_.get(), opts));
+    ASSERT_OK(cluster_->Start());
+    ASSERT_OK(cluster_->WaitForTabletServerCount(kNumTabletServers));
+
+    messenger_ = ASSERT_RESULT(rpc::MessengerBuilder("test-client").Build());
+    proxy_cache_ = std::make_unique<rpc::ProxyCache>(messenger_.get());
+
+    client_ = ASSERT_RESULT(cluster_->CreateClient());
+    ASSERT_OK(client_->CreateNamespaceIfNotExists(kTableName.namespace_name()));
+    client::YBSchemaBuilder builder;
+    builder.AddColumn("key")->Type(INT32)->HashPrimaryKey()->NotNull();
+    builder.AddColumn("value")->Type(INT32);
+    ASSERT_OK(table_.Create(kTableName, kNumTablets, client_.get(), &builder));
+  }
+
+  void DoTearDown() override {
+    client_.reset();
+    if (messenger_) {
+      messenger_->Shutdown();
+    }
+    if (cluster_) {
+      cluster_->Shutdown();
+      cluster_.reset();
+    }
+    YBMiniClusterTestBase::DoTearDown();
+  }
+
+  std::vector<MiniMaster*> FollowerMasters() {
+    auto* leader = cluster_->leader_mini_master();
+    std::vector<MiniMaster*> result;
+    for (int i = 0; i != cluster_->num_masters(); ++i) {
+      if (cluster_->mini_master(i) != leader) {
+        result.push_back(cluster_->mini_master(i));
+      }
+    }
+    return result;
+  }
+
+  Result<GetTableLocationsResponsePB> GetTableLocations(MiniMaster* master) {
+    MasterServiceProxy proxy(proxy_cache_.get(), master->bound_rpc_addr());
+    GetTableLocationsRequestPB req;
+    req.mutable_table()->set_table_id(table_->id());
+    req.set_max_returned_locations(kNumTablets);
+    GetTableLocationsResponsePB resp;
+    rpc::RpcController controller;
+    controller.set_timeout(kTimeout);
+    RETURN_NOT_OK(proxy.GetTableLocations(req, &resp, &controller));
+    return resp;
+  }
+
+  // Whether the master served locations of all tablets of the table.
+  Result<bool> ServesAllLocations(MiniMaster* master) {
+    auto resp = VERIFY_RESULT(GetTableLocations(master));
+    return !resp.has_error() && resp.tablet_locations_size() == kNumTablets;
+  }
+
+  int64_t NumGetTableLocations(MiniMaster* master) {
+    auto metrics = master->master()->metric_entity()->UnsafeMetricsMapForTests();
+    auto it = metrics.find(&METRIC_handler_latency_yb_master_MasterService_GetTableLocations);
+    return it == metrics.end() ? 0 : down_cast<Histogram*>(it->second.get())->TotalCount();
+  }
+
+  // Looks up the first tablet of the table using a new client, so the lookup is not served from
+  // the client cache.
+  Status LookupFirstTabletWithNewClient() {
+    auto client = VERIFY_RESULT(cluster_->CreateClient());
+    std::shared_ptr<client::YBTable> table;
+    RETURN_NOT_OK(client->OpenTable(table_->id(), &table));
+    auto tablet = VERIFY_RESULT(MakeFuture<Result<client::internal::RemoteTabletPtr>>(
+        [&client, &table](auto callback) {
+      client->LookupTabletByKey(
+          table.get(), "" /* partition_key */, MonoTime::Now() + kTimeout, std::move(callback));
+    }).get());
+    SCHECK_EQ(tablet->partition().partition_key_start(), "", IllegalState,
+              "Wrong tablet found");
+    return Status::OK();
+  }
+
+  std::unique_ptr<rpc::Messenger> messenger_;
+  std::unique_ptr<rpc::ProxyCache> proxy_cache_;
+  std::unique_ptr<client::YBClient> client_;
+  client::TableHandle table_;
+};
+
+TEST_F(MasterFollowerTabletLocationsTest, FollowerServesTableLocations) {
+  auto leader_resp = ASSERT_RESULT(GetTableLocations(cluster_->leader_mini_master()));
+  ASSERT_FALSE(leader_resp.has_error()) << leader_resp.ShortDebugString();
+  std::set<TabletId> tablet_ids;
+  for (const auto& locs : leader_resp.tablet_locations()) {
+    tablet_ids.insert(locs.tablet_id());
+  }
+  ASSERT_EQ(kNumTablets, tablet_ids.size());
+
+  for (auto* follower : FollowerMasters()) {
+    ASSERT_OK(WaitFor([this, follower] {
+      return ServesAllLocations(follower);
+    }, kTimeout, "Follower serves table locations"));
+
+    // Locations come from the sys catalog instead of tablet server reports, so they are stale.
+    auto resp = ASSERT_RESULT(GetTableLocations(follower));
+    std::set<TabletId> follower_tablet_ids;
+    for (const auto& locs : resp.tablet_locations()) {
+      ASSERT_TRUE(locs.stale());
+      ASSERT_EQ(kNumTabletServers, locs.replicas_size());
+      follower_tablet_ids.insert(locs.tablet_id());
+    }
+    ASSERT_EQ(tablet_ids, follower_tablet_ids);
+  }
+}
+
+TEST_F(MasterFollowerTabletLocationsTest, LookupFallsBackToLeader) {
+  auto followers = FollowerMasters();
+  for (auto* follower : followers) {
+    ASSERT_OK(WaitFor([this, follower] {
+      return ServesAllLocations(follower);
+    }, kTimeout, "Follower serves table locations"));
+  }
+
+  // Followers do not refresh their locations anymore, so they are too old to be served.
+  FLAGS_master_follower_tablet_locations_refresh_interval_ms = 3600 * 1000;
+  FLAGS_master_follower_tablet_locations_max_staleness_ms = 1;
+  SleepFor(10ms);
+  for (auto* follower : followers) {
+    auto resp = ASSERT_RESULT(GetTableLocations(follower));
+    ASSERT_TRUE(resp.has_error()) << resp.ShortDebugString();
+    ASSERT_EQ(MasterErrorPB::NOT_THE_LEADER, resp.error().code());
+  }
+
+  // The initial lookup is sent to a random master. Repeat until it picks a follower, then the
+  // lookup should be retried on the leader.
+  FLAGS_lookup_tablet_locations_from_master_followers = true;
+  auto* leader = cluster_->leader_mini_master();
+  bool follower_asked = false;
+  for (int i = 0; i != 20 && !follower_asked; ++i) {
+    int64_t num_follower_requests = 0;
+    for (auto* follower : followers) {
+      num_follower_requests += NumGetTableLocations(follower);
+    }
+    const auto num_leader_requests = NumGetTableLocations(leader);
+
+    ASSERT_OK(LookupFirstTabletWithNewClient());
+
+    for (auto* follower : followers) {
+      num_follower_requests -= NumGetTableLocations(follower);
+    }
+    follower_asked = num_follower_requests != 0;
+    ASSERT_GT(NumGetTableLocations(leader), num_leader_requests);
+  }
+  ASSERT_TRUE(follower_asked);
+}
+
+} // namespace master
+} // namespace yb
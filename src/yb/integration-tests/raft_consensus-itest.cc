@@ -83,9 +83,11 @@ DECLARE_int32(leader_lease_duration_ms);
 DECLARE_int32(ht_lease_duration_ms);
 DECLARE_int32(rpc_timeout);
 
+METRIC_DECLARE_entity(server);
 METRIC_DECLARE_entity(tablet);
 METRIC_DECLARE_counter(not_leader_rejections);
 METRIC_DECLARE_gauge_int64(raft_term);
+METRIC_DECLARE_histogram(handler_latency_yb_consensus_ConsensusService_MultiRaftUpdateConsensus);
 
 namespace yb {
 namespace tserver {
@@ -512,6 +514,39 @@ TEST_F(RaftConsensusITest, TestInsertAndMutateThroughConsensus) {
   ASSERT_ALL_REPLICAS_AGREE(FLAGS_client_inserts_per_thread * num_iters);
 }
 
+// Same as above, but heartbeats of tablets are sent in batches.
+TEST_F(RaftConsensusITest, TestInsertWithMultiRaftHeartbeatBatcher) {
+  ASSERT_NO_FATALS(BuildAndStart({"--enable_multi_raft_heartbeat_batcher=true"s}));
+
+  ASSERT_NO_FATALS(InsertTestRowsRemoteThread(
+      0, FLAGS_client_inserts_per_thread, FLAGS_client_num_batches_per_thread,
+      vector<CountDownLatch*>()));
+  ASSERT_ALL_REPLICAS_AGREE(FLAGS_client_inserts_per_thread);
+
+  // Followers should keep the leader, while receiving heartbeats only in batches.
+  TServerDetails* leader = nullptr;
+  ASSERT_OK(GetLeaderReplicaWithRetries(tablet_id_, &leader));
+  SleepFor(MonoDelta::FromSeconds(5));
+  TServerDetails* new_leader = nullptr;
+  ASSERT_OK(GetLeaderReplicaWithRetries(tablet_id_, &new_leader));
+  ASSERT_EQ(leader->uuid(), new_leader->uuid());
+
+  // Heartbeats were actually delivered in batches.
+  vector<TServerDetails*> followers;
+  GetOnlyLiveFollowerReplicas(tablet_id_, &followers);
+  ASSERT_FALSE(followers.empty());
+  for (const auto& follower : followers) {
+    int64_t num_batches = 0;
+    ASSERT_OK(cluster_->tablet_server_by_uuid(follower->uuid())->GetInt64Metric(
+        &METRIC_ENTITY_server,
+        "yb.tabletserver",
+        &METRIC_handler_latency_yb_consensus_ConsensusService_MultiRaftUpdateConsensus,
+        "total_count",
+        &num_batches));
+    ASSERT_GT(num_batches, 0) << "Follower " << follower->uuid();
+  }
+}
+
 TEST_F(RaftConsensusITest, TestFailedOperation) {
   ASSERT_NO_FATALS(BuildAndStart(vector<string>()));
 
@@ -628,6 +628,140 @@ void AsyncCopartitionTable::HandleResponse(int attempt) {
   LOG(INFO) << "master can't handle server responses yet";
 }
 
+// ============================================================================
+//  Class AsyncAddTableToTablet.
+// ============================================================================
+AsyncAddTableToTablet::AsyncAddTableToTablet(Master* master,
+                                             ThreadPool* callback_pool,
+                                             const scoped_refptr<TabletInfo>& tablet,
+                                             const scoped_refptr<TableInfo>& table)
+    : RetryingTSRpcTask(master,
+                        callback_pool,
+                        gscoped_ptr<TSPicker>(new PickLeaderReplica(tablet)),
+                        table.get()),
+      tablet_(tablet), table_(table) {
+}
+
+string AsyncAddTableToTablet::description() const {
+  return tablet_->ToString() + " Add Table to Tablet RPC for table " + table_->ToString();
+}
+
+TabletId AsyncAddTableToTablet::tablet_id() const {
+  return tablet_->tablet_id();
+}
+
+TabletServerId AsyncAddTableToTablet::permanent_uuid() const {
+  return target_ts_desc_ != nullptr ? target_ts_desc_->permanent_uuid() : "";
+}
+
+void AsyncAddTableToTablet::HandleResponse(int attempt) {
+  server::UpdateClock(resp_, master_->clock());
+
+  if (!resp_.has_error()) {
+    TransitionToTerminalState(MonitoredTaskState::kRunning, MonitoredTaskState::kComplete);
+    VLOG(1) << "TS " << permanent_uuid() << ": added table " << table_->ToString()
+            << " to tablet " << tablet_->ToString();
+    WARN_NOT_OK(master_->catalog_manager()->HandleColocatedTableAdded(table_.get()),
+                "Failed to mark colocated table as running");
+    return;
+  }
+
+  Status status = StatusFromPB(resp_.error().status());
+  LOG(WARNING) << "TS " << permanent_uuid() << ": add table " << table_->ToString()
+               << " failed for tablet " << tablet_->ToString() << ": " << status;
+  // Do not retry on a fatal error.
+  if (resp_.error().code() == TabletServerErrorPB::TABLET_NOT_FOUND) {
+    table_->SetCreateTableErrorStatus(status);
+    TransitionToTerminalState(MonitoredTaskState::kRunning, MonitoredTaskState::kFailed);
+  }
+}
+
+bool AsyncAddTableToTablet::SendRequest(int attempt) {
+  tserver::ChangeMetadataRequestPB req;
+  req.set_dest_uuid(permanent_uuid());
+  req.set_tablet_id(tablet_->tablet_id());
+  auto& add_table = *req.mutable_add_table();
+  {
+    auto l = table_->LockForRead();
+    add_table.set_table_id(table_->id());
+    add_table.set_table_name(l->data().name());
+    add_table.set_table_type(l->data().table_type());
+    add_table.mutable_schema()->CopyFrom(l->data().schema());
+    add_table.set_schema_version(l->data().pb.version());
+    add_table.mutable_partition_schema()->CopyFrom(l->data().pb.partition_schema());
+    if (l->data().pb.has_index_info()) {
+      add_table.mutable_index_info()->CopyFrom(l->data().pb.index_info());
+    }
+  }
+  req.set_propagated_hybrid_time(master_->clock()->Now().ToUint64());
+
+  ts_admin_proxy_->AlterSchemaAsync(req, &resp_, &rpc_, BindRpcCallback());
+  VLOG(1) << "Send add table request to " << permanent_uuid()
+          << " (attempt " << attempt << "):\n"
+          << req.DebugString();
+  return true;
+}
+
+// ============================================================================
+//  Class AsyncRemoveTableFromTablet.
+// ============================================================================
+AsyncRemoveTableFromTablet::AsyncRemoveTableFromTablet(Master* master,
+                                                       ThreadPool* callback_pool,
+                                                       const scoped_refptr<TabletInfo>& tablet,
+                                                       const scoped_refptr<TableInfo>& table)
+    : RetryingTSRpcTask(master,
+                        callback_pool,
+                        gscoped_ptr<TSPicker>(new PickLeaderReplica(tablet)),
+                        table.get()),
+      tablet_(tablet), table_(table) {
+}
+
+string AsyncRemoveTableFromTablet::description() const {
+  return tablet_->ToString() + " Remove Table from Tablet RPC for table " + table_->ToString();
+}
+
+TabletId AsyncRemoveTableFromTablet::tablet_id() const {
+  return tablet_->tablet_id();
+}
+
+TabletServerId AsyncRemoveTableFromTablet::permanent_uuid() const {
+  return target_ts_desc_ != nullptr ? target_ts_desc_->permanent_uuid() : "";
+}
+
+void AsyncRemoveTableFromTablet::HandleResponse(int attempt) {
+  server::UpdateClock(resp_, master_->clock());
+
+  if (!resp_.has_error() ||
+      resp_.error().code() == TabletServerErrorPB::TABLET_NOT_FOUND) {
+    // Nothing to remove when the tablet itself is gone.
+    TransitionToTerminalState(MonitoredTaskState::kRunning, MonitoredTaskState::kComplete);
+    VLOG(1) << "TS " << permanent_uuid() << ": removed table " << table_->ToString()
+            << " from tablet " << tablet_->ToString();
+    WARN_NOT_OK(
+        master_->catalog_manager()->HandleColocatedTableRemoved(tablet_.get(), table_.get()),
+        "Failed to mark colocated table as deleted");
+    return;
+  }
+
+  LOG(WARNING) << "TS " << permanent_uuid() << ": remove table " << table_->ToString()
+               << " failed for tablet " << tablet_->ToString() << ": "
+               << StatusFromPB(resp_.error().status());
+}
+
+bool AsyncRemoveTableFromTablet::SendRequest(int attempt) {
+  tserver::ChangeMetadataRequestPB req;
+  req.set_dest_uuid(permanent_uuid());
+  req.set_tablet_id(tablet_->tablet_id());
+  req.set_remove_table_id(table_->id());
+  req.set_propagated_hybrid_time(master_->clock()->Now().ToUint64());
+
+  ts_admin_proxy_->AlterSchemaAsync(req, &resp_, &rpc_, BindRpcCallback());
+  VLOG(1) << "Send remove table request to " << permanent_uuid()
+          << " (attempt " << attempt << "):\n"
+          << req.DebugString();
+  return true;
+}
+
 // ============================================================================
 //  Class AsyncTruncate.
 // ============================================================================
@@ -360,6 +360,63 @@ class AsyncCopartitionTable : public RetryingTSRpcTask {
   tserver::CopartitionTableResponsePB resp_;
 };
 
+// Send the "Alter Table" request, that adds table to the tablet of colocated database, to the
+// leader replica of this tablet.
+// Keeps retrying until tablet confirms that table was added.
+class AsyncAddTableToTablet : public RetryingTSRpcTask {
+ public:
+  AsyncAddTableToTablet(Master* master,
+                        ThreadPool* callback_pool,
+                        const scoped_refptr<TabletInfo>& tablet,
+                        const scoped_refptr<TableInfo>& table);
+
+  Type type() const override { return ASYNC_ADD_TABLE_TO_TABLET; }
+
+  std::string type_name() const override { return "Add Table to Tablet"; }
+
+  std::string description() const override;
+
+ private:
+  TabletId tablet_id() const override;
+
+  TabletServerId permanent_uuid() const;
+
+  void HandleResponse(int attempt) override;
+  bool SendRequest(int attempt) override;
+
+  scoped_refptr<TabletInfo> tablet_;
+  scoped_refptr<TableInfo> table_;
+  tserver::ChangeMetadataResponsePB resp_;
+};
+
+// Send the "Alter Table" request, that removes table from the tablet of colocated database, to the
+// leader replica of this tablet.
+class AsyncRemoveTableFromTablet : public RetryingTSRpcTask {
+ public:
+  AsyncRemoveTableFromTablet(Master* master,
+                             ThreadPool* callback_pool,
+                             const scoped_refptr<TabletInfo>& tablet,
+                             const scoped_refptr<TableInfo>& table);
+
+  Type type() const override { return ASYNC_REMOVE_TABLE_FROM_TABLET; }
+
+  std::string type_name() const override { return "Remove Table from Tablet"; }
+
+  std::string description() const override;
+
+ private:
+  TabletId tablet_id() const override;
+
+  TabletServerId permanent_uuid() const;
+
+  void HandleResponse(int attempt) override;
+  bool SendRequest(int attempt) override;
+
+  scoped_refptr<TabletInfo> tablet_;
+  scoped_refptr<TableInfo> table_;
+  tserver::ChangeMetadataResponsePB resp_;
+};
+
 // Send a Truncate() RPC request.
 class AsyncTruncate : public RetryingTSRpcTask {
  public:
@@ -194,6 +194,11 @@ TableType TableInfo::GetTableType() const {
   return l->data().pb.table_type();
 }
 
+bool TableInfo::colocated() const {
+  auto l = LockForRead();
+  return l->data().colocated();
+}
+
 bool TableInfo::RemoveTablet(const std::string& partition_key_start) {
   std::lock_guard<simple_spinlock> l(lock_);
   return EraseKeyReturnValuePtr(&tablet_map_, partition_key_start) != NULL;
@@ -463,6 +468,11 @@ YQLDatabase NamespaceInfo::database_type() const {
   return l->data().pb.database_type();
 }
 
+bool NamespaceInfo::colocated() const {
+  auto l = LockForRead();
+  return l->data().colocated();
+}
+
 std::string NamespaceInfo::ToString() const {
   return Substitute("$0 [id=$1]", name(), namespace_id_);
 }
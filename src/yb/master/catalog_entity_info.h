@@ -270,6 +270,10 @@ struct PersistentTableInfo : public Persistent<SysTablesEntryPB, SysRowEntry::TA
     return pb.schema();
   }
 
+  bool colocated() const {
+    return pb.colocated();
+  }
+
   // Helper to set the state of the tablet with a custom message.
   void set_state(SysTablesEntryPB::State state, const std::string& msg);
 };
@@ -309,6 +313,9 @@ class TableInfo : public RefCountedThreadSafe<TableInfo>,
   // Return the table type of the table.
   TableType GetTableType() const;
 
+  // Whether the table shares tablet of colocated database with other tables.
+  bool colocated() const;
+
   // Checks if the table is the internal redis table.
   bool IsRedisTable() const {
     return GetTableType() == REDIS_TABLE_TYPE;
@@ -425,6 +432,10 @@ struct PersistentNamespaceInfo : public Persistent<SysNamespaceEntryPB, SysRowEn
   YQLDatabase database_type() const {
     return pb.database_type();
   }
+
+  bool colocated() const {
+    return pb.colocated();
+  }
 };
 
 // The information about a namespace.
@@ -442,6 +453,8 @@ class NamespaceInfo : public RefCountedThreadSafe<NamespaceInfo>,
 
   YQLDatabase database_type() const;
 
+  bool colocated() const;
+
   std::string ToString() const override;
 
  private:
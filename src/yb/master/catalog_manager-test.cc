@@ -30,6 +30,8 @@
 // under the License.
 //
 
+#include <map>
+
 #include "yb/master/catalog_manager-test_base.h"
 
 namespace yb {
@@ -130,6 +132,49 @@ TEST(TestLoadBalancerCommunity, TestLoadBalancerAlgorithm) {
   lb->TestAlgorithm();
 }
 
+TEST(TestCatalogManager, TestPlacementWithReadReplicas) {
+  TSDescriptorVector ts_descs = {
+      SetupTS("0000", "a"), SetupTS("1111", "b"), SetupTS("2222", "c"),
+      SetupTS("rr00", "a", kReadReplicaPlacementUuid),
+      SetupTS("rr11", "b", kReadReplicaPlacementUuid)};
+
+  ReplicationInfoPB replication_info;
+  SetupClusterConfig({"a", "b", "c"}, &replication_info);
+  auto* read_replica_placement = replication_info.add_read_replicas();
+  read_replica_placement->set_placement_uuid(kReadReplicaPlacementUuid);
+  read_replica_placement->set_num_replicas(2);
+
+  CatalogManager catalog_manager(nullptr /* master */);
+  consensus::RaftConfigPB config;
+  ASSERT_OK(catalog_manager.HandlePlacementUsingReplicationInfo(
+      replication_info, ts_descs, &config));
+
+  // Voters are placed on the live cluster only, even though read replica tablet servers match
+  // the live placement blocks, and every read replica tablet server gets an observer.
+  std::map<string, consensus::RaftPeerPB::MemberType> member_types;
+  for (const auto& peer : config.peers()) {
+    ASSERT_TRUE(member_types.emplace(peer.permanent_uuid(), peer.member_type()).second);
+  }
+  const std::map<string, consensus::RaftPeerPB::MemberType> expected_member_types = {
+      {"0000", consensus::RaftPeerPB::VOTER},
+      {"1111", consensus::RaftPeerPB::VOTER},
+      {"2222", consensus::RaftPeerPB::VOTER},
+      {"rr00", consensus::RaftPeerPB::OBSERVER},
+      {"rr11", consensus::RaftPeerPB::OBSERVER}};
+  ASSERT_EQ(expected_member_types, member_types);
+
+  // Read replicas are best effort, so the tablet gets voters only when there are not enough read
+  // replica tablet servers.
+  read_replica_placement->set_num_replicas(3);
+  config.Clear();
+  ASSERT_OK(catalog_manager.HandlePlacementUsingReplicationInfo(
+      replication_info, ts_descs, &config));
+  ASSERT_EQ(kNumReplicas, config.peers_size());
+  for (const auto& peer : config.peers()) {
+    ASSERT_EQ(consensus::RaftPeerPB::VOTER, peer.member_type());
+  }
+}
+
 TEST(TestCatalogManager, TestLoadCountMultiAZ) {
   std::shared_ptr<TSDescriptor> ts0 = SetupTS("0000", "a");
   std::shared_ptr<TSDescriptor> ts1 = SetupTS("1111", "b");
@@ -30,6 +30,7 @@ namespace master {
 const string default_cloud = "aws";
 const string default_region = "us-west-1";
 const int kNumReplicas = 3;
+const string kReadReplicaPlacementUuid = "read_replica";
 
 void CreateTable(const vector<string> split_keys, const int num_replicas, bool setup_placement,
                  TableInfo* table, vector<scoped_refptr<TabletInfo>>* tablets) {
@@ -81,9 +82,11 @@ void NewReplica(
   replica->ts_desc = ts_desc;
   replica->state = state;
   replica->role = role;
+  replica->member_type = consensus::RaftPeerPB::VOTER;
 }
 
-std::shared_ptr<TSDescriptor> SetupTS(const string& uuid, const string& az) {
+std::shared_ptr<TSDescriptor> SetupTS(const string& uuid, const string& az,
+                                      const string& placement_uuid = "") {
   NodeInstancePB node;
   node.set_permanent_uuid(uuid);
 
@@ -96,6 +99,9 @@ std::shared_ptr<TSDescriptor> SetupTS(const string& uuid, const string& az) {
   ci->set_placement_cloud(default_cloud);
   ci->set_placement_region(default_region);
   ci->set_placement_zone(az);
+  if (!placement_uuid.empty()) {
+    reg.mutable_common()->set_placement_uuid(placement_uuid);
+  }
 
   std::shared_ptr<TSDescriptor> ts(new YB_EDITION_NS_PREFIX TSDescriptor(node.permanent_uuid()));
   CHECK_OK(ts->Register(node, reg, CloudInfoPB(), nullptr));
@@ -170,6 +176,9 @@ class TestLoadBalancerBase {
     PrepareTestState(ts_descs_multi_az);
     TestBalancingLeaders();
 
+    PrepareTestState(ts_descs_multi_az);
+    TestWithReadReplicas();
+
     PrepareTestState(ts_descs_single_az);
     TestMissingPlacementSingleAz();
 
@@ -737,6 +746,53 @@ class TestLoadBalancerBase {
     ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
   }
 
+  void TestWithReadReplicas() {
+    LOG(INFO) << "Testing with observers of a read replica cluster";
+    SetupClusterConfig({"a", "b", "c"}, &replication_info_);
+    auto* read_replica_placement = replication_info_.add_read_replicas();
+    read_replica_placement->set_placement_uuid(kReadReplicaPlacementUuid);
+    read_replica_placement->set_num_replicas(1);
+
+    // Move all leaders to ts0, then add an observer of every tablet on a read replica tablet
+    // server in AZ "a". It has no live replicas, so it would be the best destination for load and
+    // leaders of ts0, if it was balanced together with the live cluster.
+    for (const auto& tablet : tablets_) {
+      MoveTabletLeader(tablet.get(), ts_descs_[0]);
+    }
+    ts_descs_.push_back(SetupTS("rr00", "a", kReadReplicaPlacementUuid));
+    const auto read_replica_uuid = ts_descs_[3]->permanent_uuid();
+    for (const auto& tablet : tablets_) {
+      AddObserverReplica(tablet.get(), ts_descs_[3]);
+    }
+    LOG(INFO) << "Leader distribution: 4 0 0, observers on read replica tablet server";
+
+    ASSERT_OK(AnalyzeTablets());
+
+    // Observers are neither treated as over-replication, nor moved, nor is load added to the read
+    // replica tablet server.
+    string placeholder;
+    ASSERT_FALSE(ASSERT_RESULT(HandleAddReplicas(&placeholder, &placeholder, &placeholder)));
+    ASSERT_FALSE(ASSERT_RESULT(cb_->HandleRemoveReplicas(&placeholder, &placeholder)));
+
+    // Leaders are balanced across the live tablet servers only.
+    string tablet_id_1, tablet_id_2;
+    TestMoveLeader(&tablet_id_1, ts_descs_[0]->permanent_uuid(), ts_descs_[1]->permanent_uuid());
+    TestMoveLeader(&tablet_id_2, ts_descs_[0]->permanent_uuid(), ts_descs_[2]->permanent_uuid());
+    ASSERT_NE(tablet_id_1, tablet_id_2);
+    ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
+
+    // Observers are left in place.
+    for (const auto& tablet : tablets_) {
+      TabletInfo::ReplicaMap replicas;
+      tablet->GetReplicaLocations(&replicas);
+      ASSERT_EQ(4, replicas.size());
+      auto it = replicas.find(read_replica_uuid);
+      ASSERT_NE(it, replicas.end());
+      ASSERT_EQ(consensus::RaftPeerPB::OBSERVER, it->second.member_type);
+      ASSERT_EQ(consensus::RaftPeerPB::READ_REPLICA, it->second.role);
+    }
+  }
+
   void TestMissingPlacementSingleAz() {
     LOG(INFO) << "Testing single az deployment where min_num_replicas different from num_replicas";
     // Setup cluster level placement to single AZ.
@@ -864,6 +920,18 @@ class TestLoadBalancerBase {
     tablet->SetReplicaLocations(replicas);
   }
 
+  void AddObserverReplica(TabletInfo* tablet, std::shared_ptr<TSDescriptor> ts_desc) {
+    TabletInfo::ReplicaMap replicas;
+    tablet->GetReplicaLocations(&replicas);
+
+    TabletReplica replica;
+    NewReplica(ts_desc.get(), tablet::RaftGroupStatePB::RUNNING,
+               consensus::RaftPeerPB::READ_REPLICA, &replica);
+    replica.member_type = consensus::RaftPeerPB::OBSERVER;
+    InsertOrDie(&replicas, ts_desc->permanent_uuid(), replica);
+    tablet->SetReplicaLocations(replicas);
+  }
+
   void RemoveReplica(TabletInfo* tablet, std::shared_ptr<TSDescriptor> ts_desc) {
     TabletInfo::ReplicaMap replicas;
     tablet->GetReplicaLocations(&replicas);
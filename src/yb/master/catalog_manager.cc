@@ -63,6 +63,7 @@
 #include <mutex>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <glog/logging.h>
@@ -364,6 +365,7 @@ CatalogManager::CatalogManager(Master* master)
     sys_catalog_.reset(new SysCatalogTable(
         master_, master_->metric_registry(),
         Bind(&CatalogManager::ElectedAsLeaderCb, Unretained(this))));
+    follower_tablet_locations_ = std::make_unique<FollowerTabletLocations>(sys_catalog_.get());
   }
 }
 
@@ -1326,6 +1328,105 @@ Status CatalogManager::CreateCopartitionedTable(const CreateTableRequestPB req,
   return Status::OK();
 }
 
+Status CatalogManager::CreateColocatedTable(const CreateTableRequestPB& req,
+                                            const Schema& schema,
+                                            const PartitionSchema& partition_schema,
+                                            const scoped_refptr<NamespaceInfo>& ns,
+                                            CreateTableResponsePB* resp,
+                                            rpc::RpcContext* rpc) {
+  const char* const object_type = req.indexed_table_id().empty() ? "table" : "index";
+
+  // For index table, populate the index info.
+  IndexInfoPB index_info;
+  if (req.has_indexed_table_id()) {
+    IndexInfoBuilder index_info_builder(&index_info);
+    index_info_builder.ApplyProperties(req.indexed_table_id(),
+        req.is_local_index(), req.is_unique_index());
+  }
+
+  scoped_refptr<TableInfo> table;
+  scoped_refptr<TabletInfo> tablet;
+  {
+    std::lock_guard<LockType> l(lock_);
+    TRACE("Acquired catalog manager lock");
+
+    TabletInfos tablets;
+    scoped_refptr<TableInfo> parent_table = FindPtrOrNull(
+        table_ids_map_, ns->id() + kColocatedParentTableIdSuffix);
+    if (parent_table != nullptr) {
+      parent_table->GetAllTablets(&tablets);
+    }
+    if (tablets.size() != 1) {
+      Status s = STATUS_SUBSTITUTE(NotFound,
+          "Tablet of colocated database '$0' does not exist", ns->name());
+      return SetupError(resp->mutable_error(), MasterErrorPB::OBJECT_NOT_FOUND, s);
+    }
+    tablet = tablets.front();
+
+    RETURN_NOT_OK(CreateTableInMemory(req, schema, partition_schema, false /* create_tablets */,
+                                      ns->id(), std::vector<Partition>(), &index_info,
+                                      nullptr /* tablets */, resp, &table));
+    table->mutable_metadata()->mutable_dirty()->pb.set_colocated(true);
+  }
+  TRACE("Inserted new table info into CatalogManager maps");
+
+  // The table stays in "preparing" state until it is added to the tablet, see
+  // HandleColocatedTableAdded.
+  Status s = sys_catalog_->AddItem(table.get(), leader_ready_term_);
+  if (PREDICT_FALSE(!s.ok())) {
+    return AbortTableCreation(table.get(), {},
+                              s.CloneAndPrepend(
+                                  Substitute("An error occurred while inserting to sys-tablets: $0",
+                                             s.ToString())),
+                              resp);
+  }
+  TRACE("Wrote table to system table");
+  table->mutable_metadata()->CommitMutation();
+
+  {
+    auto tablet_lock = tablet->LockForWrite();
+    tablet_lock->mutable_data()->pb.add_table_ids(table->id());
+    s = sys_catalog_->UpdateItem(tablet.get(), leader_ready_term_);
+    if (PREDICT_FALSE(!s.ok())) {
+      s = s.CloneAndPrepend("An error occurred while updating sys-tablets");
+      table->SetCreateTableErrorStatus(s);
+      return CheckIfNoLongerLeaderAndSetupError(s, resp);
+    }
+    tablet_lock->Commit();
+  }
+  table->AddTablet(tablet.get());
+  TRACE("Wrote tablet to system table");
+
+  SendAddTableToTabletRequest(tablet, table);
+
+  LOG(INFO) << "Successfully created colocated " << object_type << " " << table->ToString()
+            << " in tablet " << tablet->tablet_id() << " per request from "
+            << RequestorString(rpc);
+  return Status::OK();
+}
+
+Status CatalogManager::CreateColocatedParentTable(const scoped_refptr<NamespaceInfo>& ns,
+                                                  rpc::RpcContext* rpc) {
+  CreateTableRequestPB req;
+  CreateTableResponsePB resp;
+  req.set_name(ns->id() + kColocatedParentTableNameSuffix);
+  req.set_table_id(ns->id() + kColocatedParentTableIdSuffix);
+  req.mutable_namespace_()->set_id(ns->id());
+  req.set_table_type(PGSQL_TABLE_TYPE);
+  req.set_num_tablets(1);
+  // Parent table owns the tablet, so it is created as a regular table.
+  req.set_colocated(false);
+
+  // Tables of the database are transactional, so the shared tablet should be transactional too.
+  TableProperties table_properties;
+  table_properties.SetTransactional(true);
+  Schema schema({ ColumnSchema("key", BINARY) }, 1 /* key_columns */, table_properties);
+  SchemaToPB(schema, req.mutable_schema());
+  req.mutable_partition_schema()->mutable_range_schema();
+
+  return CreateTable(&req, &resp, rpc);
+}
+
 namespace {
 
 CHECKED_STATUS ValidateCreateTableSchema(const Schema& schema, CreateTableResponsePB* resp) {
@@ -1639,6 +1740,13 @@ Status CatalogManager::CreateTable(const CreateTableRequestPB* orig_req,
     }
   }
 
+  // Tables of colocated database are stored in the shared tablet, unless requested otherwise.
+  if (req.table_type() == PGSQL_TABLE_TYPE && req.colocated() && ns->colocated()) {
+    PartitionSchema partition_schema;
+    RETURN_NOT_OK(PartitionSchema::FromPB(req.partition_schema(), schema, &partition_schema));
+    return CreateColocatedTable(req, schema, partition_schema, ns, resp, rpc);
+  }
+
   // Get cluster level placement info.
   ReplicationInfoPB replication_info;
   {
@@ -2018,6 +2126,11 @@ Status CatalogManager::IsCreateTableDone(const IsCreateTableDoneRequestPB* req,
   TRACE("Verify if the table creation is in progress for $0", table->ToString());
   resp->set_done(!table->IsCreateInProgress());
 
+  // Colocated table is created when it is added to the shared tablet.
+  if (resp->done() && l->data().colocated()) {
+    resp->set_done(l->data().is_running());
+  }
+
   // 3. Set any current errors, if we are experiencing issues creating the table. This will be
   // bubbled up to the MasterService layer. If it is an error, it gets wrapped around in
   // MasterErrorPB::UNKNOWN_ERROR.
@@ -2279,6 +2392,13 @@ Status CatalogManager::TruncateTable(const TableId& table_id,
     return SetupError(resp->mutable_error(), MasterErrorPB::OBJECT_NOT_FOUND, s);
   }
 
+  // Truncate is applied to the whole tablet, that is shared by all tables of colocated database.
+  if (l->data().colocated()) {
+    Status s = STATUS_SUBSTITUTE(NotSupported,
+        "Truncate of colocated $0 '$1' is not supported", table_type, table->name());
+    return SetupError(resp->mutable_error(), MasterErrorPB::INVALID_TABLE_TYPE, s);
+  }
+
   // Send a Truncate() request to each tablet in the table.
   SendTruncateTableRequest(table);
 
@@ -2410,6 +2530,20 @@ Status CatalogManager::DeleteTable(const DeleteTableRequestPB* req,
 
   // The table lock (l) and the global lock (lock_) must be released for the next call.
   for (int i = 0; i < deleted_tables.size(); i++) {
+    if (tables[i]->colocated()) {
+      // Colocated table is removed from the shared tablet, that stays alive, and is marked as
+      // deleted after that, see HandleColocatedTableRemoved.
+      TabletInfos tablets;
+      tables[i]->GetAllTablets(&tablets);
+      if (tablets.empty()) {
+        MarkTableDeletedIfNoTablets(deleted_tables[i], tables[i].get());
+      }
+      for (const auto& tablet : tablets) {
+        SendRemoveTableFromTabletRequest(tablet, tables[i]);
+      }
+      continue;
+    }
+
     MarkTableDeletedIfNoTablets(deleted_tables[i], tables[i].get());
 
     // Send a DeleteTablet() request to each tablet replica in the table.
@@ -2527,8 +2661,11 @@ Status CatalogManager::DeleteTableInMemory(const TableIdentifierPB& table_identi
       }
     }
 
-    TRACE("Add deleted table tablets into tablet wait list");
-    deleted_table->AddTabletsToMap(&deleted_tablet_map_);
+    // Shared tablet of colocated table is not deleted together with the table.
+    if (!l->data().colocated()) {
+      TRACE("Add deleted table tablets into tablet wait list");
+      deleted_table->AddTabletsToMap(&deleted_tablet_map_);
+    }
   }
 
   // For regular (indexed) table, insert table info and lock in the front of the list. Else for
@@ -2770,6 +2907,13 @@ Status CatalogManager::AlterTable(const AlterTableRequestPB* req,
     return SetupError(resp->mutable_error(), MasterErrorPB::OBJECT_NOT_FOUND, s);
   }
 
+  // Tablet applies altered schema to its primary table, that is the parent table for tablet of
+  // colocated database.
+  if (l->data().colocated()) {
+    Status s = STATUS(NotSupported, "Altering colocated table is not supported", table->name());
+    return SetupError(resp->mutable_error(), MasterErrorPB::INVALID_TABLE_TYPE, s);
+  }
+
   bool has_changes = false;
   const TableName table_name = l->data().name();
   const NamespaceId namespace_id = l->data().namespace_id();
@@ -3536,6 +3680,10 @@ Status CatalogManager::CreateNamespace(const CreateNamespaceRequestPB* req,
     TRACE("Acquired catalog manager lock");
 
     // Validate the user request.
+    if (req->colocated() && req->database_type() != YQL_DATABASE_PGSQL) {
+      s = STATUS(InvalidArgument, "Only YSQL database could be colocated", req->name());
+      return SetupError(resp->mutable_error(), MasterErrorPB::INVALID_SCHEMA, s);
+    }
 
     // Verify that the namespace does not exist except for namespace for YSQL database that is
     // identified by id only.
@@ -3564,6 +3712,7 @@ Status CatalogManager::CreateNamespace(const CreateNamespaceRequestPB* req,
     // For namespace created for a Postgres database, save the list of tables and indexes for
     // for the database that need to be copied.
     if (req->database_type() == YQL_DATABASE_PGSQL) {
+      metadata->set_colocated(req->colocated());
       if (req->source_namespace_id().empty()) {
         metadata->set_next_pg_oid(req->next_pg_oid());
       } else {
@@ -3635,6 +3784,10 @@ Status CatalogManager::CreateNamespace(const CreateNamespaceRequestPB* req,
     RETURN_NOT_OK(CopyPgsqlSysTables(ns->id(), pgsql_tables, resp, rpc));
   }
 
+  if (req->colocated()) {
+    RETURN_NOT_OK(CreateColocatedParentTable(ns, rpc));
+  }
+
   return Status::OK();
 }
 
@@ -3818,6 +3971,21 @@ Status CatalogManager::DeleteYsqlDBTables(const scoped_refptr<NamespaceInfo>& da
         continue;
       }
 
+      // Colocated table is deleted together with the shared tablet, that belongs to the parent
+      // table of the database.
+      if (l->data().colocated()) {
+        table->AbortTasks();
+        l->mutable_data()->set_state(SysTablesEntryPB::DELETED,
+                                     Substitute("Deleted with database at $0", LocalTimeAsString()));
+        Status s = sys_catalog_->UpdateItem(table.get(), leader_ready_term_);
+        if (!s.ok()) {
+          LOG(WARNING) << "An error occurred while updating sys tables: " << s;
+          continue;
+        }
+        l->Commit();
+        continue;
+      }
+
       TRACE("Updating metadata on disk");
       // Update the metadata for the on-disk state.
       l->mutable_data()->set_state(SysTablesEntryPB::DELETING,
@@ -4528,6 +4696,21 @@ void CatalogManager::SendCopartitionTabletRequest(const scoped_refptr<TabletInfo
   WARN_NOT_OK(call->Run(), "Failed to send copartition table request");
 }
 
+void CatalogManager::SendAddTableToTabletRequest(const scoped_refptr<TabletInfo>& tablet,
+                                                 const scoped_refptr<TableInfo>& table) {
+  auto call = std::make_shared<AsyncAddTableToTablet>(master_, worker_pool_.get(), tablet, table);
+  table->AddTask(call);
+  WARN_NOT_OK(call->Run(), "Failed to send add table to tablet request");
+}
+
+void CatalogManager::SendRemoveTableFromTabletRequest(const scoped_refptr<TabletInfo>& tablet,
+                                                      const scoped_refptr<TableInfo>& table) {
+  auto call = std::make_shared<AsyncRemoveTableFromTablet>(
+      master_, worker_pool_.get(), tablet, table);
+  table->AddTask(call);
+  WARN_NOT_OK(call->Run(), "Failed to send remove table from tablet request");
+}
+
 void CatalogManager::DeleteTabletReplicas(
     const TabletInfo* tablet,
     const std::string& msg) {
@@ -4683,6 +4866,43 @@ void CatalogManager::ExtractTabletsToProcess(
   }
 }
 
+void CatalogManager::ProcessPendingColocatedTables() {
+  std::vector<scoped_refptr<TableInfo>> tables_to_add;
+  std::vector<scoped_refptr<TableInfo>> tables_to_remove;
+  {
+    boost::shared_lock<LockType> l(lock_);
+    for (const auto& entry : table_ids_map_) {
+      const auto& table = entry.second;
+      auto table_lock = table->LockForRead();
+      if (!table_lock->data().colocated()) {
+        continue;
+      }
+      const auto state = table_lock->data().pb.state();
+      if (state == SysTablesEntryPB::PREPARING &&
+          !table->HasTasks(MonitoredTask::ASYNC_ADD_TABLE_TO_TABLET)) {
+        tables_to_add.push_back(table);
+      } else if (state == SysTablesEntryPB::DELETING &&
+                 !table->HasTasks(MonitoredTask::ASYNC_REMOVE_TABLE_FROM_TABLET)) {
+        tables_to_remove.push_back(table);
+      }
+    }
+  }
+
+  TabletInfos tablets;
+  for (const auto& table : tables_to_add) {
+    table->GetAllTablets(&tablets);
+    for (const auto& tablet : tablets) {
+      SendAddTableToTabletRequest(tablet, table);
+    }
+  }
+  for (const auto& table : tables_to_remove) {
+    table->GetAllTablets(&tablets);
+    for (const auto& tablet : tablets) {
+      SendRemoveTableFromTabletRequest(tablet, table);
+    }
+  }
+}
+
 struct DeferredAssignmentActions {
   vector<TabletInfo*> tablets_to_add;
   vector<TabletInfo*> tablets_to_update;
@@ -4787,6 +5007,55 @@ Status CatalogManager::HandleTabletSchemaVersionReport(TabletInfo *tablet, uint3
   return Status::OK();
 }
 
+Status CatalogManager::HandleColocatedTableAdded(TableInfo* table) {
+  auto l = table->LockForWrite();
+  if (l->data().pb.state() != SysTablesEntryPB::PREPARING) {
+    return Status::OK();
+  }
+
+  l->mutable_data()->set_state(SysTablesEntryPB::RUNNING,
+                               Substitute("Added to colocated tablet at $0", LocalTimeAsString()));
+  RETURN_NOT_OK_PREPEND(sys_catalog_->UpdateItem(table, leader_ready_term_),
+                        "An error occurred while updating sys-tables");
+  l->Commit();
+
+  LOG(INFO) << "Colocated table " << table->ToString() << " is running";
+  return Status::OK();
+}
+
+Status CatalogManager::HandleColocatedTableRemoved(TabletInfo* tablet, TableInfo* table) {
+  {
+    auto tablet_lock = tablet->LockForWrite();
+    table->RemoveTablet(tablet_lock->data().pb.partition().partition_key_start());
+    auto* table_ids = tablet_lock->mutable_data()->pb.mutable_table_ids();
+    for (int i = 0; i != table_ids->size(); ++i) {
+      if (table_ids->Get(i) == table->id()) {
+        table_ids->DeleteSubrange(i, 1);
+        RETURN_NOT_OK_PREPEND(sys_catalog_->UpdateItem(tablet, leader_ready_term_),
+                              "An error occurred while updating sys-tablets");
+        tablet_lock->Commit();
+        break;
+      }
+    }
+  }
+
+  auto l = table->LockForWrite();
+  if (l->data().pb.state() != SysTablesEntryPB::DELETING) {
+    return Status::OK();
+  }
+
+  l->mutable_data()->set_state(
+      SysTablesEntryPB::DELETED,
+      Substitute("Removed from colocated tablet at $0", LocalTimeAsString()));
+  RETURN_NOT_OK_PREPEND(sys_catalog_->UpdateItem(table, leader_ready_term_),
+                        "An error occurred while updating sys-tables");
+  l->Commit();
+
+  LOG(INFO) << "Colocated table " << table->ToString() << " removed from tablet "
+            << tablet->tablet_id();
+  return Status::OK();
+}
+
 // Helper class to commit TabletInfo mutations at the end of a scope.
 namespace {
 
@@ -4985,8 +5254,46 @@ Status CatalogManager::HandlePlacementUsingReplicationInfo(
     const ReplicationInfoPB& replication_info,
     const TSDescriptorVector& all_ts_descs,
     consensus::RaftConfigPB* config) {
-  return HandlePlacementUsingPlacementInfo(replication_info.live_replicas(),
-                                           all_ts_descs, RaftPeerPB::VOTER, config);
+  // Tablet servers of read replica clusters should never get voters, even when the live placement
+  // does not specify a placement uuid.
+  std::unordered_set<string> read_replica_uuids;
+  for (const auto& read_replica : replication_info.read_replicas()) {
+    read_replica_uuids.insert(read_replica.placement_uuid());
+  }
+  TSDescriptorVector live_ts_descs;
+  for (const auto& ts : all_ts_descs) {
+    if (TSManager::IsTsInCluster(ts, replication_info.live_replicas().placement_uuid()) &&
+        !read_replica_uuids.count(ts->placement_uuid())) {
+      live_ts_descs.push_back(ts);
+    }
+  }
+  RETURN_NOT_OK(HandlePlacementUsingPlacementInfo(replication_info.live_replicas(),
+                                                  live_ts_descs, RaftPeerPB::VOTER, config));
+
+  // Replicas of read replica clusters are added as observers. The leader ships them the log, but
+  // they do not vote and are not part of the majority, so they do not slow down writes.
+  // Read replicas are best effort, i.e. tablet is created even if they could not be placed, the
+  // missing ones could be added later with ADD_SERVER PRE_OBSERVER.
+  for (const auto& read_replica : replication_info.read_replicas()) {
+    TSDescriptorVector read_replica_ts_descs;
+    for (const auto& ts : all_ts_descs) {
+      if (ts->placement_uuid() == read_replica.placement_uuid()) {
+        read_replica_ts_descs.push_back(ts);
+      }
+    }
+    consensus::RaftConfigPB observers_config;
+    Status s = HandlePlacementUsingPlacementInfo(
+        read_replica, read_replica_ts_descs, RaftPeerPB::OBSERVER, &observers_config);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to place read replicas of cluster " << read_replica.placement_uuid()
+                   << ": " << s;
+      continue;
+    }
+    for (auto& peer : *observers_config.mutable_peers()) {
+      config->add_peers()->Swap(&peer);
+    }
+  }
+  return Status::OK();
 }
 
 Status CatalogManager::HandlePlacementUsingPlacementInfo(const PlacementInfoPB& placement_info,
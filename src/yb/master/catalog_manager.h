@@ -68,6 +68,7 @@
 #include "yb/util/status.h"
 #include "yb/gutil/thread_annotations.h"
 #include "yb/master/catalog_entity_info.h"
+#include "yb/master/follower_tablet_locations.h"
 #include "yb/master/scoped_leader_shared_lock.h"
 #include "yb/master/permissions_manager.h"
 
@@ -534,6 +535,10 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
     return permissions_manager_.get();
   }
 
+  FollowerTabletLocations* follower_tablet_locations() {
+    return follower_tablet_locations_.get();
+  }
+
  protected:
   // TODO Get rid of these friend classes and introduce formal interface.
   friend class TableLoader;
@@ -634,6 +639,18 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
                                           Schema schema,
                                           NamespaceId namespace_id);
 
+  // Helper for creating table in the shared tablet of colocated database.
+  CHECKED_STATUS CreateColocatedTable(const CreateTableRequestPB& req,
+                                      const Schema& schema,
+                                      const PartitionSchema& partition_schema,
+                                      const scoped_refptr<NamespaceInfo>& ns,
+                                      CreateTableResponsePB* resp,
+                                      rpc::RpcContext* rpc);
+
+  // Creates the table, that owns the shared tablet of colocated database.
+  CHECKED_STATUS CreateColocatedParentTable(const scoped_refptr<NamespaceInfo>& ns,
+                                            rpc::RpcContext* rpc);
+
   // Check that local host is present in master addresses for normal master process start.
   // On error, it could imply that master_addresses is incorrectly set for shell master startup
   // or that this master host info was missed in the master addresses and it should be
@@ -705,6 +722,10 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   void ExtractTabletsToProcess(TabletInfos *tablets_to_delete,
                                TabletInfos *tablets_to_process);
 
+  // Sends add or remove requests for colocated tables, that were not added to or removed from
+  // the shared tablet yet. For instance because requests were lost on master leader change.
+  void ProcessPendingColocatedTables();
+
   // Task that takes care of the tablet assignments/creations.
   // Loops through the "not created" tablets and sends a CreateTablet() request.
   CHECKED_STATUS ProcessPendingAssignments(const TabletInfos& tablets);
@@ -752,6 +773,12 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
 
   CHECKED_STATUS HandleTabletSchemaVersionReport(TabletInfo *tablet, uint32_t version);
 
+  // Marks colocated table as running, after it was added to the shared tablet.
+  CHECKED_STATUS HandleColocatedTableAdded(TableInfo* table);
+
+  // Marks colocated table as deleted, after it was removed from the shared tablet.
+  CHECKED_STATUS HandleColocatedTableRemoved(TabletInfo* tablet, TableInfo* table);
+
   // Send the create tablet requests to the selected peers of the consensus configurations.
   // The creation is async, and at the moment there is no error checking on the
   // caller side. We rely on the assignment timeout. If we don't see the tablet
@@ -776,6 +803,14 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   void SendCopartitionTabletRequest(const scoped_refptr<TabletInfo>& tablet,
                                     const scoped_refptr<TableInfo>& table);
 
+  // Start the background task to add colocated table to the shared tablet.
+  void SendAddTableToTabletRequest(const scoped_refptr<TabletInfo>& tablet,
+                                   const scoped_refptr<TableInfo>& table);
+
+  // Start the background task to remove colocated table from the shared tablet.
+  void SendRemoveTableFromTabletRequest(const scoped_refptr<TabletInfo>& tablet,
+                                        const scoped_refptr<TableInfo>& table);
+
   // Send the "truncate table request" to all tablets of the specified table.
   void SendTruncateTableRequest(const scoped_refptr<TableInfo>& table);
 
@@ -1001,6 +1036,8 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Async operations are accessing some private methods
   // (TODO: this stuff should be deferred and done in the background thread)
   friend class AsyncAlterTable;
+  friend class AsyncAddTableToTablet;
+  friend class AsyncRemoveTableFromTablet;
 
   // Number of live tservers metric.
   scoped_refptr<AtomicGauge<uint32_t>> metric_num_tablet_servers_live_;
@@ -1024,6 +1061,9 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
 
   std::unique_ptr<PermissionsManager> permissions_manager_;
 
+  // Tablet locations served while this master is a follower, null for masters without sys catalog.
+  std::unique_ptr<FollowerTabletLocations> follower_tablet_locations_;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(CatalogManager);
 };
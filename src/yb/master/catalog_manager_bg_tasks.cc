@@ -36,6 +36,7 @@
 
 #include "yb/master/catalog_manager_bg_tasks.h"
 #include "yb/master/catalog_manager.h"
+#include "yb/master/master.h"
 #include "yb/master/scoped_leader_shared_lock.h"
 #include "yb/master/ts_descriptor.h"
 #include "yb/master/cluster_balance.h"
@@ -98,6 +99,7 @@ void CatalogManagerBgTasks::Run() {
   while (!closing_.load()) {
     // Perform assignment processing.
     ScopedLeaderSharedLock l(catalog_manager_);
+    bool refresh_follower_tablet_locations = false;
     if (!l.catalog_status().ok()) {
       LOG(WARNING) << "Catalog manager background task thread going to sleep: "
                    << l.catalog_status().ToString();
@@ -121,6 +123,9 @@ void CatalogManagerBgTasks::Run() {
       // Get list of tablets not yet running or already replaced.
       catalog_manager_->ExtractTabletsToProcess(&to_delete, &to_process);
 
+      // Retry adding and removing tables of colocated databases.
+      catalog_manager_->ProcessPendingColocatedTables();
+
       if (!to_process.empty()) {
         // Transition tablet assignment state from preparing to creating, send
         // and schedule creation / deletion RPC messages, etc.
@@ -137,6 +142,9 @@ void CatalogManagerBgTasks::Run() {
       } else {
         catalog_manager_->load_balance_policy_->RunLoadBalancer();
       }
+    } else {
+      refresh_follower_tablet_locations = !catalog_manager_->master_->IsShellMode() &&
+                                          catalog_manager_->follower_tablet_locations();
     }
 
     // if (!to_delete.empty()) {
@@ -148,6 +156,12 @@ void CatalogManagerBgTasks::Run() {
     //  - HandleReportedTablet/ProcessPendingAssignments will call WakeIfHasPendingUpdates()
     //    to notify about tablets creation.
     l.Unlock();
+
+    // Done without the leader lock, so this master could become the leader meanwhile.
+    if (refresh_follower_tablet_locations) {
+      catalog_manager_->follower_tablet_locations()->MaybeRefresh();
+    }
+
     Wait(FLAGS_catalog_manager_bg_task_wait_ms);
   }
   VLOG(1) << "Catalog manager background task thread shutting down";
@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <unordered_set>
 
 #include <boost/thread/locks.hpp>
 
@@ -259,7 +260,16 @@ Status ClusterLoadBalancer::AnalyzeTablets(const TableId& table_uuid) {
   // assigned any tablets yet).
   TSDescriptorVector ts_descs;
   GetAllReportedDescriptors(&ts_descs);
+  // Tablet servers of read replica clusters host only observers, that are not balanced together
+  // with live replicas.
+  std::unordered_set<std::string> read_replica_uuids;
+  for (const auto& read_replica : GetClusterReplicationInfo().read_replicas()) {
+    read_replica_uuids.insert(read_replica.placement_uuid());
+  }
   for (const auto ts_desc : ts_descs) {
+    if (read_replica_uuids.count(ts_desc->placement_uuid())) {
+      continue;
+    }
     state_->UpdateTabletServer(ts_desc);
   }
 
@@ -825,6 +835,11 @@ const TableInfoMap& ClusterLoadBalancer::GetTableMap() const {
   return catalog_manager_->table_ids_map_;
 }
 
+const ReplicationInfoPB& ClusterLoadBalancer::GetClusterReplicationInfo() const {
+  auto l = catalog_manager_->cluster_config_->LockForRead();
+  return l->data().pb.replication_info();
+}
+
 const PlacementInfoPB& ClusterLoadBalancer::GetClusterPlacementInfo() const {
   auto l = catalog_manager_->cluster_config_->LockForRead();
   return l->data().pb.replication_info().live_replicas();
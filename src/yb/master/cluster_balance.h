@@ -103,6 +103,9 @@ class ClusterLoadBalancer {
   // Get the table info object for given table uuid.
   virtual const scoped_refptr<TableInfo> GetTableInfo(const TableId& table_uuid) const;
 
+  // Get the replication information from the cluster configuration.
+  virtual const ReplicationInfoPB& GetClusterReplicationInfo() const;
+
   // Get the placement information from the cluster configuration.
   virtual const PlacementInfoPB& GetClusterPlacementInfo() const;
 
@@ -249,6 +249,15 @@ class ClusterLoadState {
     // Get replicas for this tablet.
     TabletInfo::ReplicaMap replica_map;
     GetReplicaLocations(tablet, &replica_map);
+    // Observers belong to read replica clusters, so they are not counted against live placement.
+    for (auto it = replica_map.begin(); it != replica_map.end();) {
+      if (it->second.member_type == consensus::RaftPeerPB::OBSERVER ||
+          it->second.member_type == consensus::RaftPeerPB::PRE_OBSERVER) {
+        it = replica_map.erase(it);
+      } else {
+        ++it;
+      }
+    }
     // Set state information for both the tablet and the tablet server replicas.
     for (const auto& replica : replica_map) {
       const auto& ts_uuid = replica.first;
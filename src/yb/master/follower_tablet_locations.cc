@@ -0,0 +1,240 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/master/follower_tablet_locations.h"
+
+#include <unordered_set>
+
+#include "yb/consensus/quorum_util.h"
+#include "yb/master/catalog_entity_info.h"
+#include "yb/master/master_util.h"
+#include "yb/master/sys_catalog.h"
+#include "yb/master/sys_catalog-internal.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(master_follower_tablet_locations_refresh_interval_ms, 0,
+             "Interval at which master followers rebuild tablet locations from the sys catalog, "
+             "to serve GetTableLocations and GetTabletLocations requests. 0 to disable serving "
+             "tablet locations from followers.");
+TAG_FLAG(master_follower_tablet_locations_refresh_interval_ms, advanced);
+
+DEFINE_int32(master_follower_tablet_locations_max_staleness_ms, 10000,
+             "Tablet locations are not served by a master follower when they were rebuilt "
+             "earlier than this amount of time ago.");
+TAG_FLAG(master_follower_tablet_locations_max_staleness_ms, advanced);
+
+namespace yb {
+namespace master {
+
+class FollowerTabletLocations::TableVisitor : public Visitor<PersistentTableInfo> {
+ public:
+  explicit TableVisitor(Snapshot* snapshot) : snapshot_(snapshot) {}
+
+ protected:
+  CHECKED_STATUS Visit(const TableId& table_id, const SysTablesEntryPB& metadata) override {
+    if (metadata.state() == SysTablesEntryPB::RUNNING ||
+        metadata.state() == SysTablesEntryPB::ALTERING) {
+      snapshot_->tables[table_id].table_type = metadata.table_type();
+    }
+    return Status::OK();
+  }
+
+ private:
+  Snapshot* snapshot_;
+};
+
+class FollowerTabletLocations::TabletVisitor : public Visitor<PersistentTabletInfo> {
+ public:
+  explicit TabletVisitor(Snapshot* snapshot) : snapshot_(snapshot) {}
+
+  // Removes tables that could not be served, because some of their tablets are not running yet.
+  void RemoveIncompleteTables() {
+    for (const auto& table_id : incomplete_tables_) {
+      snapshot_->tables.erase(table_id);
+    }
+  }
+
+ protected:
+  CHECKED_STATUS Visit(const TabletId& tablet_id, const SysTabletsEntryPB& metadata) override {
+    if (metadata.state() == SysTabletsEntryPB::REPLACED ||
+        metadata.state() == SysTabletsEntryPB::DELETED) {
+      return Status::OK();
+    }
+
+    std::vector<TableId> table_ids(metadata.table_ids().begin(), metadata.table_ids().end());
+    if (table_ids.empty()) {
+      table_ids.push_back(metadata.table_id());
+    }
+
+    if (metadata.state() != SysTabletsEntryPB::RUNNING ||
+        !metadata.has_committed_consensus_state()) {
+      incomplete_tables_.insert(table_ids.begin(), table_ids.end());
+      return Status::OK();
+    }
+
+    TabletLocationsPB locs;
+    locs.set_tablet_id(tablet_id);
+    locs.set_table_id(metadata.table_id());
+    for (const auto& table_id : table_ids) {
+      locs.add_table_ids(table_id);
+    }
+    *locs.mutable_partition() = metadata.partition();
+    // Replicas are taken from the persisted consensus state, instead of tablet server reports.
+    locs.set_stale(true);
+
+    const auto& cstate = metadata.committed_consensus_state();
+    for (const consensus::RaftPeerPB& peer : cstate.config().peers()) {
+      if (!peer.has_permanent_uuid()) {
+        incomplete_tables_.insert(table_ids.begin(), table_ids.end());
+        return Status::OK();
+      }
+      auto* replica_pb = locs.add_replicas();
+      replica_pb->set_role(consensus::GetConsensusRole(peer.permanent_uuid(), cstate));
+      replica_pb->set_member_type(peer.has_member_type()
+          ? peer.member_type() : consensus::RaftPeerPB::UNKNOWN_MEMBER_TYPE);
+      TSInfoPB* tsinfo_pb = replica_pb->mutable_ts_info();
+      tsinfo_pb->set_permanent_uuid(peer.permanent_uuid());
+      CopyRegistration(peer, tsinfo_pb);
+    }
+
+    const auto* tablet_locs = &(snapshot_->tablets[tablet_id] = std::move(locs));
+    for (const auto& table_id : table_ids) {
+      auto it = snapshot_->tables.find(table_id);
+      if (it != snapshot_->tables.end()) {
+        it->second.tablets[metadata.partition().partition_key_start()] = tablet_locs;
+      }
+    }
+    return Status::OK();
+  }
+
+ private:
+  Snapshot* snapshot_;
+  std::unordered_set<TableId> incomplete_tables_;
+};
+
+FollowerTabletLocations::FollowerTabletLocations(SysCatalogTable* sys_catalog)
+    : sys_catalog_(sys_catalog) {
+}
+
+bool FollowerTabletLocations::Enabled() {
+  return FLAGS_master_follower_tablet_locations_refresh_interval_ms > 0;
+}
+
+void FollowerTabletLocations::MaybeRefresh() {
+  if (!Enabled()) {
+    return;
+  }
+
+  auto snapshot = std::atomic_load(&snapshot_);
+  if (snapshot && MonoTime::Now() < snapshot->refresh_time + MonoDelta::FromMilliseconds(
+          FLAGS_master_follower_tablet_locations_refresh_interval_ms)) {
+    return;
+  }
+
+  Status s = Refresh();
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to refresh follower tablet locations: " << s;
+  }
+}
+
+Status FollowerTabletLocations::Refresh() {
+  auto snapshot = std::make_shared<Snapshot>();
+  // Taken before reading the sys catalog, so the snapshot is never considered newer than it is.
+  snapshot->refresh_time = MonoTime::Now();
+
+  TableVisitor table_visitor(snapshot.get());
+  RETURN_NOT_OK(sys_catalog_->Visit(&table_visitor));
+  TabletVisitor tablet_visitor(snapshot.get());
+  RETURN_NOT_OK(sys_catalog_->Visit(&tablet_visitor));
+  tablet_visitor.RemoveIncompleteTables();
+
+  VLOG(1) << "Refreshed follower tablet locations: " << snapshot->tables.size() << " tables, "
+          << snapshot->tablets.size() << " tablets";
+  std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+  return Status::OK();
+}
+
+std::shared_ptr<const FollowerTabletLocations::Snapshot>
+    FollowerTabletLocations::FreshSnapshot() const {
+  if (!Enabled()) {
+    return nullptr;
+  }
+  auto snapshot = std::atomic_load(&snapshot_);
+  if (!snapshot || snapshot->refresh_time + MonoDelta::FromMilliseconds(
+          FLAGS_master_follower_tablet_locations_max_staleness_ms) < MonoTime::Now()) {
+    return nullptr;
+  }
+  return snapshot;
+}
+
+bool FollowerTabletLocations::GetTableLocations(const GetTableLocationsRequestPB* req,
+                                                GetTableLocationsResponsePB* resp) const {
+  // Invalid requests are left to the leader, so the error is reported the same way.
+  if (!req->table().has_table_id() || req->max_returned_locations() <= 0 ||
+      (req->has_partition_key_start() && req->has_partition_key_end() &&
+       req->partition_key_start() > req->partition_key_end())) {
+    return false;
+  }
+
+  auto snapshot = FreshSnapshot();
+  if (!snapshot) {
+    return false;
+  }
+  auto table_it = snapshot->tables.find(req->table().table_id());
+  if (table_it == snapshot->tables.end() || table_it->second.tablets.empty()) {
+    return false;
+  }
+
+  // Same range semantics as TableInfo::GetTabletsInRange.
+  const auto& tablets = table_it->second.tablets;
+  auto it = tablets.begin();
+  if (req->has_partition_key_start()) {
+    it = tablets.upper_bound(req->partition_key_start());
+    if (it != tablets.begin()) {
+      --it;
+    }
+  }
+  auto it_end = req->has_partition_key_end() ? tablets.upper_bound(req->partition_key_end())
+                                             : tablets.end();
+  for (int32_t count = 0; it != it_end && count < req->max_returned_locations(); ++it, ++count) {
+    *resp->add_tablet_locations() = *it->second;
+  }
+  resp->set_table_type(table_it->second.table_type);
+  return true;
+}
+
+bool FollowerTabletLocations::GetTabletLocations(const GetTabletLocationsRequestPB* req,
+                                                 GetTabletLocationsResponsePB* resp) const {
+  auto snapshot = FreshSnapshot();
+  if (!snapshot || req->tablet_ids().empty()) {
+    return false;
+  }
+
+  std::vector<const TabletLocationsPB*> locations;
+  locations.reserve(req->tablet_ids_size());
+  for (const auto& tablet_id : req->tablet_ids()) {
+    auto it = snapshot->tablets.find(tablet_id);
+    if (it == snapshot->tablets.end()) {
+      return false;
+    }
+    locations.push_back(&it->second);
+  }
+
+  for (const auto* locs : locations) {
+    *resp->add_tablet_locations() = *locs;
+  }
+  return true;
+}
+
+} // namespace master
+} // namespace yb
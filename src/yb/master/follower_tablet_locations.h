@@ -0,0 +1,90 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_MASTER_FOLLOWER_TABLET_LOCATIONS_H
+#define YB_MASTER_FOLLOWER_TABLET_LOCATIONS_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "yb/common/entity_ids.h"
+#include "yb/master/master.pb.h"
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace master {
+
+class SysCatalogTable;
+
+// Tablet locations served by a master follower, so that clients warming up their meta cache
+// could spread lookups across all masters instead of sending all of them to the leader.
+//
+// Followers do not receive tablet server heartbeats and do not load the catalog into memory, so
+// the snapshot is periodically rebuilt from the replicated sys catalog, using committed consensus
+// states of the tablets. All locations are reported as stale, and the snapshot is not used when
+// it is older than FLAGS_master_follower_tablet_locations_max_staleness_ms. Clients handle
+// outdated locations the same way as for the leader, i.e. by refreshing them on failure.
+class FollowerTabletLocations {
+ public:
+  explicit FollowerTabletLocations(SysCatalogTable* sys_catalog);
+
+  // Whether followers are configured to serve tablet locations.
+  static bool Enabled();
+
+  // Rebuilds the snapshot if the refresh interval has elapsed since the last refresh.
+  void MaybeRefresh();
+
+  CHECKED_STATUS Refresh();
+
+  // Fill the response using the current snapshot. Returns false if the request could not be
+  // served by this follower, then it should be handled by the leader.
+  bool GetTableLocations(const GetTableLocationsRequestPB* req,
+                         GetTableLocationsResponsePB* resp) const;
+  bool GetTabletLocations(const GetTabletLocationsRequestPB* req,
+                          GetTabletLocationsResponsePB* resp) const;
+
+ private:
+  struct TableLocations {
+    TableType table_type;
+
+    // Locations of the table tablets, indexed by partition key start.
+    std::map<std::string, const TabletLocationsPB*> tablets;
+  };
+
+  struct Snapshot {
+    MonoTime refresh_time;
+    std::unordered_map<TableId, TableLocations> tables;
+    std::unordered_map<TabletId, TabletLocationsPB> tablets;
+  };
+
+  // Returns the current snapshot, or nullptr if it is absent or too old to be served.
+  std::shared_ptr<const Snapshot> FreshSnapshot() const;
+
+  class TableVisitor;
+  class TabletVisitor;
+
+  SysCatalogTable* const sys_catalog_;
+
+  // Accessed via atomic_load/atomic_store only.
+  std::shared_ptr<const Snapshot> snapshot_;
+
+  DISALLOW_COPY_AND_ASSIGN(FollowerTabletLocations);
+};
+
+} // namespace master
+} // namespace yb
+
+#endif // YB_MASTER_FOLLOWER_TABLET_LOCATIONS_H
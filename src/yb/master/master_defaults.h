@@ -54,6 +54,10 @@ static const char* const kSystemAuthRolePermissionsTableName = "role_permissions
 static const char* const kSystemAuthResourceRolePermissionsIndexTableName =
                   "resource_role_permissions_index";
 
+// Suffixes of id and name of the table, that owns the shared tablet of colocated database.
+static const char* const kColocatedParentTableIdSuffix = ".colocated.parent.uuid";
+static const char* const kColocatedParentTableNameSuffix = ".colocated.parent.tablename";
+
 static const char* const kDefaultSchemaVersion = "00000000-0000-0000-0000-000000000000";
 
 // Needs to be updated each time we add a new system namespace.
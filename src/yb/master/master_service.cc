@@ -41,6 +41,7 @@
 #include "yb/common/wire_protocol.h"
 #include "yb/master/catalog_manager-internal.h"
 #include "yb/master/flush_manager.h"
+#include "yb/master/follower_tablet_locations.h"
 #include "yb/master/master_service_base-internal.h"
 #include "yb/master/master.h"
 #include "yb/master/ts_descriptor.h"
@@ -82,6 +83,12 @@ static void SetupErrorAndRespond(MasterErrorPB* error,
   rpc->RespondSuccess();
 }
 
+// The leader always serves up to date locations, so the follower snapshot is used only when this
+// master is initialized and is not the leader.
+static bool ServeFromFollower(const CatalogManager::ScopedLeaderSharedLock& l) {
+  return l.catalog_status().ok() && !l.leader_status().ok();
+}
+
 MasterServiceImpl::MasterServiceImpl(Master* server)
   : MasterServiceIf(server->metric_entity()),
     MasterServiceBase(server) {
@@ -202,6 +209,11 @@ void MasterServiceImpl::GetTabletLocations(const GetTabletLocationsRequestPB* re
                                            GetTabletLocationsResponsePB* resp,
                                            RpcContext rpc) {
   CatalogManager::ScopedLeaderSharedLock l(server_->catalog_manager());
+  if (FollowerTabletLocations::Enabled() && ServeFromFollower(l) &&
+      server_->catalog_manager()->follower_tablet_locations()->GetTabletLocations(req, resp)) {
+    rpc.RespondSuccess();
+    return;
+  }
   if (!l.CheckIsInitializedAndIsLeaderOrRespond(resp, &rpc)) {
     return;
   }
@@ -302,6 +314,15 @@ void MasterServiceImpl::ListTables(const ListTablesRequestPB* req,
 void MasterServiceImpl::GetTableLocations(const GetTableLocationsRequestPB* req,
                                           GetTableLocationsResponsePB* resp,
                                           RpcContext rpc) {
+  if (FollowerTabletLocations::Enabled()) {
+    CatalogManager::ScopedLeaderSharedLock l(server_->catalog_manager());
+    if (ServeFromFollower(l) &&
+        server_->catalog_manager()->follower_tablet_locations()->GetTableLocations(req, resp)) {
+      rpc.RespondSuccess();
+      return;
+    }
+  }
+
   HandleOnLeader(req, resp, &rpc, [&]() -> Status {
     if (PREDICT_FALSE(FLAGS_master_inject_latency_on_tablet_lookups_ms > 0)) {
       SleepFor(MonoDelta::FromMilliseconds(FLAGS_master_inject_latency_on_tablet_lookups_ms));
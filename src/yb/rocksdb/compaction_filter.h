@@ -146,6 +146,19 @@ class CompactionFilter {
   virtual const char* Name() const = 0;
 };
 
+// CompactionFileFilter allows an application to drop whole SST files without rewriting them,
+// for instance when all their records are known to be expired. The decision is made using only
+// file metadata, i.e. the boundary values stored in the MANIFEST.
+class CompactionFileFilter {
+ public:
+  virtual ~CompactionFileFilter() {}
+
+  // Returns true if all records of the file with specified boundary values could be dropped.
+  // Only the oldest files are checked, so dropping them could not expose older records.
+  virtual bool Expired(const FileBoundaryValuesBase& smallest,
+                       const FileBoundaryValuesBase& largest) = 0;
+};
+
 // Each compaction will create a new CompactionFilter allowing the
 // application to know about different compactions
 class CompactionFilterFactory {
@@ -155,6 +168,19 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Creates a filter that is used by compaction picker to find files that could be deleted
+  // without compaction. Returns nullptr when there are no such files.
+  virtual std::unique_ptr<CompactionFileFilter> CreateCompactionFileFilter() {
+    return nullptr;
+  }
+
+  // Returns size of the prefix of user_key, such that all keys with this prefix should be
+  // processed by the same compaction filter, e.g. because the filter keeps state across them.
+  // Boundaries of subcompactions are truncated to such prefixes.
+  virtual size_t SubcompactionBoundaryPrefixSize(const Slice& user_key) {
+    return user_key.size();
+  }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
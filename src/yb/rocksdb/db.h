@@ -877,7 +877,12 @@ class DB {
   // Needed for StackableDB
   virtual DB* GetRootDB() { return this; }
 
-  virtual CHECKED_STATUS Import(const std::string& source_dir) {
+  virtual CHECKED_STATUS Import(
+      const std::string& source_dir, UserFrontierPtr flushed_frontier = nullptr) {
+    return STATUS(NotSupported, "");
+  }
+
+  virtual CHECKED_STATUS ValidateImport(const std::string& source_dir) {
     return STATUS(NotSupported, "");
   }
 
@@ -534,7 +534,9 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    // With a single level, outputs of subcompactions are placed to level 0. They have overlapping
+    // seqno ranges, so universal compaction picker treats them as one sorted run.
+    return number_levels_ == 1 || output_level_ > 0;
   } else {
     return false;
   }
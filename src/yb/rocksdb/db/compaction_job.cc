@@ -29,7 +29,9 @@
 
 #include <inttypes.h>
 #include <algorithm>
+#include <climits>
 #include <functional>
+#include <iterator>
 #include <vector>
 #include <memory>
 #include <list>
@@ -49,9 +51,11 @@
 #include "yb/rocksdb/db/memtable_list.h"
 #include "yb/rocksdb/db/merge_context.h"
 #include "yb/rocksdb/db/merge_helper.h"
+#include "yb/rocksdb/db/table_cache.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/port/likely.h"
 #include "yb/rocksdb/port/port.h"
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/statistics.h"
@@ -60,6 +64,7 @@
 #include "yb/rocksdb/table/block.h"
 #include "yb/rocksdb/table/block_based_table_factory.h"
 #include "yb/rocksdb/table/merger.h"
+#include "yb/rocksdb/table/table_reader.h"
 #include "yb/rocksdb/table/table_builder.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
@@ -120,6 +125,8 @@ struct CompactionJob::SubcompactionState {
   uint64_t num_output_records;
   CompactionJobStats compaction_job_stats;
   uint64_t approx_size;
+  // Frontier provided by compaction filter of this subcompaction.
+  UserFrontierPtr largest_user_frontier;
 
   SubcompactionState(Compaction* c, Slice* _start, Slice* _end,
                      uint64_t size = 0)
@@ -152,6 +159,7 @@ struct CompactionJob::SubcompactionState {
     num_output_records = std::move(o.num_output_records);
     compaction_job_stats = std::move(o.compaction_job_stats);
     approx_size = std::move(o.approx_size);
+    largest_user_frontier = std::move(o.largest_user_frontier);
     return *this;
   }
 
@@ -393,6 +401,11 @@ void CompactionJob::GenSubcompactionBoundaries() {
           bounds.emplace_back(flevel->files[i].smallest.key);
           bounds.emplace_back(flevel->files[i].largest.key);
         }
+        if (c->number_levels() == 1) {
+          // With a single level all files usually cover the whole key range, so their
+          // boundaries do not split the compaction. Keys sampled from data index are used instead.
+          SampleLevel0Keys(*flevel);
+        }
       } else {
         // For all other levels add the smallest/largest key in the level to
         // encompass the range covered by that level
@@ -411,6 +424,10 @@ void CompactionJob::GenSubcompactionBoundaries() {
     }
   }
 
+  for (const auto& key : sample_keys_) {
+    bounds.emplace_back(key);
+  }
+
   std::sort(bounds.begin(), bounds.end(),
     [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
       return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) < 0;
@@ -442,9 +459,15 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   // Group the ranges into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
+  const auto* mutable_cf_options = cfd->GetCurrentMutableCFOptions();
+  uint64_t max_file_size = mutable_cf_options->MaxFileSizeForLevel(out_lvl);
+  if (max_file_size == ULLONG_MAX) {
+    // Output files of this level are not limited by size, so target file size is used as
+    // a minimal size of a subcompaction.
+    max_file_size = std::max<uint64_t>(mutable_cf_options->target_file_size_base, 1);
+  }
   uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+      sum / min_file_fill_percent / max_file_size));
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -454,6 +477,7 @@ void CompactionJob::GenSubcompactionBoundaries() {
                                     : std::numeric_limits<double>::max();
 
   if (subcompactions > 1) {
+    auto* filter_factory = cfd->ioptions()->compaction_filter_factory;
     // Greedily add ranges to the subcompaction until the sum of the ranges'
     // sizes becomes >= the expected mean size of a subcompaction
     sum = 0;
@@ -465,7 +489,16 @@ void CompactionJob::GenSubcompactionBoundaries() {
         continue;
       }
       if (sum >= mean) {
-        boundaries_.emplace_back(ExtractUserKey(ranges[i].range.limit));
+        Slice boundary = ExtractUserKey(ranges[i].range.limit);
+        if (filter_factory) {
+          // Keys that should be processed by the same compaction filter are not split.
+          boundary = Slice(
+              boundary.data(), filter_factory->SubcompactionBoundaryPrefixSize(boundary));
+          if (!boundaries_.empty() && cfd_comparator->Compare(boundaries_.back(), boundary) >= 0) {
+            continue;
+          }
+        }
+        boundaries_.emplace_back(boundary);
         sizes_.emplace_back(sum);
         subcompactions--;
         sum = 0;
@@ -478,6 +511,39 @@ void CompactionJob::GenSubcompactionBoundaries() {
   }
 }
 
+void CompactionJob::SampleLevel0Keys(const LevelFilesBrief& files) {
+  auto* cfd = compact_->compaction->column_family_data();
+  uint64_t total_size = 0;
+  for (size_t i = 0; i < files.num_files; i++) {
+    total_size += files.files[i].fd.GetTotalFileSize();
+  }
+  if (total_size == 0) {
+    return;
+  }
+  // Number of samples per file is proportional to its size, several samples per subcompaction
+  // allow to balance subcompactions better.
+  constexpr uint64_t kSamplesPerSubcompaction = 4;
+  const uint64_t total_samples = kSamplesPerSubcompaction * db_options_.max_subcompactions;
+  for (size_t i = 0; i < files.num_files; i++) {
+    const auto& fd = files.files[i].fd;
+    const uint64_t num_samples = total_samples * fd.GetTotalFileSize() / total_size;
+    if (num_samples == 0) {
+      continue;
+    }
+    TableCache::TableReaderWithHandle trwh;
+    Status s = cfd->table_cache()->GetTableReaderForIterator(
+        ReadOptions(), env_options_, cfd->internal_comparator(), fd, &trwh);
+    if (!s.ok()) {
+      RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+          "[%s] [JOB %d] Failed to sample keys of file %" PRIu64 ": %s",
+          cfd->GetName().c_str(), job_id_, fd.GetNumber(), s.ToString().c_str());
+      continue;
+    }
+    auto samples = trwh.table_reader->GetSampleKeys(num_samples);
+    std::move(samples.begin(), samples.end(), std::back_inserter(sample_keys_));
+  }
+}
+
 Result<FileNumbersHolder> CompactionJob::Run() {
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_COMPACTION_RUN);
@@ -656,7 +722,7 @@ void CompactionJob::ProcessKeyValueCompaction(
   if (compaction_filter) {
     // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
     // filter.
-    largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
+    sub_compact->largest_user_frontier = compaction_filter->GetLargestUserFrontier();
   }
 
   MergeHelper merge(
@@ -968,13 +1034,19 @@ Status CompactionJob::InstallCompactionResults(
   // Add compaction outputs
   compaction->AddInputDeletions(compaction->edit());
 
+  UserFrontierPtr largest_user_frontier;
   for (const auto& sub_compact : compact_->sub_compact_states) {
     for (const auto& out : sub_compact.outputs) {
       compaction->edit()->AddFile(compaction->output_level(), out.meta);
     }
+    if (sub_compact.largest_user_frontier) {
+      UpdateUserFrontier(
+          &largest_user_frontier, sub_compact.largest_user_frontier,
+          UpdateUserValueType::kLargest);
+    }
   }
-  if (largest_user_frontier_) {
-    compaction->edit()->UpdateFlushedFrontier(largest_user_frontier_);
+  if (largest_user_frontier) {
+    compaction->edit()->UpdateFlushedFrontier(largest_user_frontier);
   }
   return versions_->LogAndApply(compaction->column_family_data(),
                                 mutable_cf_options, compaction->edit(),
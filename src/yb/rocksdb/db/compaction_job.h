@@ -110,6 +110,8 @@ class CompactionJob {
 
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
+  // Adds keys sampled from data index of level 0 input files to sample_keys_.
+  void SampleLevel0Keys(const LevelFilesBrief& files);
 
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
@@ -185,8 +187,8 @@ class CompactionJob {
   std::vector<Slice> boundaries_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
-
-  UserFrontierPtr largest_user_frontier_;
+  // Stores keys sampled from data index of input files, that could be referenced by boundaries_.
+  std::vector<std::string> sample_keys_;
 };
 
 }  // namespace rocksdb
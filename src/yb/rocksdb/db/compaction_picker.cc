@@ -28,6 +28,7 @@
 
 #include <inttypes.h>
 
+#include <algorithm>
 #include <limits>
 #include <queue>
 #include <string>
@@ -35,8 +36,10 @@
 
 #include <gflags/gflags.h>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/column_family.h"
 #include "yb/rocksdb/db/filename.h"
+#include "yb/rocksdb/db/version_builder.h"
 #include "yb/rocksdb/util/log_buffer.h"
 #include "yb/rocksdb/util/random.h"
 #include "yb/rocksdb/util/statistics.h"
@@ -1148,20 +1151,49 @@ bool LevelCompactionPicker::PickCompactionBySize(VersionStorageInfo* vstorage,
 bool UniversalCompactionPicker::NeedsCompaction(
     const VersionStorageInfo* vstorage) const {
   const int kLevel0 = 0;
-  return vstorage->CompactionScore(kLevel0) >= 1;
+  if (vstorage->CompactionScore(kLevel0) >= 1) {
+    return true;
+  }
+  // Expired files do not contribute to the compaction score, but should be deleted without waiting
+  // for enough sorted runs to trigger a regular compaction.
+  auto file_filter = CreateExpiredFilesFilter(*vstorage);
+  if (!file_filter) {
+    return false;
+  }
+  const FileMetaData* oldest = vstorage->LevelFiles(kLevel0).back();
+  return file_filter->Expired(oldest->smallest, oldest->largest);
+}
+
+std::unique_ptr<CompactionFileFilter> UniversalCompactionPicker::CreateExpiredFilesFilter(
+    const VersionStorageInfo& vstorage) const {
+  if (ioptions_.compaction_filter_factory == nullptr) {
+    return nullptr;
+  }
+  // Files of other levels are older than level 0 files, and could contain records hidden by
+  // expired records of level 0.
+  for (int level = 1; level < vstorage.num_levels(); ++level) {
+    if (!vstorage.LevelFiles(level).empty()) {
+      return nullptr;
+    }
+  }
+  const std::vector<FileMetaData*>& level_files = vstorage.LevelFiles(0);
+  if (level_files.empty() || level_files.back()->being_compacted) {
+    return nullptr;
+  }
+  return ioptions_.compaction_filter_factory->CreateCompactionFileFilter();
 }
 
 struct UniversalCompactionPicker::SortedRun {
-  SortedRun(int _level, FileMetaData* _file, uint64_t _size,
+  SortedRun(int _level, std::vector<FileMetaData*> _files, uint64_t _size,
             uint64_t _compensated_file_size, bool _being_compacted)
       : level(_level),
-        file(_file),
+        files(std::move(_files)),
         size(_size),
         compensated_file_size(_compensated_file_size),
         being_compacted(_being_compacted) {
     assert(compensated_file_size > 0);
-    // Allowed either one of level and file.
-    assert((level != 0) != (file != nullptr));
+    // Allowed either one of level and files.
+    assert((level != 0) != !files.empty());
   }
 
   void Dump(char* out_buf, size_t out_buf_size,
@@ -1172,12 +1204,16 @@ struct UniversalCompactionPicker::SortedRun {
                     size_t sorted_run_count) const;
 
   int level;
-  // `file` Will be null for level > 0. For level = 0, the sorted run is
-  // for this file.
-  FileMetaData* file;
+  // `files` will be empty for level > 0. For level = 0, the sorted run is
+  // for these files. There are several files, when they were produced by
+  // one compaction split into subcompactions. Such files have overlapping
+  // seqno ranges and disjoint key ranges, so they are always compacted together.
+  std::vector<FileMetaData*> files;
   // For level > 0, `size` and `compensated_file_size` are sum of sizes all
   // files in the level. `being_compacted` should be the same for all files
   // in a non-zero level. Use the value here.
+  // For level = 0, they are sum of sizes of `files`, and `being_compacted` is
+  // set if any of `files` is being compacted.
   uint64_t size;
   uint64_t compensated_file_size;
   bool being_compacted;
@@ -1187,14 +1223,20 @@ void UniversalCompactionPicker::SortedRun::Dump(char* out_buf,
                                                 size_t out_buf_size,
                                                 bool print_path) const {
   if (level == 0) {
-    assert(file != nullptr);
+    assert(!files.empty());
+    const FileMetaData* file = files.front();
+    int written;
     if (file->fd.GetPathId() == 0 || !print_path) {
-      snprintf(out_buf, out_buf_size, "file %" PRIu64, file->fd.GetNumber());
+      written = snprintf(out_buf, out_buf_size, "file %" PRIu64, file->fd.GetNumber());
     } else {
-      snprintf(out_buf, out_buf_size, "file %" PRIu64
-                                      "(path "
-                                      "%" PRIu32 ")",
-               file->fd.GetNumber(), file->fd.GetPathId());
+      written = snprintf(out_buf, out_buf_size, "file %" PRIu64
+                                                "(path "
+                                                "%" PRIu32 ")",
+                         file->fd.GetNumber(), file->fd.GetPathId());
+    }
+    if (files.size() > 1 && written >= 0 && static_cast<size_t>(written) < out_buf_size) {
+      snprintf(out_buf + written, out_buf_size - written, "(+%" ROCKSDB_PRIszt " files)",
+               files.size() - 1);
     }
   } else {
     snprintf(out_buf, out_buf_size, "level %d", level);
@@ -1204,13 +1246,13 @@ void UniversalCompactionPicker::SortedRun::Dump(char* out_buf,
 void UniversalCompactionPicker::SortedRun::DumpSizeInfo(
     char* out_buf, size_t out_buf_size, size_t sorted_run_count) const {
   if (level == 0) {
-    assert(file != nullptr);
+    assert(!files.empty());
     snprintf(out_buf, out_buf_size,
-             "file %" PRIu64 "[%" ROCKSDB_PRIszt
+             "file %" PRIu64 "(+%" ROCKSDB_PRIszt " files)[%" ROCKSDB_PRIszt
              "] "
              "with size %" PRIu64 " (compensated size %" PRIu64 ")",
-             file->fd.GetNumber(), sorted_run_count, file->fd.GetTotalFileSize(),
-             file->compensated_file_size);
+             files.front()->fd.GetNumber(), files.size() - 1, sorted_run_count, size,
+             compensated_file_size);
   } else {
     snprintf(out_buf, out_buf_size,
              "level %d[%" ROCKSDB_PRIszt
@@ -1225,10 +1267,27 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
                                                    const ImmutableCFOptions& ioptions,
                                                    uint64_t max_file_size) {
   std::vector<std::vector<SortedRun>> ret(1);
-  for (FileMetaData* f : vstorage.LevelFiles(0)) {
-    if (f->fd.GetTotalFileSize() <= max_file_size) {
-      ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
-          f->being_compacted);
+  const auto& level0_files = vstorage.LevelFiles(0);
+  for (size_t i = 0; i != level0_files.size();) {
+    // Level 0 files are sorted by seqno from newest to oldest, so files with overlapping seqno
+    // ranges, i.e. outputs of one compaction split into subcompactions, are adjacent.
+    std::vector<FileMetaData*> files;
+    SequenceNumber smallest_seqno = level0_files[i]->smallest.seqno;
+    uint64_t size = 0;
+    uint64_t compensated_file_size = 0;
+    bool being_compacted = false;
+    do {
+      FileMetaData* f = level0_files[i];
+      files.push_back(f);
+      smallest_seqno = std::min(smallest_seqno, f->smallest.seqno);
+      size += f->fd.GetTotalFileSize();
+      compensated_file_size += f->compensated_file_size;
+      being_compacted = being_compacted || f->being_compacted;
+      ++i;
+    } while (i != level0_files.size() && level0_files[i]->largest.seqno >= smallest_seqno);
+
+    if (size <= max_file_size) {
+      ret.back().emplace_back(0, std::move(files), size, compensated_file_size, being_compacted);
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
     // a row. So we just don't start new sequence in this case.
     } else if (!ret.back().empty()) {
@@ -1262,7 +1321,9 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
       }
     }
     if (total_compensated_size > 0) {
-      ret.back().emplace_back(level, nullptr, total_size, total_compensated_size, being_compacted);
+      ret.back().emplace_back(
+          level, std::vector<FileMetaData*>(), total_size, total_compensated_size,
+          being_compacted);
     }
   }
 
@@ -1353,6 +1414,14 @@ Compaction* UniversalCompactionPicker::PickCompaction(
     const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage,
     LogBuffer* log_buffer) {
+  // Deleting expired files is cheap and makes following compactions smaller, so it goes first.
+  Compaction* expired = PickCompactionUniversalExpiredFiles(
+      cf_name, mutable_cf_options, vstorage, log_buffer);
+  if (expired != nullptr) {
+    level0_compactions_in_progress_.insert(expired);
+    return expired;
+  }
+
   std::vector<std::vector<SortedRun>> sorted_runs = CalculateSortedRuns(
       *vstorage,
       ioptions_,
@@ -1453,14 +1522,19 @@ Compaction* UniversalCompactionPicker::DoPickCompaction(
 
   size_t level_index = 0U;
   if (c->start_level() == 0) {
+    FileMetaData* prev = nullptr;
     for (auto f : *c->inputs(0)) {
       DCHECK_LE(f->smallest.seqno, f->largest.seqno);
       if (is_first) {
         is_first = false;
+        prev_smallest_seqno = f->smallest.seqno;
       } else {
-        DCHECK_GT(prev_smallest_seqno, f->largest.seqno);
+        // Files of one sorted run could have overlapping seqno ranges, so we only check that
+        // files are picked in the level order.
+        DCHECK(!NewestFirstBySeqNo(f, prev));
+        prev_smallest_seqno = std::min(prev_smallest_seqno, f->smallest.seqno);
       }
-      prev_smallest_seqno = f->smallest.seqno;
+      prev = f;
     }
     level_index = 1U;
   }
@@ -1494,6 +1568,42 @@ Compaction* UniversalCompactionPicker::DoPickCompaction(
   return c;
 }
 
+Compaction* UniversalCompactionPicker::PickCompactionUniversalExpiredFiles(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, LogBuffer* log_buffer) {
+  auto file_filter = CreateExpiredFilesFilter(*vstorage);
+  if (!file_filter) {
+    return nullptr;
+  }
+  const std::vector<FileMetaData*>& level_files = vstorage->LevelFiles(0);
+
+  std::vector<CompactionInputFiles> inputs(1);
+  inputs[0].level = 0;
+  // Level 0 files are sorted from newest to oldest. Only a sequence of the oldest files could be
+  // deleted, otherwise records of older files that were overwritten by expired records would
+  // become visible again.
+  for (auto ritr = level_files.rbegin(); ritr != level_files.rend(); ++ritr) {
+    auto f = *ritr;
+    if (f->being_compacted || !file_filter->Expired(f->smallest, f->largest)) {
+      break;
+    }
+    inputs[0].files.push_back(f);
+    char tmp_fsize[16];
+    AppendHumanBytes(f->fd.GetTotalFileSize(), tmp_fsize, sizeof(tmp_fsize));
+    LOG_TO_BUFFER(log_buffer, "[%s] Universal: picking expired file %" PRIu64
+                              " with size %s for deletion",
+                  cf_name.c_str(), f->fd.GetNumber(), tmp_fsize);
+  }
+  if (inputs[0].files.empty()) {
+    return nullptr;
+  }
+
+  return new Compaction(
+      vstorage, mutable_cf_options, std::move(inputs), 0, 0, 0, 0,
+      kNoCompression, {}, /* is manual */ false, vstorage->CompactionScore(0),
+      /* is deletion compaction */ true, CompactionReason::kUniversalExpiredFiles);
+}
+
 uint32_t UniversalCompactionPicker::GetPathId(
     const ImmutableCFOptions& ioptions, uint64_t file_size) {
   // Two conditions need to be satisfied:
@@ -1688,8 +1798,8 @@ Compaction* UniversalCompactionPicker::PickCompactionUniversalReadAmp(
   for (size_t i = start_index; i < first_index_after; i++) {
     auto& picking_sr = sorted_runs[i];
     if (picking_sr.level == 0) {
-      FileMetaData* picking_file = picking_sr.file;
-      inputs[0].files.push_back(picking_file);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1814,8 +1924,8 @@ Compaction* UniversalCompactionPicker::PickCompactionUniversalSizeAmp(
   for (size_t loop = start_index; loop < sorted_runs.size(); loop++) {
     auto& picking_sr = sorted_runs[loop];
     if (picking_sr.level == 0) {
-      FileMetaData* f = picking_sr.file;
-      inputs[0].files.push_back(f);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -44,6 +44,7 @@ namespace rocksdb {
 
 class LogBuffer;
 class Compaction;
+class CompactionFileFilter;
 class VersionStorageInfo;
 struct CompactionInputFiles;
 
@@ -273,6 +274,16 @@ class UniversalCompactionPicker : public CompactionPicker {
       unsigned int num_files, const std::vector<SortedRun>& sorted_runs,
       LogBuffer* log_buffer);
 
+  // Returns filter to check the oldest level 0 files for expiration, or nullptr when expired files
+  // could not be deleted without compaction.
+  std::unique_ptr<CompactionFileFilter> CreateExpiredFilesFilter(
+      const VersionStorageInfo& vstorage) const;
+
+  // Pick the oldest files, all records of which expired, to be deleted without compaction.
+  Compaction* PickCompactionUniversalExpiredFiles(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage, LogBuffer* log_buffer);
+
   // Pick Universal compaction to limit space amplification.
   Compaction* PickCompactionUniversalSizeAmp(
       const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
@@ -21,9 +21,11 @@
 #include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/compaction_picker.h"
 #include <limits>
+#include <set>
 #include <string>
 #include <utility>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/util/logging.h"
 #include "yb/util/string_util.h"
 #include "yb/rocksdb/util/testharness.h"
@@ -474,6 +476,140 @@ TEST_F(CompactionPickerTest, AllowsTrivialMoveUniversal) {
   ASSERT_TRUE(compaction->is_trivial_move());
 }
 
+namespace {
+
+// Treats files with specified largest sequence numbers as expired.
+class ExpiredFilesFilterFactory : public CompactionFilterFactory {
+ public:
+  explicit ExpiredFilesFilterFactory(std::set<SequenceNumber> expired)
+      : expired_(std::move(expired)) {}
+
+  std::unique_ptr<CompactionFilter> CreateCompactionFilter(
+      const CompactionFilter::Context& context) override {
+    return nullptr;
+  }
+
+  std::unique_ptr<CompactionFileFilter> CreateCompactionFileFilter() override {
+    return std::make_unique<FileFilter>(&expired_);
+  }
+
+  const char* Name() const override { return "ExpiredFilesFilterFactory"; }
+
+ private:
+  class FileFilter : public CompactionFileFilter {
+   public:
+    explicit FileFilter(const std::set<SequenceNumber>* expired) : expired_(expired) {}
+
+    bool Expired(const FileBoundaryValuesBase& smallest,
+                 const FileBoundaryValuesBase& largest) override {
+      return expired_->count(largest.seqno) != 0;
+    }
+
+   private:
+    const std::set<SequenceNumber>* expired_;
+  };
+
+  std::set<SequenceNumber> expired_;
+};
+
+} // namespace
+
+TEST_F(CompactionPickerTest, UniversalExpiredFiles) {
+  const uint64_t kFileSize = 100000;
+
+  // File 2 is expired, but it is newer than file 3, so only file 4 could be deleted.
+  ExpiredFilesFilterFactory filter_factory({199, 399});
+  ioptions_.compaction_filter_factory = &filter_factory;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, icmp_.get());
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  Add(0, 1U, "150", "200", kFileSize, 0, 400, 499);
+  Add(0, 2U, "201", "250", kFileSize, 0, 300, 399);
+  Add(0, 3U, "251", "300", kFileSize, 0, 200, 299);
+  Add(0, 4U, "301", "350", kFileSize, 0, 100, 199);
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction != nullptr);
+  ASSERT_TRUE(compaction->deletion_compaction());
+  ASSERT_EQ(CompactionReason::kUniversalExpiredFiles, compaction->compaction_reason());
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(4U, compaction->input(0, 0)->fd.GetNumber());
+}
+
+// Expired file should be deleted even when there are not enough files to trigger a compaction.
+TEST_F(CompactionPickerTest, NeedsCompactionUniversalExpiredFiles) {
+  const uint64_t kFileSize = 100000;
+
+  ExpiredFilesFilterFactory filter_factory({199});
+  ioptions_.compaction_filter_factory = &filter_factory;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, icmp_.get());
+
+  // Only newer file is expired, so it could not be deleted.
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  Add(0, 1U, "150", "200", kFileSize, 0, 100, 199);
+  Add(0, 2U, "201", "250", kFileSize, 0, 1, 99);
+  UpdateVersionStorageInfo();
+  ASSERT_LT(vstorage_->CompactionScore(0), 1);
+  ASSERT_FALSE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  Add(0, 1U, "150", "200", kFileSize, 0, 200, 299);
+  Add(0, 2U, "201", "250", kFileSize, 0, 100, 199);
+  UpdateVersionStorageInfo();
+  ASSERT_LT(vstorage_->CompactionScore(0), 1);
+  ASSERT_TRUE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+
+  // Expired file that is being compacted is not picked again.
+  vstorage_->LevelFiles(0).back()->being_compacted = true;
+  ASSERT_FALSE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+}
+
+// Outputs of a compaction split into subcompactions have overlapping seqno ranges and should be
+// treated as a single sorted run.
+TEST_F(CompactionPickerTest, UniversalSubcompactionOutputs) {
+  const uint64_t kFileSize = 100000;
+  const uint64_t kOutputFileSize = 30000;
+
+  mutable_cf_options_.level0_file_num_compaction_trigger = 3;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, icmp_.get());
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  Add(0, 1U, "150", "200", kFileSize, 0, 400, 499);
+  Add(0, 2U, "100", "199", kOutputFileSize, 0, 100, 299);
+  Add(0, 3U, "200", "299", kOutputFileSize, 0, 120, 280);
+  Add(0, 4U, "300", "399", kOutputFileSize, 0, 110, 290);
+  UpdateVersionStorageInfo();
+
+  // There are only 2 sorted runs, that is less than the trigger.
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction == nullptr);
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  Add(0, 5U, "150", "200", kFileSize, 0, 500, 599);
+  Add(0, 1U, "150", "200", kFileSize, 0, 400, 499);
+  Add(0, 2U, "100", "199", kOutputFileSize, 0, 100, 299);
+  Add(0, 3U, "200", "299", kOutputFileSize, 0, 120, 280);
+  Add(0, 4U, "300", "399", kOutputFileSize, 0, 110, 290);
+  UpdateVersionStorageInfo();
+
+  // All outputs of the compaction are picked together.
+  compaction.reset(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction != nullptr);
+  ASSERT_EQ(5U, compaction->num_input_files(0));
+  std::set<uint64_t> input_numbers;
+  for (size_t i = 0; i != compaction->num_input_files(0); ++i) {
+    input_numbers.insert(compaction->input(0, i)->fd.GetNumber());
+  }
+  ASSERT_EQ(std::set<uint64_t>({1U, 2U, 3U, 4U, 5U}), input_numbers);
+}
+
 TEST_F(CompactionPickerTest, NeedsCompactionFIFO) {
   NewVersionStorage(1, kCompactionStyleFIFO);
   const int kFileCount =
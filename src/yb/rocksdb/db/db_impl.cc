@@ -2085,8 +2085,15 @@ void DBImpl::NotifyOnCompactionCompleted(
     info.stats = compaction_job_stats;
     info.table_properties = c->GetOutputTableProperties();
     info.compaction_reason = c->compaction_reason();
+    info.is_full_compaction = c->is_full_compaction();
+    info.flushed_frontier = c->edit()->flushed_frontier();
     for (size_t i = 0; i < c->num_input_levels(); ++i) {
       for (const auto fmd : *c->inputs(i)) {
+        if (fmd->largest.user_frontier) {
+          UpdateUserFrontier(
+              &info.largest_input_frontier, fmd->largest.user_frontier,
+              UpdateUserValueType::kLargest);
+        }
         auto fn = TableFileName(db_options_.db_paths, fmd->fd.GetNumber(),
                                 fmd->fd.GetPathId());
         info.input_files.push_back(fn);
@@ -2694,7 +2701,9 @@ bool DBImpl::AddToCompactionQueue(ColumnFamilyData* cfd) {
     c = cfd->PickCompaction(*cfd->GetLatestMutableCFOptions(), &log_buffer);
     if (c) {
       cfd->Ref();
-      if (c->CalculateTotalInputSize() < db_options_.compaction_size_threshold_bytes) {
+      // Deletion compaction does not read input files, so it is always small.
+      if (c->deletion_compaction() ||
+          c->CalculateTotalInputSize() < db_options_.compaction_size_threshold_bytes) {
         small_compaction_queue_.push_back(c);
       } else {
         large_compaction_queue_.push_back(c);
@@ -3109,8 +3118,8 @@ Result<FileNumbersHolder> DBImpl::BackgroundCompaction(
     // file if there is alive snapshot pointing to it
     assert(c->num_input_files(1) == 0);
     assert(c->level() == 0);
-    assert(c->column_family_data()->ioptions()->compaction_style ==
-           kCompactionStyleFIFO);
+    assert(c->column_family_data()->ioptions()->compaction_style == kCompactionStyleFIFO ||
+           c->column_family_data()->ioptions()->compaction_style == kCompactionStyleUniversal);
 
     compaction_job_stats.num_input_files = c->num_input_files(0);
 
@@ -5214,7 +5223,7 @@ ColumnFamilyHandle* DBImpl::GetColumnFamilyHandleUnlocked(
   return cf_memtables->GetColumnFamilyHandle();
 }
 
-Status DBImpl::Import(const std::string& source_dir) {
+Status DBImpl::Import(const std::string& source_dir, UserFrontierPtr flushed_frontier) {
   const auto seqno = versions_->LastSequence();
   FlushOptions options;
   Flush(options);
@@ -5223,9 +5232,16 @@ Status DBImpl::Import(const std::string& source_dir) {
   if (!status.ok()) {
     return status;
   }
+  if (flushed_frontier) {
+    edit.UpdateFlushedFrontier(std::move(flushed_frontier));
+  }
   return ApplyVersionEdit(&edit);
 }
 
+Status DBImpl::ValidateImport(const std::string& source_dir) {
+  return versions_->Import(source_dir, versions_->LastSequence(), nullptr /* edit */);
+}
+
 bool DBImpl::NeedsDelay() {
   return write_controller_.NeedsDelay();
 }
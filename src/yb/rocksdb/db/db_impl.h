@@ -467,7 +467,13 @@ class DBImpl : public DB {
   // Checks that source database has appropriate seqno.
   // I.e. seqno ranges of imported database does not overlap with seqno ranges of destination db.
   // And max seqno of imported database is less that active seqno of destination db.
-  CHECKED_STATUS Import(const std::string& source_dir) override;
+  // If flushed_frontier is specified, it is updated in the same version edit that adds imported
+  // files, so import could not be replayed after restart.
+  CHECKED_STATUS Import(
+      const std::string& source_dir, UserFrontierPtr flushed_frontier = nullptr) override;
+
+  // Performs the same checks as Import, without importing anything.
+  CHECKED_STATUS ValidateImport(const std::string& source_dir) override;
 
   bool NeedsDelay() override;
 
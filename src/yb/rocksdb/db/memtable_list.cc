@@ -348,8 +348,9 @@ Status MemTableList::InstallMemtableFlushResults(
     mems[i]->file_number_holder_ = file_number_holder;
     mems[i]->file_number_ = file_number;
   }
+  // Flush does not produce a file when all records of the memtables cancel out, e.g. Puts with
+  // their SingleDeletes, but the flushed frontier still advances.
   if (frontiers) {
-    DCHECK_NE(0, mems[0]->edit_.GetNewFiles().size());
     mems[0]->edit_.UpdateFlushedFrontier(frontiers->Largest().Clone());
   }
 
@@ -144,10 +144,15 @@ class VersionBuilder::Rep {
         auto f2 = level_files[i];
         if (level == 0) {
           assert(level_zero_cmp_(f1, f2));
+          auto ucmp = vstorage->InternalComparator()->user_comparator();
           assert(f1->largest.seqno > f2->largest.seqno ||
                  // We can have multiple files with seqno = 0 as a result of
                  // using DB::AddFile()
-                 (f1->largest.seqno == 0 && f2->largest.seqno == 0));
+                 (f1->largest.seqno == 0 && f2->largest.seqno == 0) ||
+                 // Outputs of a compaction split into subcompactions have overlapping seqno
+                 // ranges, but do not overlap by keys.
+                 ucmp->Compare(f1->largest.key.user_key(), f2->smallest.key.user_key()) < 0 ||
+                 ucmp->Compare(f2->largest.key.user_key(), f1->smallest.key.user_key()) < 0);
         } else {
           assert(level_nonzero_cmp_(f1, f2));
 
@@ -162,6 +162,7 @@ class VersionEdit {
     last_sequence_ = seq;
   }
   void UpdateFlushedFrontier(UserFrontierPtr value);
+  const UserFrontierPtr& flushed_frontier() const { return flushed_frontier_; }
   void ModifyFlushedFrontier(UserFrontierPtr value, FrontierModificationMode mode);
   void SetMaxColumnFamily(uint32_t max_column_family) {
     max_column_family_ = max_column_family;
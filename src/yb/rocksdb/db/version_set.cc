@@ -2814,6 +2814,30 @@ Status VersionSet::Recover(
   return s;
 }
 
+namespace {
+
+typedef std::pair<SequenceNumber, SequenceNumber> SeqnoSegment;
+
+// Outputs of a compaction split into subcompactions have overlapping seqno ranges, so seqno
+// ranges of one DB are merged before checking them against seqno ranges of another DB.
+void MergeOverlappingSegments(std::vector<SeqnoSegment>* segments) {
+  if (segments->empty()) {
+    return;
+  }
+  std::sort(segments->begin(), segments->end());
+  auto out = segments->begin();
+  for (auto it = segments->begin() + 1; it != segments->end(); ++it) {
+    if (it->first <= out->second) {
+      out->second = std::max(out->second, it->second);
+    } else {
+      *++out = *it;
+    }
+  }
+  segments->erase(out + 1, segments->end());
+}
+
+} // namespace
+
 Status VersionSet::Import(const std::string& source_dir,
                           SequenceNumber seqno,
                           VersionEdit* edit) {
@@ -2824,7 +2848,7 @@ Status VersionSet::Import(const std::string& source_dir,
     return status;
   }
   std::vector<FileMetaData> files;
-  std::vector<std::pair<SequenceNumber, SequenceNumber>> segments;
+  std::vector<SeqnoSegment> segments;
   for (;;) {
     status = manifest_reader.Next();
     if (!status.ok()) {
@@ -2859,9 +2883,13 @@ Status VersionSet::Import(const std::string& source_dir,
 
   std::vector<LiveFileMetaData> live_files;
   GetLiveFilesMetaData(&live_files);
+  std::vector<SeqnoSegment> live_segments;
   for (const auto& file : live_files) {
-    segments.emplace_back(file.smallest.seqno, file.largest.seqno);
+    live_segments.emplace_back(file.smallest.seqno, file.largest.seqno);
   }
+  MergeOverlappingSegments(&segments);
+  MergeOverlappingSegments(&live_segments);
+  segments.insert(segments.end(), live_segments.begin(), live_segments.end());
 
   std::sort(segments.begin(), segments.end(), [](const auto& lhs, const auto& rhs) {
     return lhs.first < rhs.first;
@@ -2880,6 +2908,10 @@ Status VersionSet::Import(const std::string& source_dir,
     prev = segment;
   }
 
+  if (!edit) {
+    return Status::OK();
+  }
+
   std::vector<std::string> revert_list;
   for (auto file : files) {
     auto source_base = MakeTableFileName(source_dir, file.fd.GetNumber());
@@ -26,6 +26,7 @@
 #include <unordered_map>
 #include <vector>
 #include "yb/rocksdb/compaction_job_stats.h"
+#include "yb/rocksdb/metadata.h"
 #include "yb/rocksdb/status.h"
 #include "yb/rocksdb/table_properties.h"
 
@@ -74,6 +75,8 @@ enum class CompactionReason {
   kManualCompaction,
   // DB::SuggestCompactRange() marked files for compaction
   kFilesMarkedForCompaction,
+  // [Universal] all records of the oldest files expired, so files are deleted without compaction
+  kUniversalExpiredFiles,
 };
 
 #ifndef ROCKSDB_LITE
@@ -145,6 +148,15 @@ struct CompactionJobInfo {
   // Reason to run the compaction
   CompactionReason compaction_reason;
 
+  // Whether all files of the column family were compacted.
+  bool is_full_compaction = false;
+
+  // Largest user frontier of the compaction input files.
+  UserFrontierPtr largest_input_frontier;
+
+  // Flushed frontier updated by this compaction, for instance by compaction filter.
+  UserFrontierPtr flushed_frontier;
+
   // If non-null, this variable stores detailed information
   // about this compaction.
   CompactionJobStats stats;
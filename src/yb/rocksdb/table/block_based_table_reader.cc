@@ -23,6 +23,7 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <cinttypes>
@@ -1611,6 +1612,39 @@ uint64_t BlockBasedTable::ApproximateOffsetOf(const Slice& key) {
   return result;
 }
 
+std::vector<std::string> BlockBasedTable::GetSampleKeys(size_t max_keys) {
+  std::vector<std::string> result;
+  if (max_keys == 0) {
+    return result;
+  }
+  // For multi-level data index top_level_iter is updated to iterate over the top level index
+  // block only, that is already in memory. Index entries are evenly spread over the data, since
+  // every entry corresponds to the same amount of data blocks.
+  BlockIter top_level_iter;
+  InternalIterator* index_iter = NewIndexIterator(ReadOptions::kDefault, &top_level_iter);
+  // On failure top_level_iter itself is returned with error status.
+  std::unique_ptr<InternalIterator> index_iter_holder(
+      index_iter != &top_level_iter ? index_iter : nullptr);
+  size_t num_entries = 0;
+  for (top_level_iter.SeekToFirst(); top_level_iter.Valid(); top_level_iter.Next()) {
+    ++num_entries;
+  }
+  if (!top_level_iter.status().ok() || num_entries == 0) {
+    return result;
+  }
+  const size_t num_keys = std::min(max_keys, num_entries);
+  result.reserve(num_keys);
+  size_t index = 0;
+  for (top_level_iter.SeekToFirst(); top_level_iter.Valid() && result.size() < num_keys;
+       top_level_iter.Next(), ++index) {
+    // Pick entries with indexes (i + 1) * num_entries / (num_keys + 1) for i in [0, num_keys).
+    if ((result.size() + 1) * num_entries / (num_keys + 1) == index) {
+      result.push_back(top_level_iter.key().ToBuffer());
+    }
+  }
+  return result;
+}
+
 bool BlockBasedTable::TEST_filter_block_preloaded() const {
   return rep_->filter != nullptr;
 }
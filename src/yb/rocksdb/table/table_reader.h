@@ -25,6 +25,8 @@
 #define ROCKSDB_TABLE_TABLE_READER_H
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "yb/util/slice.h"
 
@@ -72,6 +74,13 @@ class TableReader {
   // be close to the file length.
   virtual uint64_t ApproximateOffsetOf(const Slice& key) = 0;
 
+  // Returns up to max_keys internal keys, that split the file into parts of approximately equal
+  // size. They are used to split processing of the file between several threads.
+  // Returns empty vector if table does not support it.
+  virtual std::vector<std::string> GetSampleKeys(size_t max_keys) {
+    return std::vector<std::string>();
+  }
+
   // Set up the table for Compaction. Might change some parameters with
   // posix_fadvise
   virtual void SetupForCompaction() = 0;
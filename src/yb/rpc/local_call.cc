@@ -34,6 +34,9 @@ LocalOutboundCall::LocalOutboundCall(
 
 Status LocalOutboundCall::SetRequestParam(
     const google::protobuf::Message& req, const MemTrackerPtr& mem_tracker) {
+  if (controller()->has_encoded_request_fields()) {
+    return STATUS(NotSupported, "Encoded request fields are not supported by local calls");
+  }
   req_ = &req;
   return Status::OK();
 }
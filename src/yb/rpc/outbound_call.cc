@@ -249,6 +249,10 @@ void OutboundCall::NotifyTransferred(const Status& status, Connection* conn) {
 
 void OutboundCall::Serialize(boost::container::small_vector_base<RefCntBuffer>* output) {
   output->push_back(std::move(buffer_));
+  for (auto& field : encoded_request_fields_) {
+    output->push_back(std::move(field));
+  }
+  encoded_request_fields_.clear();
   buffer_consumption_ = ScopedTrackedConsumption();
 }
 
@@ -257,10 +261,17 @@ Status OutboundCall::SetRequestParam(
   using serialization::SerializeHeader;
   using serialization::SerializeMessage;
 
+  // Encoded fields are appended to the serialized message, so they are accounted in its length.
+  encoded_request_fields_ = std::move(controller_->encoded_request_fields_);
+  size_t fields_size = 0;
+  for (const auto& field : encoded_request_fields_) {
+    fields_size += field.size();
+  }
+
   size_t message_size = 0;
   auto status = SerializeMessage(message,
                                  /* param_buf */ nullptr,
-                                 /* additional_size */ 0,
+                                 /* additional_size */ fields_size,
                                  /* use_cached_size */ false,
                                  /* offset */ 0,
                                  &message_size);
@@ -271,7 +282,8 @@ Status OutboundCall::SetRequestParam(
 
   RequestHeader header;
   InitHeader(&header);
-  status = SerializeHeader(header, message_size, &buffer_, message_size, &header_size);
+  status = SerializeHeader(
+      header, message_size + fields_size, &buffer_, message_size, &header_size);
   remote_method_pool_->Release(header.release_remote_method());
   if (!status.ok()) {
     return status;
@@ -283,7 +295,7 @@ Status OutboundCall::SetRequestParam(
 
   return SerializeMessage(message,
                           &buffer_,
-                          /* additional_size */ 0,
+                          fields_size,
                           /* use_cached_size */ true,
                           header_size);
 }
@@ -367,6 +367,9 @@ class OutboundCall : public RpcCall {
   // Buffers for storing segments of the wire-format request.
   RefCntBuffer buffer_;
 
+  // Encoded request fields sent after buffer_, see RpcController::set_encoded_request_fields.
+  std::vector<RefCntBuffer> encoded_request_fields_;
+
   // Consumption of buffer_.
   ScopedTrackedConsumption buffer_consumption_;
 
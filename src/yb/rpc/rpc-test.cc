@@ -170,6 +170,50 @@ TEST_F(TestRpc, TestCall) {
   }
 }
 
+namespace {
+
+// Encoded field y of AddRequestPB with the specified value.
+std::vector<RefCntBuffer> EncodedAddRequestY(uint8_t value) {
+  const char encoded[] = {2 << 3, static_cast<char>(value)};
+  return {RefCntBuffer(encoded, sizeof(encoded))};
+}
+
+Result<uint32_t> CallAdd(Proxy* proxy, uint32_t x, uint32_t y, RpcController* controller) {
+  rpc_test::AddRequestPB req;
+  req.set_x(x);
+  req.set_y(y);
+  rpc_test::AddResponsePB resp;
+  controller->set_timeout(MonoDelta::FromMilliseconds(10000));
+  RETURN_NOT_OK(proxy->SyncRequest(
+      CalculatorServiceMethods::AddMethod(), req, &resp, controller));
+  return resp.result();
+}
+
+} // namespace
+
+// Test that controller reused after Reset does not send encoded fields set before it.
+TEST_F(TestRpc, ReuseControllerWithEncodedFields) {
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+  std::unique_ptr<Messenger> client_messenger = CreateMessenger("Client");
+  Proxy p(client_messenger.get(), server_addr);
+
+  RpcController controller;
+  // Encoded fields are parsed after the request, so they override y.
+  controller.set_encoded_request_fields(EncodedAddRequestY(5));
+  ASSERT_EQ(6U, ASSERT_RESULT(CallAdd(&p, 1, 2, &controller)));
+
+  controller.Reset();
+  ASSERT_FALSE(controller.has_encoded_request_fields());
+  ASSERT_EQ(3U, ASSERT_RESULT(CallAdd(&p, 1, 2, &controller)));
+
+  controller.Reset();
+  controller.set_encoded_request_fields(EncodedAddRequestY(7));
+  controller.Reset();
+  ASSERT_FALSE(controller.has_encoded_request_fields());
+  ASSERT_EQ(3U, ASSERT_RESULT(CallAdd(&p, 1, 2, &controller)));
+}
+
 // Test that connecting to an invalid server properly throws an error.
 TEST_F(TestRpc, TestCallToBadServer) {
   std::unique_ptr<Messenger> client_messenger = CreateMessenger("Client");
@@ -70,6 +70,7 @@ void RpcController::Swap(RpcController* other) {
   std::swap(allow_local_calls_in_curr_thread_, other->allow_local_calls_in_curr_thread_);
   std::swap(call_, other->call_);
   std::swap(invoke_callback_mode_, other->invoke_callback_mode_);
+  std::swap(encoded_request_fields_, other->encoded_request_fields_);
 }
 
 void RpcController::Reset() {
@@ -78,6 +79,7 @@ void RpcController::Reset() {
     CHECK(finished());
   }
   call_.reset();
+  encoded_request_fields_.clear();
 }
 
 bool RpcController::finished() const {
@@ -33,6 +33,7 @@
 #define YB_RPC_RPC_CONTROLLER_H
 
 #include <memory>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -40,6 +41,7 @@
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -144,6 +146,16 @@ class RpcController {
   // Return the configured timeout.
   MonoDelta timeout() const;
 
+  // Sets buffers with protobuf encoded fields of the request message, that are sent right after
+  // the serialized request. The receiver parses them as part of the request message, so data that
+  // was encoded once could be sent to several receivers without encoding or copying it again.
+  // The buffers are taken by the next call made with this controller.
+  void set_encoded_request_fields(std::vector<RefCntBuffer> fields) {
+    encoded_request_fields_ = std::move(fields);
+  }
+
+  bool has_encoded_request_fields() const { return !encoded_request_fields_.empty(); }
+
   // Fills the 'sidecar' parameter with the slice pointing to the i-th
   // sidecar upon success.
   //
@@ -165,6 +177,7 @@ class RpcController {
   OutboundCallPtr call_;
   bool allow_local_calls_in_curr_thread_ = false;
   InvokeCallbackMode invoke_callback_mode_ = InvokeCallbackMode::kThreadPool;
+  std::vector<RefCntBuffer> encoded_request_fields_;
 
   DISALLOW_COPY_AND_ASSIGN(RpcController);
 };
@@ -55,6 +55,7 @@
 DEFINE_bool(is_panic_test_child, false, "Used by TestRpcPanic");
 DECLARE_bool(socket_inject_short_recvs);
 DECLARE_int32(rpc_slow_query_threshold_ms);
+DECLARE_string(rpc_method_priority_classes);
 DECLARE_int32(TEST_delay_connect_ms);
 
 using namespace std::chrono_literals;
@@ -531,6 +532,49 @@ TEST_F(RpcStubTest, TestDontHandleTimedOutCalls) {
   ASSERT_EQ(1, timed_out_in_queue->value());
 }
 
+class RpcStubPriorityTest : public RpcStubTest {
+ public:
+  void SetUp() override {
+    FLAGS_rpc_method_priority_classes = "Add=high,yb.rpc_test.CalculatorService.Sleep=low";
+    RpcStubTest::SetUp();
+  }
+};
+
+TEST_F(RpcStubPriorityTest, HighPriorityCallBypassesQueue) {
+  CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
+  vector<AsyncSleep*> sleeps;
+  ElementDeleter d(&sleeps);
+
+  // Queue several rounds of sleep calls for the worker threads.
+  const size_t kSleepRounds = 4;
+  auto count = TestServerOptions().n_worker_threads * kSleepRounds;
+  CountDownLatch latch(count);
+  for (size_t i = 0; i < count; i++) {
+    gscoped_ptr<AsyncSleep> sleep(new AsyncSleep);
+    sleep->rpc.set_timeout(10s);
+    sleep->req.set_sleep_micros(500 * 1000);
+    p.SleepAsync(sleep->req, &sleep->resp, &sleep->rpc, [&latch]() { latch.CountDown(); });
+    sleeps.push_back(sleep.release());
+  }
+  std::this_thread::sleep_for(100ms);
+
+  // In FIFO order this call would wait for all sleep calls, but it belongs to the high priority
+  // class, so it is executed as soon as the first round of sleep calls completes.
+  RpcController rpc;
+  rpc.set_timeout(1500ms);
+  AddRequestPB req;
+  req.set_x(10);
+  req.set_y(20);
+  AddResponsePB resp;
+  ASSERT_OK(p.Add(req, &resp, &rpc));
+  ASSERT_EQ(30, resp.result());
+
+  latch.Wait();
+  for (const auto* sleep : sleeps) {
+    ASSERT_OK(sleep->rpc.status());
+  }
+}
+
 TEST_F(RpcStubTest, TestDumpCallsInFlight) {
   CountDownLatch latch(1);
   CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
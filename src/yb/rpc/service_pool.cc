@@ -32,9 +32,13 @@
 
 #include "yb/rpc/service_pool.h"
 
+#include <array>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/asio/strand.hpp>
@@ -51,6 +55,7 @@
 #include "yb/rpc/scheduler.h"
 #include "yb/rpc/service_if.h"
 
+#include "yb/gutil/strings/split.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/lockfree.h"
@@ -78,12 +83,56 @@ DEFINE_test_flag(bool, enable_backpressure_mode_for_testing, false,
             "For testing purposes. Enables the rpc's to be considered timed out in the queue even "
             "when we have not had any backpressure in the recent past.");
 
+DEFINE_string(rpc_method_priority_classes, "",
+              "Comma separated list of <method>=<class> pairs, where class is one of high, normal "
+              "or low. Method could be qualified with service name, e.g. "
+              "yb.tserver.TabletServerService.Read=high. Calls of a service with listed methods are "
+              "executed using weighted fair queuing between classes, calls of not listed methods "
+              "belong to the normal class. Calls of other services are executed in FIFO order.");
+TAG_FLAG(rpc_method_priority_classes, advanced);
+
+DEFINE_int32(rpc_high_priority_class_weight, 4,
+             "Relative share of service workers used by calls of the high priority class.");
+TAG_FLAG(rpc_high_priority_class_weight, advanced);
+TAG_FLAG(rpc_high_priority_class_weight, runtime);
+
+DEFINE_int32(rpc_normal_priority_class_weight, 2,
+             "Relative share of service workers used by calls of the normal priority class.");
+TAG_FLAG(rpc_normal_priority_class_weight, advanced);
+TAG_FLAG(rpc_normal_priority_class_weight, runtime);
+
+DEFINE_int32(rpc_low_priority_class_weight, 1,
+             "Relative share of service workers used by calls of the low priority class.");
+TAG_FLAG(rpc_low_priority_class_weight, advanced);
+TAG_FLAG(rpc_low_priority_class_weight, runtime);
+
 METRIC_DEFINE_histogram(server, rpc_incoming_queue_time,
                         "RPC Queue Time",
                         yb::MetricUnit::kMicroseconds,
                         "Number of microseconds incoming RPC requests spend in the worker queue",
                         60000000LU, 3);
 
+METRIC_DEFINE_histogram(server, rpc_incoming_queue_time_low_priority,
+                        "RPC Queue Time of Low Priority Calls",
+                        yb::MetricUnit::kMicroseconds,
+                        "Number of microseconds incoming RPC requests of the low priority class "
+                        "spend in the worker queue",
+                        60000000LU, 3);
+
+METRIC_DEFINE_histogram(server, rpc_incoming_queue_time_normal_priority,
+                        "RPC Queue Time of Normal Priority Calls",
+                        yb::MetricUnit::kMicroseconds,
+                        "Number of microseconds incoming RPC requests of the normal priority class "
+                        "spend in the worker queue",
+                        60000000LU, 3);
+
+METRIC_DEFINE_histogram(server, rpc_incoming_queue_time_high_priority,
+                        "RPC Queue Time of High Priority Calls",
+                        yb::MetricUnit::kMicroseconds,
+                        "Number of microseconds incoming RPC requests of the high priority class "
+                        "spend in the worker queue",
+                        60000000LU, 3);
+
 METRIC_DEFINE_counter(server, rpcs_timed_out_in_queue,
                       "RPC Queue Timeouts",
                       yb::MetricUnit::kRequests,
@@ -112,6 +161,59 @@ namespace {
 const CoarseDuration kTimeoutCheckGranularity = 100ms;
 const char* const kTimedOutInQueue = "Call waited in the queue past deadline";
 
+YB_DEFINE_ENUM(CallPriorityClass, (kLow)(kNormal)(kHigh));
+
+// Stride of a class with weight 1 in weighted fair queuing.
+const uint64_t kBaseCallClassStride = 1ULL << 20;
+
+int32_t CallClassWeight(CallPriorityClass call_class) {
+  switch (call_class) {
+    case CallPriorityClass::kLow:
+      return GetAtomicFlag(&FLAGS_rpc_low_priority_class_weight);
+    case CallPriorityClass::kNormal:
+      return GetAtomicFlag(&FLAGS_rpc_normal_priority_class_weight);
+    case CallPriorityClass::kHigh:
+      return GetAtomicFlag(&FLAGS_rpc_high_priority_class_weight);
+  }
+  FATAL_INVALID_ENUM_VALUE(CallPriorityClass, call_class);
+}
+
+// Returns classes of methods of the specified service listed in rpc_method_priority_classes.
+std::unordered_map<std::string, CallPriorityClass> ParseMethodClasses(
+    const std::string& service_name) {
+  std::unordered_map<std::string, CallPriorityClass> result;
+  for (const std::string& entry : strings::Split(
+           FLAGS_rpc_method_priority_classes, ",", strings::SkipEmpty())) {
+    auto pos = entry.find('=');
+    if (pos == std::string::npos) {
+      LOG(WARNING) << "Bad entry in rpc_method_priority_classes: " << entry;
+      continue;
+    }
+    auto method = entry.substr(0, pos);
+    auto class_name = entry.substr(pos + 1);
+    CallPriorityClass call_class;
+    if (class_name == "high") {
+      call_class = CallPriorityClass::kHigh;
+    } else if (class_name == "normal") {
+      call_class = CallPriorityClass::kNormal;
+    } else if (class_name == "low") {
+      call_class = CallPriorityClass::kLow;
+    } else {
+      LOG(WARNING) << "Unknown priority class in rpc_method_priority_classes: " << entry;
+      continue;
+    }
+    auto dot_pos = method.rfind('.');
+    if (dot_pos != std::string::npos) {
+      if (method.compare(0, dot_pos, service_name) != 0 || dot_pos != service_name.size()) {
+        continue;
+      }
+      method.erase(0, dot_pos + 1);
+    }
+    result[method] = call_class;
+  }
+  return result;
+}
+
 } // namespace
 
 class ServicePoolImpl final : public InboundCallHandler {
@@ -131,7 +233,16 @@ class ServicePoolImpl final : public InboundCallHandler {
             METRIC_rpcs_timed_out_early_in_queue.Instantiate(entity)),
         rpcs_queue_overflow_(METRIC_rpcs_queue_overflow.Instantiate(entity)),
         check_timeout_strand_(scheduler->io_service()),
-        log_prefix_(Format("$0: ", service_->service_name())) {
+        log_prefix_(Format("$0: ", service_->service_name())),
+        method_classes_(ParseMethodClasses(service_->service_name())) {
+    if (!method_classes_.empty()) {
+      class_queue_time_[to_underlying(CallPriorityClass::kLow)] =
+          METRIC_rpc_incoming_queue_time_low_priority.Instantiate(entity);
+      class_queue_time_[to_underlying(CallPriorityClass::kNormal)] =
+          METRIC_rpc_incoming_queue_time_normal_priority.Instantiate(entity);
+      class_queue_time_[to_underlying(CallPriorityClass::kHigh)] =
+          METRIC_rpc_incoming_queue_time_high_priority.Instantiate(entity);
+    }
   }
 
   ~ServicePoolImpl() {
@@ -179,6 +290,9 @@ class ServicePoolImpl final : public InboundCallHandler {
       ScheduleCheckTimeout(call_deadline);
     }
 
+    if (prioritized()) {
+      EnqueuePrioritized(call);
+    }
     thread_pool_.Enqueue(call->BindTask(this));
   }
 
@@ -212,6 +326,19 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
   void Failure(const InboundCallPtr& call, const Status& status) override {
+    if (prioritized()) {
+      // The turn of this pool in the thread pool was lost, so the queued call with the lowest
+      // priority is failed instead.
+      auto victim = PopPrioritizedForFailure();
+      if (victim) {
+        HandleFailure(victim, status);
+      }
+      return;
+    }
+    HandleFailure(call, status);
+  }
+
+  void HandleFailure(const InboundCallPtr& call, const Status& status) {
     if (!call->TryStartProcessing()) {
       return;
     }
@@ -230,11 +357,25 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
   void Handle(InboundCallPtr incoming) override {
-    Handle(std::move(incoming), true);
+    if (prioritized()) {
+      // The task of incoming call is just a turn of this pool in the thread pool, the call that
+      // is actually handled is picked from the priority class queues.
+      CallPriorityClass call_class;
+      auto call = PopPrioritized(&call_class);
+      if (call) {
+        Handle(std::move(call), true /* queued */,
+               class_queue_time_[to_underlying(call_class)].get());
+      }
+      return;
+    }
+    Handle(std::move(incoming), true /* queued */);
   }
 
-  void Handle(InboundCallPtr incoming, bool queued) {
+  void Handle(InboundCallPtr incoming, bool queued, Histogram* class_queue_time = nullptr) {
     incoming->RecordHandlingStarted(incoming_queue_time_);
+    if (class_queue_time) {
+      class_queue_time->Increment(incoming->GetTimeInQueue().ToMicroseconds());
+    }
     ADOPT_TRACE(incoming->trace());
 
     const char* error_message;
@@ -271,6 +412,73 @@ class ServicePoolImpl final : public InboundCallHandler {
     }
   }
 
+  bool prioritized() const {
+    return !method_classes_.empty();
+  }
+
+  void EnqueuePrioritized(const InboundCallPtr& call) {
+    auto it = method_classes_.find(call->method_name());
+    auto call_class = it != method_classes_.end() ? it->second : CallPriorityClass::kNormal;
+    std::lock_guard<std::mutex> lock(class_queues_mutex_);
+    auto& queue = class_queues_[to_underlying(call_class)];
+    if (queue.calls.empty()) {
+      // Idle class does not accumulate credit, otherwise it would monopolize workers after
+      // becoming active.
+      queue.pass = std::max(queue.pass, virtual_time_);
+    }
+    queue.calls.push_back(call);
+  }
+
+  // Picks the next call using weighted fair queuing between classes. Calls whose deadline has
+  // already passed are responded right away, so they don't consume share of their class.
+  InboundCallPtr PopPrioritized(CallPriorityClass* call_class) {
+    std::vector<InboundCallPtr> expired;
+    InboundCallPtr result;
+    {
+      std::lock_guard<std::mutex> lock(class_queues_mutex_);
+      for (;;) {
+        ClassQueue* best = nullptr;
+        for (auto& queue : class_queues_) {
+          // Ties are resolved in favor of the higher class, that is placed later.
+          if (!queue.calls.empty() && (!best || queue.pass <= best->pass)) {
+            best = &queue;
+          }
+        }
+        if (!best) {
+          break;
+        }
+        auto call = std::move(best->calls.front());
+        best->calls.pop_front();
+        if (call->ClientTimedOut()) {
+          expired.push_back(std::move(call));
+          continue;
+        }
+        *call_class = static_cast<CallPriorityClass>(best - class_queues_.data());
+        virtual_time_ = best->pass;
+        best->pass += kBaseCallClassStride / std::max(CallClassWeight(*call_class), 1);
+        result = std::move(call);
+        break;
+      }
+    }
+    for (const auto& call : expired) {
+      TimedOut(call.get(), kTimedOutInQueue, rpcs_timed_out_in_queue_.get());
+    }
+    return result;
+  }
+
+  // Returns the most recently queued call of the lowest non empty class.
+  InboundCallPtr PopPrioritizedForFailure() {
+    std::lock_guard<std::mutex> lock(class_queues_mutex_);
+    for (auto& queue : class_queues_) {
+      if (!queue.calls.empty()) {
+        auto result = std::move(queue.calls.back());
+        queue.calls.pop_back();
+        return result;
+      }
+    }
+    return nullptr;
+  }
+
   bool ShouldDropRequestDuringHighLoad(const InboundCallPtr& incoming) {
     CoarseTimePoint last_backpressure_at(last_backpressure_at_.load(std::memory_order_acquire));
 
@@ -418,6 +626,22 @@ class ServicePoolImpl final : public InboundCallHandler {
   std::atomic<bool> closing_ = {false};
   CountDownLatch shutdown_complete_latch_{1};
   std::string log_prefix_;
+
+  // Priority classes of methods of this service, calls are executed in FIFO order when it is
+  // empty. Otherwise each call enqueued to the thread pool is just a turn of this pool and the
+  // actual call is picked from class_queues_.
+  const std::unordered_map<std::string, CallPriorityClass> method_classes_;
+
+  struct ClassQueue {
+    std::deque<InboundCallPtr> calls;
+    // Virtual time of the next call of this class, advanced by stride inverse to class weight.
+    uint64_t pass = 0;
+  };
+
+  std::mutex class_queues_mutex_;
+  std::array<ClassQueue, kCallPriorityClassMapSize> class_queues_;
+  uint64_t virtual_time_ = 0;
+  std::array<scoped_refptr<Histogram>, kCallPriorityClassMapSize> class_queue_time_;
 };
 
 ServicePool::ServicePool(size_t max_tasks,
@@ -271,7 +271,25 @@ static void WriteMetricsAsJson(const MetricRegistry* const metrics,
 
 static void WriteForPrometheus(const MetricRegistry* const metrics,
                                const Webserver::WebRequest& req, std::stringstream* output) {
-  PrometheusWriter writer(output);
+  MetricPrometheusOptions opts;
+  {
+    const string* arg = FindOrNull(req.parsed_args, "metric_prefixes");
+    if (arg != nullptr) {
+      SplitStringUsing(*arg, ",", &opts.metric_name_prefixes);
+    }
+  }
+  {
+    const string* arg = FindOrNull(req.parsed_args, "entity_types");
+    if (arg != nullptr) {
+      SplitStringUsing(*arg, ",", &opts.entity_types);
+    }
+  }
+  {
+    string arg = FindWithDefault(req.parsed_args, "skip_zero_counters", "false");
+    opts.skip_zero_counters = ParseLeadingBoolValue(arg.c_str(), false);
+  }
+
+  PrometheusWriter writer(output, std::move(opts));
   WARN_NOT_OK(metrics->WriteForPrometheus(&writer), "Couldn't write text metrics for Prometheus");
 }
 
@@ -145,6 +145,11 @@ Status ChangeMetadataOperation::Apply(int64_t leader_term) {
     RETURN_NOT_OK(tablet->AddTable(state()->request()->add_table()));
   }
 
+  if (state()->request()->has_remove_table_id()) {
+    ++num_operations;
+    RETURN_NOT_OK(tablet->RemoveTable(state()->request()->remove_table_id()));
+  }
+
   if (num_operations != 1) {
     return STATUS_FORMAT(
         InvalidArgument, "Wrong number of operations in Change Metadata Operation: $0",
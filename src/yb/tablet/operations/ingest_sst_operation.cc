@@ -0,0 +1,88 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/operations/ingest_sst_operation.h"
+
+#include <glog/logging.h>
+
+#include "yb/consensus/consensus.h"
+#include "yb/server/hybrid_clock.h"
+#include "yb/tablet/tablet.h"
+#include "yb/tserver/tserver.pb.h"
+#include "yb/util/trace.h"
+
+namespace yb {
+namespace tablet {
+
+using consensus::ReplicateMsg;
+using consensus::INGEST_SST_OP;
+using strings::Substitute;
+
+void IngestSstOperationState::UpdateRequestFromConsensusRound() {
+  request_ = consensus_round()->replicate_msg()->mutable_ingest_sst_request();
+}
+
+string IngestSstOperationState::ToString() const {
+  if (!request_) {
+    return Format("IngestSstOperationState [hybrid_time=$0]", hybrid_time_even_if_unset());
+  }
+  return Format(
+      "IngestSstOperationState [hybrid_time=$0, ingestion_id=$1, file_name=$2, offset=$3, "
+          "size=$4, commit=$5, abort=$6]",
+      hybrid_time_even_if_unset(), request_->ingestion_id(), request_->file_name(),
+      request_->offset(), request_->data().size(), request_->commit(), request_->abort());
+}
+
+IngestSstOperation::IngestSstOperation(std::unique_ptr<IngestSstOperationState> state,
+                                       IngestSstOperationContext* context)
+    : Operation(std::move(state), OperationType::kIngestSst), context_(context) {
+}
+
+consensus::ReplicateMsgPtr IngestSstOperation::NewReplicateMsg() {
+  auto result = std::make_shared<ReplicateMsg>();
+  result->set_op_type(INGEST_SST_OP);
+  result->mutable_ingest_sst_request()->CopyFrom(*state()->request());
+  return result;
+}
+
+void IngestSstOperation::DoStart() {
+  state()->TrySetHybridTimeFromClock();
+
+  TRACE("START INGEST SST: hybrid time: $0",
+        server::HybridClock::GetPhysicalValueMicros(state()->hybrid_time()));
+}
+
+Status IngestSstOperation::Apply(int64_t leader_term) {
+  TRACE("APPLY INGEST SST: started");
+
+  auto status = state()->tablet()->IngestSst(state());
+  if (!status.ok()) {
+    // Replicated operation could not be rejected, so this replica diverged. For instance, replica
+    // that was remote bootstrapped in the middle of ingestion does not have chunks staged before.
+    // Only this tablet fails, instead of terminating the whole server.
+    LOG(ERROR) << "T " << state()->tablet()->tablet_id() << ": Failed to apply "
+               << state()->ToString() << ": " << status;
+    state()->SetError(status, tserver::TabletServerErrorPB::UNKNOWN_ERROR);
+    context_->IngestSstFailed(status);
+  }
+
+  TRACE("APPLY INGEST SST: finished");
+  return Status::OK();
+}
+
+string IngestSstOperation::ToString() const {
+  return Substitute("IngestSstOperation [state=$0]", state()->ToString());
+}
+
+}  // namespace tablet
+}  // namespace yb
@@ -0,0 +1,90 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_OPERATIONS_INGEST_SST_OPERATION_H
+#define YB_TABLET_OPERATIONS_INGEST_SST_OPERATION_H
+
+#include <string>
+
+#include "yb/gutil/macros.h"
+#include "yb/tablet/operations/operation.h"
+
+namespace yb {
+namespace tablet {
+
+// Operation Context for the IngestSst operation.
+// Keeps track of the Operation states (request, result, ...)
+class IngestSstOperationState : public OperationState {
+ public:
+  explicit IngestSstOperationState(Tablet* tablet,
+                                   const tserver::IngestSstRequestPB* request = nullptr)
+      : OperationState(tablet), request_(request) {}
+  ~IngestSstOperationState() {}
+
+  const tserver::IngestSstRequestPB* request() const override { return request_; }
+
+  void UpdateRequestFromConsensusRound() override;
+
+  virtual std::string ToString() const override;
+
+ private:
+  // The original RPC request.
+  const tserver::IngestSstRequestPB *request_;
+
+  DISALLOW_COPY_AND_ASSIGN(IngestSstOperationState);
+};
+
+class IngestSstOperationContext {
+ public:
+  // Invoked when replicated ingestion could not be applied, so the tablet could not continue.
+  virtual void IngestSstFailed(const Status& error) = 0;
+
+  virtual ~IngestSstOperationContext() {}
+};
+
+// Executes the ingest SST operation, i.e. stages chunk of SST file or imports staged files.
+class IngestSstOperation : public Operation {
+ public:
+  IngestSstOperation(std::unique_ptr<IngestSstOperationState> operation_state,
+                     IngestSstOperationContext* context);
+
+  IngestSstOperationState* state() override {
+    return down_cast<IngestSstOperationState*>(Operation::state());
+  }
+
+  const IngestSstOperationState* state() const override {
+    return down_cast<const IngestSstOperationState*>(Operation::state());
+  }
+
+  consensus::ReplicateMsgPtr NewReplicateMsg() override;
+
+  CHECKED_STATUS Prepare() override { return Status::OK(); }
+
+  // Executes an Apply for the ingest SST operation.
+  CHECKED_STATUS Apply(int64_t leader_term) override;
+
+  std::string ToString() const override;
+
+ private:
+  // Starts the IngestSstOperation by assigning it a timestamp.
+  void DoStart() override;
+
+  IngestSstOperationContext* const context_;
+
+  DISALLOW_COPY_AND_ASSIGN(IngestSstOperation);
+};
+
+}  // namespace tablet
+}  // namespace yb
+
+#endif  // YB_TABLET_OPERATIONS_INGEST_SST_OPERATION_H
@@ -57,7 +57,8 @@ class OperationCompletionCallback;
 class OperationState;
 
 YB_DEFINE_ENUM(OperationType,
-               (kWrite)(kChangeMetadata)(kUpdateTransaction)(kSnapshot)(kTruncate)(kEmpty));
+               (kWrite)(kChangeMetadata)(kUpdateTransaction)(kSnapshot)(kTruncate)(kIngestSst)
+               (kEmpty));
 
 // Base class for transactions.  There are different implementations for different types (Write,
 // AlterSchema, etc.) OperationDriver implementations use Operations along with Consensus to execute
@@ -274,8 +275,11 @@ class OperationCompletionCallback {
   // Subclasses should override this.
   virtual void OperationCompleted() = 0;
 
+  // Error set by set_error is kept, when operation itself is completed successfully.
   void CompleteWithStatus(const Status& status) {
-    set_error(status);
+    if (!status.ok()) {
+      set_error(status);
+    }
     OperationCompleted();
   }
 
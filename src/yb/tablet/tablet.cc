@@ -99,6 +99,7 @@
 #include "yb/tablet/transaction_coordinator.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/ingest_sst_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/tablet_options.h"
@@ -111,6 +112,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
+#include "yb/util/random_util.h"
 #include "yb/util/slice.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
@@ -148,6 +150,14 @@ DEFINE_int32(intents_flush_max_delay_ms, 2000,
              "Max time to wait for regular db to flush during flush of intents. "
              "After this time flush of regular db will be forced.");
 
+DEFINE_uint64(txn_max_apply_batch_records, 100000,
+              "Max number of intents applied or removed in one write batch. Larger transactions "
+              "are processed in several batches.");
+TAG_FLAG(txn_max_apply_batch_records, advanced);
+
+DEFINE_test_flag(double, txn_continue_apply_failure_probability, 0,
+                 "Probability of failure to apply batch of transaction intents in background.");
+
 DEFINE_test_flag(
     bool, tablet_verify_flushed_frontier_after_modifying, false,
     "After modifying the flushed frontier in RocksDB, verify that the restored value of it "
@@ -276,22 +286,32 @@ CHECKED_STATUS EmitRocksDbMetricsAsPrometheus(
   if (rocksdb_statistics == nullptr) {
     return Status::OK();
   }
+  const bool skip_zero_counters = writer->options().skip_zero_counters;
   // Emit all the ticker (gauge) metrics.
-  for (std::pair<rocksdb::Tickers, std::string> entry : rocksdb::TickersNameMap) {
-    RETURN_NOT_OK(writer->WriteSingleEntry(
-        attrs, entry.second, rocksdb_statistics->getTickerCount(entry.first)));
+  for (const auto& entry : rocksdb::TickersNameMap) {
+    if (!writer->MetricNameMatches(entry.second)) {
+      continue;
+    }
+    auto count = rocksdb_statistics->getTickerCount(entry.first);
+    if (count == 0 && skip_zero_counters) {
+      continue;
+    }
+    RETURN_NOT_OK(writer->WriteSingleEntry(attrs, entry.second, count));
   }
   // Emit all the histogram metrics.
   rocksdb::HistogramData histogram_data;
-  for (std::pair<rocksdb::Histograms, std::string> entry : rocksdb::HistogramsNameMap) {
+  for (const auto& entry : rocksdb::HistogramsNameMap) {
+    if (!writer->MetricNameMatches(entry.second)) {
+      continue;
+    }
     rocksdb_statistics->histogramData(entry.first, &histogram_data);
+    if (histogram_data.count == 0 && skip_zero_counters) {
+      continue;
+    }
 
-    auto copy_of_attr = attrs;
-    const std::string hist_name = entry.second;
-    RETURN_NOT_OK(writer->WriteSingleEntry(
-        copy_of_attr, hist_name + "_sum", histogram_data.sum));
-    RETURN_NOT_OK(writer->WriteSingleEntry(
-        copy_of_attr, hist_name + "_count", histogram_data.count));
+    const std::string& hist_name = entry.second;
+    RETURN_NOT_OK(writer->WriteSingleEntry(attrs, hist_name + "_sum", histogram_data.sum));
+    RETURN_NOT_OK(writer->WriteSingleEntry(attrs, hist_name + "_count", histogram_data.count));
   }
   return Status::OK();
 }
@@ -486,6 +506,23 @@ std::string Tablet::LogPrefix() const {
   return Format("T $0$1: ", tablet_id(), log_prefix_suffix_);
 }
 
+namespace {
+
+// Removes range tombstones of the tablet after compaction of regular DB.
+class RangeTombstonesCleaner : public rocksdb::EventListener {
+ public:
+  explicit RangeTombstonesCleaner(Tablet* tablet) : tablet_(tablet) {}
+
+  void OnCompactionCompleted(rocksdb::DB* db, const rocksdb::CompactionJobInfo& info) override {
+    tablet_->CleanupRangeTombstones(info);
+  }
+
+ private:
+  Tablet* tablet_;
+};
+
+} // namespace
+
 Status Tablet::OpenKeyValueTablet() {
   rocksdb::Options rocksdb_options;
   docdb::InitRocksDBOptions(&rocksdb_options, LogPrefix(), rocksdb_statistics_, tablet_options_);
@@ -497,16 +534,27 @@ Status Tablet::OpenKeyValueTablet() {
       make_shared<TabletRetentionPolicy>(this));
 
   rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
-    if (mem_table_flush_filter_factory_) {
-      return mem_table_flush_filter_factory_();
-    }
-    return rocksdb::MemTableFilter();
+    auto filter = mem_table_flush_filter_factory_ ? mem_table_flush_filter_factory_()
+                                                  : rocksdb::MemTableFilter();
+    return [this, filter](const rocksdb::MemTable& memtable) -> Result<bool> {
+      if (!PersistRangeTombstonesBeforeFlush()) {
+        return false;
+      }
+      return filter ? filter(memtable) : true;
+    };
   });
 
   rocksdb_options.disable_auto_compactions = true;
   rocksdb_options.level0_slowdown_writes_trigger = std::numeric_limits<int>::max();
   rocksdb_options.level0_stop_writes_trigger = std::numeric_limits<int>::max();
 
+  range_tombstones_.Reset(metadata()->range_tombstones());
+  {
+    std::lock_guard<std::mutex> lock(range_tombstones_flush_mutex_);
+    flushed_range_tombstones_ = range_tombstones_.Get();
+  }
+  rocksdb_options.listeners.push_back(std::make_shared<RangeTombstonesCleaner>(this));
+
   const string db_dir = metadata()->rocksdb_dir();
   RETURN_NOT_OK(CreateTabletDirectories(db_dir, metadata()->fs_manager()));
 
@@ -541,7 +589,7 @@ Status Tablet::OpenKeyValueTablet() {
     intents_db_.reset(intents_db);
   }
 
-  ql_storage_.reset(new docdb::QLRocksDBStorage({regular_db_.get(), intents_db_.get()}));
+  ql_storage_.reset(new docdb::QLRocksDBStorage(doc_db()));
   if (transaction_participant_) {
     transaction_participant_->SetDB(intents_db_.get());
   }
@@ -619,6 +667,10 @@ void Tablet::Shutdown() {
     transaction_coordinator_->Shutdown();
   }
 
+  if (transaction_participant_) {
+    transaction_participant_->Shutdown();
+  }
+
   std::lock_guard<rw_spinlock> lock(component_lock_);
   // Shutdown the RocksDB instance for this table, if present.
   // Destroy intents and regular DBs in reverse order to their creation.
@@ -659,7 +711,7 @@ Result<std::unique_ptr<common::YQLRowwiseIteratorIf>> Tablet::NewRowIterator(
   auto read_time = ReadHybridTime::SingleTime(SafeTime(RequireLease::kFalse));
   auto result = std::make_unique<DocRowwiseIterator>(
       std::move(mapped_projection), schema, txn_op_ctx,
-      docdb::DocDB{regular_db_.get(), intents_db_.get()},
+      doc_db(),
       CoarseTimePoint::max() /* deadline */, read_time, &pending_op_counter_);
   RETURN_NOT_OK(result->Init());
   return std::move(result);
@@ -769,6 +821,10 @@ void Tablet::PrepareTransactionWriteBatch(
 void Tablet::ApplyKeyValueRowOperations(const KeyValueWriteBatchPB& put_batch,
                                         const rocksdb::UserFrontiers* frontiers,
                                         const HybridTime hybrid_time) {
+  if (!put_batch.range_tombstones().empty()) {
+    AddRangeTombstones(put_batch, hybrid_time);
+  }
+
   if (put_batch.write_pairs().empty() && put_batch.read_pairs().empty()) {
     return;
   }
@@ -779,11 +835,95 @@ void Tablet::ApplyKeyValueRowOperations(const KeyValueWriteBatchPB& put_batch,
     PrepareTransactionWriteBatch(put_batch, hybrid_time, &write_batch);
     WriteBatch(frontiers, hybrid_time, &write_batch, intents_db_.get());
   } else {
+    range_tombstones_.MarkOverwritten(
+        hybrid_time, [&put_batch](const docdb::RangeTombstone& tombstone) {
+      for (const auto& pair : put_batch.write_pairs()) {
+        if (tombstone.Covers(pair.key())) {
+          return true;
+        }
+      }
+      return false;
+    });
     PrepareNonTransactionWriteBatch(put_batch, hybrid_time, &write_batch);
     WriteBatch(frontiers, hybrid_time, &write_batch, regular_db_.get());
   }
 }
 
+// Tombstones are persisted in tablet metadata lazily, before the next flush of regular DB.
+// Until then they are restored from WAL during bootstrap, since flushed frontier of regular DB
+// does not pass operations that added them.
+// The same applies to marking tombstones as overwritten, that is done before records are written
+// to regular DB, so readers don't seek past records written after a tombstone.
+void Tablet::AddRangeTombstones(const KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time) {
+  DCHECK(!put_batch.has_transaction());
+  docdb::RangeTombstoneVector tombstones;
+  tombstones.reserve(put_batch.range_tombstones_size());
+  for (const auto& tombstone_pb : put_batch.range_tombstones()) {
+    tombstones.push_back(
+        docdb::RangeTombstone{tombstone_pb.start_key(), tombstone_pb.end_key(), hybrid_time});
+    VLOG_WITH_PREFIX(2) << "Adding range tombstone: " << tombstones.back().ToString();
+  }
+  // Tombstone could be already registered, when operation is replayed during bootstrap.
+  range_tombstones_.Add(std::move(tombstones));
+}
+
+void Tablet::MarkAllRangeTombstonesOverwritten(HybridTime hybrid_time) {
+  range_tombstones_.MarkOverwritten(
+      hybrid_time, [](const docdb::RangeTombstone&) { return true; });
+}
+
+Status Tablet::FlushRangeTombstones() {
+  std::lock_guard<std::mutex> lock(range_tombstones_flush_mutex_);
+  // Registry replaces its snapshot on every change, so the same snapshot is already persisted.
+  auto tombstones = range_tombstones_.Get();
+  if (tombstones == flushed_range_tombstones_) {
+    return Status::OK();
+  }
+  metadata_->SetRangeTombstones(
+      tombstones ? *tombstones : docdb::RangeTombstoneVector());
+  RETURN_NOT_OK(metadata_->Flush());
+  flushed_range_tombstones_ = std::move(tombstones);
+  return Status::OK();
+}
+
+bool Tablet::PersistRangeTombstonesBeforeFlush() {
+  auto status = FlushRangeTombstones();
+  if (!status.ok()) {
+    // Memtable is not flushed, so operations that added tombstones are still replayed from WAL.
+    YB_LOG_EVERY_N_SECS(WARNING, 1) << LogPrefix() << "Failed to flush range tombstones, "
+                                    << "postponing flush of regular DB: " << status;
+    return false;
+  }
+  return true;
+}
+
+void Tablet::CleanupRangeTombstones(const rocksdb::CompactionJobInfo& info) {
+  // Only full compaction processes all records, that could be deleted by a tombstone.
+  if (!info.status.ok() || !info.is_full_compaction || !info.flushed_frontier ||
+      !info.largest_input_frontier) {
+    return;
+  }
+  // Compaction applies tombstones written at or below history cutoff, and records written after
+  // the latest compacted record could still reside in memtable.
+  auto history_cutoff =
+      down_cast<const docdb::ConsensusFrontier&>(*info.flushed_frontier).history_cutoff();
+  auto max_input_ht =
+      down_cast<const docdb::ConsensusFrontier&>(*info.largest_input_frontier).hybrid_time();
+  if (!history_cutoff.is_valid() || !max_input_ht.is_valid()) {
+    return;
+  }
+  auto removed = range_tombstones_.RemoveUpTo(std::min(history_cutoff, max_input_ht));
+  if (removed == 0) {
+    return;
+  }
+  LOG_WITH_PREFIX(INFO) << "Removed " << removed << " range tombstones purged by compaction";
+  auto status = FlushRangeTombstones();
+  if (!status.ok()) {
+    // Tombstones will be removed from metadata after the next full compaction.
+    LOG_WITH_PREFIX(WARNING) << "Failed to flush range tombstones: " << status;
+  }
+}
+
 void Tablet::WriteBatch(const rocksdb::UserFrontiers* frontiers,
                         HybridTime hybrid_time,
                         rocksdb::WriteBatch* write_batch,
@@ -873,7 +1013,7 @@ Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
   ScopedTabletMetricsTracker metrics_tracker(metrics_->redis_read_latency);
 
   docdb::RedisReadOperation doc_op(
-      redis_read_request, {regular_db_.get(), intents_db_.get()}, deadline, read_time);
+      redis_read_request, doc_db(), deadline, read_time);
   RETURN_NOT_OK(doc_op.Execute());
   *response = std::move(doc_op.response());
   return Status::OK();
@@ -896,6 +1036,20 @@ Status Tablet::HandleQLReadRequest(
     return Status::OK();
   }
 
+  // Primary keys are grouped by tablet using table partitions cached by the client. When they are
+  // outdated, the request is rejected the same way as for outdated schema, so the client refreshes
+  // table metadata and retries.
+  for (const auto& key : ql_read_request.primary_keys()) {
+    if (!metadata_->partition().ContainsKey(
+            PartitionSchema::EncodeMultiColumnHashValue(key.hash_code()))) {
+      result->response.set_status(QLResponsePB::YQL_STATUS_SCHEMA_VERSION_MISMATCH);
+      result->response.set_error_message(Format(
+          "Primary key with hash code $0 does not belong to tablet $1", key.hash_code(),
+          tablet_id()));
+      return Status::OK();
+    }
+  }
+
   Result<TransactionOperationContextOpt> txn_op_ctx =
       CreateTransactionOperationContext(transaction_metadata);
   RETURN_NOT_OK(txn_op_ctx);
@@ -908,8 +1062,8 @@ CHECKED_STATUS Tablet::CreatePagingStateForRead(const QLReadRequestPB& ql_read_r
                                                 QLResponsePB* response) const {
 
   // If the response does not have a next partition key, it means we are done reading the current
-  // tablet. But, if the request does not have the hash columns set, this must be a table-scan,
-  // so we need to decide if we are done or if we need to move to the next tablet.
+  // tablet. But, if the request does not have the hash columns or primary keys set, this must be a
+  // table-scan, so we need to decide if we are done or if we need to move to the next tablet.
   // If we did not reach the:
   //   1. max number of results (LIMIT clause -- if set)
   //   2. end of the table (this was the last tablet)
@@ -917,6 +1071,7 @@ CHECKED_STATUS Tablet::CreatePagingStateForRead(const QLReadRequestPB& ql_read_r
   // we set the paging state to point to the exclusive end partition key of this tablet, which is
   // the start key of the next tablet).
   if (ql_read_request.hashed_column_values().empty() &&
+      ql_read_request.primary_keys().empty() &&
       !response->paging_state().has_next_partition_key()) {
     // Check we did not reach the results limit.
     // If return_paging_state is set, it means the request limit is actually just the page size.
@@ -1347,20 +1502,45 @@ Status Tablet::WaitForFlush() {
 
 Status Tablet::ImportData(const std::string& source_dir) {
   // We import only regular records, so don't have to deal with intents here.
+  // Imported files are not flushed from memtable, so marked tombstones are persisted before them.
+  MarkAllRangeTombstonesOverwritten(HybridTime::kMax);
+  RETURN_NOT_OK(FlushRangeTombstones());
   return regular_db_->Import(source_dir);
 }
 
 // We apply intents using by iterating over whole transaction reverse index.
 // Using value of reverse index record we find original intent record and apply it.
 // After that we delete both intent record and reverse index record.
-// TODO(dtxn) use separate thread for applying intents.
-// TODO(dtxn) use multiple batches when applying really big transaction.
-Status Tablet::ApplyIntents(const TransactionApplyData& data) {
+//
+// Large transaction is applied in several batches. The first batch is applied by APPLY operation,
+// it also removes applied intents and stores apply state in intents DB, so apply could be resumed
+// after restart. Other batches are applied by ContinueApplyIntents.
+Result<docdb::ApplyTransactionState> Tablet::ApplyIntents(const TransactionApplyData& data) {
+  if (data.apply_state) {
+    return ContinueApplyIntents(data);
+  }
+
+  MarkAllRangeTombstonesOverwritten(data.commit_ht);
+
   rocksdb::WriteBatch regular_write_batch;
   rocksdb::WriteBatch intents_write_batch;
-  RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
-      data.transaction_id, data.commit_ht,
-      &regular_write_batch, intents_db_.get(), &intents_write_batch));
+  auto apply_state = VERIFY_RESULT(docdb::PrepareApplyIntentsBatch(
+      data.transaction_id, data.commit_ht, nullptr /* apply_state */,
+      FLAGS_txn_max_apply_batch_records, &regular_write_batch, intents_db_.get(),
+      &intents_write_batch));
+
+  if (apply_state.active()) {
+    docdb::ApplyTransactionStatePB state_pb;
+    state_pb.set_key(apply_state.key);
+    state_pb.set_write_id(apply_state.write_id);
+    state_pb.set_commit_ht(data.commit_ht.ToUint64());
+    *state_pb.mutable_op_id() = data.op_id;
+    state_pb.set_log_ht(data.log_ht.ToUint64());
+    state_pb.set_status_tablet(data.status_tablet);
+    docdb::KeyBytes key;
+    docdb::AppendApplyTransactionStateKey(data.transaction_id, &key);
+    intents_write_batch.Put(key.AsSlice(), state_pb.SerializeAsString());
+  }
 
   // data.hybrid_time contains transaction commit time.
   // We don't set transaction field of put_batch, otherwise we would write another bunch of intents.
@@ -1369,31 +1549,88 @@ Status Tablet::ApplyIntents(const TransactionApplyData& data) {
   set_hybrid_time(data.log_ht, &frontiers);
   WriteBatch(&frontiers, data.commit_ht, &regular_write_batch, regular_db_.get());
   WriteBatch(&frontiers, data.commit_ht, &intents_write_batch, intents_db_.get());
-  return Status::OK();
+  return apply_state;
 }
 
-CHECKED_STATUS Tablet::RemoveIntents(const TransactionId& id) {
+// Batches applied in background are not ordered with Raft operations, so they are written
+// without frontiers and don't remove intents. Intents are removed only after all records
+// of transaction were flushed to regular DB, otherwise records could be lost after restart,
+// because intents DB could be flushed before regular DB.
+// Until then apply state stored in intents DB points to the second batch, so after restart
+// apply is restarted from it, rewriting the same records.
+Result<docdb::ApplyTransactionState> Tablet::ContinueApplyIntents(
+    const TransactionApplyData& data) {
+  if (RandomActWithProbability(FLAGS_txn_continue_apply_failure_probability)) {
+    return STATUS(IOError, "Injected failure to apply intents");
+  }
+
+  // Already marked tombstones are skipped cheaply, so each batch marks them instead of relying
+  // on the first one.
+  MarkAllRangeTombstonesOverwritten(data.commit_ht);
+
+  rocksdb::WriteBatch regular_write_batch;
+  auto apply_state = VERIFY_RESULT(docdb::PrepareApplyIntentsBatch(
+      data.transaction_id, data.commit_ht, data.apply_state, FLAGS_txn_max_apply_batch_records,
+      &regular_write_batch, intents_db_.get(), nullptr /* intents_batch */));
+  WriteBatch(nullptr /* frontiers */, data.commit_ht, &regular_write_batch, regular_db_.get());
+  if (apply_state.active()) {
+    return apply_state;
+  }
+
+  rocksdb::FlushOptions flush_options;
+  flush_options.wait = true;
+  RETURN_NOT_OK(regular_db_->Flush(flush_options));
+
+  RETURN_NOT_OK(RemoveIntents(data.transaction_id));
+
   rocksdb::WriteBatch intents_write_batch;
-  RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
-      id, HybridTime() /* commit_ht */, nullptr /* regular_write_batch */,
-      intents_db_.get(), &intents_write_batch));
+  docdb::KeyBytes key;
+  docdb::AppendApplyTransactionStateKey(data.transaction_id, &key);
+  intents_write_batch.Delete(key.AsSlice());
+  RETURN_NOT_OK(WriteIntentsBatch(&intents_write_batch));
 
-  rocksdb::WriteOptions write_options;
-  InitRocksDBWriteOptions(&write_options);
-  return intents_db_->Write(write_options, &intents_write_batch);
+  return apply_state;
+}
+
+CHECKED_STATUS Tablet::RemoveIntents(const TransactionId& id) {
+  rocksdb::WriteBatch intents_write_batch;
+  RETURN_NOT_OK(PrepareRemoveIntentsBatch(id, &intents_write_batch));
+  return WriteIntentsBatch(&intents_write_batch);
 }
 
 CHECKED_STATUS Tablet::RemoveIntents(const TransactionIdSet& transactions) {
   rocksdb::WriteBatch intents_write_batch;
   for (const TransactionId& id : transactions) {
-    RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
-        id, HybridTime() /* commit_ht */, nullptr /* regular_write_batch */,
-        intents_db_.get(), &intents_write_batch));
+    RETURN_NOT_OK(PrepareRemoveIntentsBatch(id, &intents_write_batch));
+    if (intents_write_batch.Count() >= FLAGS_txn_max_apply_batch_records) {
+      RETURN_NOT_OK(WriteIntentsBatch(&intents_write_batch));
+    }
+  }
+
+  return WriteIntentsBatch(&intents_write_batch);
+}
+
+Status Tablet::PrepareRemoveIntentsBatch(
+    const TransactionId& id, rocksdb::WriteBatch* intents_write_batch) {
+  docdb::ApplyTransactionState apply_state;
+  for (;;) {
+    apply_state = VERIFY_RESULT(docdb::PrepareApplyIntentsBatch(
+        id, HybridTime() /* commit_ht */, apply_state.active() ? &apply_state : nullptr,
+        FLAGS_txn_max_apply_batch_records, nullptr /* regular_write_batch */, intents_db_.get(),
+        intents_write_batch));
+    if (!apply_state.active()) {
+      return Status::OK();
+    }
+    RETURN_NOT_OK(WriteIntentsBatch(intents_write_batch));
   }
+}
 
+Status Tablet::WriteIntentsBatch(rocksdb::WriteBatch* intents_write_batch) {
   rocksdb::WriteOptions write_options;
   InitRocksDBWriteOptions(&write_options);
-  return intents_db_->Write(write_options, &intents_write_batch);
+  auto status = intents_db_->Write(write_options, intents_write_batch);
+  intents_write_batch->Clear();
+  return status;
 }
 
 HybridTime Tablet::ApplierSafeTime(HybridTime min_allowed, CoarseTimePoint deadline) {
@@ -1433,13 +1670,22 @@ Status Tablet::AddTable(const TableInfoPB& table_info) {
 
   metadata_->AddTable(
       table_info.table_id(), table_info.table_name(), table_info.table_type(), schema, IndexMap(),
-      partition_schema, boost::none, table_info.schema_version());
+      partition_schema,
+      table_info.has_index_info() ? boost::optional<IndexInfo>(IndexInfo(table_info.index_info()))
+                                  : boost::none,
+      table_info.schema_version());
 
   RETURN_NOT_OK(metadata_->Flush());
 
   return Status::OK();
 }
 
+Status Tablet::RemoveTable(const std::string& table_id) {
+  metadata_->RemoveTable(table_id);
+  RETURN_NOT_OK(metadata_->Flush());
+  return Status::OK();
+}
+
 Status Tablet::AlterSchema(ChangeMetadataOperationState *operation_state) {
   DCHECK(key_schema_.KeyEquals(*DCHECK_NOTNULL(operation_state->schema())))
       << "Schema keys cannot be altered";
@@ -1592,6 +1838,10 @@ Status Tablet::Truncate(TruncateOperationState *state) {
     return STATUS(IllegalState, "Failed to clean up db dir", s.ToString());
   }
 
+  // Range tombstones are not needed for the empty database.
+  metadata_->SetRangeTombstones(docdb::RangeTombstoneVector());
+  RETURN_NOT_OK(metadata_->Flush());
+
   // Create a new database.
   // Note: db_dir == metadata()->rocksdb_dir() is still valid db dir.
   s = OpenKeyValueTablet();
@@ -1614,6 +1864,79 @@ Status Tablet::Truncate(TruncateOperationState *state) {
   return Status::OK();
 }
 
+Status Tablet::IngestSst(IngestSstOperationState* state) {
+  ScopedPendingOperation scoped_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_operation);
+
+  const auto& request = *state->request();
+  auto* env = metadata_->fs_manager()->env();
+  const auto staging_dir = JoinPathSegments(
+      metadata_->rocksdb_dir() + kIngestDirSuffix, request.ingestion_id());
+
+  if (request.abort()) {
+    LOG_WITH_PREFIX(INFO) << "Aborting ingestion " << request.ingestion_id();
+    return RemoveIngestStagingDir(staging_dir);
+  }
+
+  if (request.commit()) {
+    docdb::ConsensusFrontier frontier;
+    frontier.set_op_id({state->op_id().term(), state->op_id().index()});
+    frontier.set_hybrid_time(state->hybrid_time());
+    // Flushed frontier is updated together with imported files, so import is not replayed
+    // during bootstrap once it succeeded.
+    // Staged files were validated by the leader before the commit was replicated, so failure
+    // here means that this replica diverged, and the tablet should not continue.
+    if (!env->FileExists(staging_dir)) {
+      return STATUS_FORMAT(
+          NotFound, "Ingestion $0 has no staged files, replica could be remote bootstrapped "
+                    "after they were staged", request.ingestion_id());
+    }
+    MarkAllRangeTombstonesOverwritten(HybridTime::kMax);
+    RETURN_NOT_OK(FlushRangeTombstones());
+    RETURN_NOT_OK_PREPEND(regular_db_->Import(staging_dir, frontier.Clone()),
+                          Format("Failed to commit ingestion $0", request.ingestion_id()));
+    LOG_WITH_PREFIX(INFO) << "Committed ingestion " << request.ingestion_id();
+    return RemoveIngestStagingDir(staging_dir);
+  }
+
+  RETURN_NOT_OK(env->CreateDirs(staging_dir));
+  const auto file_path = JoinPathSegments(staging_dir, request.file_name());
+  RWFileOptions options;
+  if (request.offset() == 0) {
+    options.mode = Env::CREATE_IF_NON_EXISTING_TRUNCATE;
+  } else {
+    // Chunks are written at their offsets, so replaying them during bootstrap is idempotent.
+    options.mode = env->FileExists(file_path) ? Env::OPEN_EXISTING : Env::CREATE_NON_EXISTING;
+  }
+  gscoped_ptr<RWFile> file;
+  RETURN_NOT_OK(env->NewRWFile(options, file_path, &file));
+  RETURN_NOT_OK(file->Write(request.offset(), request.data()));
+  // Staged chunks are not covered by the flushed frontier of RocksDB, so they should be durable
+  // before the operation could be garbage collected from the log.
+  RETURN_NOT_OK(file->Sync());
+  return file->Close();
+}
+
+Status Tablet::ValidateIngestion(const std::string& ingestion_id) {
+  ScopedPendingOperation scoped_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_operation);
+
+  const auto staging_dir = JoinPathSegments(
+      metadata_->rocksdb_dir() + kIngestDirSuffix, ingestion_id);
+  if (!metadata_->fs_manager()->env()->FileExists(staging_dir)) {
+    return STATUS_FORMAT(NotFound, "Ingestion $0 has no staged files", ingestion_id);
+  }
+  return regular_db_->ValidateImport(staging_dir);
+}
+
+Status Tablet::RemoveIngestStagingDir(const std::string& staging_dir) {
+  auto* env = metadata_->fs_manager()->env();
+  if (!env->FileExists(staging_dir)) {
+    return Status::OK();
+  }
+  return env->DeleteRecursively(staging_dir);
+}
+
 void Tablet::UpdateMonotonicCounter(int64_t value) {
   int64_t counter = monotonic_counter_;
   while (true) {
@@ -1757,7 +2080,7 @@ Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
     if (isolation_level == IsolationLevel::NON_TRANSACTIONAL) {
       auto now = clock_->Now();
       auto result = VERIFY_RESULT(docdb::ResolveOperationConflicts(
-          operation->doc_ops(), now, { regular_db_.get(), intents_db_.get() },
+          operation->doc_ops(), now, doc_db(),
           transaction_participant_.get()));
       if (now != result) {
         clock_->Update(result);
@@ -1785,7 +2108,7 @@ Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
       RETURN_NOT_OK(docdb::ResolveTransactionConflicts(
           operation->doc_ops(), *write_batch, clock_->Now(),
           read_time ? read_time.read : HybridTime::kMax,
-          { regular_db_.get(), intents_db_.get() }, transaction_participant_.get(),
+          doc_db(), transaction_participant_.get(),
           metrics_->transaction_conflicts.get()));
 
       if (!read_time) {
@@ -1819,7 +2142,7 @@ Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
   for (;;) {
     RETURN_NOT_OK(docdb::ExecuteDocWriteOperation(
         operation->doc_ops(), operation->deadline(), real_read_time,
-        { regular_db_.get(), intents_db_.get() }, write_batch,
+        doc_db(), write_batch,
         table_type_ == TableType::REDIS_TABLE_TYPE
             ? InitMarkerBehavior::kRequired
             : InitMarkerBehavior::kOptional,
@@ -1842,6 +2165,7 @@ Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
     restart_read_ht = HybridTime();
 
     operation->request()->mutable_write_batch()->clear_write_pairs();
+    operation->request()->mutable_write_batch()->clear_range_tombstones();
 
     for (auto& doc_op : operation->doc_ops()) {
       doc_op->ClearResponse();
@@ -1966,7 +2290,7 @@ std::string Tablet::TEST_DocDBDumpStr(IncludeIntents include_intents) {
     return docdb::DocDBDebugDumpToStr(regular_db_.get());
   }
 
-  return docdb::DocDBDebugDumpToStr(docdb::DocDB{regular_db_.get(), intents_db_.get()});
+  return docdb::DocDBDebugDumpToStr(doc_db());
 }
 
 size_t Tablet::TEST_CountRocksDBRecords() {
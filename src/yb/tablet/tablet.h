@@ -56,6 +56,7 @@
 #include "yb/docdb/docdb_compaction_filter.h"
 #include "yb/docdb/doc_operation.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
+#include "yb/docdb/range_tombstones.h"
 #include "yb/docdb/shared_lock_manager.h"
 
 #include "yb/gutil/atomicops.h"
@@ -117,6 +118,7 @@ struct TransactionApplyData;
 class TransactionCoordinator;
 class TransactionCoordinatorContext;
 class TransactionParticipant;
+class IngestSstOperationState;
 class TruncateOperationState;
 class WriteOperationState;
 
@@ -243,7 +245,7 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   CHECKED_STATUS ImportData(const std::string& source_dir);
 
-  CHECKED_STATUS ApplyIntents(const TransactionApplyData& data) override;
+  Result<docdb::ApplyTransactionState> ApplyIntents(const TransactionApplyData& data) override;
 
   CHECKED_STATUS RemoveIntents(const TransactionId& id) override;
 
@@ -380,9 +382,20 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Apply replicated add table operation.
   CHECKED_STATUS AddTable(const TableInfoPB& table_info);
 
+  // Apply replicated remove table operation.
+  CHECKED_STATUS RemoveTable(const std::string& table_id);
+
   // Truncate this tablet by resetting the content of RocksDB.
   CHECKED_STATUS Truncate(TruncateOperationState* state);
 
+  // Apply replicated ingest SST operation: writes chunk of SST file to the staging directory of
+  // ingestion, imports staged files to regular DB on commit or removes them on abort.
+  CHECKED_STATUS IngestSst(IngestSstOperationState* state);
+
+  // Checks that files staged by the ingestion could be imported to regular DB. Invoked by the
+  // leader before replicating the commit, so replicas do not diverge on a failed import.
+  CHECKED_STATUS ValidateIngestion(const std::string& ingestion_id);
+
   // Verbosely dump this entire tablet to the logs. This is only
   // really useful when debugging unit tests failures where the tablet
   // has a very small number of rows.
@@ -452,6 +465,11 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // The HybridTime of the oldest write that is still not scheduled to be flushed in RocksDB.
   TabletFlushStats* flush_stats() const { return flush_stats_.get(); }
 
+  const docdb::RangeTombstones& range_tombstones() const { return range_tombstones_; }
+
+  // Removes range tombstones, whose records were purged by the completed compaction of regular DB.
+  void CleanupRangeTombstones(const rocksdb::CompactionJobInfo& info);
+
   const scoped_refptr<server::Clock> &clock() const {
     return clock_;
   }
@@ -565,6 +583,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Pause any new read/write operations and wait for all pending read/write operations to finish.
   util::ScopedPendingOperationPause PauseReadWriteOperations();
 
+  CHECKED_STATUS RemoveIngestStagingDir(const std::string& staging_dir);
+
   std::string LogPrefix() const;
 
   // Lock protecting schema_ and key_schema_.
@@ -681,6 +701,15 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::unique_ptr<TransactionParticipant> transaction_participant_;
 
+  // Range tombstones of regular DB, persisted in tablet metadata until full compaction purges
+  // records deleted by them.
+  docdb::RangeTombstones range_tombstones_;
+
+  std::mutex range_tombstones_flush_mutex_;
+  // Snapshot of range_tombstones_ that was saved to tablet metadata.
+  docdb::RangeTombstoneVectorPtr flushed_range_tombstones_
+      GUARDED_BY(range_tombstones_flush_mutex_);
+
   std::shared_future<client::YBClient*> client_future_;
 
   // Created only when secondary indexes are present.
@@ -702,11 +731,41 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   HybridTime DoGetSafeTime(
       RequireLease require_lease, HybridTime min_allowed, CoarseTimePoint deadline) const override;
 
+  docdb::DocDB doc_db() const {
+    return { regular_db_.get(), intents_db_.get(), &range_tombstones_ };
+  }
+
+  // Registers range tombstones of the write batch at the hybrid time of the operation.
+  void AddRangeTombstones(const docdb::KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time);
+
+  // Marks all range tombstones written at or before hybrid_time as overwritten. Used when keys
+  // of written records are not known, i.e. for transactions and imported files, that are not
+  // mixed with range deletions in practice.
+  void MarkAllRangeTombstonesOverwritten(HybridTime hybrid_time);
+
+  // Saves current range tombstones to tablet metadata, if they were changed since the last save.
+  CHECKED_STATUS FlushRangeTombstones();
+
+  // Called before flush of regular DB memtable. Returns false if range tombstones could not be
+  // saved, so memtable should not be flushed yet.
+  bool PersistRangeTombstonesBeforeFlush();
+
   void UpdateQLIndexes(std::unique_ptr<WriteOperation> operation);
   void CompleteQLWriteBatch(std::unique_ptr<WriteOperation> operation, const Status& status);
 
   Result<bool> IntentsDbFlushFilter(const rocksdb::MemTable& memtable);
 
+  // Applies next batch of intents of transaction, that is applied in several batches.
+  Result<docdb::ApplyTransactionState> ContinueApplyIntents(const TransactionApplyData& data);
+
+  // Adds removal of transaction intents to intents_write_batch. Large transactions are removed
+  // in several batches, filled batch is written to intents DB and cleared.
+  CHECKED_STATUS PrepareRemoveIntentsBatch(
+      const TransactionId& id, rocksdb::WriteBatch* intents_write_batch);
+
+  // Writes batch to intents DB and clears it.
+  CHECKED_STATUS WriteIntentsBatch(rocksdb::WriteBatch* intents_write_batch);
+
   std::function<rocksdb::MemTableFilter()> mem_table_flush_filter_factory_;
 
   client::LocalTabletFilter local_tablet_filter_;
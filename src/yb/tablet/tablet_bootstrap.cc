@@ -40,6 +40,7 @@
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/ingest_sst_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/operations/write_operation.h"
@@ -98,6 +99,7 @@ using consensus::OpIdToString;
 using consensus::ReplicateMsg;
 using strings::Substitute;
 using tserver::ChangeMetadataRequestPB;
+using tserver::IngestSstRequestPB;
 using tserver::TruncateRequestPB;
 using tserver::WriteRequestPB;
 
@@ -151,15 +153,18 @@ struct ReplayState {
 
   bool CanApply(log::LogEntryPB* entry);
 
+  // Stops at the first entry that could not be applied, so bootstrap fails instead of continuing
+  // with diverged data.
   template<class Handler>
-  void ApplyCommittedPendingReplicates(const Handler& handler) {
+  CHECKED_STATUS ApplyCommittedPendingReplicates(const Handler& handler) {
     auto iter = pending_replicates.begin();
     while (iter != pending_replicates.end() && CanApply(iter->second.entry.get())) {
       std::unique_ptr<log::LogEntryPB> entry = std::move(iter->second.entry);
-      handler(entry.get(), iter->second.entry_time);
+      RETURN_NOT_OK(handler(entry.get(), iter->second.entry_time));
       iter = pending_replicates.erase(iter);  // erase and advance the iterator (C++11)
       ++num_entries_applied_to_rocksdb;
     }
+    return Status::OK();
   }
 
   bool UpdateCommittedFromStored();
@@ -662,10 +667,8 @@ Status TabletBootstrap::HandleReplicateMessage(
   // that entry. This allows us to decide when we can replay a REPLICATE entry during bootstrap.
   state->UpdateCommittedOpId(replicate.committed_op_id());
 
-  state->ApplyCommittedPendingReplicates(
+  return state->ApplyCommittedPendingReplicates(
       std::bind(&TabletBootstrap::HandleEntryPair, this, state, _1, _2));
-
-  return Status::OK();
 }
 
 Status TabletBootstrap::HandleOperation(consensus::OperationType op_type,
@@ -684,6 +687,9 @@ Status TabletBootstrap::HandleOperation(consensus::OperationType op_type,
     case consensus::TRUNCATE_OP:
       return PlayTruncateRequest(replicate);
 
+    case consensus::INGEST_SST_OP:
+      return PlayIngestSstRequest(replicate);
+
     case consensus::NO_OP:
       return PlayNoOpRequest(replicate);
 
@@ -853,8 +859,8 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   }
 
   if (state.UpdateCommittedFromStored()) {
-    state.ApplyCommittedPendingReplicates(
-        std::bind(&TabletBootstrap::HandleEntryPair, this, &state, _1, _2));
+    RETURN_NOT_OK(state.ApplyCommittedPendingReplicates(
+        std::bind(&TabletBootstrap::HandleEntryPair, this, &state, _1, _2)));
   }
 
   if (last_committed_op_id.index > state.committed_op_id.index()) {
@@ -864,8 +870,8 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
       // be overriden by a new leader.
       if (last_committed_op_id.term == it->second.entry->replicate().id().term()) {
         state.UpdateCommittedOpId(last_committed_op_id.ToPB<consensus::OpId>());
-        state.ApplyCommittedPendingReplicates(
-            std::bind(&TabletBootstrap::HandleEntryPair, this, &state, _1, _2));
+        RETURN_NOT_OK(state.ApplyCommittedPendingReplicates(
+            std::bind(&TabletBootstrap::HandleEntryPair, this, &state, _1, _2)));
       } else {
         LOG_WITH_PREFIX(DFATAL)
             << "Invalid last committed op id: " << last_committed_op_id
@@ -997,6 +1003,18 @@ Status TabletBootstrap::PlayTruncateRequest(ReplicateMsg* replicate_msg) {
   return Status::OK();
 }
 
+Status TabletBootstrap::PlayIngestSstRequest(ReplicateMsg* replicate_msg) {
+  IngestSstRequestPB* req = replicate_msg->mutable_ingest_sst_request();
+
+  IngestSstOperationState operation_state(nullptr, req);
+  operation_state.mutable_op_id()->CopyFrom(replicate_msg->id());
+  operation_state.set_hybrid_time(HybridTime(replicate_msg->hybrid_time()));
+
+  RETURN_NOT_OK_PREPEND(tablet_->IngestSst(&operation_state), "Failed to ingest SST:");
+
+  return Status::OK();
+}
+
 Status TabletBootstrap::PlayUpdateTransactionRequest(
     ReplicateMsg* replicate_msg, AlreadyApplied already_applied) {
   DCHECK(replicate_msg->has_hybrid_time());
@@ -82,6 +82,7 @@ namespace tablet {
 const int64 kNoDurableMemStore = -1;
 const std::string kIntentsSubdir = "intents";
 const std::string kIntentsDBSuffix = ".intents";
+const std::string kIngestDirSuffix = ".ingest";
 
 // ============================================================================
 //  Raft group metadata
@@ -186,6 +187,11 @@ Status KvStoreInfo::LoadTablesFromPB(
 Status KvStoreInfo::LoadFromPB(const KvStoreInfoPB& pb, TableId primary_table_id) {
   kv_store_id = KvStoreId(pb.kv_store_id());
   rocksdb_dir = pb.rocksdb_dir();
+  range_tombstones.clear();
+  range_tombstones.reserve(pb.range_tombstones().size());
+  for (const auto& tombstone_pb : pb.range_tombstones()) {
+    range_tombstones.push_back(docdb::RangeTombstone::FromPB(tombstone_pb));
+  }
   return LoadTablesFromPB(pb.tables(), primary_table_id);
 }
 
@@ -203,6 +209,10 @@ void KvStoreInfo::ToPB(TableId primary_table_id, KvStoreInfoPB* pb) const {
       it.second->ToPB(pb->add_tables());
     }
   }
+
+  for (const auto& tombstone : range_tombstones) {
+    tombstone.ToPB(pb->add_range_tombstones());
+  }
 }
 
 // ============================================================================
@@ -391,6 +401,12 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
     }
   }
 
+  const auto ingest_dir = rocksdb_dir + kIngestDirSuffix;
+  if (fs_manager_->env()->FileExists(ingest_dir)) {
+    const Status s = fs_manager_->env()->DeleteRecursively(ingest_dir);
+    LOG_IF(ERROR, !s.ok()) << "Failed to remove staged ingestions at: " << ingest_dir << ": " << s;
+  }
+
   // Flushing will sync the new tablet_data_state_ to disk and will now also
   // delete all the data.
   RETURN_NOT_OK(Flush());
@@ -631,6 +647,16 @@ void RaftGroupMetadata::SetTableName(const string& table_name) {
   tables[primary_table_id_]->table_name = table_name;
 }
 
+docdb::RangeTombstoneVector RaftGroupMetadata::range_tombstones() const {
+  std::lock_guard<LockType> l(data_lock_);
+  return kv_store_.range_tombstones;
+}
+
+void RaftGroupMetadata::SetRangeTombstones(docdb::RangeTombstoneVector range_tombstones) {
+  std::lock_guard<LockType> l(data_lock_);
+  kv_store_.range_tombstones = std::move(range_tombstones);
+}
+
 void RaftGroupMetadata::AddTable(const std::string& table_id,
                               const std::string& table_name,
                               const TableType table_type,
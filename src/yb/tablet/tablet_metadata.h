@@ -44,6 +44,7 @@
 #include "yb/common/partition.h"
 #include "yb/common/schema.h"
 #include "yb/consensus/opid_util.h"
+#include "yb/docdb/range_tombstones.h"
 #include "yb/fs/fs_manager.h"
 #include "yb/gutil/callback.h"
 #include "yb/gutil/dynamic_annotations.h"
@@ -146,6 +147,9 @@ struct KvStoreInfo {
   // tablet won't have thousands of "alter table" calls. Replace the raw pointer with shared_ptr and
   // modify the callers to hold the shared_ptr at the top of the calls (e.g. tserver rpc calls).
   std::vector<std::unique_ptr<TableInfo>> old_tables;
+
+  // Range tombstones of the regular RocksDB, that were not yet purged by full compaction.
+  docdb::RangeTombstoneVector range_tombstones;
 };
 
 // Manages the "blocks tracking" for the specified Raft group.
@@ -309,6 +313,10 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
 
   void SetTableName(const std::string& table_name);
 
+  docdb::RangeTombstoneVector range_tombstones() const;
+
+  void SetRangeTombstones(docdb::RangeTombstoneVector range_tombstones);
+
   void AddTable(const std::string& table_id,
                 const std::string& table_name,
                 const TableType table_type,
@@ -463,6 +471,7 @@ CHECKED_STATUS MigrateSuperblock(RaftGroupReplicaSuperBlockPB* superblock);
 
 extern const std::string kIntentsSubdir;
 extern const std::string kIntentsDBSuffix;
+extern const std::string kIngestDirSuffix;
 
 } // namespace tablet
 } // namespace yb
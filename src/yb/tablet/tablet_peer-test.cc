@@ -44,12 +44,14 @@
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/opid_util.h"
+#include "yb/fs/fs_manager.h"
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/gutil/macros.h"
 #include "yb/rpc/messenger.h"
 #include "yb/server/clock.h"
 #include "yb/server/logical_clock.h"
 #include "yb/tablet/maintenance_manager.h"
+#include "yb/tablet/operations/ingest_sst_operation.h"
 #include "yb/tablet/operations/operation.h"
 #include "yb/tablet/operations/operation_driver.h"
 #include "yb/tablet/operations/write_operation.h"
@@ -58,6 +60,7 @@
 #include "yb/tablet/tablet-test-util.h"
 #include "yb/tserver/tserver.pb.h"
 #include "yb/util/metrics.h"
+#include "yb/util/path_util.h"
 #include "yb/util/test_util.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/threadpool.h"
@@ -89,6 +92,7 @@ using server::LogicalClock;
 using std::shared_ptr;
 using std::string;
 using strings::Substitute;
+using tserver::IngestSstRequestPB;
 using tserver::WriteRequestPB;
 using tserver::WriteResponsePB;
 
@@ -271,6 +275,18 @@ class TabletPeerTest : public YBTabletTest,
       << " (expected any value earlier than last log id: " << last_log_opid << ")";
   }
 
+  Status ExecuteIngestSst(const IngestSstRequestPB& req) {
+    auto operation_state = std::make_unique<IngestSstOperationState>(
+        tablet_peer_->tablet(), &req);
+    Synchronizer synchronizer;
+    operation_state->set_completion_callback(
+        std::make_unique<SynchronizerOperationCompletionCallback>(&synchronizer));
+    tablet_peer_->Submit(
+        std::make_unique<IngestSstOperation>(std::move(operation_state), tablet_peer_.get()),
+        tablet_peer_->LeaderTerm());
+    return synchronizer.Wait();
+  }
+
   int32_t EarliestNeededIndex() const {
     auto max_persistent_op_id = tablet_peer_->tablet()->MaxPersistentOpId();
     EXPECT_OK(max_persistent_op_id);
@@ -461,6 +477,38 @@ TEST_P(TabletPeerTest, TestGCEmptyLog) {
   ASSERT_OK(tablet_peer_->RunLogGC());
 }
 
+// Replica that was remote bootstrapped in the middle of ingestion does not have chunks staged
+// before. Commit of such ingestion fails only the tablet, instead of the whole server.
+TEST_P(TabletPeerTest, IngestSstCommitWithMissingStagedChunks) {
+  ConsensusBootstrapInfo info;
+  ASSERT_OK(StartPeer(info));
+
+  const std::string kIngestionId = "test_ingestion";
+  IngestSstRequestPB req;
+  req.set_tablet_id(tablet()->tablet_id());
+  req.set_ingestion_id(kIngestionId);
+  req.set_file_name("000001.sst");
+  req.set_offset(0);
+  req.set_data("chunk");
+  ASSERT_OK(ExecuteIngestSst(req));
+
+  auto* env = tablet()->metadata()->fs_manager()->env();
+  const auto staging_dir = JoinPathSegments(
+      tablet()->metadata()->rocksdb_dir() + kIngestDirSuffix, kIngestionId);
+  ASSERT_TRUE(env->FileExists(staging_dir));
+  ASSERT_OK(env->DeleteRecursively(staging_dir));
+
+  IngestSstRequestPB commit_req;
+  commit_req.set_tablet_id(tablet()->tablet_id());
+  commit_req.set_ingestion_id(kIngestionId);
+  commit_req.set_commit(true);
+  ASSERT_NOK(ExecuteIngestSst(commit_req));
+
+  ASSERT_EQ(RaftGroupStatePB::FAILED, tablet_peer_->state());
+  ASSERT_NOK(tablet_peer_->error());
+  ASSERT_NOK(tablet_peer_->CheckRunning());
+}
+
 INSTANTIATE_TEST_CASE_P(Rocks, TabletPeerTest, ::testing::Values(YQL_TABLE_TYPE));
 
 } // namespace tablet
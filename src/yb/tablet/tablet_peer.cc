@@ -72,6 +72,7 @@
 
 #include "yb/tablet/operations/change_metadata_operation.h"
 #include "yb/tablet/operations/operation_driver.h"
+#include "yb/tablet/operations/ingest_sst_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
@@ -169,7 +170,8 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
                                   const scoped_refptr<MetricEntity> &metric_entity,
                                   ThreadPool* raft_pool,
                                   ThreadPool* tablet_prepare_pool,
-                                  consensus::RetryableRequests* retryable_requests) {
+                                  consensus::RetryableRequests* retryable_requests,
+                                  consensus::MultiRaftManager* multi_raft_manager) {
 
   DCHECK(tablet) << "A TabletPeer must be provided with a Tablet";
   DCHECK(log) << "A TabletPeer must be provided with a Log";
@@ -246,7 +248,8 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
         mark_dirty_clbk_,
         tablet_->table_type(),
         raft_pool,
-        retryable_requests);
+        retryable_requests,
+        multi_raft_manager);
     has_consensus_.store(true, std::memory_order_release);
     auto ht_lease_provider = [this](MicrosTime min_allowed, CoarseTimePoint deadline) {
       MicrosTime lease_micros {
@@ -321,6 +324,10 @@ Status TabletPeer::Start(const ConsensusBootstrapInfo& bootstrap_info) {
   // Because we changed the tablet state, we need to re-report the tablet to the master.
   mark_dirty_clbk_.Run(context);
 
+  if (tablet_->transaction_participant()) {
+    tablet_->transaction_participant()->ResumeApplies();
+  }
+
   return tablet_->EnableCompactions();
 }
 
@@ -610,6 +617,9 @@ consensus::OperationType MapOperationTypeToPB(OperationType operation_type) {
     case OperationType::kTruncate:
       return consensus::TRUNCATE_OP;
 
+    case OperationType::kIngestSst:
+      return consensus::INGEST_SST_OP;
+
     case OperationType::kEmpty:
       LOG(FATAL) << "OperationType::kEmpty cannot be converted to consensus::OperationType";
   }
@@ -773,6 +783,12 @@ std::unique_ptr<Operation> TabletPeer::CreateOperation(consensus::ReplicateMsg*
       return std::make_unique<TruncateOperation>(
           std::make_unique<TruncateOperationState>(tablet()));
 
+    case consensus::INGEST_SST_OP:
+      DCHECK(replicate_msg->has_ingest_sst_request()) << "INGEST_SST_OP replica"
+          " operation must receive an IngestSstRequestPB";
+      return std::make_unique<IngestSstOperation>(
+          std::make_unique<IngestSstOperationState>(tablet()), this);
+
     case consensus::SNAPSHOT_OP: FALLTHROUGH_INTENDED;
     case consensus::UNKNOWN_OP: FALLTHROUGH_INTENDED;
     case consensus::NO_OP: FALLTHROUGH_INTENDED;
@@ -962,6 +978,14 @@ void TabletPeer::SetFailed(const Status& error) {
   }
 }
 
+void TabletPeer::IngestSstFailed(const Status& error) {
+  // Operations are applied sequentially, so the state could not be changed to FAILED concurrently.
+  if (state() == RaftGroupStatePB::FAILED) {
+    return;
+  }
+  SetFailed(error);
+}
+
 Status TabletPeer::UpdateState(RaftGroupStatePB expected, RaftGroupStatePB new_state,
                                const std::string& error_message) {
   RaftGroupStatePB old = expected;
@@ -53,6 +53,7 @@
 #include "yb/tablet/transaction_coordinator.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/operation_order_verifier.h"
+#include "yb/tablet/operations/ingest_sst_operation.h"
 #include "yb/tablet/operations/operation_tracker.h"
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/preparer.h"
@@ -95,7 +96,8 @@ class Operation;
 class TabletPeer : public consensus::ReplicaOperationFactory,
                    public TransactionParticipantContext,
                    public TransactionCoordinatorContext,
-                   public WriteOperationContext {
+                   public WriteOperationContext,
+                   public IngestSstOperationContext {
  public:
   typedef std::map<int64_t, int64_t> MaxIdxToSegmentSizeMap;
 
@@ -117,7 +119,8 @@ class TabletPeer : public consensus::ReplicaOperationFactory,
                                 const scoped_refptr<MetricEntity> &metric_entity,
                                 ThreadPool* raft_pool,
                                 ThreadPool* tablet_prepare_pool,
-                                consensus::RetryableRequests* retryable_requests);
+                                consensus::RetryableRequests* retryable_requests,
+                                consensus::MultiRaftManager* multi_raft_manager = nullptr);
 
   // Starts the TabletPeer, making it available for Write()s. If this
   // TabletPeer is part of a consensus configuration this will connect it to other peers
@@ -217,6 +220,9 @@ class TabletPeer : public consensus::ReplicaOperationFactory,
   // one.
   void SetFailed(const Status& error);
 
+  // Fails the tablet, unless it has already failed.
+  void IngestSstFailed(const Status& error) override;
+
   // Returns the error that occurred, when state is FAILED.
   CHECKED_STATUS error() const {
     Status *error;
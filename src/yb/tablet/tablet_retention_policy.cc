@@ -51,9 +51,14 @@ HistoryRetentionDirective TabletRetentionPolicy::GetRetentionDirective() {
   return {
     history_cutoff,
     std::move(deleted_before_history_cutoff),
-    TableTTL(tablet_->metadata()->schema())
+    TableTTL(tablet_->metadata()->schema()),
+    tablet_->range_tombstones().Get()
   };
 }
 
+MonoDelta TabletRetentionPolicy::GetTableTTL() {
+  return TableTTL(tablet_->metadata()->schema());
+}
+
 }  // namespace tablet
 }  // namespace yb
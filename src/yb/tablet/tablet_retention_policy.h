@@ -30,6 +30,8 @@ class TabletRetentionPolicy : public docdb::HistoryRetentionPolicy {
 
   docdb::HistoryRetentionDirective GetRetentionDirective() override;
 
+  MonoDelta GetTableTTL() override;
+
  private:
   Tablet* tablet_;
 
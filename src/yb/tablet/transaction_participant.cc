@@ -15,6 +15,7 @@
 
 #include "yb/tablet/transaction_participant.h"
 
+#include <condition_variable>
 #include <mutex>
 #include <queue>
 
@@ -55,6 +56,14 @@ DEFINE_uint64(transaction_delay_status_reply_usec_in_tests, 0,
               "For tests only. Delay handling status reply by specified amount of usec.");
 DEFINE_double(transaction_ignore_applying_probability_in_tests, 0,
               "Probability to ignore APPLYING update in tests.");
+DEFINE_int32(transaction_apply_retry_initial_delay_ms, 100,
+             "Delay before the first retry of failed background apply of transaction intents. "
+             "Doubled after each failed attempt.");
+DEFINE_int32(transaction_apply_retry_max_delay_ms, 10000,
+             "Max delay between retries of failed background apply of transaction intents.");
+DEFINE_int32(transaction_status_cache_ttl_ms, 20,
+             "Time during which PENDING transaction status received from coordinator could be "
+             "reused by conflict resolution without sending new status request.");
 
 namespace yb {
 namespace tablet {
@@ -130,6 +139,15 @@ class RunningTransaction;
 
 typedef std::shared_ptr<RunningTransaction> RunningTransactionPtr;
 
+// Transaction whose status should be requested from coordinator, with serial no of this request.
+struct StatusRequestTarget {
+  RunningTransactionPtr transaction;
+  int64_t serial_no;
+};
+
+// Status requests grouped by status tablet, so one RPC is sent per status tablet.
+typedef std::unordered_map<TabletId, std::vector<StatusRequestTarget>> StatusRequestBatches;
+
 class RunningTransactionContext {
  public:
   RunningTransactionContext(TransactionParticipantContext* participant_context,
@@ -141,6 +159,8 @@ class RunningTransactionContext {
 
   virtual bool RemoveUnlocked(const TransactionId& id) = 0;
 
+  virtual void SendStatusRequests(StatusRequestBatches* batches) = 0;
+
   int64_t NextRequestIdUnlocked() {
     return ++request_serial_;
   }
@@ -264,6 +284,8 @@ class CleanupAbortsTask : public rpc::ThreadPoolTask {
     auto now = participant_context_.Now();
     auto tid = std::this_thread::get_id();
 
+    static const std::string kRequestReason = "cleanup"s;
+    std::vector<StatusRequest> requests;
     for (const TransactionId& transaction_id : transactions_to_cleanup_) {
       VLOG(1) << "Checking if transaction needs to be cleaned up: " << transaction_id;
 
@@ -279,9 +301,8 @@ class CleanupAbortsTask : public rpc::ThreadPoolTask {
         continue;
       }
 
-      static const std::string kRequestReason = "cleanup"s;
       // Get transaction status
-      StatusRequest request = {
+      requests.push_back(StatusRequest {
           &transaction_id,
           now,
           now,
@@ -304,10 +325,13 @@ class CleanupAbortsTask : public rpc::ThreadPoolTask {
             if (--left_wait == 0) {
               cond_.notify_one();
             }
-          }
-      };
-      status_manager_.RequestStatusAt(request);
+          },
+          AllowRecentPending::kFalse
+      });
     }
+    // Statuses are requested in batch, so transactions sharing status tablet are checked using
+    // single RPC.
+    status_manager_.RequestStatusesAt(requests);
 
     cond_.wait(lock, [&left_wait] { return left_wait == 0; });
 
@@ -336,12 +360,11 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
         context_(*context),
         remove_intents_task_(&context->applier_, &context->participant_context_,
                              metadata_.transaction_id),
-        get_status_handle_(context->rpcs_.InvalidHandle()),
         abort_handle_(context->rpcs_.InvalidHandle()) {
   }
 
   ~RunningTransaction() {
-    context_.rpcs_.Abort({&get_status_handle_, &abort_handle_});
+    context_.rpcs_.Abort({&abort_handle_});
   }
 
   const TransactionId& id() const {
@@ -368,33 +391,58 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
     local_commit_time_ = time;
   }
 
-  void RequestStatusAt(client::YBClient* client,
-                       const StatusRequest& request,
-                       std::unique_lock<std::mutex>* lock) {
+  // Responds to request using known status or registers it as status waiter.
+  // Returns serial no of status request that should be sent to coordinator, or -1 if
+  // new status request is not required.
+  // The lock is released by this method.
+  int64_t PrepareStatusRequest(const StatusRequest& request, std::unique_lock<std::mutex>* lock) {
     DCHECK_LT(request.global_limit_ht, HybridTime::kMax);
     DCHECK_LE(request.read_ht, request.global_limit_ht);
 
     if (last_known_status_hybrid_time_ > HybridTime::kMin) {
       auto transaction_status =
           GetStatusAt(request.global_limit_ht, last_known_status_hybrid_time_, last_known_status_);
+      if (!transaction_status && request.allow_recent_pending &&
+          CoarseMonoClock::now() < last_known_status_fetch_time_ +
+              FLAGS_transaction_status_cache_ttl_ms * 1ms) {
+        transaction_status = last_known_status_;
+      }
       // If we don't have status at global_limit_ht, then we should request updated status.
       if (transaction_status) {
         HybridTime last_known_status_hybrid_time = last_known_status_hybrid_time_;
         lock->unlock();
         request.callback(
             TransactionStatusResult{*transaction_status, last_known_status_hybrid_time});
-        return;
+        return -1;
       }
     }
     bool was_empty = status_waiters_.empty();
     status_waiters_.push_back(request);
     if (!was_empty) {
-      return;
+      lock->unlock();
+      return -1;
     }
     auto request_id = context_.NextRequestIdUnlocked();
-    auto shared_self = shared_from_this();
     lock->unlock();
-    SendStatusRequest(client, request_id, shared_self);
+    return request_id;
+  }
+
+  // Invoked when status of this transaction is received from coordinator.
+  // status_hybrid_time is HybridTime::kMax when coordinator did not provide it.
+  void StatusReceived(const Status& status,
+                      TransactionStatus transaction_status,
+                      HybridTime status_hybrid_time,
+                      int64_t serial_no,
+                      const RunningTransactionPtr& shared_self) {
+    auto delay_usec = FLAGS_transaction_delay_status_reply_usec_in_tests;
+    if (delay_usec > 0) {
+      delayer_.Delay(
+          MonoTime::Now() + MonoDelta::FromMicroseconds(delay_usec),
+          std::bind(&RunningTransaction::DoStatusReceived, this, status, transaction_status,
+                    status_hybrid_time, serial_no, shared_self));
+    } else {
+      DoStatusReceived(status, transaction_status, status_hybrid_time, serial_no, shared_self);
+    }
   }
 
   void Abort(client::YBClient* client,
@@ -446,49 +494,11 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
     }
   }
 
-  void SendStatusRequest(
-      client::YBClient* client, int64_t serial_no, const RunningTransactionPtr& shared_self) {
-    tserver::GetTransactionStatusRequestPB req;
-    req.set_tablet_id(metadata_.status_tablet);
-    req.set_transaction_id(metadata_.transaction_id.begin(), metadata_.transaction_id.size());
-    req.set_propagated_hybrid_time(context_.participant_context_.Now().ToUint64());
-    context_.rpcs_.RegisterAndStart(
-        client::GetTransactionStatus(
-            TransactionRpcDeadline(),
-            nullptr /* tablet */,
-            client,
-            &req,
-            std::bind(&RunningTransaction::StatusReceived, this, client, _1, _2, serial_no,
-                      shared_self)),
-        &get_status_handle_);
-  }
-
-  void StatusReceived(client::YBClient* client,
-                      const Status& status,
-                      const tserver::GetTransactionStatusResponsePB& response,
-                      int64_t serial_no,
-                      const RunningTransactionPtr& shared_self) {
-    auto delay_usec = FLAGS_transaction_delay_status_reply_usec_in_tests;
-    if (delay_usec > 0) {
-      delayer_.Delay(
-          MonoTime::Now() + MonoDelta::FromMicroseconds(delay_usec),
-          std::bind(&RunningTransaction::DoStatusReceived, this, client, status, response,
-                    serial_no, shared_self));
-    } else {
-      DoStatusReceived(client, status, response, serial_no, shared_self);
-    }
-  }
-
-  void DoStatusReceived(client::YBClient* client,
-                        const Status& status,
-                        const tserver::GetTransactionStatusResponsePB& response,
+  void DoStatusReceived(const Status& status,
+                        TransactionStatus response_status,
+                        HybridTime response_status_hybrid_time,
                         int64_t serial_no,
                         const RunningTransactionPtr& shared_self) {
-    if (response.has_propagated_hybrid_time()) {
-      context_.participant_context_.UpdateClock(HybridTime(response.propagated_hybrid_time()));
-    }
-
-    context_.rpcs_.Unregister(&get_status_handle_);
     decltype(status_waiters_) status_waiters;
     HybridTime time_of_status;
     TransactionStatus transaction_status;
@@ -505,15 +515,14 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
         return;
       }
 
-      DCHECK(response.has_status_hybrid_time() ||
-             response.status() == TransactionStatus::ABORTED);
-      time_of_status = response.has_status_hybrid_time()
-          ? HybridTime(response.status_hybrid_time())
-          : HybridTime::kMax;
+      DCHECK(response_status_hybrid_time != HybridTime::kMax ||
+             response_status == TransactionStatus::ABORTED);
+      time_of_status = response_status_hybrid_time;
       if (last_known_status_hybrid_time_ <= time_of_status) {
         last_known_status_hybrid_time_ = time_of_status;
-        last_known_status_ = response.status();
-        if (response.status() == TransactionStatus::ABORTED) {
+        last_known_status_ = response_status;
+        last_known_status_fetch_time_ = CoarseMonoClock::now();
+        if (response_status == TransactionStatus::ABORTED) {
           if (!local_commit_time_ && remove_intents_task_.Prepare(shared_self)) {
             context_.participant_context_.Enqueue(&remove_intents_task_);
             VLOG_WITH_PREFIX(1) << "Transaction should be aborted: " << id();
@@ -531,7 +540,9 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
       }
     }
     if (new_request_id >= 0) {
-      SendStatusRequest(client, new_request_id, shared_self);
+      StatusRequestBatches batches;
+      batches[metadata_.status_tablet].push_back({shared_self, new_request_id});
+      context_.SendStatusRequests(&batches);
     }
     NotifyWaiters(serial_no, time_of_status, transaction_status, status_waiters);
   }
@@ -615,6 +626,8 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
       std::lock_guard<std::mutex> lock(context_.mutex_);
       context_.rpcs_.Unregister(&abort_handle_);
       abort_waiters_.swap(abort_waiters);
+      // Status was changed by abort, so recently received PENDING status should not be reused.
+      last_known_status_fetch_time_ = CoarseTimePoint();
     }
     auto result = MakeAbortResult(status, response);
     for (const auto& waiter : abort_waiters) {
@@ -634,8 +647,9 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
 
   TransactionStatus last_known_status_;
   HybridTime last_known_status_hybrid_time_ = HybridTime::kMin;
+  // When last_known_status_ was received from coordinator.
+  CoarseTimePoint last_known_status_fetch_time_;
   std::vector<StatusRequest> status_waiters_;
-  rpc::Rpcs::Handle get_status_handle_;
   rpc::Rpcs::Handle abort_handle_;
   std::vector<TransactionStatusCallback> abort_waiters_;
 
@@ -660,10 +674,17 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   }
 
   ~Impl() {
+    Shutdown();
     transactions_.clear();
     rpcs_.Shutdown();
   }
 
+  void Shutdown() {
+    closing_.store(true, std::memory_order_release);
+    std::unique_lock<std::mutex> lock(intents_tasks_mutex_);
+    intents_tasks_cond_.wait(lock, [this] { return running_intents_tasks_ == 0; });
+  }
+
   // Adds new running transaction.
   void Add(const TransactionMetadataPB& data, bool may_have_metadata,
            rocksdb::WriteBatch *write_batch) {
@@ -758,13 +779,25 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   }
 
   void RequestStatusAt(const StatusRequest& request) {
-    auto lock_and_iterator = LockAndFindOrLoad(*request.id, *request.reason, request.must_exist);
-    if (!lock_and_iterator.found()) {
-      request.callback(
-          STATUS_FORMAT(NotFound, "Request status of unknown transaction: $0", *request.id));
-      return;
+    StatusRequestBatches batches;
+    PrepareStatusRequest(request, &batches);
+    SendStatusRequests(&batches);
+  }
+
+  void RequestStatusesAt(const std::vector<StatusRequest>& requests) {
+    StatusRequestBatches batches;
+    for (const auto& request : requests) {
+      PrepareStatusRequest(request, &batches);
     }
-    lock_and_iterator.transaction().RequestStatusAt(client(), request, &lock_and_iterator.lock);
+    SendStatusRequests(&batches);
+  }
+
+  // Sends one GetTransactionStatus RPC per status tablet.
+  void SendStatusRequests(StatusRequestBatches* batches) override {
+    for (auto& batch : *batches) {
+      SendStatusRequest(batch.first, std::move(batch.second));
+    }
+    batches->clear();
   }
 
   // Registers request, giving him newly allocated id and returning this id.
@@ -883,6 +916,16 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   }
 
   CHECKED_STATUS ProcessApply(const TransactionApplyData& data) {
+    {
+      // The coordinator resends APPLYING until it is notified that the transaction was applied,
+      // so the same apply could be replicated again while the previous one is still in progress.
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (applies_in_progress_.count(data.transaction_id)) {
+        VLOG_WITH_PREFIX(2) << "Apply of " << data.transaction_id << " is already in progress";
+        return Status::OK();
+      }
+    }
+
     {
       // It is our last chance to load transaction metadata, if missing.
       // Because it will be deleted when intents are applied.
@@ -899,17 +942,93 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       lock_and_iterator.transaction().SetLocalCommitTime(data.commit_ht);
     }
 
-    CHECK_OK(applier_.ApplyIntents(data));
+    auto apply_state = VERIFY_RESULT(applier_.ApplyIntents(data));
+    if (apply_state.active()) {
+      // Transaction is too big to be applied in one batch, so the rest of its intents is applied
+      // in thread pool. Transaction is kept as running, so its intents are treated as committed
+      // until apply completes.
+      VLOG_WITH_PREFIX(2) << "Continue apply of " << data.transaction_id << " in background: "
+                          << apply_state.ToString();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        applies_in_progress_.insert(data.transaction_id);
+      }
+      ExecuteIntentsTask([this, data, apply_state] {
+        ApplyRemainingIntents(data, apply_state);
+      });
+      return Status::OK();
+    }
 
+    FinishApply(data);
+    return Status::OK();
+  }
+
+  void FinishApply(const TransactionApplyData& data) {
     {
       auto lock_and_iterator = LockAndFindOrLoad(data.transaction_id, "apply"s);
       if (lock_and_iterator.found()) {
         RemoveUnlocked(lock_and_iterator.iterator);
+      } else {
+        lock_and_iterator.lock = std::unique_lock<std::mutex>(mutex_);
       }
+      applies_in_progress_.erase(data.transaction_id);
     }
 
     NotifyApplied(data);
-    return Status::OK();
+  }
+
+  // Applies intents of transaction batch by batch, starting from apply_state.
+  // Stops when participant is shutting down, in this case apply is resumed after restart using
+  // apply state stored in intents DB.
+  // Failed batch is retried with backoff, failures is the number of previous failed attempts.
+  void ApplyRemainingIntents(TransactionApplyData data, docdb::ApplyTransactionState apply_state,
+                             int failures = 0) {
+    while (apply_state.active()) {
+      if (closing_.load(std::memory_order_acquire)) {
+        LOG_WITH_PREFIX(INFO) << "Apply of " << data.transaction_id
+                              << " will be resumed after restart: " << apply_state.ToString();
+        return;
+      }
+      data.apply_state = &apply_state;
+      auto result = applier_.ApplyIntents(data);
+      data.apply_state = nullptr;
+      if (!result.ok()) {
+        ScheduleApplyRetry(data, apply_state, failures + 1, result.status());
+        return;
+      }
+      failures = 0;
+      apply_state = std::move(*result);
+    }
+    data.apply_state = nullptr;
+
+    FinishApply(data);
+  }
+
+  // Transaction is kept in applies_in_progress_ until retry, so APPLY resent by coordinator does
+  // not start another apply of the same transaction.
+  void ScheduleApplyRetry(const TransactionApplyData& data,
+                          const docdb::ApplyTransactionState& apply_state,
+                          int failures,
+                          const Status& status) {
+    auto delay = std::min<int64_t>(
+        FLAGS_transaction_apply_retry_max_delay_ms,
+        static_cast<int64_t>(FLAGS_transaction_apply_retry_initial_delay_ms)
+            << std::min(failures - 1, 20));
+    LOG_WITH_PREFIX(WARNING) << "Failed to apply intents of " << data.transaction_id << " at "
+                             << apply_state.ToString() << ", attempt " << failures
+                             << ", retry in " << delay << "ms: " << status;
+    apply_retry_delayer_.Delay(
+        MonoTime::Now() + MonoDelta::FromMilliseconds(delay),
+        [this, data, apply_state, failures] {
+      if (closing_.load(std::memory_order_acquire)) {
+        LOG_WITH_PREFIX(INFO) << "Apply of " << data.transaction_id
+                              << " will be resumed after restart: " << apply_state.ToString();
+        return;
+      }
+      ExecuteIntentsTask([this, data, apply_state, failures] {
+        ApplyRemainingIntents(data, apply_state, failures);
+      });
+    });
   }
 
   void NotifyApplied(const TransactionApplyData& data) {
@@ -956,15 +1075,37 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       }
     }
 
-    auto status = applier_.RemoveIntents(data.transaction_id);
-    LOG_IF_WITH_PREFIX(DFATAL, !status.ok()) << "Failed to remove intents for "
-                                             << data.transaction_id << ": " << status;
+    // Intents of aborted transaction are ignored by readers, so they could be removed in
+    // background, without blocking operation apply.
+    ExecuteIntentsTask([this, id = data.transaction_id] {
+      auto status = applier_.RemoveIntents(id);
+      LOG_IF_WITH_PREFIX(DFATAL, !status.ok()) << "Failed to remove intents for " << id << ": "
+                                               << status;
+    });
 
     return Status::OK();
   }
 
   void SetDB(rocksdb::DB* db) {
     db_ = db;
+    LoadInterruptedApplies();
+  }
+
+  // Interrupted applies are continued in thread pool, so they don't delay bootstrap.
+  // Replicated APPLY of those transactions is ignored until they are completed.
+  void ResumeApplies() {
+    decltype(interrupted_applies_) applies;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      applies.swap(interrupted_applies_);
+    }
+    for (auto& data_and_state : applies) {
+      LOG_WITH_PREFIX(INFO) << "Resume apply of " << data_and_state.first.transaction_id << ": "
+                            << data_and_state.second.ToString();
+      ExecuteIntentsTask([this, data_and_state = std::move(data_and_state)] {
+        ApplyRemainingIntents(data_and_state.first, data_and_state.second);
+      });
+    }
   }
 
   TransactionParticipantContext* participant_context() const {
@@ -987,6 +1128,103 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       >
   > Transactions;
 
+  void PrepareStatusRequest(const StatusRequest& request, StatusRequestBatches* batches) {
+    auto lock_and_iterator = LockAndFindOrLoad(*request.id, *request.reason, request.must_exist);
+    if (!lock_and_iterator.found()) {
+      request.callback(
+          STATUS_FORMAT(NotFound, "Request status of unknown transaction: $0", *request.id));
+      return;
+    }
+    RunningTransactionPtr transaction = *lock_and_iterator.iterator;
+    auto serial_no = transaction->PrepareStatusRequest(request, &lock_and_iterator.lock);
+    if (serial_no >= 0) {
+      auto& status_tablet = transaction->metadata().status_tablet;
+      (*batches)[status_tablet].push_back({std::move(transaction), serial_no});
+    }
+  }
+
+  void SendStatusRequest(const TabletId& status_tablet,
+                         std::vector<StatusRequestTarget> targets) {
+    tserver::GetTransactionStatusRequestPB req;
+    req.set_tablet_id(status_tablet);
+    for (const auto& target : targets) {
+      const auto& id = target.transaction->id();
+      req.add_transaction_id(id.begin(), id.size());
+    }
+    req.set_propagated_hybrid_time(participant_context_.Now().ToUint64());
+
+    auto handle = rpcs_.Prepare();
+    if (handle == rpcs_.InvalidHandle()) {
+      auto status = STATUS(Aborted, "Transaction participant is shutting down");
+      for (const auto& target : targets) {
+        target.transaction->StatusReceived(
+            status, TransactionStatus::PENDING, HybridTime::kInvalid, target.serial_no,
+            target.transaction);
+      }
+      return;
+    }
+    *handle = client::GetTransactionStatus(
+        TransactionRpcDeadline(),
+        nullptr /* tablet */,
+        client(),
+        &req,
+        [this, handle, status_tablet, targets = std::move(targets)](
+            const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+          StatusReceived(status, response, status_tablet, targets, handle);
+        });
+    (**handle).SendRpc();
+  }
+
+  void StatusReceived(const Status& status,
+                      const tserver::GetTransactionStatusResponsePB& response,
+                      const TabletId& status_tablet,
+                      const std::vector<StatusRequestTarget>& targets,
+                      rpc::Rpcs::Handle handle) {
+    if (response.has_propagated_hybrid_time()) {
+      participant_context_.UpdateClock(HybridTime(response.propagated_hybrid_time()));
+    }
+    rpcs_.Unregister(handle);
+
+    if (status.ok() && static_cast<size_t>(response.status_size()) != targets.size()) {
+      // Coordinator that does not support batched requests responds only with status of the
+      // last transaction, so each transaction is requested separately.
+      if (targets.size() > 1) {
+        VLOG_WITH_PREFIX(1) << "Wrong number of statuses in response, expected "
+                            << targets.size() << ": " << response.ShortDebugString()
+                            << ", requesting statuses one by one";
+        for (const auto& target : targets) {
+          SendStatusRequest(status_tablet, {target});
+        }
+        return;
+      }
+      auto batch_status = STATUS_FORMAT(
+          IllegalState, "Wrong number of statuses in response, expected $0: $1",
+          targets.size(), response.ShortDebugString());
+      for (const auto& target : targets) {
+        target.transaction->StatusReceived(
+            batch_status, TransactionStatus::PENDING, HybridTime::kMax, target.serial_no,
+            target.transaction);
+      }
+      return;
+    }
+
+    for (size_t i = 0; i != targets.size(); ++i) {
+      auto transaction_status = TransactionStatus::PENDING;
+      // Coordinator that does not support batched requests does not provide status hybrid time
+      // for ABORTED transaction.
+      auto status_hybrid_time = HybridTime::kMax;
+      if (status.ok()) {
+        transaction_status = response.status(i);
+        if (i < static_cast<size_t>(response.status_hybrid_time_size())) {
+          status_hybrid_time = HybridTime(response.status_hybrid_time(i));
+        }
+      }
+      targets[i].transaction->StatusReceived(
+          status, transaction_status, status_hybrid_time, targets[i].serial_no,
+          targets[i].transaction);
+    }
+  }
+
   // Tries to remove transaction with specified id.
   // Returns true if transaction is not exists after call to this method, otherwise returns false.
   // Which means that transaction will be removed later.
@@ -1123,6 +1361,97 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     TransactionId transaction_id;
   };
 
+  // Task that processes intents in thread pool.
+  class IntentsTask : public rpc::ThreadPoolTask {
+   public:
+    IntentsTask(Impl* impl, std::function<void()> action)
+        : impl_(*impl), action_(std::move(action)) {
+      std::lock_guard<std::mutex> lock(impl_.intents_tasks_mutex_);
+      ++impl_.running_intents_tasks_;
+    }
+
+    ~IntentsTask() {
+      std::lock_guard<std::mutex> lock(impl_.intents_tasks_mutex_);
+      if (--impl_.running_intents_tasks_ == 0) {
+        impl_.intents_tasks_cond_.notify_all();
+      }
+    }
+
+    void Prepare(std::shared_ptr<IntentsTask> self) {
+      retain_self_ = std::move(self);
+    }
+
+    void Run() override {
+      if (!impl_.closing_.load(std::memory_order_acquire)) {
+        action_();
+      }
+    }
+
+    void Done(const Status& status) override {
+      retain_self_ = nullptr;
+    }
+
+   private:
+    Impl& impl_;
+    std::function<void()> action_;
+    std::shared_ptr<IntentsTask> retain_self_;
+  };
+
+  // Executes action in thread pool, or in place when thread pool is not available, for instance
+  // during bootstrap.
+  void ExecuteIntentsTask(std::function<void()> action) {
+    auto task = std::make_shared<IntentsTask>(this, std::move(action));
+    task->Prepare(task);
+    if (!participant_context_.Enqueue(task.get())) {
+      task->Run();
+    }
+  }
+
+  // Loads state of transactions, that were applied in several batches and were interrupted
+  // by shutdown. They are completed by ResumeApplies.
+  void LoadInterruptedApplies() {
+    docdb::KeyBytes prefix;
+    prefix.AppendValueType(docdb::ValueType::kTransactionApplyState);
+    auto iter = docdb::CreateRocksDBIterator(db_,
+                                             docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
+                                             boost::none,
+                                             rocksdb::kDefaultQueryId);
+    std::vector<std::pair<TransactionApplyData, docdb::ApplyTransactionState>> applies;
+    for (iter->Seek(prefix.AsSlice());
+         iter->Valid() && iter->key().starts_with(prefix.AsSlice());
+         iter->Next()) {
+      auto key = iter->key();
+      key.consume_byte();
+      auto id = FullyDecodeTransactionId(key);
+      docdb::ApplyTransactionStatePB state_pb;
+      if (!id.ok() || !state_pb.ParseFromArray(iter->value().cdata(), iter->value().size())) {
+        LOG_WITH_PREFIX(DFATAL) << "Bad apply state: " << iter->key().ToDebugHexString() << " => "
+                                << iter->value().ToDebugHexString();
+        continue;
+      }
+      TransactionApplyData data = {
+          OpId::kUnknownTerm, *id, state_pb.op_id(), HybridTime(state_pb.commit_ht()),
+          HybridTime(state_pb.log_ht()), state_pb.status_tablet() };
+      applies.emplace_back(
+          data, docdb::ApplyTransactionState{state_pb.key(), state_pb.write_id()});
+    }
+
+    for (const auto& data_and_state : applies) {
+      const auto& data = data_and_state.first;
+      auto lock_and_iterator = LockAndFindOrLoad(
+          data.transaction_id, "resume apply"s, MustExist::kFalse);
+      if (lock_and_iterator.found()) {
+        lock_and_iterator.transaction().SetLocalCommitTime(data.commit_ht);
+      } else {
+        lock_and_iterator.lock = std::unique_lock<std::mutex>(mutex_);
+      }
+      applies_in_progress_.insert(data.transaction_id);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    interrupted_applies_ = std::move(applies);
+  }
+
   std::string log_prefix_;
 
   rocksdb::DB* db_ = nullptr;
@@ -1136,6 +1465,21 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   // Queue of transaction ids that should be cleaned, paired with request that should be completed
   // in order to be able to do clean.
   std::deque<CleanupQueueEntry> cleanup_queue_;
+
+  // Transactions whose intents are being applied in background.
+  TransactionIdSet applies_in_progress_;
+  // Applies loaded by LoadInterruptedApplies, that are not yet resumed.
+  std::vector<std::pair<TransactionApplyData, docdb::ApplyTransactionState>> interrupted_applies_;
+
+  std::atomic<bool> closing_{false};
+
+  std::mutex intents_tasks_mutex_;
+  std::condition_variable intents_tasks_cond_;
+  size_t running_intents_tasks_ = 0;
+
+  // Delays retries of failed background applies. Declared last, so it is destroyed, and stops
+  // executing retries, before other fields.
+  Delayer apply_retry_delayer_;
 };
 
 TransactionParticipant::TransactionParticipant(
@@ -1177,6 +1521,10 @@ void TransactionParticipant::RequestStatusAt(const StatusRequest& request) {
   return impl_->RequestStatusAt(request);
 }
 
+void TransactionParticipant::RequestStatusesAt(const std::vector<StatusRequest>& requests) {
+  return impl_->RequestStatusesAt(requests);
+}
+
 int64_t TransactionParticipant::RegisterRequest() {
   return impl_->RegisterRequest();
 }
@@ -1211,6 +1559,14 @@ void TransactionParticipant::SetDB(rocksdb::DB* db) {
   impl_->SetDB(db);
 }
 
+void TransactionParticipant::ResumeApplies() {
+  impl_->ResumeApplies();
+}
+
+void TransactionParticipant::Shutdown() {
+  impl_->Shutdown();
+}
+
 TransactionParticipantContext* TransactionParticipant::context() const {
   return impl_->participant_context();
 }
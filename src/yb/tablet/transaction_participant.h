@@ -30,6 +30,8 @@
 
 #include "yb/consensus/opid_util.h"
 
+#include "yb/docdb/docdb_fwd.h"
+
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/server/server_fwd.h"
@@ -67,6 +69,8 @@ struct TransactionApplyData {
   HybridTime commit_ht;
   HybridTime log_ht;
   TabletId status_tablet;
+  // Not null when apply is continued from the specified state.
+  const docdb::ApplyTransactionState* apply_state = nullptr;
 
   std::string ToString() const;
 };
@@ -74,7 +78,9 @@ struct TransactionApplyData {
 // Interface to object that should apply intents in RocksDB when transaction is applying.
 class TransactionIntentApplier {
  public:
-  virtual CHECKED_STATUS ApplyIntents(const TransactionApplyData& data) = 0;
+  // Applies intents of transaction, large transaction is applied in several batches.
+  // Returns state to continue apply with, it is not active when all intents were applied.
+  virtual Result<docdb::ApplyTransactionState> ApplyIntents(const TransactionApplyData& data) = 0;
   virtual CHECKED_STATUS RemoveIntents(const TransactionId& transaction_id) = 0;
   virtual CHECKED_STATUS RemoveIntents(const TransactionIdSet& transactions) = 0;
   virtual HybridTime ApplierSafeTime(HybridTime min_allowed, CoarseTimePoint deadline) = 0;
@@ -123,6 +129,9 @@ class TransactionParticipant : public TransactionStatusManager {
 
   void RequestStatusAt(const StatusRequest& request) override;
 
+  // Requests to transactions with the same status tablet are sent in a single RPC.
+  void RequestStatusesAt(const std::vector<StatusRequest>& requests) override;
+
   void Abort(const TransactionId& id, TransactionStatusCallback callback) override;
 
   void Handle(std::unique_ptr<tablet::UpdateTxnOperationState> request, int64_t term);
@@ -142,8 +151,16 @@ class TransactionParticipant : public TransactionStatusManager {
 
   CHECKED_STATUS ProcessReplicated(const ReplicatedData& data);
 
+  // Also loads applies of transactions, that were interrupted by shutdown.
   void SetDB(rocksdb::DB* db);
 
+  // Continues applies loaded by SetDB in background. Should be invoked after bootstrap.
+  void ResumeApplies();
+
+  // Waits until background processing of intents is stopped. Apply of large transaction that is
+  // in progress will be resumed after restart.
+  void Shutdown();
+
   TransactionParticipantContext* context() const;
 
   size_t TEST_GetNumRunningTransactions() const;
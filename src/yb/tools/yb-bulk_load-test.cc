@@ -38,8 +38,10 @@
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/util/date_time.h"
+#include "yb/util/faststring.h"
 #include "yb/util/path_util.h"
 #include "yb/util/random.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/subprocess.h"
 
 DECLARE_uint64(initial_seqno);
@@ -48,6 +50,7 @@ DECLARE_bool(enable_load_balancing);
 DECLARE_int32(replication_factor);
 
 using namespace std::literals;
+using namespace yb::size_literals;
 
 namespace yb {
 namespace tools {
@@ -357,6 +360,60 @@ class YBBulkLoadTest : public YBMiniClusterTestBase<MiniCluster> {
     *rowblock = rowsResult.GetRowBlock();
   }
 
+  void SendIngestRequest(const tserver::IngestSstRequestPB& req,
+                         tserver::TabletServerServiceProxy* tserver_proxy) {
+    tserver::IngestSstResponsePB resp;
+    rpc::RpcController controller;
+    controller.set_timeout(15s);
+    ASSERT_OK(tserver_proxy->IngestSst(req, &resp, &controller));
+    ASSERT_FALSE(resp.has_error()) << resp.DebugString();
+  }
+
+  // Ships files of the tablet's bulk load dir to the tablet leader in small chunks, and commits
+  // them, the same way as yb-bulk_load does by default.
+  void IngestTabletFiles(const string& tablet_id, const string& tablet_path,
+                         tserver::TabletServerServiceProxy* tserver_proxy) {
+    constexpr size_t kChunkSize = 16_KB;
+    const string ingestion_id = "test_ingestion";
+    vector<string> tablet_files;
+    ASSERT_OK(Env::Default()->GetChildren(tablet_path, &tablet_files));
+    for (const string& file_name : tablet_files) {
+      if (file_name != "CURRENT" && !boost::starts_with(file_name, "MANIFEST-") &&
+          file_name.find(".sst") == string::npos) {
+        continue;
+      }
+      faststring contents;
+      ASSERT_OK(ReadFileToString(Env::Default(), JoinPathSegments(tablet_path, file_name),
+                                 &contents));
+      size_t offset = 0;
+      do {
+        tserver::IngestSstRequestPB req;
+        req.set_tablet_id(tablet_id);
+        req.set_ingestion_id(ingestion_id);
+        req.set_file_name(file_name);
+        req.set_offset(offset);
+        auto size = std::min(kChunkSize, contents.size() - offset);
+        req.set_data(contents.data() + offset, size);
+        SendIngestRequest(req, tserver_proxy);
+        offset += size;
+      } while (offset < contents.size());
+    }
+
+    tserver::IngestSstRequestPB commit_req;
+    commit_req.set_tablet_id(tablet_id);
+    commit_req.set_ingestion_id(ingestion_id);
+    commit_req.set_commit(true);
+    SendIngestRequest(commit_req, tserver_proxy);
+
+    // Staged files were removed by the commit, so the second commit is rejected by the leader
+    // before it is replicated.
+    tserver::IngestSstResponsePB resp;
+    rpc::RpcController controller;
+    controller.set_timeout(15s);
+    ASSERT_OK(tserver_proxy->IngestSst(commit_req, &resp, &controller));
+    ASSERT_TRUE(resp.has_error());
+  }
+
   std::unique_ptr<YBClient> client_;
   YBSchema schema_;
   std::unique_ptr<YBTableName> table_name_;
@@ -507,6 +564,7 @@ TEST_F_EX(YBBulkLoadTest, TestCLITool, YBBulkLoadTestWithoutRebalancing) {
   client::TableHandle table;
   ASSERT_OK(table.Open(*table_name_, client_.get()));
 
+  size_t tablet_index = 0;
   for (const master::TabletLocationsPB& tablet_location : resp.tablet_locations()) {
     const string& tablet_id = tablet_location.tablet_id();
     string tablet_path = JoinPathSegments(bulk_load_data, tablet_id);
@@ -541,14 +599,18 @@ TEST_F_EX(YBBulkLoadTest, TestCLITool, YBBulkLoadTestWithoutRebalancing) {
     // Wait for load generator to generate some traffic.
     SleepFor(MonoDelta::FromSeconds(5));
 
-    // Import the data into the tserver.
-    tserver::ImportDataRequestPB import_req;
-    import_req.set_tablet_id(tablet_id);
-    import_req.set_source_dir(tablet_path);
-    tserver::ImportDataResponsePB import_resp;
-    rpc::RpcController controller;
-    ASSERT_OK(tserver_proxy->ImportData(import_req, &import_resp, &controller));
-    ASSERT_FALSE(import_resp.has_error()) << import_resp.DebugString();
+    // Import the data into the tserver, half of the tablets are ingested through Raft.
+    if (tablet_index++ % 2 == 0) {
+      tserver::ImportDataRequestPB import_req;
+      import_req.set_tablet_id(tablet_id);
+      import_req.set_source_dir(tablet_path);
+      tserver::ImportDataResponsePB import_resp;
+      rpc::RpcController controller;
+      ASSERT_OK(tserver_proxy->ImportData(import_req, &import_resp, &controller));
+      ASSERT_FALSE(import_resp.has_error()) << import_resp.DebugString();
+    } else {
+      ASSERT_NO_FATALS(IngestTabletFiles(tablet_id, tablet_path, tserver_proxy.get()));
+    }
 
     for (const string& row : tabletid_to_line[tablet_id]) {
       // Build read request.
@@ -12,7 +12,9 @@
 //
 
 #include <sched.h>
+#include <atomic>
 #include <iostream>
+#include <mutex>
 #include <thread>
 #include <boost/algorithm/string.hpp>
 
@@ -38,6 +40,7 @@
 #include "yb/tools/yb-generate_partitions.h"
 #include "yb/tserver/tserver_service.proxy.h"
 #include "yb/util/env.h"
+#include "yb/util/env_util.h"
 #include "yb/util/status.h"
 #include "yb/util/stol_utils.h"
 #include "yb/util/stopwatch.h"
@@ -45,6 +48,7 @@
 #include "yb/util/threadpool.h"
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
+#include "yb/util/oid_generator.h"
 #include "yb/util/path_util.h"
 #include "yb/util/subprocess.h"
 
@@ -60,6 +64,7 @@ using yb::client::YBTableName;
 using yb::docdb::DocWriteBatch;
 using yb::docdb::InitMarkerBehavior;
 using yb::operator"" _GB;
+using yb::operator"" _MB;
 
 DEFINE_string(master_addresses, "", "Comma-separated list of YB Master server addresses");
 DEFINE_string(table_name, "", "Name of the table to generate partitions for");
@@ -76,6 +81,16 @@ DEFINE_string(bulk_load_cleanup_script, "./bulk_load_cleanup.sh", "Relative path
 DEFINE_string(ssh_key_file, "", "SSH key to push SSTable files to production cluster");
 DEFINE_bool(export_files, false, "Whether or not the files should be exported to a production "
             "cluster.");
+DEFINE_bool(export_files_via_ssh, false, "Export files with bulk_load_helper_script over SSH and "
+            "import them on each replica separately, instead of ingesting them through the tablet "
+            "leader.");
+DEFINE_int32(bulk_load_ingest_chunk_size_bytes, 1_MB,
+             "Size of file chunk sent in a single ingest request. Each chunk is replicated "
+             "through Raft, so it should be less than the max consensus batch size.");
+DEFINE_int32(bulk_load_ingest_num_threads, 8,
+             "Number of chunks of the tablet's files that are ingested in parallel.");
+DEFINE_int32(bulk_load_ingest_rpc_timeout_ms, 60000, "Timeout of a single ingest request.");
+DEFINE_int32(bulk_load_ingest_max_attempts, 10, "Max number of attempts of an ingest request.");
 DEFINE_int32(bulk_load_num_threads, 16, "Number of threads to use for bulk load");
 DEFINE_int32(bulk_load_threadpool_queue_size, 10000,
              "Maximum number of entries to queue in the threadpool");
@@ -131,8 +146,16 @@ class BulkLoad {
                                         vector<pair<TabletId, string>> rows);
   CHECKED_STATUS RetryableSubmit(vector<pair<TabletId, string>> rows);
   CHECKED_STATUS CompactFiles();
+  CHECKED_STATUS ExportFilesViaSsh(const TabletId &tablet_id);
+  CHECKED_STATUS IngestFiles(const TabletId &tablet_id);
+  CHECKED_STATUS IngestChunk(const TabletId &tablet_id, const string &ingestion_id,
+                             const string &file_name, uint64_t offset, size_t size);
+  CHECKED_STATUS SendIngestRequest(const tserver::IngestSstRequestPB &req);
+  Result<HostPort> FindTabletLeader(const TabletId &tablet_id);
 
   std::unique_ptr<YBClient> client_;
+  std::unique_ptr<rpc::Messenger> messenger_;
+  std::unique_ptr<rpc::ProxyCache> proxy_cache_;
   shared_ptr<YBTable> table_;
   unique_ptr<YBPartitionGenerator> partition_generator_;
   gscoped_ptr<ThreadPool> thread_pool_;
@@ -385,6 +408,161 @@ Status BulkLoad::FinishTabletProcessing(const TabletId &tablet_id,
     return Status::OK();
   }
 
+  if (FLAGS_export_files_via_ssh) {
+    RETURN_NOT_OK(ExportFilesViaSsh(tablet_id));
+  } else {
+    RETURN_NOT_OK(IngestFiles(tablet_id));
+  }
+
+  // Delete the data once the import is done.
+  return yb::Env::Default()->DeleteRecursively(db_fixture_->rocksdb_dir());
+}
+
+Result<HostPort> BulkLoad::FindTabletLeader(const TabletId &tablet_id) {
+  master::TabletLocationsPB tablet_locations;
+  RETURN_NOT_OK(client_->GetTabletLocation(tablet_id, &tablet_locations));
+  for (const master::TabletLocationsPB_ReplicaPB &replica : tablet_locations.replicas()) {
+    if (replica.role() == consensus::RaftPeerPB::LEADER) {
+      return HostPortFromPB(replica.ts_info().private_rpc_addresses(0));
+    }
+  }
+  return STATUS_SUBSTITUTE(NotFound, "No leader found for tablet $0", tablet_id);
+}
+
+Status BulkLoad::SendIngestRequest(const tserver::IngestSstRequestPB &req) {
+  Status status;
+  for (int attempt = 1; attempt <= FLAGS_bulk_load_ingest_max_attempts; ++attempt) {
+    if (attempt > 1) {
+      LOG(WARNING) << "Ingest request to tablet " << req.tablet_id() << " failed, attempt "
+                   << attempt - 1 << ": " << status;
+      SleepFor(MonoDelta::FromMilliseconds(100 * attempt));
+    }
+    auto leader = FindTabletLeader(req.tablet_id());
+    if (!leader.ok()) {
+      status = leader.status();
+      continue;
+    }
+
+    tserver::TabletServerServiceProxy proxy(proxy_cache_.get(), *leader);
+    tserver::IngestSstResponsePB resp;
+    rpc::RpcController controller;
+    controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_bulk_load_ingest_rpc_timeout_ms));
+    status = proxy.IngestSst(req, &resp, &controller);
+    bool not_replicated = false;
+    if (status.ok() && resp.has_error()) {
+      status = StatusFromPB(resp.error().status());
+      const auto code = resp.error().code();
+      not_replicated = code == tserver::TabletServerErrorPB::NOT_THE_LEADER ||
+                       code == tserver::TabletServerErrorPB::LEADER_NOT_READY_TO_SERVE ||
+                       code == tserver::TabletServerErrorPB::TABLET_NOT_FOUND ||
+                       code == tserver::TabletServerErrorPB::TABLET_NOT_RUNNING;
+    }
+    if (status.ok()) {
+      return Status::OK();
+    }
+    // Chunks are written at their offsets and abort just removes staged files, so they could be
+    // safely retried. Commit is retried only when it is known that it was not replicated.
+    if (req.commit() && !not_replicated) {
+      return status;
+    }
+  }
+  return status;
+}
+
+Status BulkLoad::IngestChunk(const TabletId &tablet_id, const string &ingestion_id,
+                             const string &file_name, uint64_t offset, size_t size) {
+  gscoped_ptr<RandomAccessFile> file;
+  RETURN_NOT_OK(Env::Default()->NewRandomAccessFile(
+      JoinPathSegments(db_fixture_->rocksdb_dir(), file_name), &file));
+  std::unique_ptr<uint8_t[]> scratch(new uint8_t[size]);
+  Slice data;
+  RETURN_NOT_OK(env_util::ReadFully(file.get(), offset, size, &data, scratch.get()));
+
+  tserver::IngestSstRequestPB req;
+  req.set_tablet_id(tablet_id);
+  req.set_ingestion_id(ingestion_id);
+  req.set_file_name(file_name);
+  req.set_offset(offset);
+  req.set_data(data.cdata(), data.size());
+  return SendIngestRequest(req);
+}
+
+Status BulkLoad::IngestFiles(const TabletId &tablet_id) {
+  const string ingestion_id = ObjectIdGenerator().Next();
+  const string &dir = db_fixture_->rocksdb_dir();
+
+  // Only files that are required to import DB are shipped, i.e. CURRENT, MANIFEST and SST files.
+  struct Chunk {
+    string file_name;
+    uint64_t offset;
+    size_t size;
+  };
+  vector<Chunk> chunks;
+  const auto file_names = VERIFY_RESULT(Env::Default()->GetChildren(dir, ExcludeDots::kTrue));
+  for (const auto &file_name : file_names) {
+    if (file_name != "CURRENT" && !boost::starts_with(file_name, "MANIFEST-") &&
+        file_name.find(".sst") == string::npos) {
+      continue;
+    }
+    const uint64_t file_size = VERIFY_RESULT(
+        Env::Default()->GetFileSize(JoinPathSegments(dir, file_name)));
+    uint64_t offset = 0;
+    do {
+      const size_t size = std::min<uint64_t>(
+          file_size - offset, FLAGS_bulk_load_ingest_chunk_size_bytes);
+      chunks.push_back(Chunk{file_name, offset, size});
+      offset += size;
+    } while (offset < file_size);
+  }
+
+  LOG(INFO) << "Ingesting " << chunks.size() << " chunks from " << dir << " to tablet "
+            << tablet_id << ", ingestion id: " << ingestion_id;
+
+  // Chunks are independent, so they are sent in parallel, and ingestion is committed once all of
+  // them were replicated.
+  std::atomic<size_t> next_chunk{0};
+  std::mutex status_mutex;
+  Status status;
+  vector<std::thread> threads;
+  for (int i = 0; i < std::max(FLAGS_bulk_load_ingest_num_threads, 1); ++i) {
+    threads.emplace_back([&] {
+      for (;;) {
+        const size_t idx = next_chunk.fetch_add(1);
+        if (idx >= chunks.size()) {
+          return;
+        }
+        const auto &chunk = chunks[idx];
+        auto chunk_status = IngestChunk(
+            tablet_id, ingestion_id, chunk.file_name, chunk.offset, chunk.size);
+        if (!chunk_status.ok()) {
+          std::lock_guard<std::mutex> lock(status_mutex);
+          status = chunk_status;
+          next_chunk = chunks.size();
+          return;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  tserver::IngestSstRequestPB req;
+  req.set_tablet_id(tablet_id);
+  req.set_ingestion_id(ingestion_id);
+  if (!status.ok()) {
+    req.set_abort(true);
+    WARN_NOT_OK(SendIngestRequest(req), "Failed to abort ingestion " + ingestion_id);
+    return status;
+  }
+
+  req.set_commit(true);
+  RETURN_NOT_OK_PREPEND(SendIngestRequest(req), "Failed to commit ingestion " + ingestion_id);
+  LOG(INFO) << "Ingested " << dir << " to tablet " << tablet_id;
+  return Status::OK();
+}
+
+Status BulkLoad::ExportFilesViaSsh(const TabletId &tablet_id) {
   // Find replicas for the tablet.
   master::TabletLocationsPB tablet_locations;
   RETURN_NOT_OK(client_->GetTabletLocation(tablet_id, &tablet_locations));
@@ -410,9 +588,6 @@ Status BulkLoad::FinishTabletProcessing(const TabletId &tablet_id,
   LOG(INFO) << "Helper script stdout: " << bulk_load_helper_stdout;
 
   // Finalize the import.
-  rpc::MessengerBuilder bld("Client");
-  std::unique_ptr<rpc::Messenger> client_messenger = VERIFY_RESULT(bld.Build());
-  rpc::ProxyCache proxy_cache(client_messenger.get());
   vector<string> lines;
   boost::split(lines, bulk_load_helper_stdout, boost::is_any_of("\n"));
   for (const string &line : lines) {
@@ -425,7 +600,7 @@ Status BulkLoad::FinishTabletProcessing(const TabletId &tablet_id,
     const string &directory = tokens[1];
     HostPort hostport(replica_host, host_to_rpcport[replica_host]);
 
-    tserver::TabletServerServiceProxy proxy(&proxy_cache, hostport);
+    tserver::TabletServerServiceProxy proxy(proxy_cache_.get(), hostport);
     tserver::ImportDataRequestPB req;
     req.set_tablet_id(tablet_id);
     req.set_source_dir(directory);
@@ -445,8 +620,7 @@ Status BulkLoad::FinishTabletProcessing(const TabletId &tablet_id,
     RETURN_NOT_OK(Subprocess::Call(cleanup_script));
   }
 
-  // Delete the data once the import is done.
-  return yb::Env::Default()->DeleteRecursively(db_fixture_->rocksdb_dir());
+  return Status::OK();
 }
 
 
@@ -469,6 +643,8 @@ Status BulkLoad::InitYBBulkLoad() {
   builder.add_master_server_addr(FLAGS_master_addresses);
 
   client_ = VERIFY_RESULT(builder.Build());
+  messenger_ = VERIFY_RESULT(rpc::MessengerBuilder("Client").Build());
+  proxy_cache_ = std::make_unique<rpc::ProxyCache>(messenger_.get());
   RETURN_NOT_OK(client_->OpenTable(table_name, &table_));
   partition_generator_.reset(new YBPartitionGenerator(table_name, {FLAGS_master_addresses}));
   RETURN_NOT_OK(partition_generator_->Init());
@@ -538,8 +714,8 @@ int main(int argc, char** argv) {
         "--base_dir";
   }
 
-  if (FLAGS_export_files && FLAGS_ssh_key_file.empty()) {
-    LOG(FATAL) << "Need to specify --ssh_key_file with --export_files";
+  if (FLAGS_export_files_via_ssh && FLAGS_ssh_key_file.empty()) {
+    LOG(FATAL) << "Need to specify --ssh_key_file with --export_files_via_ssh";
   }
 
   // Verify the bulk load path exists.
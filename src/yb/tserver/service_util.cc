@@ -21,6 +21,11 @@
 namespace yb {
 namespace tserver {
 
+void SetupError(TabletServerErrorPB* error, const Status& s, TabletServerErrorPB::Code code) {
+  StatusToPB(s, error->mutable_status());
+  error->set_code(code);
+}
+
 void SetupErrorAndRespond(TabletServerErrorPB* error,
                           const Status& s,
                           TabletServerErrorPB::Code code,
@@ -31,8 +36,7 @@ void SetupErrorAndRespond(TabletServerErrorPB* error,
     return;
   }
 
-  StatusToPB(s, error->mutable_status());
-  error->set_code(code);
+  SetupError(error, s, code);
   // TODO: rename RespondSuccess() to just "Respond" or
   // "SendResponse" since we use it for application-level error
   // responses, and this just looks confusing!
@@ -45,6 +49,34 @@ void SetupErrorAndRespond(TabletServerErrorPB* error,
   SetupErrorAndRespond(error, s, static_cast<TabletServerErrorPB::Code>(s.error_code()), context);
 }
 
+Result<std::shared_ptr<tablet::TabletPeer>> LookupTabletPeer(
+    TabletPeerLookupIf* tablet_manager,
+    const string& tablet_id,
+    TabletServerErrorPB* error) {
+  std::shared_ptr<tablet::TabletPeer> result;
+  Status status = tablet_manager->GetTabletPeer(tablet_id, &result);
+  if (PREDICT_FALSE(!status.ok())) {
+    TabletServerErrorPB::Code code = status.IsServiceUnavailable() ?
+                                     TabletServerErrorPB::UNKNOWN_ERROR :
+                                     TabletServerErrorPB::TABLET_NOT_FOUND;
+    SetupError(error, status, code);
+    return status;
+  }
+
+  // Check RUNNING state.
+  tablet::RaftGroupStatePB state = result->state();
+  if (PREDICT_FALSE(state != tablet::RUNNING)) {
+    Status s = STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStatePB_Name(state));
+    if (state == tablet::FAILED) {
+      s = s.CloneAndAppend(result->error().ToString());
+    }
+    SetupError(error, s, TabletServerErrorPB::TABLET_NOT_RUNNING);
+    return s;
+  }
+
+  return result;
+}
+
 Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
   std::shared_ptr<consensus::Consensus> consensus = tablet_peer.shared_consensus();
   auto leader_state = consensus->GetLeaderState();
@@ -29,6 +29,9 @@ namespace tserver {
 
 // Non-template helpers.
 
+// Fills error without responding, for errors of requests that are parts of a batch.
+void SetupError(TabletServerErrorPB* error, const Status& s, TabletServerErrorPB::Code code);
+
 void SetupErrorAndRespond(TabletServerErrorPB* error,
                           const Status& s,
                           TabletServerErrorPB::Code code,
@@ -42,32 +45,47 @@ Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer);
 
 // Template helpers.
 
-template<class ReqClass, class RespClass>
-bool CheckUuidMatchOrRespond(TabletPeerLookupIf* tablet_manager,
-                             const char* method_name,
-                             const ReqClass* req,
-                             RespClass* resp,
-                             rpc::RpcContext* context) {
+// Checks that the request is addressed to this server, filling error otherwise.
+template<class ReqClass>
+Status CheckUuidMatch(TabletPeerLookupIf* tablet_manager,
+                      const char* method_name,
+                      const ReqClass* req,
+                      const std::string& requestor_string,
+                      TabletServerErrorPB* error) {
   const string& local_uuid = tablet_manager->NodeInstance().permanent_uuid();
   if (PREDICT_FALSE(!req->has_dest_uuid())) {
     // Maintain compat in release mode, but complain.
     string msg = strings::Substitute("$0: Missing destination UUID in request from $1: $2",
-        method_name, context->requestor_string(), req->ShortDebugString());
+        method_name, requestor_string, req->ShortDebugString());
 #ifdef NDEBUG
     YB_LOG_EVERY_N(ERROR, 100) << msg;
 #else
     LOG(FATAL) << msg;
 #endif
-    return true;
+    return Status::OK();
   }
   if (PREDICT_FALSE(req->dest_uuid() != local_uuid)) {
     const Status s = STATUS_SUBSTITUTE(InvalidArgument,
         "$0: Wrong destination UUID requested. Local UUID: $1. Requested UUID: $2",
         method_name, local_uuid, req->dest_uuid());
-    LOG(WARNING) << s.ToString() << ": from " << context->requestor_string()
+    LOG(WARNING) << s.ToString() << ": from " << requestor_string
                  << ": " << req->ShortDebugString();
-    SetupErrorAndRespond(resp->mutable_error(), s,
-                         TabletServerErrorPB::WRONG_SERVER_UUID, context);
+    SetupError(error, s, TabletServerErrorPB::WRONG_SERVER_UUID);
+    return s;
+  }
+  return Status::OK();
+}
+
+template<class ReqClass, class RespClass>
+bool CheckUuidMatchOrRespond(TabletPeerLookupIf* tablet_manager,
+                             const char* method_name,
+                             const ReqClass* req,
+                             RespClass* resp,
+                             rpc::RpcContext* context) {
+  TabletServerErrorPB error;
+  Status s = CheckUuidMatch(tablet_manager, method_name, req, context->requestor_string(), &error);
+  if (PREDICT_FALSE(!s.ok())) {
+    SetupErrorAndRespond(resp->mutable_error(), s, error.code(), context);
     return false;
   }
   return true;
@@ -98,6 +116,13 @@ StdStatusCallback BindHandleResponse(RespType* resp,
   return std::bind(&HandleResponse<RespType>, resp, context, std::placeholders::_1);
 }
 
+// Lookup the given tablet, ensuring that it both exists and is RUNNING.
+// If it is not, error is filled to indicate the failure reason.
+Result<std::shared_ptr<tablet::TabletPeer>> LookupTabletPeer(
+    TabletPeerLookupIf* tablet_manager,
+    const string& tablet_id,
+    TabletServerErrorPB* error);
+
 // Lookup the given tablet, ensuring that it both exists and is RUNNING.
 // If it is not, respond to the RPC associated with 'context' after setting
 // resp->mutable_error() to indicate the failure reason.
@@ -109,28 +134,11 @@ Result<std::shared_ptr<tablet::TabletPeer>> LookupTabletPeerOrRespond(
     const string& tablet_id,
     RespClass* resp,
     rpc::RpcContext* context) {
-  std::shared_ptr<tablet::TabletPeer> result;
-  Status status = tablet_manager->GetTabletPeer(tablet_id, &result);
-  if (PREDICT_FALSE(!status.ok())) {
-    TabletServerErrorPB::Code code = status.IsServiceUnavailable() ?
-                                     TabletServerErrorPB::UNKNOWN_ERROR :
-                                     TabletServerErrorPB::TABLET_NOT_FOUND;
-    SetupErrorAndRespond(resp->mutable_error(), status, code, context);
-    return status;
-  }
-
-  // Check RUNNING state.
-  tablet::RaftGroupStatePB state = result->state();
-  if (PREDICT_FALSE(state != tablet::RUNNING)) {
-    Status s = STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStatePB_Name(state));
-    if (state == tablet::FAILED) {
-      s = s.CloneAndAppend(result->error().ToString());
-    }
-    SetupErrorAndRespond(resp->mutable_error(), s,
-                         TabletServerErrorPB::TABLET_NOT_RUNNING, context);
-    return s;
+  TabletServerErrorPB error;
+  auto result = LookupTabletPeer(tablet_manager, tablet_id, &error);
+  if (PREDICT_FALSE(!result.ok())) {
+    SetupErrorAndRespond(resp->mutable_error(), result.status(), error.code(), context);
   }
-
   return result;
 }
 
@@ -63,6 +63,7 @@
 #include "yb/tablet/tablet_metrics.h"
 
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/ingest_sst_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/operations/write_operation.h"
@@ -186,24 +187,36 @@ using tablet::Tablet;
 using tablet::TabletPeer;
 using tablet::TabletPeerPtr;
 using tablet::TabletStatusPB;
+using tablet::IngestSstOperationState;
 using tablet::TruncateOperationState;
 using tablet::OperationCompletionCallback;
 using tablet::WriteOperationState;
 
 namespace {
 
+Result<shared_ptr<Consensus>> GetConsensus(const TabletPeerPtr& tablet_peer,
+                                           TabletServerErrorPB* error) {
+  auto consensus = tablet_peer->shared_consensus();
+  if (!consensus) {
+    Status s = STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running");
+    SetupError(error, s, TabletServerErrorPB::TABLET_NOT_RUNNING);
+    return s;
+  }
+  return consensus;
+}
+
 template<class RespClass>
 bool GetConsensusOrRespond(const TabletPeerPtr& tablet_peer,
                            RespClass* resp,
                            rpc::RpcContext* context,
                            shared_ptr<Consensus>* consensus) {
-  *consensus = tablet_peer->shared_consensus();
-  if (!*consensus) {
-    Status s = STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running");
-    SetupErrorAndRespond(resp->mutable_error(), s,
-                         TabletServerErrorPB::TABLET_NOT_RUNNING, context);
+  TabletServerErrorPB error;
+  auto result = GetConsensus(tablet_peer, &error);
+  if (!result.ok()) {
+    SetupErrorAndRespond(resp->mutable_error(), result.status(), error.code(), context);
     return false;
   }
+  *consensus = std::move(*result);
   return true;
 }
 
@@ -371,23 +384,15 @@ TabletServiceAdminImpl::TabletServiceAdminImpl(TabletServer* server)
       server_(server) {
 }
 
-void TabletServiceAdminImpl::AlterSchema(const ChangeMetadataRequestPB* req,
-                                         ChangeMetadataResponsePB* resp,
-                                         rpc::RpcContext context) {
-  if (!CheckUuidMatchOrRespond(server_->tablet_manager(), "ChangeMetadata", req, resp, &context)) {
-    return;
-  }
-  DVLOG(3) << "Received Change Metadata RPC: " << req->DebugString();
-
-  server::UpdateClock(*req, server_->Clock());
-
-  auto tablet = LookupLeaderTabletOrRespond(
-      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
-  if (!tablet) {
-    return;
-  }
+namespace {
 
-  uint32_t schema_version = tablet.peer->tablet_metadata()->schema_version();
+// Checks schema version of alter schema request, responds to it if it should not be applied.
+// Returns whether request should be applied.
+bool CheckSchemaVersionOrRespond(const tablet::TabletPeer& tablet_peer,
+                                 const ChangeMetadataRequestPB* req,
+                                 ChangeMetadataResponsePB* resp,
+                                 rpc::RpcContext* context) {
+  uint32_t schema_version = tablet_peer.tablet_metadata()->schema_version();
 
   // If the schema was already applied, respond as succeeded
   if (schema_version == req->schema_version()) {
@@ -397,17 +402,17 @@ void TabletServiceAdminImpl::AlterSchema(const ChangeMetadataRequestPB* req,
     Status s = SchemaFromPB(req->schema(), &req_schema);
     if (!s.ok()) {
       SetupErrorAndRespond(resp->mutable_error(), s,
-                           TabletServerErrorPB::INVALID_SCHEMA, &context);
-      return;
+                           TabletServerErrorPB::INVALID_SCHEMA, context);
+      return false;
     }
 
-    Schema tablet_schema = tablet.peer->tablet_metadata()->schema();
+    Schema tablet_schema = tablet_peer.tablet_metadata()->schema();
     if (req_schema.Equals(tablet_schema)) {
-      context.RespondSuccess();
-      return;
+      context->RespondSuccess();
+      return false;
     }
 
-    schema_version = tablet.peer->tablet_metadata()->schema_version();
+    schema_version = tablet_peer.tablet_metadata()->schema_version();
     if (schema_version == req->schema_version()) {
       LOG(ERROR) << "The current schema does not match the request schema."
                  << " version=" << schema_version
@@ -416,8 +421,8 @@ void TabletServiceAdminImpl::AlterSchema(const ChangeMetadataRequestPB* req,
                  << " (corruption)";
       SetupErrorAndRespond(resp->mutable_error(),
                            STATUS(Corruption, "got a different schema for the same version number"),
-                           TabletServerErrorPB::MISMATCHED_SCHEMA, &context);
-      return;
+                           TabletServerErrorPB::MISMATCHED_SCHEMA, context);
+      return false;
     }
   }
 
@@ -425,7 +430,41 @@ void TabletServiceAdminImpl::AlterSchema(const ChangeMetadataRequestPB* req,
   if (schema_version > req->schema_version()) {
     SetupErrorAndRespond(resp->mutable_error(),
                          STATUS(InvalidArgument, "Tablet has a newer schema"),
-                         TabletServerErrorPB::TABLET_HAS_A_NEWER_SCHEMA, &context);
+                         TabletServerErrorPB::TABLET_HAS_A_NEWER_SCHEMA, context);
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace
+
+void TabletServiceAdminImpl::AlterSchema(const ChangeMetadataRequestPB* req,
+                                         ChangeMetadataResponsePB* resp,
+                                         rpc::RpcContext context) {
+  if (!CheckUuidMatchOrRespond(server_->tablet_manager(), "ChangeMetadata", req, resp, &context)) {
+    return;
+  }
+  DVLOG(3) << "Received Change Metadata RPC: " << req->DebugString();
+
+  server::UpdateClock(*req, server_->Clock());
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+
+  if (req->has_add_table() || req->has_remove_table_id()) {
+    // Tables are added to and removed from tablet of colocated database without changing schema
+    // version, so request is already applied when the table is in the requested state.
+    const auto& table_id =
+        req->has_add_table() ? req->add_table().table_id() : req->remove_table_id();
+    if (tablet.peer->tablet_metadata()->GetTableInfo(table_id).ok() == req->has_add_table()) {
+      context.RespondSuccess();
+      return;
+    }
+  } else if (!CheckSchemaVersionOrRespond(*tablet.peer, req, resp, &context)) {
     return;
   }
 
@@ -567,6 +606,69 @@ void TabletServiceImpl::Truncate(const TruncateRequestPB* req,
       std::make_unique<tablet::TruncateOperation>(std::move(tx_state)), tablet.leader_term);
 }
 
+namespace {
+
+// Ingestion id and file name are used as path components of staged files.
+bool IsValidIngestPathComponent(const std::string& name) {
+  return !name.empty() && name != "." && name != ".." && name.find('/') == std::string::npos;
+}
+
+Status ValidateIngestSstRequest(const IngestSstRequestPB& req) {
+  if (!IsValidIngestPathComponent(req.ingestion_id())) {
+    return STATUS_FORMAT(InvalidArgument, "Invalid ingestion id: $0", req.ingestion_id());
+  }
+  if (req.commit() && req.abort()) {
+    return STATUS(InvalidArgument, "Ingestion could not be committed and aborted at once");
+  }
+  if (!req.commit() && !req.abort() && !IsValidIngestPathComponent(req.file_name())) {
+    return STATUS_FORMAT(InvalidArgument, "Invalid ingested file name: $0", req.file_name());
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+void TabletServiceImpl::IngestSst(const IngestSstRequestPB* req,
+                                  IngestSstResponsePB* resp,
+                                  rpc::RpcContext context) {
+  TRACE("IngestSst");
+
+  UpdateClock(*req, server_->Clock());
+
+  auto status = ValidateIngestSstRequest(*req);
+  if (!status.ok()) {
+    SetupErrorAndRespond(
+        resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR, &context);
+    return;
+  }
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+
+  if (req->commit()) {
+    status = tablet.peer->tablet()->ValidateIngestion(req->ingestion_id());
+    if (!status.ok()) {
+      SetupErrorAndRespond(
+          resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR, &context);
+      return;
+    }
+  }
+
+  auto operation_state = std::make_unique<IngestSstOperationState>(tablet.peer->tablet(), req);
+
+  operation_state->set_completion_callback(
+      MakeRpcOperationCompletionCallback(std::move(context), resp, server_->Clock()));
+
+  // Submit the ingest op. The RPC will be responded to asynchronously.
+  tablet.peer->Submit(
+      std::make_unique<tablet::IngestSstOperation>(
+          std::move(operation_state), tablet.peer.get()),
+      tablet.leader_term);
+}
+
 void TabletServiceAdminImpl::CreateTablet(const CreateTabletRequestPB* req,
                                           CreateTabletResponsePB* resp,
                                           rpc::RpcContext context) {
@@ -742,7 +844,8 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
   }
 
   if (PREDICT_FALSE(req->has_write_batch() &&
-      (!req->write_batch().write_pairs().empty() || !req->write_batch().read_pairs().empty()))) {
+      (!req->write_batch().write_pairs().empty() || !req->write_batch().read_pairs().empty() ||
+       !req->write_batch().range_tombstones().empty()))) {
     Status s = STATUS(NotSupported, "Write Request contains write batch. This field should be "
         "used only for post-processed write requests during "
         "Raft replication.");
@@ -1069,6 +1172,11 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
       read_time.local_limit = read_time.read;
       read_time.global_limit = read_time.read;
     }
+    if (req->has_max_staleness_ms() &&
+        req->consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX &&
+        !CheckStalenessOrRespond(*req, read_context.safe_ht_to_read, resp, &context)) {
+      return;
+    }
   } else {
     read_context.safe_ht_to_read = read_context.tablet->SafeTime(
         read_context.require_lease, read_time.read, context.GetClientDeadline());
@@ -1142,6 +1250,29 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   CompleteRead(&read_context);
 }
 
+bool TabletServiceImpl::CheckStalenessOrRespond(
+    const ReadRequestPB& req, HybridTime safe_time, ReadResponsePB* resp,
+    rpc::RpcContext* context) {
+  // Leader always serves the latest data.
+  TabletPeerPtr tablet_peer;
+  if (server_->tablet_peer_lookup()->GetTabletPeer(req.tablet_id(), &tablet_peer).ok() &&
+      CheckPeerIsLeader(*tablet_peer).ok()) {
+    return true;
+  }
+
+  auto now = server_->Clock()->Now();
+  if (safe_time.is_valid() &&
+      now.PhysicalDiff(safe_time) <= static_cast<int64_t>(req.max_staleness_ms() * 1000)) {
+    return true;
+  }
+  SetupErrorAndRespond(
+      resp->mutable_error(),
+      STATUS_FORMAT(IllegalState, "Stale follower, safe time $0 lags behind $1 by more than $2ms",
+                    safe_time, now, req.max_staleness_ms()),
+      TabletServerErrorPB::STALE_FOLLOWER, context);
+  return false;
+}
+
 void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
   for (;;) {
     read_context->resp->Clear();
@@ -1191,6 +1322,12 @@ void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
     read_context->used_read_time.ToPB(read_context->resp->mutable_used_read_time());
   }
 
+  // Report safe time, so client could route bounded staleness reads to fresh enough replicas.
+  if (read_context->req->consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX &&
+      read_context->safe_ht_to_read.is_valid()) {
+    read_context->resp->set_safe_time(read_context->safe_ht_to_read.ToUint64());
+  }
+
   RpcOperationCompletionCallback<ReadResponsePB> callback(
       std::move(*read_context->context), read_context->resp, server_->Clock());
   callback.OperationCompleted();
@@ -1372,6 +1509,43 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   context.RespondSuccess();
 }
 
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(
+    const consensus::MultiRaftConsensusRequestPB* req,
+    consensus::MultiRaftConsensusResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Multi Raft Consensus Update RPC with "
+           << req->consensus_request_size() << " requests";
+  auto deadline = context.GetClientDeadline();
+  auto requestor = context.requestor_string();
+  // See UpdateConsensus for the reason of const_cast.
+  auto* requests = const_cast<consensus::MultiRaftConsensusRequestPB*>(req)
+      ->mutable_consensus_request();
+  resp->mutable_consensus_response()->Reserve(requests->size());
+  for (auto& request : *requests) {
+    auto* response = resp->add_consensus_response();
+    TabletServerErrorPB error;
+    Status s = UpdateConsensusForTablet(&request, response, requestor, deadline, &error);
+    if (PREDICT_FALSE(!s.ok())) {
+      response->Clear();
+      response->mutable_error()->Swap(&error);
+    }
+  }
+  context.RespondSuccess();
+}
+
+Status ConsensusServiceImpl::UpdateConsensusForTablet(
+    ConsensusRequestPB* req, ConsensusResponsePB* resp, const std::string& requestor,
+    CoarseTimePoint deadline, TabletServerErrorPB* error) {
+  RETURN_NOT_OK(CheckUuidMatch(tablet_manager_, "MultiRaftUpdateConsensus", req, requestor, error));
+  auto tablet_peer = VERIFY_RESULT(LookupTabletPeer(tablet_manager_, req->tablet_id(), error));
+  auto consensus = VERIFY_RESULT(GetConsensus(tablet_peer, error));
+  Status s = consensus->Update(req, resp, deadline);
+  if (PREDICT_FALSE(!s.ok())) {
+    SetupError(error, s, TabletServerErrorPB::UNKNOWN_ERROR);
+  }
+  return s;
+}
+
 void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
                                                 VoteResponsePB* resp,
                                                 rpc::RpcContext context) {
@@ -116,6 +116,10 @@ class TabletServiceImpl : public TabletServerServiceIf {
                 TruncateResponsePB* resp,
                 rpc::RpcContext context) override;
 
+  void IngestSst(const IngestSstRequestPB* req,
+                 IngestSstResponsePB* resp,
+                 rpc::RpcContext context) override;
+
   void GetTabletStatus(const GetTabletStatusRequestPB* req,
                        GetTabletStatusResponsePB* resp,
                        rpc::RpcContext context) override;
@@ -150,6 +154,12 @@ class TabletServiceImpl : public TabletServerServiceIf {
   bool CheckMemoryPressure(
       tablet::Tablet* tablet, Resp* resp, rpc::RpcContext* context);
 
+  // Checks that replica safe time satisfies bounded staleness of the read, otherwise responds
+  // with STALE_FOLLOWER error.
+  bool CheckStalenessOrRespond(
+      const ReadRequestPB& req, HybridTime safe_time, ReadResponsePB* resp,
+      rpc::RpcContext* context);
+
   // Read implementation. If restart is required returns restart time, in case of success
   // returns invalid ReadHybridTime. Otherwise returns error status.
   Result<ReadHybridTime> DoRead(ReadContext* read_context);
@@ -200,6 +210,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                consensus::ConsensusResponsePB *resp,
                                rpc::RpcContext context) override;
 
+  virtual void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB *req,
+                                        consensus::MultiRaftConsensusResponsePB *resp,
+                                        rpc::RpcContext context) override;
+
   virtual void RequestConsensusVote(const consensus::VoteRequestPB* req,
                                     consensus::VoteResponsePB* resp,
                                     rpc::RpcContext context) override;
@@ -237,6 +251,13 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                     rpc::RpcContext context) override;
 
  private:
+  // Applies update of a single tablet from MultiRaftUpdateConsensus, failure is described in error.
+  CHECKED_STATUS UpdateConsensusForTablet(consensus::ConsensusRequestPB* req,
+                                          consensus::ConsensusResponsePB* resp,
+                                          const std::string& requestor,
+                                          CoarseTimePoint deadline,
+                                          TabletServerErrorPB* error);
+
   TabletPeerLookupIf* tablet_manager_;
 };
 
@@ -467,6 +467,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Used for scheduling flushes
   std::unique_ptr<BackgroundTask> background_task_;
 
+  // Batches heartbeats of tablets, that have peers on the same servers.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   // For block cache and memory monitor shared across tablets
   tablet::TabletOptions tablet_options_;
 
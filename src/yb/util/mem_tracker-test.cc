@@ -33,6 +33,7 @@
 #include "yb/util/mem_tracker.h"
 
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -41,11 +42,18 @@
 #include <gperftools/malloc_extension.h>
 #endif
 
+#include "yb/util/countdown_latch.h"
+#include "yb/util/monotime.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/test_util.h"
 
 DECLARE_int32(memory_limit_soft_percentage);
 DECLARE_int64(mem_tracker_update_consumption_interval_us);
+DECLARE_int64(mem_tracker_thread_cache_bytes);
+
+DEFINE_int32(mem_tracker_test_num_threads, 8, "Number of threads used by MemTrackerTest.Perf");
+DEFINE_int32(mem_tracker_test_num_operations, 1000000,
+             "Number of consume/release pairs per thread performed by MemTrackerTest.Perf");
 
 namespace yb {
 
@@ -336,6 +344,88 @@ TEST(MemTrackerTest, TcMallocRootTracker) {
 }
 #endif
 
+TEST(MemTrackerTest, ThreadCache) {
+  const int kNumThreads = 4;
+  const int64_t kBytesPerThread = 100;
+  auto parent = MemTracker::CreateTracker("parent");
+  CountDownLatch consumed(kNumThreads);
+  CountDownLatch release(1);
+  std::vector<std::thread> threads;
+  std::vector<MemTrackerPtr> children;
+  for (int i = 0; i != kNumThreads; ++i) {
+    children.push_back(MemTracker::CreateTracker(Format("child_$0", i), parent));
+    threads.emplace_back([&consumed, &release, child = children.back()] {
+      child->Consume(kBytesPerThread);
+      consumed.CountDown();
+      release.Wait();
+      child->Release(kBytesPerThread);
+    });
+  }
+  consumed.Wait();
+
+  // Consumption of the tracker itself is updated immediately, while ancestors are updated
+  // through thread local caches.
+  for (const auto& child : children) {
+    ASSERT_EQ(kBytesPerThread, child->consumption());
+  }
+  MemTracker::FlushThreadCaches();
+  ASSERT_EQ(kNumThreads * kBytesPerThread, parent->consumption());
+
+  // Caches are flushed when threads exit.
+  release.CountDown();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(0, parent->consumption());
+}
+
+namespace {
+
+MonoDelta ConsumeReleaseInParallel(const MemTrackerPtr& parent) {
+  std::vector<MemTrackerPtr> children;
+  for (int i = 0; i != FLAGS_mem_tracker_test_num_threads; ++i) {
+    children.push_back(MemTracker::CreateTracker(Format("child_$0", i), parent));
+  }
+  std::vector<std::thread> threads;
+  auto start = MonoTime::Now();
+  for (const auto& child : children) {
+    threads.emplace_back([child] {
+      for (int i = 0; i != FLAGS_mem_tracker_test_num_operations; ++i) {
+        child->Consume(1_KB);
+        child->Release(1_KB);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto result = MonoTime::Now() - start;
+  for (const auto& child : children) {
+    child->UnregisterFromParent();
+  }
+  return result;
+}
+
+} // namespace
+
+TEST(MemTrackerTest, Perf) {
+  google::FlagSaver saver;
+  auto parent = MemTracker::CreateTracker("parent");
+  auto grand_child = MemTracker::CreateTracker("grand_child", parent);
+
+  auto cached_time = ConsumeReleaseInParallel(grand_child);
+  ASSERT_EQ(0, parent->consumption());
+
+  FLAGS_mem_tracker_thread_cache_bytes = 0;
+  auto uncached_time = ConsumeReleaseInParallel(grand_child);
+  ASSERT_EQ(0, parent->consumption());
+
+  LOG(INFO) << "Threads: " << FLAGS_mem_tracker_test_num_threads
+            << ", operations per thread: " << FLAGS_mem_tracker_test_num_operations
+            << ", with thread cache: " << cached_time
+            << ", without thread cache: " << uncached_time;
+}
+
 TEST(MemTrackerTest, UnregisterFromParent) {
   shared_ptr<MemTracker> p = MemTracker::CreateTracker("parent");
   shared_ptr<MemTracker> c = MemTracker::CreateTracker("child", p);
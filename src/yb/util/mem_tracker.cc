@@ -33,11 +33,13 @@
 #include "yb/util/mem_tracker.h"
 
 #include <algorithm>
+#include <array>
 #include <deque>
 #include <limits>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <utility>
 
 #ifdef TCMALLOC_ENABLED
 #include <gperftools/malloc_extension.h>
@@ -102,6 +104,11 @@ DEFINE_int64(mem_tracker_update_consumption_interval_us, 2000000,
              "Interval that is used to update memory consumption from external source. "
              "For instance from tcmalloc statistics.");
 
+DEFINE_int64(mem_tracker_thread_cache_bytes, 64 * 1024,
+             "Consumption of mem tracker ancestors is accumulated in thread local cache and "
+             "applied when it reaches this number of bytes. 0 to update ancestors immediately.");
+TAG_FLAG(mem_tracker_thread_cache_bytes, advanced);
+
 namespace yb {
 
 // NOTE: this class has been adapted from Impala, so the code style varies
@@ -193,6 +200,168 @@ std::string CreateMetricDescription(const MemTracker& mem_tracker) {
 
 } // namespace
 
+// Consume() and Release() update the tracker itself immediately, while updates of its parent and
+// further ancestors are accumulated in a cache of the current thread and applied in chunks. So
+// trackers close to the root, which are shared by all threads, are not updated on every call.
+//
+// Entries are guarded by a spinlock that other threads take only to flush all caches, so it is
+// almost always uncontended.
+class MemTracker::ThreadCache {
+ public:
+  // Returns nullptr if cache is disabled or current thread is exiting.
+  static ThreadCache* Current() {
+    if (FLAGS_mem_tracker_thread_cache_bytes <= 0 || Destroyed()) {
+      return nullptr;
+    }
+    static thread_local ThreadCache cache;
+    return &cache;
+  }
+
+  // Returns cache of the current thread if it was already created.
+  static ThreadCache* CurrentIfExists() {
+    return CurrentPtr();
+  }
+
+  ThreadCache() {
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.caches.push_back(this);
+    registry.size.store(registry.caches.size(), std::memory_order_relaxed);
+    CurrentPtr() = this;
+  }
+
+  ~ThreadCache() {
+    CurrentPtr() = nullptr;
+    Destroyed() = true;
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> registry_lock(registry.mutex);
+    {
+      std::lock_guard<simple_spinlock> lock(mutex_);
+      FlushUnlocked(nullptr /* tracker */);
+    }
+    registry.caches.erase(std::find(registry.caches.begin(), registry.caches.end(), this));
+    registry.size.store(registry.caches.size(), std::memory_order_relaxed);
+    if (released_bytes_) {
+      base::subtle::Barrier_AtomicIncrement(&released_memory_since_gc, released_bytes_);
+    }
+  }
+
+  // Adds bytes to pending update of tracker and its ancestors.
+  void Update(MemTracker* tracker, int64_t bytes) {
+    std::lock_guard<simple_spinlock> lock(mutex_);
+    Entry* entry = nullptr;
+    Entry* free_entry = nullptr;
+    for (auto& current : entries_) {
+      if (current.tracker == tracker) {
+        entry = &current;
+        break;
+      }
+      if (!current.tracker && !free_entry) {
+        free_entry = &current;
+      }
+    }
+    if (!entry) {
+      if (!free_entry) {
+        free_entry = &entries_[next_evicted_entry_];
+        next_evicted_entry_ = (next_evicted_entry_ + 1) % kMaxEntries;
+        FlushEntry(free_entry);
+      }
+      entry = free_entry;
+      entry->tracker = tracker;
+    }
+    entry->bytes += bytes;
+    if (std::abs(entry->bytes) >= FLAGS_mem_tracker_thread_cache_bytes) {
+      FlushEntry(entry);
+    }
+  }
+
+  // Accumulates released bytes, returns number of bytes that should be added to
+  // released_memory_since_gc.
+  int64_t Released(int64_t bytes) {
+    released_bytes_ += bytes;
+    if (released_bytes_ < FLAGS_mem_tracker_thread_cache_bytes) {
+      return 0;
+    }
+    return std::exchange(released_bytes_, 0);
+  }
+
+  void Flush() {
+    std::lock_guard<simple_spinlock> lock(mutex_);
+    for (auto& entry : entries_) {
+      FlushEntry(&entry);
+    }
+  }
+
+  // Flushes caches of all threads. If tracker is specified, only its entries are flushed and
+  // removed from caches.
+  static void FlushAll(MemTracker* tracker) {
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> registry_lock(registry.mutex);
+    for (auto* cache : registry.caches) {
+      std::lock_guard<simple_spinlock> lock(cache->mutex_);
+      cache->FlushUnlocked(tracker);
+    }
+  }
+
+  // Returns upper bound for absolute value of pending updates of a single tracker.
+  static int64_t MaxPendingBytes() {
+    return static_cast<int64_t>(GetRegistry().size.load(std::memory_order_relaxed) * kMaxEntries) *
+           FLAGS_mem_tracker_thread_cache_bytes;
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 4;
+
+  struct Entry {
+    MemTracker* tracker = nullptr;
+    int64_t bytes = 0;
+  };
+
+  struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadCache*> caches;
+    std::atomic<size_t> size{0};
+  };
+
+  static Registry& GetRegistry() {
+    // Intentionally leaked, since thread local caches could be destroyed after static objects.
+    static Registry* registry = new Registry();
+    return *registry;
+  }
+
+  static ThreadCache*& CurrentPtr() {
+    static thread_local ThreadCache* current = nullptr;
+    return current;
+  }
+
+  static bool& Destroyed() {
+    static thread_local bool destroyed = false;
+    return destroyed;
+  }
+
+  void FlushEntry(Entry* entry) {
+    if (entry->bytes) {
+      entry->tracker->IncrementAll(entry->bytes);
+      entry->bytes = 0;
+    }
+  }
+
+  void FlushUnlocked(MemTracker* tracker) {
+    for (auto& entry : entries_) {
+      if (entry.tracker && (!tracker || entry.tracker == tracker)) {
+        FlushEntry(&entry);
+        entry.tracker = nullptr;
+      }
+    }
+  }
+
+  simple_spinlock mutex_;
+  std::array<Entry, kMaxEntries> entries_;
+  size_t next_evicted_entry_ = 0;
+  // Accessed only by the owning thread.
+  int64_t released_bytes_ = 0;
+};
+
 class MemTracker::TrackerMetrics {
  public:
   explicit TrackerMetrics(const MetricEntityPtr& metric_entity)
@@ -305,6 +474,9 @@ MemTracker::MemTracker(int64_t byte_limit, const string& id, shared_ptr<MemTrack
         all_trackers_.end(), parent_->all_trackers_.begin(), parent_->all_trackers_.end());
     limit_trackers_.insert(
         limit_trackers_.end(), parent_->limit_trackers_.begin(), parent_->limit_trackers_.end());
+    for (auto* tracker : parent_->all_trackers_) {
+      tracker->tracks_descendants_.store(true, std::memory_order_relaxed);
+    }
   }
 
   if (create_metrics) {
@@ -320,6 +492,9 @@ MemTracker::MemTracker(int64_t byte_limit, const string& id, shared_ptr<MemTrack
 
 MemTracker::~MemTracker() {
   VLOG(1) << "Destroying tracker " << ToString();
+  if (tracks_descendants_.load(std::memory_order_relaxed)) {
+    ThreadCache::FlushAll(this);
+  }
   if (parent_) {
     DCHECK_EQ(consumption(), 0) << "Memory tracker " << ToString();
     if (add_to_parent_) {
@@ -456,14 +631,59 @@ void MemTracker::Consume(int64_t bytes) {
   if (PREDICT_FALSE(enable_logging_)) {
     LogUpdate(true, bytes);
   }
+  IncrementBy(bytes, &consumption_, metrics_);
+  DCHECK_GE(consumption_.current_value(), 0);
+  UpdateAncestors(bytes);
+}
+
+void MemTracker::UpdateAncestors(int64_t bytes) {
+  if (all_trackers_.size() < 2) {
+    return;
+  }
+  auto* cache = ThreadCache::Current();
+  if (cache) {
+    cache->Update(all_trackers_[1], bytes);
+  } else {
+    all_trackers_[1]->IncrementAll(bytes);
+  }
+}
+
+void MemTracker::IncrementAll(int64_t bytes) {
   for (auto& tracker : all_trackers_) {
     if (!tracker->UpdateConsumption()) {
       IncrementBy(bytes, &tracker->consumption_, tracker->metrics_);
-      DCHECK_GE(tracker->consumption_.current_value(), 0);
     }
   }
 }
 
+void MemTracker::FlushThreadCaches() {
+  ThreadCache::FlushAll(nullptr /* tracker */);
+}
+
+void MemTracker::FlushCurrentThreadCache() {
+  auto* cache = ThreadCache::CurrentIfExists();
+  if (cache) {
+    cache->Flush();
+  }
+}
+
+void MemTracker::FlushThreadCachesIfNearLimit(int64_t bytes) const {
+  if (!tracks_descendants_.load(std::memory_order_relaxed)) {
+    return;
+  }
+#if TCMALLOC_ENABLED
+  // Consumption of the root tracker is taken from tcmalloc.
+  if (!parent_) {
+    return;
+  }
+#endif
+  auto max_pending_bytes = ThreadCache::MaxPendingBytes();
+  if (max_pending_bytes != 0 &&
+      std::abs(limit_ - consumption_.current_value() - bytes) <= max_pending_bytes) {
+    FlushThreadCaches();
+  }
+}
+
 bool MemTracker::TryConsume(int64_t bytes, MemTracker** blocking_mem_tracker) {
   UpdateConsumption();
   if (bytes <= 0) {
@@ -473,6 +693,12 @@ bool MemTracker::TryConsume(int64_t bytes, MemTracker** blocking_mem_tracker) {
     LogUpdate(true, bytes);
   }
 
+  // Limits are checked against exact consumption, so pending updates are flushed when they could
+  // affect the result.
+  for (auto* tracker : limit_trackers_) {
+    tracker->FlushThreadCachesIfNearLimit(bytes);
+  }
+
   int i = 0;
   // Walk the tracker tree top-down, to avoid expanding a limit on a child whose parent
   // won't accommodate the change.
@@ -525,8 +751,11 @@ void MemTracker::Release(int64_t bytes) {
     return;
   }
 
-  if (PREDICT_FALSE(base::subtle::Barrier_AtomicIncrement(&released_memory_since_gc, bytes) >
-                    GC_RELEASE_SIZE)) {
+  auto* cache = ThreadCache::Current();
+  auto released_bytes = cache ? cache->Released(bytes) : bytes;
+  if (released_bytes != 0 &&
+      PREDICT_FALSE(base::subtle::Barrier_AtomicIncrement(
+          &released_memory_since_gc, released_bytes) > GC_RELEASE_SIZE)) {
     GcTcmalloc();
   }
 
@@ -541,18 +770,11 @@ void MemTracker::Release(int64_t bytes) {
     LogUpdate(false, bytes);
   }
 
-  for (auto& tracker : all_trackers_) {
-    if (!tracker->UpdateConsumption()) {
-      IncrementBy(-bytes, &tracker->consumption_, tracker->metrics_);
-      // If a UDF calls FunctionContext::TrackAllocation() but allocates less than the
-      // reported amount, the subsequent call to FunctionContext::Free() may cause the
-      // process mem tracker to go negative until it is synced back to the tcmalloc
-      // metric. Don't blow up in this case. (Note that this doesn't affect non-process
-      // trackers since we can enforce that the reported memory usage is internally
-      // consistent.)
-      DCHECK_GE(tracker->consumption_.current_value(), 0) << "Tracker: " << tracker->ToString();
-    }
-  }
+  IncrementBy(-bytes, &consumption_, metrics_);
+  // Ancestors are not checked, since their consumption could temporarily go negative, when
+  // memory consumed by one thread is released by another thread that flushes its cache first.
+  DCHECK_GE(consumption_.current_value(), 0) << "Tracker: " << ToString();
+  UpdateAncestors(-bytes);
 }
 
 bool MemTracker::AnyLimitExceeded() {
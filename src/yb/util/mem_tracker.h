@@ -34,6 +34,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -294,10 +295,20 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   const std::string& id() const { return id_; }
 
   // Returns the memory consumed in bytes.
+  // Consume() and Release() update ancestors of the tracker through a thread local cache, so
+  // consumption of a tracker could miss up to mem_tracker_thread_cache_bytes per thread for each
+  // of its descendants updated by other threads. Updates made by the calling thread are always
+  // visible.
   int64_t consumption() const {
+    if (tracks_descendants_.load(std::memory_order_relaxed)) {
+      FlushCurrentThreadCache();
+    }
     return consumption_.current_value();
   }
 
+  // Flushes thread local caches of all threads, so consumption of all trackers becomes exact.
+  static void FlushThreadCaches();
+
   int64_t GetUpdatedConsumption() {
     UpdateConsumption();
     return consumption();
@@ -341,10 +352,28 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   }
 
  private:
+  class ThreadCache;
+
   bool CheckLimitExceeded() const {
-    return limit_ >= 0 && limit_ < consumption();
+    if (limit_ < 0) {
+      return false;
+    }
+    FlushThreadCachesIfNearLimit(0);
+    return limit_ < consumption();
   }
 
+  // Updates consumption of ancestors of this tracker, through thread local cache if it is enabled.
+  void UpdateAncestors(int64_t bytes);
+
+  // Updates consumption of this tracker and its ancestors, bypassing thread local caches.
+  void IncrementAll(int64_t bytes);
+
+  // Flushes thread local caches of all threads, when their pending updates could make difference
+  // for consumption of bytes in respect to the limit of this tracker.
+  void FlushThreadCachesIfNearLimit(int64_t bytes) const;
+
+  static void FlushCurrentThreadCache();
+
   // If consumption is higher than max_consumption, attempts to free memory by calling any
   // added GC functions.  Returns true if max_consumption is still exceeded. Takes
   // gc_lock. Updates metrics if initialized.
@@ -396,6 +425,10 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
 
   HighWaterMark consumption_{0};
 
+  // Whether consumption of some trackers is added to this one, so thread local caches could
+  // contain pending updates for it.
+  std::atomic<bool> tracks_descendants_{false};
+
   // this tracker plus all of its ancestors
   std::vector<MemTracker*> all_trackers_;
   // all_trackers_ with valid limits
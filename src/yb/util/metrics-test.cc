@@ -217,6 +217,64 @@ TEST_F(MetricsTest, JsonPrintTest) {
   ASSERT_EQ("", out.str());
 }
 
+METRIC_DEFINE_counter(server, test_prometheus_requests, "Test Requests", MetricUnit::kRequests,
+                      "Test counter exported to Prometheus");
+METRIC_DEFINE_counter(server, test_prometheus_idle_requests, "Test Idle Requests",
+                      MetricUnit::kRequests, "Test counter exported to Prometheus");
+
+TEST_F(MetricsTest, PrometheusTest) {
+  MetricRegistry registry;
+  auto server_entity = METRIC_ENTITY_server.Instantiate(&registry, "yb.test");
+  METRIC_test_prometheus_requests.Instantiate(server_entity)->IncrementBy(3);
+  auto idle_requests = METRIC_test_prometheus_idle_requests.Instantiate(server_entity);
+
+  auto write = [&registry](MetricPrometheusOptions opts) {
+    std::stringstream out;
+    PrometheusWriter writer(&out, std::move(opts));
+    EXPECT_OK(registry.WriteForPrometheus(&writer));
+    return out.str();
+  };
+
+  auto output = write(MetricPrometheusOptions());
+  ASSERT_STR_CONTAINS(output, "test_prometheus_requests{");
+  ASSERT_STR_CONTAINS(output, "metric_id=\"yb.test\"");
+  ASSERT_STR_CONTAINS(output, "test_prometheus_idle_requests{");
+
+  MetricPrometheusOptions opts;
+  opts.skip_zero_counters = true;
+  output = write(opts);
+  ASSERT_STR_CONTAINS(output, "test_prometheus_requests{");
+  ASSERT_EQ(output.find("test_prometheus_idle_requests"), std::string::npos) << output;
+
+  opts = MetricPrometheusOptions();
+  opts.metric_name_prefixes = { "test_prometheus_idle" };
+  output = write(opts);
+  ASSERT_EQ(output.find("test_prometheus_requests"), std::string::npos) << output;
+  ASSERT_STR_CONTAINS(output, "test_prometheus_idle_requests{");
+
+  opts = MetricPrometheusOptions();
+  opts.entity_types = { "tablet" };
+  ASSERT_EQ("", write(opts));
+}
+
+TEST_F(MetricsTest, PrometheusTableRollupTest) {
+  std::stringstream out;
+  PrometheusWriter writer(&out);
+  MetricEntity::AttributeMap table1_attrs = {{"table_id", "t1"}};
+  MetricEntity::AttributeMap table2_attrs = {{"table_id", "t2"}};
+  // Values of tablets of the same table are summed up, the first one included.
+  ASSERT_OK(writer.WriteSingleEntry(table1_attrs, "rows", 1));
+  ASSERT_OK(writer.WriteSingleEntry(table2_attrs, "rows", 10));
+  ASSERT_OK(writer.WriteSingleEntry(table1_attrs, "rows", 2));
+  ASSERT_OK(writer.WriteSingleEntry(table1_attrs, "rows", 4));
+  ASSERT_EQ("", out.str());
+
+  ASSERT_OK(writer.FlushAggregatedValues());
+  auto output = out.str();
+  ASSERT_STR_CONTAINS(output, "rows{table_id=\"t1\"} 7 ");
+  ASSERT_STR_CONTAINS(output, "rows{table_id=\"t2\"} 10 ");
+}
+
 // Test that metrics are retired when they are no longer referenced.
 TEST_F(MetricsTest, RetirementTest) {
   FLAGS_metrics_retirement_age_ms = 100;
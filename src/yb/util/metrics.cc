@@ -31,6 +31,7 @@
 //
 #include "yb/util/metrics.h"
 
+#include <chrono>
 #include <iostream>
 #include <map>
 #include <regex>
@@ -285,50 +286,50 @@ Status MetricEntity::WriteAsJson(JsonWriter* writer,
 }
 
 CHECKED_STATUS MetricEntity::WriteForPrometheus(PrometheusWriter* writer) const {
-  // We want the keys to be in alphabetical order when printing, so we use an ordered map here.
-  typedef std::map<const char*, scoped_refptr<Metric> > OrderedMetricMap;
-  OrderedMetricMap metrics;
-  AttributeMap attrs;
-  std::vector<ExternalPrometheusMetricsCb> external_metrics_cbs;
+  const char* entity_type = prototype_->name();
+  // This is currently tablet / server / cluster.
+  const bool is_tablet = strcmp(entity_type, "tablet") == 0;
+  if ((!is_tablet && strcmp(entity_type, "server") != 0 && strcmp(entity_type, "cluster") != 0) ||
+      !writer->EntityTypeMatches(entity_type)) {
+    return Status::OK();
+  }
+
+  std::vector<scoped_refptr<Metric>> metrics;
+  std::vector<ExternalPrometheusMetricsCbPtr> external_metrics_cbs;
+  AttributeMap prometheus_attr;
   {
     // Snapshot the metrics, attributes & external metrics callbacks in this metrics entity. (Note:
     // this is not guaranteed to be a consistent snapshot).
     std::lock_guard<simple_spinlock> l(lock_);
-    attrs = attributes_;
+    if (is_tablet) {
+      // Per tablet metrics come with tablet_id, as well as table_id and table_name attributes.
+      // We ignore the tablet part to squash at the table level.
+      prometheus_attr["table_id"] = FindWithDefault(attributes_, "table_id", string());
+      prometheus_attr["table_name"] = FindWithDefault(attributes_, "table_name", string());
+    } else {
+      prometheus_attr = attributes_;
+      // This is tablet_id in the case of tablet, but otherwise names the server type, eg: yb.master
+      prometheus_attr["metric_id"] = id_;
+    }
     external_metrics_cbs = external_prometheus_metrics_cbs_;
+    metrics.reserve(metric_map_.size());
     for (const MetricMap::value_type& val : metric_map_) {
-      const MetricPrototype* prototype = val.first;
-      const scoped_refptr<Metric>& metric = val.second;
-
-      InsertOrDie(&metrics, prototype->name(), metric);
+      if (writer->MetricNameMatches(val.first->name())) {
+        metrics.push_back(val.second);
+      }
     }
   }
-  AttributeMap prometheus_attr;
-  // Per tablet metrics come with tablet_id, as well as table_id and table_name attributes.
-  // We ignore the tablet part to squash at the table level.
-  if (strcmp(prototype_->name(), "tablet") == 0)  {
-    prometheus_attr["table_id"] = attrs["table_id"];
-    prometheus_attr["table_name"] = attrs["table_name"];
-  } else if (strcmp(prototype_->name(), "server") == 0 ||
-      strcmp(prototype_->name(), "cluster") == 0) {
-    prometheus_attr = attrs;
-    // This is tablet_id in the case of tablet, but otherwise names the server type, eg: yb.master
-    prometheus_attr["metric_id"] = id_;
-  } else {
-    return Status::OK();
-  }
-  // This is currently tablet / server / cluster.
-  prometheus_attr["metric_type"] = prototype_->name();
+  prometheus_attr["metric_type"] = entity_type;
   prometheus_attr["exported_instance"] = FLAGS_metric_node_name;
 
-  for (OrderedMetricMap::value_type& val : metrics) {
-    WARN_NOT_OK(val.second->WriteForPrometheus(writer, prometheus_attr),
-                strings::Substitute("Failed to write $0 as Prometheus", val.first));
-
+  for (const auto& metric : metrics) {
+    WARN_NOT_OK(metric->WriteForPrometheus(writer, prometheus_attr),
+                strings::Substitute("Failed to write $0 as Prometheus",
+                                    metric->prototype()->name()));
   }
   // Run the external metrics collection callback if there is one set.
-  for (const ExternalPrometheusMetricsCb& cb : external_metrics_cbs) {
-    cb(writer);
+  for (const auto& cb : external_metrics_cbs) {
+    (*cb)(writer);
   }
 
   return Status::OK();
@@ -437,15 +438,19 @@ Status MetricRegistry::WriteAsJson(JsonWriter* writer,
 }
 
 CHECKED_STATUS MetricRegistry::WriteForPrometheus(PrometheusWriter* writer) const {
-  EntityMap entities;
+  // Only the entities are referenced, to avoid copying their ids.
+  std::vector<scoped_refptr<MetricEntity>> entities;
   {
     std::lock_guard<simple_spinlock> l(lock_);
-    entities = entities_;
+    entities.reserve(entities_.size());
+    for (const EntityMap::value_type& e : entities_) {
+      entities.push_back(e.second);
+    }
   }
 
-  for (const EntityMap::value_type e : entities) {
-    WARN_NOT_OK(e.second->WriteForPrometheus(writer),
-                Substitute("Failed to write entity $0 as Prometheus", e.second->id()));
+  for (const auto& entity : entities) {
+    WARN_NOT_OK(entity->WriteForPrometheus(writer),
+                Substitute("Failed to write entity $0 as Prometheus", entity->id()));
   }
   RETURN_NOT_OK(writer->FlushAggregatedValues());
 
@@ -538,6 +543,64 @@ void MetricPrototypeRegistry::WriteAsJsonAndExit() const {
   exit(0);
 }
 
+//
+// PrometheusWriter
+//
+
+PrometheusWriter::PrometheusWriter(std::stringstream* output, MetricPrometheusOptions opts)
+    : output_(output),
+      opts_(std::move(opts)),
+      timestamp_(std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count()) {
+}
+
+bool PrometheusWriter::EntityTypeMatches(const char* entity_type) const {
+  if (opts_.entity_types.empty()) {
+    return true;
+  }
+  for (const auto& type : opts_.entity_types) {
+    if (type == entity_type) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PrometheusWriter::MetricNameMatchesPrefixes(const char* name) const {
+  for (const auto& prefix : opts_.metric_name_prefixes) {
+    if (strncmp(name, prefix.c_str(), prefix.size()) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PrometheusWriter::AggregateForTable(const std::string& table_id,
+                                         const MetricEntity::AttributeMap& attr,
+                                         const std::string& name,
+                                         double value) {
+  if (!last_table_ || last_table_->first != table_id) {
+    auto it = per_table_.find(table_id);
+    if (it == per_table_.end()) {
+      // If it's the first time we see this table, attributes of the entry are used for the table.
+      it = per_table_.emplace(table_id, TableAggregate{attr, {}}).first;
+    }
+    last_table_ = &*it;
+  }
+  last_table_->second.values[name] += value;
+}
+
+Status PrometheusWriter::FlushAggregatedValues() {
+  for (const auto& table : per_table_) {
+    for (const auto& metric_entry : table.second.values) {
+      FlushSingleEntry(table.second.attributes, metric_entry.first, metric_entry.second);
+    }
+  }
+  per_table_.clear();
+  last_table_ = nullptr;
+  return Status::OK();
+}
+
 //
 // MetricPrototype
 //
@@ -692,7 +755,11 @@ Status Counter::WriteAsJson(JsonWriter* writer,
 
 CHECKED_STATUS Counter::WriteForPrometheus(
     PrometheusWriter* writer, const MetricEntity::AttributeMap& attr) const {
-  return writer->WriteSingleEntry(attr, prototype_->name(), value());
+  auto current_value = value();
+  if (current_value == 0 && writer->options().skip_zero_counters) {
+    return Status::OK();
+  }
+  return writer->WriteSingleEntry(attr, prototype_->name(), current_value);
 }
 
 
@@ -747,17 +814,24 @@ Status Histogram::WriteAsJson(JsonWriter* writer,
 
 CHECKED_STATUS Histogram::WriteForPrometheus(
     PrometheusWriter* writer, const MetricEntity::AttributeMap& attr) const {
-  HdrHistogram snapshot(*histogram_);
+  // Only the totals are written, so they are read directly instead of copying the whole histogram.
+  // Like the snapshot, they are not guaranteed to be consistent with each other.
+  auto total_count = histogram_->TotalCount();
+  if (total_count == 0 && writer->options().skip_zero_counters) {
+    return Status::OK();
+  }
 
   // Representing the sum and count require suffixed names.
   std::string hist_name = prototype_->name();
-  auto copy_of_attr = attr;
-  RETURN_NOT_OK(writer->WriteSingleEntry(
-        copy_of_attr, hist_name + "_sum", snapshot.TotalSum()));
-  RETURN_NOT_OK(writer->WriteSingleEntry(
-        copy_of_attr, hist_name + "_count", snapshot.TotalCount()));
+  auto hist_name_size = hist_name.size();
+  hist_name += "_sum";
+  RETURN_NOT_OK(writer->WriteSingleEntry(attr, hist_name, histogram_->TotalSum()));
+  hist_name.resize(hist_name_size);
+  hist_name += "_count";
+  RETURN_NOT_OK(writer->WriteSingleEntry(attr, hist_name, total_count));
   /*
   // Copy the label map to add the quatiles.
+  auto copy_of_attr = attr;
   copy_of_attr["quantile"] = "0.75";
   RETURN_NOT_OK(writer->WriteSingleEntry(
         copy_of_attr, hist_name, snapshot.ValueAtPercentile(75)));
@@ -239,6 +239,7 @@
 /////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <sstream>
@@ -441,6 +442,21 @@ struct MetricJsonOptions {
   bool include_schema_info;
 };
 
+struct MetricPrometheusOptions {
+  // Only metrics whose names start with one of these prefixes are written.
+  // Default: empty, i.e. all metrics are written.
+  std::vector<std::string> metric_name_prefixes;
+
+  // Only entities of these types, e.g. "tablet" or "server", are written.
+  // Default: empty, i.e. entities of all types are written.
+  std::vector<std::string> entity_types;
+
+  // Skip counters and histograms that were never updated, i.e. that are still zero. This
+  // significantly reduces the output size for nodes with a lot of idle tablets.
+  // Default: false
+  bool skip_zero_counters = false;
+};
+
 class MetricEntityPrototype {
  public:
   explicit MetricEntityPrototype(const char* name);
@@ -476,6 +492,7 @@ class MetricEntity : public RefCountedThreadSafe<MetricEntity> {
     ExternalJsonMetricsCb;
   typedef std::function<void (PrometheusWriter* writer)>
     ExternalPrometheusMetricsCb;
+  typedef std::shared_ptr<const ExternalPrometheusMetricsCb> ExternalPrometheusMetricsCbPtr;
 
   scoped_refptr<Counter> FindOrCreateCounter(const CounterPrototype* proto);
   scoped_refptr<Histogram> FindOrCreateHistogram(const HistogramPrototype* proto);
@@ -537,8 +554,9 @@ class MetricEntity : public RefCountedThreadSafe<MetricEntity> {
   }
 
   void AddExternalPrometheusMetricsCb(const ExternalPrometheusMetricsCb&external_metrics_cb) {
+    auto cb = std::make_shared<const ExternalPrometheusMetricsCb>(external_metrics_cb);
     std::lock_guard<simple_spinlock> l(lock_);
-    external_prometheus_metrics_cbs_.push_back(external_metrics_cb);
+    external_prometheus_metrics_cbs_.push_back(std::move(cb));
   }
 
   const MetricEntityPrototype& prototype() const { return *prototype_; }
@@ -575,82 +593,97 @@ class MetricEntity : public RefCountedThreadSafe<MetricEntity> {
   // Callbacks fired each time WriteAsJson is called.
   std::vector<ExternalJsonMetricsCb> external_json_metrics_cbs_;
 
-  // Callbacks fired each time WriteForPrometheus is called.
-  std::vector<ExternalPrometheusMetricsCb> external_prometheus_metrics_cbs_;
+  // Callbacks fired each time WriteForPrometheus is called. Held by pointer, so that taking a
+  // snapshot of them during a scrape does not copy the state they capture.
+  std::vector<ExternalPrometheusMetricsCbPtr> external_prometheus_metrics_cbs_;
 };
 
 typedef scoped_refptr<MetricEntity> MetricEntityPtr;
 
+// Writes metrics in the Prometheus text format directly to the output stream.
+// Tablet level metrics are rolled up on the table level while they are written, and the
+// aggregated values are written by FlushAggregatedValues.
 class PrometheusWriter {
  public:
-  explicit PrometheusWriter(std::stringstream* output)
-    : output_(output),
-      timestamp_(std::chrono::duration_cast<std::chrono::milliseconds>(
-          std::chrono::system_clock::now().time_since_epoch()).count()) {}
+  explicit PrometheusWriter(std::stringstream* output,
+                            MetricPrometheusOptions opts = MetricPrometheusOptions());
+
+  const MetricPrometheusOptions& options() const { return opts_; }
+
+  // Whether entities of the specified type are requested by the options.
+  bool EntityTypeMatches(const char* entity_type) const;
+
+  // Whether the metric with the specified name is requested by the options.
+  bool MetricNameMatches(const char* name) const {
+    return opts_.metric_name_prefixes.empty() || MetricNameMatchesPrefixes(name);
+  }
+
+  bool MetricNameMatches(const std::string& name) const {
+    return MetricNameMatches(name.c_str());
+  }
 
   template<typename T>
   CHECKED_STATUS WriteSingleEntry(
       const MetricEntity::AttributeMap& attr, const std::string& name, const T& value) {
+    if (!MetricNameMatches(name)) {
+      return Status::OK();
+    }
     auto it = attr.find("table_id");
     if (it != attr.end()) {
       // For tablet level metrics, we roll up on the table level.
-      if (per_table_attributes_.find(it->second) == per_table_attributes_.end()) {
-        // If it's the first time we see this table, create the aggregate structures.
-        per_table_attributes_[it->second] = attr;
-        per_table_values_[it->second];
-      } else {
-        per_table_values_[it->second][name] += value;
-      }
+      AggregateForTable(it->second, attr, name, value);
     } else {
       // For non-tablet level metrics, export them directly.
-      RETURN_NOT_OK(FlushSingleEntry(attr, name, value));
+      FlushSingleEntry(attr, name, value);
     }
     return Status::OK();
   }
 
-  CHECKED_STATUS FlushAggregatedValues() {
-    for (const auto& entry : per_table_values_) {
-      const auto& attrs = per_table_attributes_[entry.first];
-      for (const auto& metric_entry : entry.second) {
-        RETURN_NOT_OK(FlushSingleEntry(attrs, metric_entry.first, metric_entry.second));
-      }
-    }
-    return Status::OK();
-  }
+  CHECKED_STATUS FlushAggregatedValues();
 
  private:
+  struct TableAggregate {
+    MetricEntity::AttributeMap attributes;
+    // Map from metric name to the sum of its values over the tablets of the table.
+    std::unordered_map<std::string, double> values;
+  };
+
+  typedef std::unordered_map<std::string, TableAggregate> TableAggregates;
+
+  bool MetricNameMatchesPrefixes(const char* name) const;
+
+  void AggregateForTable(const std::string& table_id,
+                         const MetricEntity::AttributeMap& attr,
+                         const std::string& name,
+                         double value);
+
   template<typename T>
-  CHECKED_STATUS FlushSingleEntry(
+  void FlushSingleEntry(
       const MetricEntity::AttributeMap& attr, const std::string& name, const T& value) {
     *output_ << name;
-    size_t total_elements = attr.size();
-    if (total_elements > 0) {
-      *output_ << "{";
+    if (!attr.empty()) {
+      char separator = '{';
       for (const auto& entry : attr) {
-        *output_ << entry.first << "=\"" << entry.second << "\"";
-        if (--total_elements > 0) {
-          *output_ << ",";
-        }
+        *output_ << separator << entry.first << "=\"" << entry.second << '"';
+        separator = ',';
       }
-      *output_ << "}";
+      *output_ << '}';
     }
-    *output_ << " " << value;
-    *output_ << " " << timestamp_;
-    *output_ << std::endl;
-    return Status::OK();
+    *output_ << ' ' << value << ' ' << timestamp_ << '\n';
   }
 
-  // Map from table_id to attributes
-  std::map<std::string, MetricEntity::AttributeMap> per_table_attributes_;
-  // Map from table_id to map of metric_name to value
-  std::map<std::string, std::map<std::string, double>> per_table_values_;
   // Output stream
   std::stringstream* output_;
+  const MetricPrometheusOptions opts_;
   // Timestamp for all metrics belonging to this writer instance.
-  int64_t timestamp_;
-};
-
+  const int64_t timestamp_;
 
+  // Map from table_id to values aggregated over the tablets of this table.
+  TableAggregates per_table_;
+  // Metrics of the same tablet are written in a row, so the table of the previous entry is
+  // remembered to avoid looking it up for each entry.
+  TableAggregates::value_type* last_table_ = nullptr;
+};
 
 // Base class to allow for putting all metrics into a single container.
 // See documentation at the top of this file for information on metrics ownership.
@@ -203,6 +203,7 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   request_ = nullptr;
   stmts_.clear();
   parse_trees_.clear();
+  unprepared_stmt_ = nullptr;
   SetCurrentSession(nullptr);
   service_impl_->ReturnProcessor(pos_);
 }
@@ -310,8 +311,17 @@ CQLResponse* CQLProcessor::ProcessRequest(const ExecuteRequest& req) {
 
 CQLResponse* CQLProcessor::ProcessRequest(const QueryRequest& req) {
   VLOG(1) << "QUERY " << req.query();
-  RunAsync(req.query(), req.params(), statement_executed_cb_);
-  return nullptr;
+  auto stmt = GetUnpreparedStatement(req);
+  if (!stmt.ok()) {
+    return ProcessError(stmt.status());
+  }
+  if (*stmt == nullptr) {
+    RunAsync(req.query(), req.params(), statement_executed_cb_);
+    return nullptr;
+  }
+  unprepared_stmt_ = std::move(*stmt);
+  const Status s = unprepared_stmt_->ExecuteAsync(this, req.params(), statement_executed_cb_);
+  return s.ok() ? nullptr : ProcessError(s);
 }
 
 CQLResponse* CQLProcessor::ProcessRequest(const BatchRequest& req) {
@@ -381,6 +391,43 @@ shared_ptr<const CQLStatement> CQLProcessor::GetPreparedStatement(const CQLMessa
   return stmt;
 }
 
+Result<shared_ptr<const CQLStatement>> CQLProcessor::GetUnpreparedStatement(
+    const QueryRequest& req) {
+  if (!CQLServiceImpl::UnpreparedStatementsCacheEnabled()) {
+    return shared_ptr<const CQLStatement>();
+  }
+
+  const string& keyspace = ql_env_.CurrentKeyspace();
+  shared_ptr<const CQLStatement> stmt = service_impl_->GetUnpreparedStatement(keyspace, req.query());
+  if (stmt != nullptr) {
+    stmt->clear_reparsed();
+    return stmt;
+  }
+
+  auto new_stmt = std::make_shared<CQLStatement>(keyspace, req.query(), CQLStatementListPos());
+  RETURN_NOT_OK(new_stmt->Prepare(this, service_impl_->unprepared_stmts_mem_tracker()));
+
+  // Only DML statements are cached. Other statements are rarely repeated and may change the state
+  // the analysis depends on, e.g. the current keyspace or the schema.
+  const Result<const ParseTree&> parse_tree = new_stmt->GetParseTree();
+  RETURN_NOT_OK(parse_tree);
+  const ql::TreeNode* root = parse_tree->root().get();
+  if (root != nullptr) {
+    switch (root->opcode()) {
+      case ql::TreeNodeOpcode::kPTSelectStmt: FALLTHROUGH_INTENDED;
+      case ql::TreeNodeOpcode::kPTInsertStmt: FALLTHROUGH_INTENDED;
+      case ql::TreeNodeOpcode::kPTUpdateStmt: FALLTHROUGH_INTENDED;
+      case ql::TreeNodeOpcode::kPTDeleteStmt:
+        service_impl_->InsertUnpreparedStatement(new_stmt);
+        break;
+      default:
+        break;
+    }
+  }
+  stmt = std::move(new_stmt);
+  return stmt;
+}
+
 void CQLProcessor::StatementExecuted(const Status& s, const ExecutedResult::SharedPtr& result) {
   unique_ptr<CQLResponse> response(s.ok() ? ProcessResult(result) : ProcessError(s));
   if (response) {
@@ -394,6 +441,11 @@ CQLResponse* CQLProcessor::ProcessError(const Status& s,
     ErrorCode ql_errcode = GetErrorCode(s);
     if (ql_errcode == ErrorCode::UNPREPARED_STATEMENT ||
         ql_errcode == ErrorCode::STALE_METADATA) {
+      // A stale unprepared statement is deleted from the cache, so that the retry below analyzes
+      // the query again.
+      if (unprepared_stmt_ != nullptr && unprepared_stmt_->stale()) {
+        service_impl_->DeleteUnpreparedStatement(unprepared_stmt_);
+      }
       // Delete all stale prepared statements from our cache. Since CQL protocol allows only one
       // unprepared query id to be returned, we will return just the last unprepared / stale one
       // we found.
@@ -415,6 +467,7 @@ CQLResponse* CQLProcessor::ProcessError(const Status& s,
       if (++retry_count_ == 1) {
         stmts_.clear();
         parse_trees_.clear();
+        unprepared_stmt_ = nullptr;
         Reschedule(&process_request_task_.Bind(this));
         return nullptr;
       }
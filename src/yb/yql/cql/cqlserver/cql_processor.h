@@ -88,6 +88,10 @@ class CQLProcessor : public ql::QLProcessor {
   // Get a prepared statement and adds it to the set of statements currently being executed.
   std::shared_ptr<const CQLStatement> GetPreparedStatement(const CQLMessage::QueryId& id);
 
+  // Get the analyzed statement of an unprepared query from the cache, or parse and analyze the
+  // query and cache the statement when it is a DML. Returns nullptr when the cache is disabled.
+  Result<std::shared_ptr<const CQLStatement>> GetUnpreparedStatement(const QueryRequest& req);
+
   // Statement executed callback.
   void StatementExecuted(const Status& s, const ql::ExecutedResult::SharedPtr& result = nullptr);
 
@@ -116,6 +120,9 @@ class CQLProcessor : public ql::QLProcessor {
   std::unordered_set<std::shared_ptr<const CQLStatement>> stmts_;
   std::unordered_set<ql::ParseTree::UniPtr> parse_trees_;
 
+  // Cached unprepared statement being executed for the current query.
+  std::shared_ptr<const CQLStatement> unprepared_stmt_;
+
   // Current retry count.
   int retry_count_ = 0;
 
@@ -16,6 +16,8 @@
 #include <mutex>
 #include <thread>
 
+#include <boost/thread/shared_mutex.hpp>
+
 #include "yb/client/meta_data_cache.h"
 #include "yb/client/transaction_pool.h"
 
@@ -40,6 +42,10 @@ DECLARE_bool(use_cassandra_authentication);
 DEFINE_int64(cql_service_max_prepared_statement_size_bytes, 128_MB,
              "The maximum amount of memory the CQL proxy should use to maintain prepared "
              "statements. 0 or negative means unlimited.");
+DEFINE_int64(cql_service_max_unprepared_statement_size_bytes, 32_MB,
+             "The maximum amount of memory the CQL proxy should use to cache analyzed unprepared "
+             "statements, so that repeated queries are not parsed and analyzed again. 0 or "
+             "negative disables the cache.");
 DEFINE_int32(cql_ybclient_reactor_threads, 24,
              "The number of reactor threads to be used for processing ybclient "
              "requests originating in the cql layer");
@@ -82,6 +88,10 @@ CQLServiceImpl::CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts,
       FLAGS_cql_service_max_prepared_statement_size_bytes : -1,
       "CQL prepared statements", server->mem_tracker());
 
+  // Unprepared statements are evicted explicitly on insert, so the tracker has no limit of its own.
+  unprepared_stmts_mem_tracker_ = MemTracker::CreateTracker(
+      "CQL unprepared statements", server->mem_tracker());
+
   auth_prepared_stmt_ = std::make_shared<ql::Statement>(
       "",
       Substitute("SELECT $0, $1 FROM system_auth.roles WHERE role = ?",
@@ -166,29 +176,36 @@ void CQLServiceImpl::ReturnProcessor(const CQLProcessorListPos& pos) {
   next_available_processor_ = pos;
 }
 
+CQLServiceImpl::PreparedStatementsShard& CQLServiceImpl::PreparedStatementsShardFor(
+    const CQLMessage::QueryId& query_id) {
+  return prepared_stmts_shards_[
+      std::hash<CQLMessage::QueryId>()(query_id) % kNumPreparedStatementsShards];
+}
+
 shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
     const CQLMessage::QueryId& query_id, const string& keyspace, const string& query) {
-  // Get exclusive lock before allocating a prepared statement and updating the LRU list.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  auto& shard = PreparedStatementsShardFor(query_id);
+
+  // Get exclusive lock before allocating a prepared statement and updating the CLOCK list.
+  std::lock_guard<rw_spinlock> guard(shard.lock);
 
   shared_ptr<CQLStatement> stmt;
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
+  const auto itr = shard.map.find(query_id);
+  if (itr == shard.map.end()) {
     // Allocate the prepared statement placeholder that multiple clients trying to prepare the same
     // statement to contend on. The statement will then be prepared by one client while the rest
     // wait for the results.
-    stmt = prepared_stmts_map_.emplace(
-        query_id, std::make_shared<CQLStatement>(
-            keyspace, query, prepared_stmts_list_.end())).first->second;
-    InsertLruPreparedStatementUnlocked(stmt);
+    stmt = shard.map.emplace(
+        query_id, std::make_shared<CQLStatement>(keyspace, query, shard.list.end())).first->second;
+    stmt->set_pos(shard.list.insert(shard.list.end(), stmt));
   } else {
     // Return existing statement if found.
     stmt = itr->second;
-    MoveLruPreparedStatementUnlocked(stmt);
+    stmt->MarkReferenced();
   }
 
-  VLOG(1) << "InsertPreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
+  VLOG(1) << "InsertPreparedStatement: CQL prepared statement shard cache count = "
+          << shard.map.size() << "/" << shard.list.size()
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 
   return stmt;
@@ -196,15 +213,20 @@ shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
 
 shared_ptr<const CQLStatement> CQLServiceImpl::GetPreparedStatement(
     const CQLMessage::QueryId& query_id) {
-  // Get exclusive lock before looking up a prepared statement and updating the LRU list.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  auto& shard = PreparedStatementsShardFor(query_id);
 
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
-    return nullptr;
-  }
+  shared_ptr<CQLStatement> stmt;
+  {
+    // Only shared lock is needed to look up a prepared statement, since the CLOCK list is not
+    // updated on hits.
+    boost::shared_lock<rw_spinlock> guard(shard.lock);
 
-  shared_ptr<CQLStatement> stmt = itr->second;
+    const auto itr = shard.map.find(query_id);
+    if (itr == shard.map.end()) {
+      return nullptr;
+    }
+    stmt = itr->second;
+  }
 
   // If the statement has not finished preparing, do not return it.
   if (stmt->unprepared()) {
@@ -212,64 +234,161 @@ shared_ptr<const CQLStatement> CQLServiceImpl::GetPreparedStatement(
   }
   // If the statement is stale, delete it.
   if (stmt->stale()) {
-    DeletePreparedStatementUnlocked(stmt);
+    std::lock_guard<rw_spinlock> guard(shard.lock);
+    DeletePreparedStatementUnlocked(&shard, stmt);
     return nullptr;
   }
 
-  MoveLruPreparedStatementUnlocked(stmt);
+  stmt->MarkReferenced();
   return stmt;
 }
 
 void CQLServiceImpl::DeletePreparedStatement(const shared_ptr<const CQLStatement>& stmt) {
+  auto& shard = PreparedStatementsShardFor(stmt->query_id());
+
   // Get exclusive lock before deleting the prepared statement.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  std::lock_guard<rw_spinlock> guard(shard.lock);
 
-  DeletePreparedStatementUnlocked(stmt);
+  DeletePreparedStatementUnlocked(&shard, stmt);
 
-  VLOG(1) << "DeletePreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
+  VLOG(1) << "DeletePreparedStatement: CQL prepared statement shard cache count = "
+          << shard.map.size() << "/" << shard.list.size()
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 }
 
-void CQLServiceImpl::InsertLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
-  // Insert the statement at the front of the LRU list.
-  stmt->set_pos(prepared_stmts_list_.insert(prepared_stmts_list_.begin(), stmt));
-}
-
-void CQLServiceImpl::MoveLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
-  // Move the statement to the front of the LRU list.
-  prepared_stmts_list_.splice(prepared_stmts_list_.begin(), prepared_stmts_list_, stmt->pos());
-}
-
 void CQLServiceImpl::DeletePreparedStatementUnlocked(
-    const std::shared_ptr<const CQLStatement> stmt) {
+    PreparedStatementsShard* shard, const std::shared_ptr<const CQLStatement> stmt) {
   // Remove statement from cache by looking it up by query ID and only when it is same statement
   // object. Note that the "stmt" parameter above is not a ref ("&") intentionally so that we have
-  // a separate copy of the shared_ptr and not the very shared_ptr in prepared_stmts_map_ or
-  // prepared_stmt_list_ we are deleting.
-  const auto itr = prepared_stmts_map_.find(stmt->query_id());
-  if (itr != prepared_stmts_map_.end() && itr->second == stmt) {
-    prepared_stmts_map_.erase(itr);
+  // a separate copy of the shared_ptr and not the very shared_ptr in the shard's map or list we
+  // are deleting.
+  const auto itr = shard->map.find(stmt->query_id());
+  if (itr != shard->map.end() && itr->second == stmt) {
+    shard->map.erase(itr);
   }
-  // Remove statement from LRU list only when it is in the list, i.e. pos() != end().
-  if (stmt->pos() != prepared_stmts_list_.end()) {
-    prepared_stmts_list_.erase(stmt->pos());
-    stmt->set_pos(prepared_stmts_list_.end());
+  // Remove statement from CLOCK list only when it is in the list, i.e. pos() != end().
+  if (stmt->pos() != shard->list.end()) {
+    shard->list.erase(stmt->pos());
+    stmt->set_pos(shard->list.end());
   }
 }
 
-void CQLServiceImpl::CollectGarbage(size_t required) {
-  // Get exclusive lock before deleting the least recently used statement at the end of the LRU
-  // list from the cache.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+bool CQLServiceImpl::EvictPreparedStatement(PreparedStatementsShard* shard) {
+  // Get exclusive lock before scanning the CLOCK list.
+  std::lock_guard<rw_spinlock> guard(shard->lock);
+
+  if (shard->list.empty()) {
+    return false;
+  }
 
-  if (!prepared_stmts_list_.empty()) {
-    DeletePreparedStatementUnlocked(prepared_stmts_list_.back());
+  // Statements used since the last scan are moved to the end of the list with the reference bit
+  // cleared. Statements could be marked concurrently, since lookups do not take the exclusive lock,
+  // so the scan is bounded by two passes over the list, evicting the first statement afterwards.
+  for (size_t i = 2 * shard->list.size(); i != 0; --i) {
+    const auto& stmt = shard->list.front();
+    if (!stmt->ClearReferenced()) {
+      break;
+    }
+    shard->list.splice(shard->list.end(), shard->list, stmt->pos());
   }
+  DeletePreparedStatementUnlocked(shard, shard->list.front());
 
-  VLOG(1) << "DeleteLruPreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
+  VLOG(1) << "DeleteLruPreparedStatement: CQL prepared statement shard cache count = "
+          << shard->map.size() << "/" << shard->list.size()
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
+  return true;
+}
+
+void CQLServiceImpl::CollectGarbage(size_t required) {
+  // Delete one not recently used statement, starting with the next shard in turn so that the
+  // evictions are spread evenly across the shards.
+  const size_t start = next_evicted_prepared_stmts_shard_.fetch_add(1, std::memory_order_relaxed);
+  for (size_t i = 0; i != kNumPreparedStatementsShards; ++i) {
+    if (EvictPreparedStatement(
+            &prepared_stmts_shards_[(start + i) % kNumPreparedStatementsShards])) {
+      return;
+    }
+  }
+}
+
+bool CQLServiceImpl::UnpreparedStatementsCacheEnabled() {
+  return FLAGS_cql_service_max_unprepared_statement_size_bytes > 0;
+}
+
+shared_ptr<const CQLStatement> CQLServiceImpl::GetUnpreparedStatement(
+    const string& keyspace, const string& query) {
+  if (!UnpreparedStatementsCacheEnabled()) {
+    return nullptr;
+  }
+
+  const CQLMessage::QueryId query_id = CQLStatement::GetQueryId(keyspace, query);
+
+  // Get exclusive lock before looking up an unprepared statement and updating the LRU list.
+  std::lock_guard<std::mutex> guard(unprepared_stmts_mutex_);
+
+  const auto itr = unprepared_stmts_map_.find(query_id);
+  if (itr == unprepared_stmts_map_.end()) {
+    return nullptr;
+  }
+
+  shared_ptr<CQLStatement> stmt = itr->second;
+
+  // If the statement is stale, delete it so that the query is analyzed again.
+  if (stmt->stale()) {
+    DeleteUnpreparedStatementUnlocked(stmt);
+    return nullptr;
+  }
+
+  unprepared_stmts_list_.splice(
+      unprepared_stmts_list_.begin(), unprepared_stmts_list_, stmt->pos());
+  return stmt;
+}
+
+void CQLServiceImpl::InsertUnpreparedStatement(const shared_ptr<CQLStatement>& stmt) {
+  const auto limit = FLAGS_cql_service_max_unprepared_statement_size_bytes;
+  if (limit <= 0) {
+    return;
+  }
+
+  // Get exclusive lock before inserting the statement and updating the LRU list.
+  std::lock_guard<std::mutex> guard(unprepared_stmts_mutex_);
+
+  // Another client could have cached the same query in the meantime. Keep the existing statement.
+  if (!unprepared_stmts_map_.emplace(stmt->query_id(), stmt).second) {
+    return;
+  }
+  stmt->set_pos(unprepared_stmts_list_.insert(unprepared_stmts_list_.begin(), stmt));
+
+  // Evict the least recently used statement to make room. The memory of an evicted statement is
+  // released only when the last execution using it is done, so the consumption could stay above
+  // the limit for a while. Evicting one statement per insert avoids flushing the whole cache in
+  // that case, while still keeping the cache bounded.
+  if (unprepared_stmts_mem_tracker_->consumption() > limit && unprepared_stmts_list_.size() > 1) {
+    DeleteUnpreparedStatementUnlocked(unprepared_stmts_list_.back());
+  }
+
+  VLOG(1) << "InsertUnpreparedStatement: CQL unprepared statement cache count = "
+          << unprepared_stmts_map_.size() << "/" << unprepared_stmts_list_.size()
+          << ", memory usage = " << unprepared_stmts_mem_tracker_->consumption();
+}
+
+void CQLServiceImpl::DeleteUnpreparedStatement(const shared_ptr<const CQLStatement>& stmt) {
+  // Get exclusive lock before deleting the unprepared statement.
+  std::lock_guard<std::mutex> guard(unprepared_stmts_mutex_);
+
+  DeleteUnpreparedStatementUnlocked(stmt);
+}
+
+void CQLServiceImpl::DeleteUnpreparedStatementUnlocked(
+    const std::shared_ptr<const CQLStatement> stmt) {
+  // Same as DeletePreparedStatementUnlocked, "stmt" is intentionally passed by value.
+  const auto itr = unprepared_stmts_map_.find(stmt->query_id());
+  if (itr == unprepared_stmts_map_.end() || itr->second != stmt) {
+    return;
+  }
+  unprepared_stmts_map_.erase(itr);
+  unprepared_stmts_list_.erase(stmt->pos());
+  stmt->set_pos(unprepared_stmts_list_.end());
 }
 
 client::TransactionPool* CQLServiceImpl::GetTransactionPool() {
@@ -17,6 +17,8 @@
 #ifndef YB_YQL_CQL_CQLSERVER_CQL_SERVICE_H_
 #define YB_YQL_CQL_CQLSERVER_CQL_SERVICE_H_
 
+#include <array>
+#include <atomic>
 #include <vector>
 
 #include "yb/client/client_fwd.h"
@@ -28,6 +30,7 @@
 #include "yb/yql/cql/cqlserver/cql_server_options.h"
 #include "yb/yql/cql/ql/statement.h"
 
+#include "yb/util/locks.h"
 #include "yb/util/string_case.h"
 
 #include "yb/client/async_initializer.h"
@@ -79,6 +82,26 @@ class CQLServiceImpl : public CQLServerServiceIf,
     return prepared_stmts_mem_tracker_;
   }
 
+  // Look up an analyzed unprepared statement by the current keyspace and the query text. Nullptr
+  // will be returned if the statement is not found or the unprepared statements cache is disabled.
+  std::shared_ptr<const CQLStatement> GetUnpreparedStatement(
+      const std::string& keyspace, const std::string& query);
+
+  // Cache an analyzed unprepared statement so that the same query does not need to be parsed and
+  // analyzed again. The least recently used statements are evicted when the cache is full.
+  void InsertUnpreparedStatement(const std::shared_ptr<CQLStatement>& stmt);
+
+  // Delete the unprepared statement from the cache.
+  void DeleteUnpreparedStatement(const std::shared_ptr<const CQLStatement>& stmt);
+
+  // Return the memory tracker for unprepared statements.
+  const MemTrackerPtr& unprepared_stmts_mem_tracker() const {
+    return unprepared_stmts_mem_tracker_;
+  }
+
+  // Whether the analyzed unprepared statements are cached.
+  static bool UnpreparedStatementsCacheEnabled();
+
   // Return the YBClient to communicate with either master or tserver.
   client::YBClient* client() const;
 
@@ -96,26 +119,48 @@ class CQLServiceImpl : public CQLServerServiceIf,
   server::Clock* clock();
 
  private:
+  friend class TestCQLPreparedStatements;
+
   constexpr static int kRpcTimeoutSec = 5;
 
   // Either gets an available processor or creates a new one.
   CQLProcessor *GetProcessor();
 
-  // Insert a prepared statement at the front of the LRU list. "prepared_stmts_mutex_" needs to be
-  // locked before this call.
-  void InsertLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
+  // A shard of the prepared statements cache. Statements are assigned to shards by query id, so
+  // lookups of different statements do not contend on the same lock. Instead of maintaining an
+  // exact LRU order, which requires an exclusive lock on every lookup, a used statement only sets
+  // its reference bit and the eviction gives it a second chance (CLOCK algorithm).
+  struct PreparedStatementsShard {
+    // Prepared statements cache.
+    CQLStatementMap map;
 
-  // Move a prepared statement to the front of the LRU list. "prepared_stmts_mutex_" needs to be
-  // locked before this call.
-  void MoveLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
+    // Prepared statements CLOCK list. New statements are appended at the end and eviction scans
+    // from the beginning.
+    CQLStatementList list;
 
-  // Delete a prepared statement from the cache and the LRU list. "prepared_stmts_mutex_" needs to
-  // be locked before this call.
-  void DeletePreparedStatementUnlocked(const std::shared_ptr<const CQLStatement> stmt);
+    // Lock that protects the prepared statements and the CLOCK list. Lookups take it shared.
+    rw_spinlock lock;
+  };
 
-  // Delete the least recently used prepared statement from the cache to free up memory.
+  // Return the shard the statement with the given query id belongs to.
+  PreparedStatementsShard& PreparedStatementsShardFor(const CQLMessage::QueryId& query_id);
+
+  // Delete a prepared statement from the cache and the CLOCK list. The lock of the statement's
+  // shard needs to be exclusively locked before this call.
+  void DeletePreparedStatementUnlocked(
+      PreparedStatementsShard* shard, const std::shared_ptr<const CQLStatement> stmt);
+
+  // Evict the first statement in the shard's CLOCK list, that was not used since the last scan.
+  // Returns false if the shard is empty.
+  bool EvictPreparedStatement(PreparedStatementsShard* shard);
+
+  // Delete a not recently used prepared statement from the cache to free up memory.
   void CollectGarbage(size_t required) override;
 
+  // Delete an unprepared statement from the cache and the LRU list. "unprepared_stmts_mutex_" needs
+  // to be locked before this call.
+  void DeleteUnpreparedStatementUnlocked(const std::shared_ptr<const CQLStatement> stmt);
+
   // CQLServer of this service.
   CQLServer* const server_;
 
@@ -137,20 +182,28 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Mutex that protects access to processors_.
   std::mutex processors_mutex_;
 
-  // Prepared statements cache.
-  CQLStatementMap prepared_stmts_map_;
+  static constexpr size_t kNumPreparedStatementsShards = 16;
 
-  // Prepared statements LRU list (least recently used one at the end).
-  CQLStatementList prepared_stmts_list_;
+  // Prepared statements cache shards.
+  std::array<PreparedStatementsShard, kNumPreparedStatementsShards> prepared_stmts_shards_;
 
-  // Mutex that protects the prepared statements and the LRU list.
-  std::mutex prepared_stmts_mutex_;
+  // Shard to start the next eviction from, so that evictions are spread across the shards.
+  std::atomic<size_t> next_evicted_prepared_stmts_shard_{0};
 
   std::shared_ptr<ql::Statement> auth_prepared_stmt_;
 
   // Tracker to measure and limit memory usage of prepared statements.
   MemTrackerPtr prepared_stmts_mem_tracker_;
 
+  // Analyzed unprepared statements cache, LRU list (least recently used one at the end) and the
+  // mutex that protects them.
+  CQLStatementMap unprepared_stmts_map_;
+  CQLStatementList unprepared_stmts_list_;
+  std::mutex unprepared_stmts_mutex_;
+
+  // Tracker to measure memory usage of unprepared statements.
+  MemTrackerPtr unprepared_stmts_mem_tracker_;
+
   // Metrics to be collected and reported.
   yb::rpc::RpcMethodMetrics metrics_;
 
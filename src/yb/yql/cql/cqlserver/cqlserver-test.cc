@@ -15,16 +15,32 @@
 #include <string>
 #include <vector>
 
+#include <boost/thread/shared_mutex.hpp>
+
+#include "yb/client/table_alterer.h"
+#include "yb/client/table_handle.h"
+
 #include "yb/gutil/strings/substitute.h"
 #include "yb/integration-tests/yb_table_test_base.h"
 
 #include "yb/yql/cql/cqlserver/cql_message.h"
 #include "yb/yql/cql/cqlserver/cql_server.h"
+#include "yb/yql/cql/cqlserver/cql_service.h"
+#include "yb/yql/cql/cqlserver/cql_statement.h"
+#include "yb/yql/cql/ql/ql_processor.h"
 
 #include "yb/gutil/strings/join.h"
+#include "yb/server/hybrid_clock.h"
 #include "yb/util/cast.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
+
+DECLARE_int64(cql_service_max_unprepared_statement_size_bytes);
+
+METRIC_DECLARE_histogram(handler_latency_yb_cqlserver_SQLProcessor_ParseRequest);
 
 namespace yb {
 namespace cqlserver {
@@ -43,9 +59,13 @@ class TestCQLService : public YBTableTestBase {
  protected:
   void SendRequestAndExpectTimeout(const string& cmd);
 
-  void SendRequestAndExpectResponse(const string& cmd, const string& resp);
+  void SendRequestAndExpectResponse(
+      const string& cmd, const string& resp, int timeout_in_millis = 1000);
 
   int server_port() { return cql_server_port_; }
+
+  CQLServer* server() { return server_.get(); }
+
  private:
   Status SendRequestAndGetResponse(
       const string& cmd, int expected_resp_length, int timeout_in_millis = 1000);
@@ -125,8 +145,9 @@ void TestCQLService::SendRequestAndExpectTimeout(const string& cmd) {
   ASSERT_TRUE(SendRequestAndGetResponse(cmd, 1).IsTimedOut());
 }
 
-void TestCQLService::SendRequestAndExpectResponse(const string& cmd, const string& resp) {
-  CHECK_OK(SendRequestAndGetResponse(cmd, resp.length()));
+void TestCQLService::SendRequestAndExpectResponse(
+    const string& cmd, const string& resp, int timeout_in_millis) {
+  CHECK_OK(SendRequestAndGetResponse(cmd, resp.length(), timeout_in_millis));
 
   // Verify that the response is as expected.
   CHECK_EQ(resp, string(reinterpret_cast<char*>(resp_), resp.length()));
@@ -251,5 +272,302 @@ TEST_F(TestCQLService, TestCQLServerEventConst) {
   ASSERT_EQ(0, memcmp(buffer, ptr, kSize));
 }
 
+namespace {
+
+const client::YBTableName kStatementsTableName("my_keyspace", "statements_table");
+
+// Response to a successful INSERT, UPDATE or DELETE.
+const string kVoidResultResponse = BINARY_STRING(
+    "\x84\x00\x00\x00\x08" "\x00\x00\x00\x04" "\x00\x00\x00\x01");
+
+void AppendInt32(int32_t value, string* out) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    out->push_back(static_cast<char>((value >> shift) & 0xff));
+  }
+}
+
+// Returns a QUERY request of the query without parameters, executed with consistency ONE.
+string QueryRequest(const string& query) {
+  string body;
+  AppendInt32(query.size(), &body);
+  body += query;
+  body += BINARY_STRING("\x00\x01" "\x00");
+  string request = BINARY_STRING("\x04\x00\x00\x00\x07");
+  AppendInt32(body.size(), &request);
+  return request + body;
+}
+
+} // namespace
+
+class TestCQLUnpreparedStatements : public TestCQLService {
+ public:
+  void SetUp() override {
+    TestCQLService::SetUp();
+    client::YBSchemaBuilder builder;
+    builder.AddColumn("k")->Type(INT32)->HashPrimaryKey()->NotNull();
+    builder.AddColumn("v")->Type(INT32);
+    ASSERT_OK(statements_table_.Create(kStatementsTableName, 1, client_.get(), &builder));
+  }
+
+ protected:
+  void ExecuteQuery(const string& query) {
+    SendRequestAndExpectResponse(QueryRequest(query), kVoidResultResponse, 30000 * kTimeMultiplier);
+  }
+
+  // Number of queries parsed by the server, i.e. not found in the cache.
+  int64_t NumParsedQueries() {
+    const auto metrics = server()->metric_entity()->UnsafeMetricsMapForTests();
+    const auto it = metrics.find(&METRIC_handler_latency_yb_cqlserver_SQLProcessor_ParseRequest);
+    return it == metrics.end() ? 0 : down_cast<Histogram*>(it->second.get())->TotalCount();
+  }
+
+  int64_t UnpreparedStatementsMemory() {
+    return server()->mem_tracker()->FindChild("CQL unprepared statements")->consumption();
+  }
+
+  client::TableHandle statements_table_;
+};
+
+TEST_F(TestCQLUnpreparedStatements, CacheHit) {
+  const string kQuery = "INSERT INTO my_keyspace.statements_table (k, v) VALUES (1, 1)";
+  const auto num_parsed = NumParsedQueries();
+  ExecuteQuery(kQuery);
+  ASSERT_EQ(num_parsed + 1, NumParsedQueries());
+  ASSERT_GT(UnpreparedStatementsMemory(), 0);
+
+  // The analyzed statement is reused.
+  ExecuteQuery(kQuery);
+  ExecuteQuery(kQuery);
+  ASSERT_EQ(num_parsed + 1, NumParsedQueries());
+
+  // Statements are cached by the raw query text, so the same query written differently is a
+  // different statement.
+  ExecuteQuery("INSERT INTO my_keyspace.statements_table (k, v)  VALUES (1, 1)");
+  ASSERT_EQ(num_parsed + 2, NumParsedQueries());
+
+}
+
+TEST_F(TestCQLUnpreparedStatements, AlterTable) {
+  const string kQuery = "INSERT INTO my_keyspace.statements_table (k, v) VALUES (1, 1)";
+  ExecuteQuery(kQuery);
+  const auto num_parsed = NumParsedQueries();
+
+  std::unique_ptr<client::YBTableAlterer> table_alterer(
+      client_->NewTableAlterer(kStatementsTableName));
+  table_alterer->AddColumn("w")->Type(INT32);
+  ASSERT_OK(table_alterer->Alter());
+
+  // The cached statement was analyzed with the old schema. Its execution fails with stale
+  // metadata, so the statement is removed from the cache and the query is analyzed again.
+  ExecuteQuery(kQuery);
+  ASSERT_EQ(num_parsed + 1, NumParsedQueries());
+
+  // The statement analyzed with the new schema is cached.
+  ExecuteQuery(kQuery);
+  ASSERT_EQ(num_parsed + 1, NumParsedQueries());
+}
+
+TEST_F(TestCQLUnpreparedStatements, EvictLeastRecentlyUsed) {
+  // Queries of the same length, so their statements use the same amount of memory.
+  auto query = [](int key) {
+    return Substitute("INSERT INTO my_keyspace.statements_table (k, v) VALUES ($0, $0)", key);
+  };
+  ExecuteQuery(query(1));
+  const auto statement_memory = UnpreparedStatementsMemory();
+  ASSERT_GT(statement_memory, 0);
+
+  // Room for two and a half statements.
+  FLAGS_cql_service_max_unprepared_statement_size_bytes = statement_memory * 5 / 2;
+  ExecuteQuery(query(2));
+  ExecuteQuery(query(1));
+  const auto num_parsed = NumParsedQueries();
+
+  // Statement 2 is the least recently used one, so it is evicted to make room for statement 3.
+  ExecuteQuery(query(3));
+  ASSERT_EQ(num_parsed + 1, NumParsedQueries());
+  ASSERT_LE(UnpreparedStatementsMemory(), FLAGS_cql_service_max_unprepared_statement_size_bytes);
+  ExecuteQuery(query(1));
+  ExecuteQuery(query(3));
+  ASSERT_EQ(num_parsed + 1, NumParsedQueries());
+  ExecuteQuery(query(2));
+  ASSERT_EQ(num_parsed + 2, NumParsedQueries());
+}
+
+// Tests of the prepared statements cache, that call the CQL service directly.
+class TestCQLPreparedStatements : public YBTableTestBase {
+ public:
+  void SetUp() override {
+    YBTableTestBase::SetUp();
+
+    CQLServerOptions opts;
+    auto master_rpc_addrs = master_rpc_addresses_as_strings();
+    opts.master_addresses_flag = JoinStrings(master_rpc_addrs, ",");
+    auto master_addresses = std::make_shared<server::MasterAddresses>();
+    for (const auto& hp_str : master_rpc_addrs) {
+      HostPort hp;
+      CHECK_OK(hp.ParseString(hp_str, 0));
+      master_addresses->push_back({std::move(hp)});
+    }
+    opts.SetMasterAddresses(master_addresses);
+
+    // The server is not started, it only provides metrics and memory trackers to the service.
+    io_.reset(new boost::asio::io_service());
+    server_.reset(new CQLServer(opts, io_.get(), nullptr, client::LocalTabletFilter()));
+    service_ = std::make_shared<CQLServiceImpl>(server_.get(), opts, client::LocalTabletFilter());
+
+    clock_.reset(new server::HybridClock());
+    ASSERT_OK(clock_->Init());
+    processor_.reset(new ql::QLProcessor(
+        service_->client(), service_->metadata_cache(), nullptr /* ql_metrics */, clock_,
+        ql::TransactionPoolProvider()));
+
+    client::YBSchemaBuilder builder;
+    builder.AddColumn("k")->Type(INT32)->HashPrimaryKey()->NotNull();
+    builder.AddColumn("v")->Type(INT32);
+    ASSERT_OK(statements_table_.Create(kStatementsTableName, 1, client_.get(), &builder));
+  }
+
+  void TearDown() override {
+    processor_.reset();
+    if (service_) {
+      service_->Shutdown();
+      service_.reset();
+    }
+    server_.reset();
+    YBTableTestBase::TearDown();
+  }
+
+ protected:
+  static constexpr size_t kNumShards = CQLServiceImpl::kNumPreparedStatementsShards;
+
+  static string Query(int key) {
+    return Substitute("SELECT v FROM my_keyspace.statements_table WHERE k = $0", key);
+  }
+
+  static CQLMessage::QueryId QueryId(const string& query) {
+    return CQLStatement::GetQueryId("" /* keyspace */, query);
+  }
+
+  size_t ShardIndex(const string& query) {
+    return &service_->PreparedStatementsShardFor(QueryId(query)) -
+           service_->prepared_stmts_shards_.data();
+  }
+
+  size_t ShardSize(size_t shard_index) {
+    auto& shard = service_->prepared_stmts_shards_[shard_index];
+    boost::shared_lock<rw_spinlock> guard(shard.lock);
+    return shard.map.size();
+  }
+
+  // Checks whether the statement is cached, without marking it as used.
+  bool IsCached(const string& query) {
+    auto& shard = service_->PreparedStatementsShardFor(QueryId(query));
+    boost::shared_lock<rw_spinlock> guard(shard.lock);
+    return shard.map.count(QueryId(query)) != 0;
+  }
+
+  Result<std::shared_ptr<const CQLStatement>> Prepare(const string& query) {
+    auto stmt = service_->AllocatePreparedStatement(QueryId(query), "" /* keyspace */, query);
+    RETURN_NOT_OK(stmt->Prepare(processor_.get(), service_->prepared_stmts_mem_tracker()));
+    return stmt;
+  }
+
+  bool Evict(size_t shard_index) {
+    return service_->EvictPreparedStatement(&service_->prepared_stmts_shards_[shard_index]);
+  }
+
+  void CollectGarbage() {
+    service_->CollectGarbage(1 /* required */);
+  }
+
+  unique_ptr<boost::asio::io_service> io_;
+  unique_ptr<CQLServer> server_;
+  std::shared_ptr<CQLServiceImpl> service_;
+  server::ClockPtr clock_;
+  unique_ptr<ql::QLProcessor> processor_;
+  client::TableHandle statements_table_;
+};
+
+TEST_F(TestCQLPreparedStatements, SecondChance) {
+  // Find three statements of the same shard.
+  const size_t shard_index = ShardIndex(Query(0));
+  vector<string> queries;
+  for (int key = 0; queries.size() < 3; ++key) {
+    if (ShardIndex(Query(key)) == shard_index) {
+      queries.push_back(Query(key));
+    }
+  }
+  for (const auto& query : queries) {
+    ASSERT_OK(Prepare(query));
+  }
+
+  // All statements were used since they were added, so each of them gets a second chance and the
+  // eviction takes the oldest one after the scan.
+  ASSERT_TRUE(Evict(shard_index));
+  ASSERT_FALSE(IsCached(queries[0]));
+  ASSERT_TRUE(IsCached(queries[1]));
+  ASSERT_TRUE(IsCached(queries[2]));
+
+  // The statement used since the last scan is kept, the unused one is evicted.
+  ASSERT_NE(service_->GetPreparedStatement(QueryId(queries[1])), nullptr);
+  ASSERT_TRUE(Evict(shard_index));
+  ASSERT_TRUE(IsCached(queries[1]));
+  ASSERT_FALSE(IsCached(queries[2]));
+
+  ASSERT_TRUE(Evict(shard_index));
+  ASSERT_FALSE(IsCached(queries[1]));
+  ASSERT_FALSE(Evict(shard_index));
+}
+
+TEST_F(TestCQLPreparedStatements, EvictionsSpreadAcrossShards) {
+  // Prepare two statements in every shard.
+  std::array<size_t, kNumShards> shard_sizes{};
+  size_t num_full_shards = 0;
+  for (int key = 0; num_full_shards < kNumShards; ++key) {
+    const string query = Query(key);
+    auto& shard_size = shard_sizes[ShardIndex(query)];
+    if (shard_size < 2) {
+      ASSERT_OK(Prepare(query));
+      if (++shard_size == 2) {
+        ++num_full_shards;
+      }
+    }
+  }
+
+  // Each garbage collection evicts a single statement, starting from the next shard in turn.
+  for (size_t i = 0; i != kNumShards; ++i) {
+    CollectGarbage();
+  }
+  for (size_t i = 0; i != kNumShards; ++i) {
+    ASSERT_EQ(1U, ShardSize(i)) << "Shard " << i;
+  }
+
+  // Empty shards are skipped.
+  for (size_t i = 0; i != kNumShards; ++i) {
+    CollectGarbage();
+  }
+  for (size_t i = 0; i != kNumShards; ++i) {
+    ASSERT_EQ(0U, ShardSize(i)) << "Shard " << i;
+  }
+  ASSERT_EQ(0, service_->prepared_stmts_mem_tracker()->consumption());
+}
+
+TEST_F(TestCQLPreparedStatements, StaleStatementRemovedOnLookup) {
+  const string query = Query(1);
+  auto stmt = ASSERT_RESULT(Prepare(query));
+  ASSERT_EQ(stmt, service_->GetPreparedStatement(QueryId(query)));
+  ASSERT_GT(service_->prepared_stmts_mem_tracker()->consumption(), 0);
+
+  const auto parse_tree = stmt->GetParseTree();
+  ASSERT_OK(parse_tree);
+  parse_tree->set_stale();
+  ASSERT_EQ(nullptr, service_->GetPreparedStatement(QueryId(query)));
+  ASSERT_FALSE(IsCached(query));
+
+  // The statement memory is released with the last reference.
+  stmt.reset();
+  ASSERT_EQ(0, service_->prepared_stmts_mem_tracker()->consumption());
+}
+
 }  // namespace cqlserver
 }  // namespace yb
@@ -33,15 +33,43 @@ Status Executor::AggregateResultSets(const PTSelectStmt* pt_select, TnodeContext
   shared_ptr<RowsResult> rows_result = tnode_context->rows_result();
   DCHECK(rows_result->client() == QLClient::YQL_CLIENT_CQL);
   shared_ptr<QLRowBlock> row_block = rows_result->GetRowBlock();
-  int column_index = 0;
   faststring buffer;
 
-  CQLEncodeLength(1, &buffer);
+  if (pt_select->group_by_column_count() == 0) {
+    CQLEncodeLength(1, &buffer);
+    RETURN_NOT_OK(AggregateRows(pt_select, row_block, rows_result.get(), &buffer));
+  } else {
+    // Grouping columns include all hash columns, so each group is aggregated by a single tablet
+    // and appears in a single row. Only partial aggregate values, like the sum and count of AVG,
+    // remain to be evaluated.
+    CQLEncodeLength(row_block->row_count(), &buffer);
+    auto group_block = std::make_shared<QLRowBlock>(row_block->schema());
+    for (auto& row : row_block->rows()) {
+      group_block->rows().clear();
+      group_block->rows().push_back(std::move(row));
+      RETURN_NOT_OK(AggregateRows(pt_select, group_block, rows_result.get(), &buffer));
+    }
+  }
+
+  // Change the result set to the aggregate result.
+  rows_result->set_rows_data(buffer.c_str(), buffer.size());
+  return Status::OK();
+}
+
+Status Executor::AggregateRows(const PTSelectStmt* pt_select,
+                               const shared_ptr<QLRowBlock>& row_block,
+                               RowsResult* rows_result,
+                               faststring* buffer) {
+  int column_index = 0;
   for (auto expr_node : pt_select->selected_exprs()) {
     QLValue ql_value;
 
     switch (expr_node->aggregate_opcode()) {
       case TSOpcode::kNoOp:
+        // Grouping column, the same for all rows of the group.
+        if (!row_block->rows().empty()) {
+          ql_value = row_block->row(0).column(column_index).value();
+        }
         break;
       case TSOpcode::kAvg:
         RETURN_NOT_OK(EvalAvg(row_block, column_index, expr_node->ql_type()->main(),
@@ -66,12 +94,9 @@ Status Executor::AggregateResultSets(const PTSelectStmt* pt_select, TnodeContext
     }
 
     // Serialize the return value.
-    ql_value.Serialize(expr_node->ql_type(), rows_result->client(), &buffer);
+    ql_value.Serialize(expr_node->ql_type(), rows_result->client(), buffer);
     column_index++;
   }
-
-  // Change the result set to the aggregate result.
-  rows_result->set_rows_data(buffer.c_str(), buffer.size());
   return Status::OK();
 }
 
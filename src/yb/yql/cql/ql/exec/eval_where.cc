@@ -315,6 +315,16 @@ Status Executor::WhereKeyToPB(QLReadRequestPB *req,
   return Status::OK();
 }
 
+Status Executor::KeyToPB(const Schema& schema, const QLRow& key, QLPrimaryKeyPB* key_pb) {
+  for (size_t idx = 0; idx < schema.num_hash_key_columns(); idx++) {
+    *key_pb->add_hashed_column_values()->mutable_value() = key.column(idx).value();
+  }
+  for (size_t idx = schema.num_hash_key_columns(); idx < schema.num_key_columns(); idx++) {
+    *key_pb->add_range_column_values()->mutable_value() = key.column(idx).value();
+  }
+  return Status::OK();
+}
+
 Status Executor::WhereJsonColOpToPB(QLConditionPB *condition, const JsonColumnOp& col_op) {
   // Set the operator.
   condition->set_op(col_op.yb_op());
@@ -189,6 +189,10 @@ Status TnodeContext::AppendRowsResult(RowsResult::SharedPtr&& rows_result) {
 
 void TnodeContext::InitializePartition(QLReadRequestPB *req, uint64_t start_partition) {
   current_partition_index_ = start_partition;
+  SetPartitionHashValues(req, start_partition);
+}
+
+void TnodeContext::SetPartitionHashValues(QLReadRequestPB *req, uint64_t start_partition) const {
   // Hash values before the first 'IN' condition will be already set.
   // hash_values_options_ vector starts from the first column with an 'IN' restriction.
   // E.g. for a query "h1 = 1 and h2 in (2,3) and h3 in (4,5) and h4 = 6":
@@ -243,6 +247,29 @@ void TnodeContext::AdvanceToNextPartition(QLReadRequestPB *req) {
   req->clear_max_hash_code();
 }
 
+void TnodeContext::SetParallelRead(const YBqlReadOpPtr& template_op, uint64_t start_partition) {
+  parallel_read_template_ = template_op;
+  current_partition_index_ = start_partition;
+}
+
+void TnodeContext::SetupPartitionRead(QLReadRequestPB *req, uint64_t partition) const {
+  if (hash_values_options_) {
+    SetPartitionHashValues(req, partition);
+    return;
+  }
+  const auto& range = partition_hash_ranges_[partition];
+  req->set_hash_code(range.first);
+  req->set_max_hash_code(range.second);
+}
+
+std::string TnodeContext::CurrentPartitionStartKey() const {
+  if (partition_hash_ranges_.empty()) {
+    return std::string();
+  }
+  return PartitionSchema::EncodeMultiColumnHashValue(
+      partition_hash_ranges_[current_partition_index_].first);
+}
+
 bool TnodeContext::HasPendingOperations() const {
   for (const auto& op : ops_) {
     if (!op->response().has_status()) {
@@ -105,6 +105,35 @@ class TnodeContext {
   // this will do, index: 2 -> 3 and hashed_column_values: [1, 3, 4, 6] -> [1, 3, 5, 6].
   void AdvanceToNextPartition(QLReadRequestPB *req);
 
+  // Used for multi-partition selects that read several partitions in parallel.
+  // Sets the request, from which the reads of individual partitions are produced, and the
+  // partition to start reading from. Called from Executor::ExecPTNode for PTSelectStmt.
+  void SetParallelRead(const client::YBqlReadOpPtr& template_op, uint64_t start_partition);
+
+  // Template of partition reads of multi-partition select that reads partitions in parallel,
+  // nullptr if partitions are read one by one.
+  const client::YBqlReadOpPtr& parallel_read_template() const {
+    return parallel_read_template_;
+  }
+
+  // Sets up request, produced from parallel read template, to read the specified partition.
+  void SetupPartitionRead(QLReadRequestPB *req, uint64_t partition) const;
+
+  // Marks the current partition of parallel read as completely read.
+  void FinishPartition() {
+    current_partition_index_++;
+  }
+
+  // Partition key, from which reading of the current partition should be resumed, if partition
+  // was not read at all. Empty when partition is identified by its index.
+  std::string CurrentPartitionStartKey() const;
+
+  // Used for table scans that read tablets in parallel. Each tablet is read as a separate
+  // partition, restricted to the hash code range of that tablet.
+  std::vector<std::pair<uint16_t, uint16_t>>& partition_hash_ranges() {
+    return partition_hash_ranges_;
+  }
+
   std::vector<std::vector<QLExpressionPB>>& hash_values_options() {
     if (!hash_values_options_) {
       hash_values_options_.emplace();
@@ -141,6 +170,9 @@ class TnodeContext {
   void SetUncoveredSelectOp(const client::YBqlReadOpPtr& select_op);
 
  private:
+  // Sets hashed column values of the specified partition in request of multi-partition select.
+  void SetPartitionHashValues(QLReadRequestPB *req, uint64_t partition) const;
+
   // Tree node of the statement being executed.
   const TreeNode* tnode_ = nullptr;
 
@@ -164,6 +196,14 @@ class TnodeContext {
   uint64_t partitions_count_ = 0;
   uint64_t current_partition_index_ = 0;
 
+  // For table scans that read tablets in parallel, the hash code range of each tablet to read.
+  std::vector<std::pair<uint16_t, uint16_t>> partition_hash_ranges_;
+
+  // For multi-partition selects that read partitions in parallel, the request all partition reads
+  // are produced from. Pending reads in ops_ are for consecutive partitions starting from
+  // current_partition_index_.
+  client::YBqlReadOpPtr parallel_read_template_;
+
   // Rows result of this statement tnode for DML statements.
   RowsResult::SharedPtr rows_result_;
 
@@ -30,10 +30,24 @@
 #include "yb/common/wire_protocol.h"
 #include "yb/rpc/thread_pool.h"
 #include "yb/util/decimal.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
 
+DEFINE_int32(cql_max_parallel_partition_reads, 16,
+             "Max number of partitions read in parallel by a single multi-partition SELECT, "
+             "i.e. a SELECT with IN condition on hash columns or a table scan. Value of 1 makes "
+             "such SELECT read partitions one by one.");
+TAG_FLAG(cql_max_parallel_partition_reads, advanced);
+
+DEFINE_int32(cql_follower_read_max_staleness_ms, 0,
+             "Max staleness of data returned by selects with consistency level ONE, which are "
+             "served by followers. Followers that lag behind more redirect such reads to other "
+             "replicas. 0 means staleness is not bounded.");
+TAG_FLAG(cql_follower_read_max_staleness_ms, advanced);
+TAG_FLAG(cql_follower_read_max_staleness_ms, runtime);
+
 namespace yb {
 namespace ql {
 
@@ -675,6 +689,15 @@ Status Executor::GetOffsetOrLimit(
 
 //--------------------------------------------------------------------------------------------------
 
+namespace {
+
+// Returns the row count limit of a read request, which is unlimited when not set.
+size_t ReadLimit(const QLReadRequestPB& req) {
+  return req.has_limit() ? req.limit() : std::numeric_limits<size_t>::max();
+}
+
+} // namespace
+
 Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_context) {
   const shared_ptr<client::YBTable>& table = tnode->table();
   if (table == nullptr) {
@@ -711,6 +734,9 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   // Where clause - Hash, range, and regular columns.
 
   req->set_is_aggregate(tnode->is_aggregate());
+  if (tnode->group_by_column_count() > 0) {
+    req->set_group_by_column_count(tnode->group_by_column_count());
+  }
 
   Result<uint64_t> max_rows_estimate = WhereClauseToPB(req, tnode->key_where_ops(),
                                                        tnode->where_ops(),
@@ -768,6 +794,8 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   // Default row count limit is the page size.
   // We should return paging state when page size limit is hit.
   // For system tables, we do not support page size so do nothing.
+  // For grouped aggregates, the limit is the number of groups, and tablets stop reading at a group
+  // boundary.
   if (!tnode->is_system()) {
     req->set_limit(params.page_size());
     req->set_return_paging_state(true);
@@ -826,13 +854,23 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   // start partition here, and then iteratively scan the rest in FetchMoreRows.
   // Otherwise, the request will already have the right hashed column values set.
   if (tnode_context->UnreadPartitionsRemaining() > 0) {
-    tnode_context->InitializePartition(select_op->mutable_request(),
-                                       continue_select ? params.next_partition_index() : 0);
-
     // We can optimize to run the ops in parallel (rather than serially) if:
     // - the estimated max number of rows is less than req limit (min of page size and CQL limit).
     // - there is no offset (which requires passing skipped rows from one request to the next).
-    if (*max_rows_estimate <= req->limit() && !req->has_offset()) {
+    const bool read_all_partitions = *max_rows_estimate <= req->limit() && !req->has_offset();
+
+    // Otherwise, partitions could still be read in parallel a window at a time, with results
+    // merged in partition order by ProcessPartitionReads.
+    if (!read_all_partitions && CanReadPartitionsInParallel(tnode, *req)) {
+      tnode_context->SetParallelRead(select_op,
+                                     continue_select ? params.next_partition_index() : 0);
+      return AddPartitionReads(tnode_context, ReadLimit(*req));
+    }
+
+    tnode_context->InitializePartition(select_op->mutable_request(),
+                                       continue_select ? params.next_partition_index() : 0);
+
+    if (read_all_partitions) {
       RETURN_NOT_OK(AddOperation(select_op, tnode_context));
       while (tnode_context->UnreadPartitionsRemaining() > 1) {
         YBqlReadOpPtr op(table->NewQLSelect());
@@ -844,6 +882,38 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
       }
       return Status::OK();
     }
+  } else if (req->hashed_column_values().empty() && CanReadPartitionsInParallel(tnode, *req)) {
+    // For a table scan, read the tablets in parallel, each of them as a separate partition.
+    auto& hash_ranges = tnode_context->partition_hash_ranges();
+    const auto& partitions = table->GetPartitions();
+    const uint16_t min_hash_code = req->has_hash_code() ? req->hash_code() : 0;
+    const uint16_t max_hash_code = req->has_max_hash_code() ? req->max_hash_code() : UINT16_MAX;
+    for (size_t i = 0; i != partitions.size(); ++i) {
+      const uint16_t start = partitions[i].empty()
+          ? 0 : PartitionSchema::DecodeMultiColumnHashValue(partitions[i]);
+      const uint16_t end = i + 1 != partitions.size()
+          ? PartitionSchema::DecodeMultiColumnHashValue(partitions[i + 1]) - 1 : UINT16_MAX;
+      if (end >= min_hash_code && start <= max_hash_code) {
+        hash_ranges.emplace_back(std::max(start, min_hash_code), std::min(end, max_hash_code));
+      }
+    }
+
+    if (hash_ranges.size() > 1) {
+      // Resume from the tablet that contains the partition key of the paging state.
+      uint64_t start_partition = 0;
+      if (continue_select && !params.next_partition_key().empty()) {
+        const uint16_t hash_code =
+            PartitionSchema::DecodeMultiColumnHashValue(params.next_partition_key());
+        while (start_partition + 1 < hash_ranges.size() &&
+               hash_ranges[start_partition].second < hash_code) {
+          ++start_partition;
+        }
+      }
+      tnode_context->set_partitions_count(hash_ranges.size());
+      tnode_context->SetParallelRead(select_op, start_partition);
+      return AddPartitionReads(tnode_context, ReadLimit(*req));
+    }
+    hash_ranges.clear();
   }
 
   // If this select statement uses an uncovered index underneath, save this op as a template to
@@ -959,7 +1029,9 @@ Result<bool> Executor::FetchMoreRows(const PTSelectStmt* tnode,
   // Fetch more results.
 
   // Update limit, offset and paging_state information for next scan request.
-  op->mutable_request()->set_limit(fetch_limit - current_fetch_row_count);
+  if (op->request().has_limit()) {
+    op->mutable_request()->set_limit(fetch_limit - current_fetch_row_count);
+  }
   if (tnode->offset()) {
     QLExpressionPB offset_pb;
     RETURN_NOT_OK(PTExprToPB(tnode->offset(), &offset_pb));
@@ -978,18 +1050,203 @@ Result<bool> Executor::FetchMoreRows(const PTSelectStmt* tnode,
 }
 
 
+bool Executor::CanReadPartitionsInParallel(const PTSelectStmt* tnode,
+                                           const QLReadRequestPB& req) const {
+  // Partitions with OFFSET have to be read serially, since the rows skipped in one partition
+  // determine the offset in the next one. Selects from uncovered index use the op as template for
+  // reading by primary keys instead.
+  return FLAGS_cql_max_parallel_partition_reads > 1 && !tnode->is_system() &&
+         !tnode->child_select() && !req.has_offset() && !exec_context_->HasTransaction();
+}
+
+Status Executor::AddPartitionReads(TnodeContext* tnode_context, size_t limit) {
+  const YBqlReadOpPtr& template_op = tnode_context->parallel_read_template();
+  const uint64_t num_reads = std::min<uint64_t>(
+      tnode_context->UnreadPartitionsRemaining(), FLAGS_cql_max_parallel_partition_reads);
+  // The limit is split across the window, so the partitions that do not fit in the page are not
+  // read in full. Partitions that stop at their share of the limit are continued in order.
+  const size_t partition_limit = (limit + num_reads - 1) / num_reads;
+  for (uint64_t i = 0; i != num_reads; ++i) {
+    YBqlReadOpPtr op(template_op->table()->NewQLSelect());
+    op->set_yb_consistency_level(template_op->yb_consistency_level());
+    QLReadRequestPB* req = op->mutable_request();
+    req->CopyFrom(template_op->request());
+    // Only the first partition could be continued from the paging state of the prior read.
+    if (i != 0) {
+      req->clear_paging_state();
+    }
+    tnode_context->SetupPartitionRead(req, tnode_context->current_partition_index() + i);
+    if (req->has_limit()) {
+      req->set_limit(partition_limit);
+    }
+    // Paging state tells whether the partition was read completely.
+    req->set_return_paging_state(true);
+    RETURN_NOT_OK(AddOperation(op, tnode_context));
+  }
+  template_op->mutable_request()->clear_paging_state();
+  return Status::OK();
+}
+
+Result<bool> Executor::ProcessPartitionReads(const PTSelectStmt* tnode,
+                                             TnodeContext* tnode_context) {
+  const YBqlReadOpPtr& template_op = tnode_context->parallel_read_template();
+  // The limit for this select: min of page size and result limit (if set).
+  const size_t fetch_limit = ReadLimit(template_op->request());
+
+  // Result is consumed while reads are in progress when selecting from uncovered index.
+  if (!tnode_context->rows_result()) {
+    RETURN_NOT_OK(tnode_context->AppendRowsResult(std::make_shared<RowsResult>(tnode)));
+  }
+
+  // Pending ops are for consecutive partitions starting from the current one, and rows are
+  // returned in partition order. Once a partition has to be read again, the results of the
+  // following partitions are kept until it is finished. They are only dropped when the page is
+  // full, and read again on the next page.
+  bool has_buffered_ops = false;
+  std::string next_partition_key;
+  std::string next_row_key;
+  auto& ops = tnode_context->ops();
+  auto op_itr = ops.begin();
+  while (op_itr != ops.end() && tnode_context->row_count() < fetch_limit) {
+    auto& op = static_cast<YBqlReadOp&>(**op_itr);
+    const size_t rows_left = fetch_limit - tnode_context->row_count();
+    const size_t row_count = op.rows_data().empty()
+        ? 0 : VERIFY_RESULT(QLRowBlock::GetRowCount(YQL_CLIENT_CQL, op.rows_data()));
+    if (row_count > rows_left) {
+      // Partition returned more rows than left in the page, read it again with the lower limit.
+      op.mutable_response()->Clear();
+      op.mutable_rows_data()->clear();
+      op.mutable_request()->set_limit(rows_left);
+      TRACE("Apply");
+      RETURN_NOT_OK(session_->Apply(*op_itr));
+      has_buffered_ops = true;
+      break;
+    }
+
+    QLPagingStatePB paging_state = op.response().paging_state();
+    if (row_count != 0) {
+      RETURN_NOT_OK(tnode_context->AppendRowsResult(std::make_shared<RowsResult>(&op)));
+    }
+
+    if (!paging_state.next_partition_key().empty() || !paging_state.next_row_key().empty()) {
+      if (tnode_context->row_count() >= fetch_limit) {
+        // The page is full, resume from the exact place where this partition stopped.
+        next_partition_key = std::move(*paging_state.mutable_next_partition_key());
+        next_row_key = std::move(*paging_state.mutable_next_row_key());
+        op_itr = ops.erase(op_itr);
+        break;
+      }
+      // Continue reading the partition.
+      QLReadRequestPB* req = op.mutable_request();
+      if (req->has_limit()) {
+        req->set_limit(fetch_limit - tnode_context->row_count());
+      }
+      QLPagingStatePB* req_paging_state = req->mutable_paging_state();
+      req_paging_state->set_next_partition_key(paging_state.next_partition_key());
+      req_paging_state->set_next_row_key(paging_state.next_row_key());
+      op.mutable_response()->Clear();
+      op.mutable_rows_data()->clear();
+      TRACE("Apply");
+      RETURN_NOT_OK(session_->Apply(*op_itr));
+      has_buffered_ops = true;
+      break;
+    }
+
+    tnode_context->FinishPartition();
+    op_itr = ops.erase(op_itr);
+  }
+
+  if (has_buffered_ops) {
+    return true;
+  }
+
+  const bool page_full = tnode_context->row_count() >= fetch_limit;
+  ops.clear();
+
+  if (!page_full && tnode_context->UnreadPartitionsRemaining() > 0) {
+    RETURN_NOT_OK(AddPartitionReads(tnode_context, fetch_limit - tnode_context->row_count()));
+    return true;
+  }
+
+  // All reads are done, set the paging state of the result.
+  RowsResult::SharedPtr& result = tnode_context->rows_result();
+  if (tnode_context->UnreadPartitionsRemaining() == 0 ||
+      !template_op->request().return_paging_state()) {
+    result->ClearPagingState();
+    return false;
+  }
+
+  const StatementParameters& params = exec_context_->params();
+  QLPagingStatePB paging_state;
+  paging_state.set_total_num_rows_read(params.total_num_rows_read() + tnode_context->row_count());
+  paging_state.set_total_rows_skipped(params.total_rows_skipped());
+  paging_state.set_table_id(tnode->table()->id());
+  paging_state.set_next_partition_index(tnode_context->current_partition_index());
+  if (next_partition_key.empty() && next_row_key.empty()) {
+    // Resume from the start of the partition.
+    next_partition_key = tnode_context->CurrentPartitionStartKey();
+  }
+  paging_state.set_next_partition_key(next_partition_key);
+  paging_state.set_next_row_key(next_row_key);
+  paging_state.set_original_request_id(params.request_id());
+  result->SetPagingState(paging_state);
+  return false;
+}
+
+
 Result<bool> Executor::FetchRowsByKeys(const PTSelectStmt* tnode,
                                        const YBqlReadOpPtr& select_op,
                                        const QLRowBlock& keys,
                                        TnodeContext* tnode_context) {
-  const Schema& schema = tnode->table()->InternalSchema();
+  const shared_ptr<client::YBTable>& table = tnode->table();
+  const Schema& schema = table->InternalSchema();
+
+  // Rows of a select with ORDER BY are read one key per request, so they are returned in the
+  // order of the keys selected from the index.
+  if (tnode->order_by_clause() != nullptr) {
+    for (const QLRow& key : keys.rows()) {
+      YBqlReadOpPtr op(table->NewQLSelect());
+      op->set_yb_consistency_level(select_op->yb_consistency_level());
+      QLReadRequestPB* req = op->mutable_request();
+      req->CopyFrom(select_op->request());
+      RETURN_NOT_OK(WhereKeyToPB(req, schema, key));
+      RETURN_NOT_OK(AddOperation(op, tnode_context));
+    }
+    return !keys.rows().empty();
+  }
+
+  // Otherwise, the keys are grouped by tablet and the rows of each tablet are read by a single
+  // request, with the tablets read in parallel. When the cached partitions are outdated, the tablet
+  // rejects keys it does not own as stale metadata, so the statement is rerun with fresh metadata.
+  const std::vector<string>& partitions = table->GetPartitions();
+  std::vector<YBqlReadOpPtr> ops(partitions.size());
+  string partition_key;
   for (const QLRow& key : keys.rows()) {
-    YBqlReadOpPtr op(tnode->table()->NewQLSelect());
-    op->set_yb_consistency_level(select_op->yb_consistency_level());
-    QLReadRequestPB* req = op->mutable_request();
-    req->CopyFrom(select_op->request());
-    RETURN_NOT_OK(WhereKeyToPB(req, schema, key));
-    RETURN_NOT_OK(AddOperation(op, tnode_context));
+    QLPrimaryKeyPB key_pb;
+    RETURN_NOT_OK(KeyToPB(schema, key, &key_pb));
+    RETURN_NOT_OK(table->partition_schema().EncodeKey(key_pb.hashed_column_values(),
+                                                      &partition_key));
+    key_pb.set_hash_code(PartitionSchema::DecodeMultiColumnHashValue(partition_key));
+
+    // The first partition starts with the empty key, so the tablet is always found.
+    const size_t partition_idx =
+        std::upper_bound(partitions.begin(), partitions.end(), partition_key) -
+        partitions.begin() - 1;
+    YBqlReadOpPtr& op = ops[partition_idx];
+    if (!op) {
+      op.reset(table->NewQLSelect());
+      op->set_yb_consistency_level(select_op->yb_consistency_level());
+      op->mutable_request()->CopyFrom(select_op->request());
+      // The hash code of any key of the tablet routes the request to it.
+      op->mutable_request()->set_hash_code(key_pb.hash_code());
+    }
+    op->mutable_request()->add_primary_keys()->Swap(&key_pb);
+  }
+
+  for (const YBqlReadOpPtr& op : ops) {
+    if (op) {
+      RETURN_NOT_OK(AddOperation(op, tnode_context));
+    }
   }
   return !keys.rows().empty();
 }
@@ -1652,6 +1909,10 @@ Result<bool> Executor::ProcessTnodeResults(TnodeContext* tnode_context) {
 
   // Go through each op in a TnodeContext and process async results.
   const TreeNode *tnode = tnode_context->tnode();
+  if (tnode_context->parallel_read_template()) {
+    return ProcessPartitionReads(static_cast<const PTSelectStmt *>(tnode), tnode_context);
+  }
+
   auto& ops = tnode_context->ops();
   for (auto op_itr = ops.begin(); op_itr != ops.end(); ) {
     YBqlOpPtr& op = *op_itr;
@@ -1989,6 +2250,10 @@ Status Executor::AddOperation(const YBqlReadOpPtr& op, TnodeContext *tnode_conte
   DCHECK(write_batch_.Empty()) << "Concurrent read and write operations not supported yet";
 
   op->mutable_request()->set_request_id(exec_context_->params().request_id());
+  if (op->yb_consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX &&
+      FLAGS_cql_follower_read_max_staleness_ms > 0) {
+    op->set_max_staleness(MonoDelta::FromMilliseconds(FLAGS_cql_follower_read_max_staleness_ms));
+  }
   tnode_context->AddOperation(op);
 
   // We need consistent read point if statement is executed in multiple RPC commands.
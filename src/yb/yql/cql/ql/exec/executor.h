@@ -217,6 +217,17 @@ class Executor : public QLExprExecutor {
                              TnodeContext* tnode_context,
                              ExecContext* exec_context);
 
+  // Whether partitions of a multi-partition select could be read in parallel.
+  bool CanReadPartitionsInParallel(const PTSelectStmt* tnode, const QLReadRequestPB& req) const;
+
+  // Issue reads of the next unread partitions of a multi-partition select in parallel, each read
+  // is limited to the specified number of rows.
+  CHECKED_STATUS AddPartitionReads(TnodeContext* tnode_context, size_t limit);
+
+  // Process results of partitions read in parallel, in partition order, and continue reading
+  // as needed. Returns true if there are new ops being buffered to be flushed.
+  Result<bool> ProcessPartitionReads(const PTSelectStmt* tnode, TnodeContext* tnode_context);
+
   // Fetch rows for a select statement using primary keys selected from an uncovered index.
   Result<bool> FetchRowsByKeys(const PTSelectStmt* tnode,
                                const client::YBqlReadOpPtr& select_op,
@@ -225,6 +236,11 @@ class Executor : public QLExprExecutor {
 
   // Aggregate all result sets from all tablet servers to form the requested resultset.
   CHECKED_STATUS AggregateResultSets(const PTSelectStmt* pt_select, TnodeContext* tnode_context);
+  // Aggregate the rows into a single row of the resultset and append it to buffer.
+  CHECKED_STATUS AggregateRows(const PTSelectStmt* pt_select,
+                               const std::shared_ptr<QLRowBlock>& row_block,
+                               RowsResult* rows_result,
+                               faststring* buffer);
   CHECKED_STATUS EvalCount(const std::shared_ptr<QLRowBlock>& row_block,
                            int column_index,
                            QLValue *ql_value);
@@ -350,6 +366,9 @@ class Executor : public QLExprExecutor {
   // Set a primary key in a read request.
   CHECKED_STATUS WhereKeyToPB(QLReadRequestPB *req, const Schema& schema, const QLRow& key);
 
+  // Convert a primary key to protobuf.
+  CHECKED_STATUS KeyToPB(const Schema& schema, const QLRow& key, QLPrimaryKeyPB* key_pb);
+
   // Convert an expression op in where clause to protobuf.
   CHECKED_STATUS WhereOpToPB(QLConditionPB *condition, const ColumnOp& col_op);
   CHECKED_STATUS WhereSubColOpToPB(QLConditionPB *condition, const SubscriptedColumnOp& subcol_op);
@@ -321,7 +321,7 @@ CHECKED_STATUS PTSelectStmt::Analyze(SemContext *sem_context) {
       has_singular_expr = true;
     }
   }
-  if (has_aggregate_expr && has_singular_expr) {
+  if (has_aggregate_expr && has_singular_expr && group_by_clause_ == nullptr) {
     return sem_context->Error(
         selected_exprs_,
         "Selecting aggregate together with rows of non-aggregate values is not allowed",
@@ -329,6 +329,8 @@ CHECKED_STATUS PTSelectStmt::Analyze(SemContext *sem_context) {
   }
   is_aggregate_ = has_aggregate_expr;
 
+  RETURN_NOT_OK(AnalyzeGroupByClause(sem_context));
+
   // Run error checking on the WHERE conditions.
   RETURN_NOT_OK(AnalyzeWhereClause(sem_context));
 
@@ -336,7 +338,8 @@ CHECKED_STATUS PTSelectStmt::Analyze(SemContext *sem_context) {
 
   // Check if there is an index to use. If there is and it covers the query fully, we will query
   // just the index and that is it.
-  if (index_id_.empty()) {
+  // Rows are grouped in the order of primary key of the table, so indexes are not used for GROUP BY.
+  if (index_id_.empty() && group_by_column_count_ == 0) {
     RETURN_NOT_OK(AnalyzeIndexes(sem_context));
     if (child_select_ && child_select_->covers_fully_) {
       return Status::OK();
@@ -523,6 +526,57 @@ CHECKED_STATUS PTSelectStmt::AnalyzeDistinctClause(SemContext *sem_context) {
   return Status::OK();
 }
 
+CHECKED_STATUS PTSelectStmt::AnalyzeGroupByClause(SemContext *sem_context) {
+  if (group_by_clause_ == nullptr) {
+    return Status::OK();
+  }
+
+  // Aggregates are evaluated by tablets, rows of a group have to be adjacent and stored in the
+  // same tablet. So only a prefix of primary key columns, that includes all hash columns, could be
+  // used to group rows.
+  if (!is_aggregate_ || distinct_ || offset_clause_ != nullptr) {
+    return sem_context->Error(
+        group_by_clause_,
+        "GROUP BY is only supported for aggregate select without DISTINCT and OFFSET",
+        ErrorCode::CQL_STATEMENT_INVALID);
+  }
+
+  SemState sem_state(sem_context);
+  sem_state.set_allowing_column_refs(true);
+  int column_index = 0;
+  for (const auto& node : group_by_clause_->node_list()) {
+    RETURN_NOT_OK(node->Analyze(sem_context));
+    const ColumnDesc* desc = node->opcode() == TreeNodeOpcode::kPTRef
+        ? static_cast<const PTRef*>(node.get())->desc() : nullptr;
+    if (desc == nullptr || !desc->is_primary() || desc->index() != column_index) {
+      return sem_context->Error(
+          node, "GROUP BY only supports primary key columns in the primary key order",
+          ErrorCode::CQL_STATEMENT_INVALID);
+    }
+    column_index++;
+  }
+  if (column_index < num_hash_key_columns()) {
+    return sem_context->Error(group_by_clause_, "GROUP BY must include all partition key columns",
+                              ErrorCode::CQL_STATEMENT_INVALID);
+  }
+  group_by_column_count_ = column_index;
+
+  // Non-aggregate selected expressions could only refer to the grouping columns.
+  for (const auto& expr_node : selected_exprs_->node_list()) {
+    if (expr_node->IsAggregateCall()) {
+      continue;
+    }
+    const ColumnDesc* desc = expr_node->opcode() == TreeNodeOpcode::kPTRef
+        ? static_cast<const PTRef*>(expr_node.get())->desc() : nullptr;
+    if (desc == nullptr || !desc->is_primary() || desc->index() >= column_index) {
+      return sem_context->Error(
+          expr_node, "Only grouping columns could be selected together with aggregates",
+          ErrorCode::CQL_STATEMENT_INVALID);
+    }
+  }
+  return Status::OK();
+}
+
 bool PTSelectStmt::IsReadableByAllSystemTable() const {
   const client::YBTableName t = table_name();
   const string& keyspace = t.namespace_name();
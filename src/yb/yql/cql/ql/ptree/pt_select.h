@@ -218,6 +218,11 @@ class PTSelectStmt : public PTDmlStmt {
     return is_aggregate_;
   }
 
+  // Number of leading primary key columns rows are grouped by, zero when there is no GROUP BY.
+  size_t group_by_column_count() const {
+    return group_by_column_count_;
+  }
+
   const PTSelectStmt::SharedPtr& child_select() const {
     return child_select_;
   }
@@ -258,6 +263,7 @@ class PTSelectStmt : public PTDmlStmt {
   CHECKED_STATUS LookupIndex(SemContext *sem_context);
   CHECKED_STATUS AnalyzeIndexes(SemContext *sem_context);
   CHECKED_STATUS AnalyzeDistinctClause(SemContext *sem_context);
+  CHECKED_STATUS AnalyzeGroupByClause(SemContext *sem_context);
   CHECKED_STATUS AnalyzeOrderByClause(SemContext *sem_context);
   CHECKED_STATUS AnalyzeLimitClause(SemContext *sem_context);
   CHECKED_STATUS AnalyzeOffsetClause(SemContext *sem_context);
@@ -288,6 +294,7 @@ class PTSelectStmt : public PTDmlStmt {
 
   bool is_forward_scan_ = true;
   bool is_aggregate_ = false;
+  size_t group_by_column_count_ = 0;
 
   // Child select statement. Currently only a select statement using an index (covered or uncovered)
   // has a child select statement to query an index.
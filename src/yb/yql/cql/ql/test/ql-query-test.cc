@@ -13,7 +13,9 @@
 //
 //--------------------------------------------------------------------------------------------------
 
+#include <set>
 #include <thread>
+#include <tuple>
 #include <cmath>
 
 #include "yb/client/table.h"
@@ -25,6 +27,8 @@
 #include "yb/util/crypt.h"
 #include "yb/yql/cql/ql/test/ql-test-base.h"
 
+DECLARE_int32(cql_max_parallel_partition_reads);
+
 using std::string;
 using std::unique_ptr;
 using std::shared_ptr;
@@ -1587,6 +1591,207 @@ TEST_F(TestQLQuery, TestPagination) {
   EXPECT_EQ(55, sum);
 }
 
+TEST_F(TestQLQuery, TestParallelPartitionReads) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  CHECK_VALID_STMT("CREATE TABLE t (h int, r int, v int, primary key((h), r));");
+
+  // Insert 0 to 3 rows per hash key, so partitions finish at different places of a page.
+  static constexpr int kNumKeys = 40;
+  string in_list;
+  for (int h = 1; h <= kNumKeys; h++) {
+    for (int r = 1; r <= h % 4; r++) {
+      CHECK_VALID_STMT(Substitute("INSERT INTO t (h, r, v) VALUES ($0, $1, $2);", h, r, h * r));
+    }
+    in_list += (h == 1 ? "" : ", ") + std::to_string(h);
+  }
+
+  // Read all pages of the select, verify that no page exceeds the page size.
+  auto read_all = [processor](const string& select_stmt, int page_size) {
+    StatementParameters params;
+    params.set_page_size(page_size);
+    string rows;
+    for (;;) {
+      CHECK_OK(processor->Run(select_stmt, params));
+      std::shared_ptr<QLRowBlock> row_block = processor->row_block();
+      EXPECT_LE(row_block->row_count(), page_size);
+      rows += row_block->ToString();
+      if (processor->rows_result()->paging_state().empty()) {
+        break;
+      }
+      CHECK_OK(params.SetPagingState(processor->rows_result()->paging_state()));
+    }
+    return rows;
+  };
+
+  const std::vector<string> select_stmts = {
+      Substitute("SELECT h, r, v FROM t WHERE h IN ($0);", in_list),
+      Substitute("SELECT h, r, v FROM t WHERE h IN ($0) LIMIT 17;", in_list),
+      "SELECT h, r, v FROM t;",
+      "SELECT h, r, v FROM t LIMIT 17;",
+  };
+  for (const auto& select_stmt : select_stmts) {
+    for (int page_size : {1, 2, 5, 100}) {
+      // Rows read partition by partition are the reference.
+      FLAGS_cql_max_parallel_partition_reads = 1;
+      const string expected_rows = read_all(select_stmt, page_size);
+      FLAGS_cql_max_parallel_partition_reads = 4;
+      EXPECT_EQ(expected_rows, read_all(select_stmt, page_size))
+          << select_stmt << ", page size: " << page_size;
+    }
+  }
+}
+
+TEST_F(TestQLQuery, TestUncoveredIndexSelectFromMultipleTablets) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster(3));
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  CHECK_VALID_STMT("CREATE TABLE t (h int, r int, v int, w int, primary key((h), r)) "
+                   "with transactions = {'enabled':true};");
+  // Column w is not covered by the index, so rows are fetched from the table by the keys read
+  // from the index.
+  CHECK_VALID_STMT("CREATE INDEX i ON t (v);");
+
+  shared_ptr<client::YBTable> table;
+  ASSERT_OK(client_->OpenTable(client::YBTableName(kDefaultKeyspaceName, "t"), &table));
+  ASSERT_GT(table->GetPartitions().size(), 1U);
+
+  // Rows of each indexed value are spread across all tablets of the table.
+  static constexpr int kNumKeys = 50;
+  static constexpr int kNumValues = 5;
+  std::set<std::tuple<int, int, int, int>> expected_rows;
+  for (int h = 1; h <= kNumKeys; h++) {
+    for (int r = 1; r <= 2; r++) {
+      const int v = h % kNumValues;
+      CHECK_VALID_STMT(Substitute(
+          "INSERT INTO t (h, r, v, w) VALUES ($0, $1, $2, $3);", h, r, v, h * 100 + r));
+      if (v == 1 || v == 3) {
+        expected_rows.emplace(h, r, v, h * 100 + r);
+      }
+    }
+  }
+
+  // Rows are returned in tablet order, so they are compared as a set.
+  auto select_rows = [processor](const string& select_stmt) {
+    CHECK_OK(processor->Run(select_stmt));
+    std::set<std::tuple<int, int, int, int>> rows;
+    for (const auto& row : processor->row_block()->rows()) {
+      EXPECT_TRUE(rows.emplace(row.column(0).int32_value(), row.column(1).int32_value(),
+                               row.column(2).int32_value(), row.column(3).int32_value()).second);
+    }
+    return rows;
+  };
+
+  EXPECT_EQ(expected_rows, select_rows("SELECT h, r, v, w FROM t WHERE v IN (1, 3);"));
+
+  std::set<std::tuple<int, int, int, int>> expected_single_value_rows;
+  for (const auto& row : expected_rows) {
+    if (std::get<2>(row) == 3) {
+      expected_single_value_rows.insert(row);
+    }
+  }
+  EXPECT_EQ(expected_single_value_rows, select_rows("SELECT h, r, v, w FROM t WHERE v = 3;"));
+  EXPECT_TRUE(select_rows("SELECT h, r, v, w FROM t WHERE v IN (7, 8);").empty());
+}
+
+TEST_F(TestQLQuery, TestGroupByAggregate) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  CHECK_VALID_STMT("CREATE TABLE t (h int, r1 int, r2 int, v int, primary key((h), r1, r2));");
+
+  static constexpr int kNumKeys = 10;
+  static constexpr int kNumR1 = 3;
+  static constexpr int kNumR2 = 4;
+  for (int h = 1; h <= kNumKeys; h++) {
+    for (int r1 = 1; r1 <= kNumR1; r1++) {
+      for (int r2 = 1; r2 <= kNumR2; r2++) {
+        CHECK_VALID_STMT(Substitute("INSERT INTO t (h, r1, r2, v) VALUES ($0, $1, $2, $3);",
+                                    h, r1, r2, h * r1 + r2));
+      }
+    }
+  }
+
+  // Group by hash and first range column, each group has kNumR2 rows.
+  auto check_groups = [processor](const string& select_stmt, size_t expected_row_count) {
+    CHECK_VALID_STMT(select_stmt);
+    std::shared_ptr<QLRowBlock> row_block = processor->row_block();
+    EXPECT_EQ(expected_row_count, row_block->row_count()) << select_stmt;
+    std::set<std::pair<int, int>> groups;
+    for (const auto& row : row_block->rows()) {
+      const int h = row.column(0).int32_value();
+      const int r1 = row.column(1).int32_value();
+      EXPECT_TRUE(groups.emplace(h, r1).second) << "Duplicate group: " << row.ToString();
+      EXPECT_EQ(kNumR2, row.column(2).int64_value());
+      const int sum = (h * r1) * kNumR2 + kNumR2 * (kNumR2 + 1) / 2;
+      EXPECT_EQ(sum, row.column(3).int32_value());
+      EXPECT_EQ(sum / kNumR2, row.column(4).int32_value());
+      EXPECT_EQ(h * r1 + kNumR2, row.column(5).int32_value());
+    }
+  };
+
+  const string select_stmt = "SELECT h, r1, count(*), sum(v), avg(v), max(v) FROM t";
+  check_groups(select_stmt + " GROUP BY h, r1;", kNumKeys * kNumR1);
+  check_groups(select_stmt + " WHERE h IN (2, 3, 5) GROUP BY h, r1;", 3 * kNumR1);
+  check_groups(select_stmt + " WHERE h = 7 AND r1 >= 2 GROUP BY h, r1;", kNumR1 - 1);
+  check_groups(select_stmt + " GROUP BY h, r1 LIMIT 5;", 5);
+  check_groups(select_stmt + " WHERE h IN (2, 3, 5) GROUP BY h, r1 LIMIT 4;", 4);
+
+  // Group by all primary key columns, one row per group.
+  CHECK_VALID_STMT("SELECT h, r1, r2, count(*) FROM t WHERE h = 1 GROUP BY h, r1, r2;");
+  EXPECT_EQ(kNumR1 * kNumR2, processor->row_block()->row_count());
+
+  // Group by hash column only.
+  CHECK_VALID_STMT("SELECT h, count(*) FROM t GROUP BY h;");
+  EXPECT_EQ(kNumKeys, processor->row_block()->row_count());
+  for (const auto& row : processor->row_block()->rows()) {
+    EXPECT_EQ(kNumR1 * kNumR2, row.column(1).int64_value());
+  }
+
+  // Grouped results are paged by group, each group is returned once and aggregated in full.
+  for (int page_size : {1, 2, 5}) {
+    StatementParameters params;
+    params.set_page_size(page_size);
+    std::set<std::pair<int, int>> groups;
+    for (;;) {
+      CHECK_OK(processor->Run(select_stmt + " GROUP BY h, r1;", params));
+      std::shared_ptr<QLRowBlock> row_block = processor->row_block();
+      EXPECT_LE(row_block->row_count(), page_size);
+      for (const auto& row : row_block->rows()) {
+        const int h = row.column(0).int32_value();
+        const int r1 = row.column(1).int32_value();
+        EXPECT_TRUE(groups.emplace(h, r1).second) << "Duplicate group: " << row.ToString();
+        EXPECT_EQ(kNumR2, row.column(2).int64_value()) << row.ToString();
+      }
+      if (processor->rows_result()->paging_state().empty()) {
+        break;
+      }
+      CHECK_OK(params.SetPagingState(processor->rows_result()->paging_state()));
+    }
+    EXPECT_EQ(kNumKeys * kNumR1, groups.size()) << "Page size: " << page_size;
+  }
+
+  // Grouping columns must be a prefix of primary key, that includes all hash columns.
+  CHECK_INVALID_STMT("SELECT r1, count(*) FROM t GROUP BY r1;");
+  CHECK_INVALID_STMT("SELECT h, r2, count(*) FROM t GROUP BY h, r2;");
+  CHECK_INVALID_STMT("SELECT h, r1, count(*) FROM t GROUP BY r1, h;");
+  CHECK_INVALID_STMT("SELECT h, v, count(*) FROM t GROUP BY h, v;");
+  // Only grouping columns could be selected along with aggregates.
+  CHECK_INVALID_STMT("SELECT h, r1, count(*) FROM t GROUP BY h;");
+  // GROUP BY without aggregates.
+  CHECK_INVALID_STMT("SELECT h, r1 FROM t GROUP BY h, r1;");
+}
+
 TEST_F(TestQLQuery, TestTokenBcall) {
   TestPartitionHash("token");
 }
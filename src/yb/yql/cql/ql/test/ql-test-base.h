@@ -16,9 +16,14 @@
 #ifndef YB_YQL_CQL_QL_TEST_QL_TEST_BASE_H_
 #define YB_YQL_CQL_QL_TEST_QL_TEST_BASE_H_
 
+#include <mutex>
+
 #include "yb/yql/cql/ql/ql_processor.h"
 #include "yb/yql/cql/ql/util/ql_env.h"
 
+#include "yb/client/transaction_manager.h"
+#include "yb/client/transaction_pool.h"
+
 #include "yb/integration-tests/mini_cluster.h"
 #include "yb/master/mini_master.h"
 
@@ -100,9 +105,10 @@ class TestQLProcessor : public ClockHolder, public QLProcessor {
   // Constructors.
   TestQLProcessor(client::YBClient* client,
                   std::shared_ptr<client::YBMetaDataCache> cache,
-                  const RoleName& role_name)
+                  const RoleName& role_name,
+                  TransactionPoolProvider transaction_pool_provider)
       : QLProcessor(client, cache, nullptr /* ql_metrics */, clock_,
-                    TransactionPoolProvider()) {
+                    std::move(transaction_pool_provider)) {
     if (!role_name.empty()) {
       ql_env_.ql_session()->set_current_role_name(role_name);
     }
@@ -185,7 +191,7 @@ class TestQLProcessor : public ClockHolder, public QLProcessor {
 };
 
 // Base class for all QL test cases.
-class QLTestBase : public YBTest {
+class QLTestBase : public YBTest, public ClockHolder {
  public:
   //------------------------------------------------------------------------------------------------
   // Constructor and destructor.
@@ -199,6 +205,8 @@ class QLTestBase : public YBTest {
   }
 
   virtual void TearDown() override {
+    transaction_pool_.reset();
+    transaction_manager_.reset();
     client_.reset();
     if (cluster_ != nullptr) {
       cluster_->Shutdown();
@@ -229,6 +237,10 @@ class QLTestBase : public YBTest {
   // Create ql processor.
   TestQLProcessor* GetQLProcessor(const RoleName& role_name = "");
 
+  // Transaction pool used by ql processors for statements on transactional tables. Created on
+  // first use.
+  client::TransactionPool* GetTransactionPool();
+
 
   //------------------------------------------------------------------------------------------------
   // Utility functions for QL tests.
@@ -267,6 +279,11 @@ class QLTestBase : public YBTest {
   std::unique_ptr<client::YBClient> client_;
   std::shared_ptr<client::YBMetaDataCache> metadata_cache_;
 
+  // Transactions of transactional tables.
+  std::mutex transaction_pool_mutex_;
+  std::unique_ptr<client::TransactionManager> transaction_manager_;
+  std::unique_ptr<client::TransactionPool> transaction_pool_;
+
   // QL Processor.
   std::vector<TestQLProcessor::UniPtr> ql_processors_;
 
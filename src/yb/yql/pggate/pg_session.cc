@@ -17,6 +17,7 @@
 
 #include "yb/yql/pggate/pg_expr.h"
 #include "yb/yql/pggate/pg_session.h"
+#include "yb/yql/pggate/pggate_flags.h"
 #include "yb/yql/pggate/pggate_if_cxx_decl.h"
 
 #include "yb/client/batcher.h"
@@ -123,7 +124,8 @@ Status PgSession::CreateDatabase(const string& database_name,
                                   GetPgsqlNamespaceId(database_oid),
                                   source_database_oid != kPgInvalidOid
                                   ? GetPgsqlNamespaceId(source_database_oid) : "",
-                                  next_oid);
+                                  next_oid,
+                                  FLAGS_ysql_colocate_database_by_default);
 }
 
 Status PgSession::DropDatabase(const string& database_name, PgOid database_oid) {
@@ -41,3 +41,7 @@ DEFINE_string(pggate_master_addresses, "",
 
 DEFINE_int32(ysql_prefetch_limit, 4096,
              "Maximum number of rows to prefetch");
+
+DEFINE_bool(ysql_colocate_database_by_default, false,
+            "Store all tables of newly created YSQL database in a single colocated tablet.");
+TAG_FLAG(ysql_colocate_database_by_default, advanced);
@@ -107,6 +107,7 @@ namespace redisserver {
     ((zrange, ZRange, -4, READ)) \
     ((zscore, ZScore, 3, READ)) \
     ((tsrem, TsRem, -3, WRITE)) \
+    ((tsremrangebytime, TsRemRangeByTime, 4, WRITE)) \
     ((zrem, ZRem, -3, WRITE)) \
     ((zadd, ZAdd, -4, WRITE)) \
     ((getset, GetSet, 3, WRITE)) \
@@ -634,6 +634,24 @@ CHECKED_STATUS ParseTsLastN(YBRedisReadOp* op, const RedisClientCommand& args) {
   return Status::OK();
 }
 
+CHECKED_STATUS ParseTsRemRangeByTime(YBRedisWriteOp* op, const RedisClientCommand& args) {
+  op->mutable_request()->mutable_del_request(); // Allocates new RedisDelRequestPB().
+
+  const auto& key = args[1];
+  RETURN_NOT_OK(ParseTsSubKeyBound(
+      args[2],
+      op->mutable_request()->mutable_subkey_range()->mutable_lower_bound(),
+      RedisCollectionGetRangeRequestPB_GetRangeRequestType_TSRANGEBYTIME));
+  RETURN_NOT_OK(ParseTsSubKeyBound(
+      args[3],
+      op->mutable_request()->mutable_subkey_range()->mutable_upper_bound(),
+      RedisCollectionGetRangeRequestPB_GetRangeRequestType_TSRANGEBYTIME));
+
+  op->mutable_request()->mutable_key_value()->set_key(key.cdata(), key.size());
+  op->mutable_request()->mutable_key_value()->set_type(REDIS_TYPE_TIMESERIES);
+  return Status::OK();
+}
+
 CHECKED_STATUS ParseTsRangeByTime(YBRedisReadOp* op, const RedisClientCommand& args) {
   op->mutable_request()->mutable_get_collection_range_request()->set_request_type(
       RedisCollectionGetRangeRequestPB_GetRangeRequestType_TSRANGEBYTIME);
@@ -4261,6 +4261,67 @@ TEST_F(TestRedisService, TestTsRem) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestTsRemRangeByTime) {
+  // Deletes of missing key are no-op.
+  DoRedisTestOk(__LINE__, {"TSREMRANGEBYTIME", "invalid_key", "20", "40"});
+
+  DoRedisTestOk(__LINE__, {"TSADD", "ts_key",
+      "10", "v1",
+      "20", "v2",
+      "30", "v3",
+      "40", "v4",
+      "50", "v5",
+      "60", "v6",
+      "70", "v7",
+      "80", "v8",
+      "90", "v9",
+      "100", "v10",
+  });
+  SyncClient();
+
+  DoRedisTestOk(__LINE__, {"TSREMRANGEBYTIME", "ts_key", "20", "40"});
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"TSRANGEBYTIME", "ts_key", "-inf", "+inf"},
+      {"10", "v1", "50", "v5", "60", "v6", "70", "v7", "80", "v8", "90", "v9", "100", "v10"});
+
+  // Exclusive bounds.
+  DoRedisTestOk(__LINE__, {"TSREMRANGEBYTIME", "ts_key", "(50", "(80"});
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"TSRANGEBYTIME", "ts_key", "-inf", "+inf"},
+      {"10", "v1", "50", "v5", "80", "v8", "90", "v9", "100", "v10"});
+
+  // Entries added after the deletion are visible.
+  DoRedisTestOk(__LINE__, {"TSADD", "ts_key", "30", "v30", "60", "v60"});
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"TSRANGEBYTIME", "ts_key", "-inf", "+inf"},
+      {"10", "v1", "30", "v30", "50", "v5", "60", "v60", "80", "v8", "90", "v9", "100", "v10"});
+
+  // Infinite bounds.
+  DoRedisTestOk(__LINE__, {"TSREMRANGEBYTIME", "ts_key", "90", "+inf"});
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"TSRANGEBYTIME", "ts_key", "-inf", "+inf"},
+      {"10", "v1", "30", "v30", "50", "v5", "60", "v60", "80", "v8"});
+  DoRedisTestOk(__LINE__, {"TSREMRANGEBYTIME", "ts_key", "-inf", "(50"});
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"TSRANGEBYTIME", "ts_key", "-inf", "+inf"},
+      {"50", "v5", "60", "v60", "80", "v8"});
+
+  // Empty range.
+  DoRedisTestOk(__LINE__, {"TSREMRANGEBYTIME", "ts_key", "80", "50"});
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"TSRANGEBYTIME", "ts_key", "-inf", "+inf"},
+      {"50", "v5", "60", "v60", "80", "v8"});
+
+  // Invalid commands.
+  DoRedisTestExpectError(__LINE__, {"TSREMRANGEBYTIME", "ts_key", "10"});
+  DoRedisTestExpectError(__LINE__, {"TSREMRANGEBYTIME", "ts_key", "v1", "10"});
+  DoRedisTestOk(__LINE__, {"HMSET", "hkey", "10", "v1", "20", "v2"});
+  DoRedisTestExpectError(__LINE__, {"TSREMRANGEBYTIME", "hkey", "10", "20"});
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestOverwrites) {
   // The default value is true, but we explicitly set this here for clarity.
   FLAGS_emulate_redis_responses = true;